@@ -0,0 +1 @@
+COPY person FROM "dataset/copy-csv-bool-test/vPerson.csv"
\ No newline at end of file
@@ -0,0 +1 @@
+create node table person (ID INT64, isActive BOOLEAN, PRIMARY KEY (ID));
\ No newline at end of file
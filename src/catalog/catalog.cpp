@@ -315,6 +315,7 @@ void CatalogContent::saveToFile(const string& directory, DBFileType dbFileType)
     auto catalogPath = StorageUtils::getCatalogFilePath(directory, dbFileType);
     auto fileInfo = FileUtils::openFile(catalogPath, O_WRONLY | O_CREAT);
     uint64_t offset = 0;
+    offset = writeMagicBytesAndStorageVersion(fileInfo.get(), offset);
     offset = SerDeser::serializeValue<uint64_t>(nodeTableSchemas.size(), fileInfo.get(), offset);
     offset = SerDeser::serializeValue<uint64_t>(relTableSchemas.size(), fileInfo.get(), offset);
     for (auto& nodeTableSchema : nodeTableSchemas) {
@@ -331,11 +332,39 @@ void CatalogContent::saveToFile(const string& directory, DBFileType dbFileType)
     FileUtils::closeFile(fileInfo->fd);
 }
 
+uint64_t CatalogContent::writeMagicBytesAndStorageVersion(FileInfo* fileInfo, uint64_t offset) {
+    auto numMagicBytes = strlen(StorageConfig::CATALOG_MAGIC_BYTES);
+    FileUtils::writeToFile(
+        fileInfo, (uint8_t*)StorageConfig::CATALOG_MAGIC_BYTES, numMagicBytes, offset);
+    return SerDeser::serializeValue<uint64_t>(
+        StorageConfig::STORAGE_VERSION, fileInfo, offset + numMagicBytes);
+}
+
+uint64_t CatalogContent::validateMagicBytesAndStorageVersion(
+    FileInfo* fileInfo, uint64_t offset) {
+    auto numMagicBytes = strlen(StorageConfig::CATALOG_MAGIC_BYTES);
+    string magicBytes(numMagicBytes, '\0');
+    FileUtils::readFromFile(fileInfo, (uint8_t*)magicBytes.data(), numMagicBytes, offset);
+    uint64_t storageVersion = 0;
+    offset = SerDeser::deserializeValue<uint64_t>(storageVersion, fileInfo, offset + numMagicBytes);
+    if (magicBytes != StorageConfig::CATALOG_MAGIC_BYTES ||
+        storageVersion != StorageConfig::STORAGE_VERSION) {
+        // Catalogs that were written before the storage version was introduced have no magic
+        // bytes.
+        throw CatalogException(
+            fileInfo->path + " was written with a storage version other than " +
+            to_string(StorageConfig::STORAGE_VERSION) +
+            ", so the database cannot be opened. Recreate the database from its CSV files.");
+    }
+    return offset;
+}
+
 void CatalogContent::readFromFile(const string& directory, DBFileType dbFileType) {
     auto catalogPath = StorageUtils::getCatalogFilePath(directory, dbFileType);
     logger->debug("Reading from {}.", catalogPath);
     auto fileInfo = FileUtils::openFile(catalogPath, O_RDONLY);
     uint64_t offset = 0;
+    offset = validateMagicBytesAndStorageVersion(fileInfo.get(), offset);
     uint64_t numNodeTables, numRelTables;
     offset = SerDeser::deserializeValue<uint64_t>(numNodeTables, fileInfo.get(), offset);
     offset = SerDeser::deserializeValue<uint64_t>(numRelTables, fileInfo.get(), offset);
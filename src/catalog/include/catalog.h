@@ -133,6 +133,10 @@ public:
 private:
     inline table_id_t assignNextTableID() { return nextTableID++; }
 
+    static uint64_t writeMagicBytesAndStorageVersion(FileInfo* fileInfo, uint64_t offset);
+    // Throws a CatalogException if the catalog was written with a different storage version.
+    static uint64_t validateMagicBytesAndStorageVersion(FileInfo* fileInfo, uint64_t offset);
+
 private:
     shared_ptr<spdlog::logger> logger;
     unordered_map<table_id_t, unique_ptr<NodeTableSchema>> nodeTableSchemas;
@@ -1,5 +1,7 @@
 #include "src/common/include/file_utils.h"
 
+#include <sys/mman.h>
+
 #include "src/common/include/exception.h"
 #include "src/common/include/utils.h"
 
@@ -69,6 +71,40 @@ void FileUtils::readFromFile(
     }
 }
 
+void FileUtils::prefetchFromFile(FileInfo* fileInfo, uint64_t numBytes, uint64_t position) {
+    if (fileInfo->fd == -1) {
+        return;
+    }
+#if defined(__APPLE__)
+    struct radvisory advisory {
+        (off_t) position, (int)numBytes
+    };
+    fcntl(fileInfo->fd, F_RDADVISE, &advisory);
+#elif defined(POSIX_FADV_WILLNEED)
+    posix_fadvise(fileInfo->fd, position, numBytes, POSIX_FADV_WILLNEED);
+#endif
+}
+
+void FileUtils::syncFile(FileInfo* fileInfo) {
+    if (fsync(fileInfo->fd) != 0) {
+        throw Exception(StringUtils::string_format("Cannot sync file. path: %s fileDescriptor: %d",
+            fileInfo->path.c_str(), fileInfo->fd));
+    }
+}
+
+uint8_t* FileUtils::mapFileForReading(FileInfo* fileInfo, uint64_t numBytes) {
+    auto mappedFile = mmap(nullptr, numBytes, PROT_READ, MAP_SHARED, fileInfo->fd, 0 /* offset */);
+    if (mappedFile == MAP_FAILED) {
+        throw Exception(StringUtils::string_format("Cannot map file. path: %s fileDescriptor: %d",
+            fileInfo->path.c_str(), fileInfo->fd));
+    }
+    return (uint8_t*)mappedFile;
+}
+
+void FileUtils::unmapFile(uint8_t* mappedFile, uint64_t numBytes) {
+    munmap(mappedFile, numBytes);
+}
+
 void FileUtils::createDir(const string& dir) {
     if (filesystem::exists(dir)) {
         throw Exception(StringUtils::string_format("Directory %s already exists.", dir.c_str()));
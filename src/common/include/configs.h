@@ -24,6 +24,10 @@ constexpr uint64_t DEFAULT_PAGE_SIZE = 1 << DEFAULT_PAGE_SIZE_LOG_2;
 constexpr const uint64_t LARGE_PAGE_SIZE_LOG_2 = 18;
 constexpr uint64_t LARGE_PAGE_SIZE = 1 << LARGE_PAGE_SIZE_LOG_2;
 
+// Size of a cache line, which is used to align data structures that are concurrently updated by
+// multiple threads to avoid false sharing.
+constexpr uint64_t CACHE_LINE_SIZE = 64;
+
 constexpr const double DEFAULT_HT_LOAD_FACTOR = 1.5;
 
 constexpr const uint32_t VAR_LENGTH_EXTEND_MAX_DEPTH = 30;
@@ -40,6 +44,10 @@ constexpr const uint64_t MULTI_VERSION_FILE_PAGE_GROUP_SIZE = 64;
 constexpr const uint64_t DEFAULT_CHECKPOINT_WAIT_TIMEOUT_FOR_TRANSACTIONS_TO_LEAVE_IN_MICROS =
     5000000;
 
+// A group commit is committed once its transactions have written this many WAL pages, which bounds
+// the work of the checkpoint that follows the commit. See SystemConfig.
+constexpr const uint64_t DEFAULT_MAX_NUM_WAL_PAGES_PER_GROUP_COMMIT = 1 << 14;
+
 const std::string INTERNAL_ID_SUFFIX = "_id";
 
 struct StorageConfig {
@@ -49,8 +57,21 @@ struct StorageConfig {
     // The default ratio of buffer allocated to large pages.
     static constexpr double DEFAULT_PAGES_BUFFER_RATIO = 0.75;
     static constexpr double LARGE_PAGES_BUFFER_RATIO = 1.0 - DEFAULT_PAGES_BUFFER_RATIO;
+    // The minimum number of frames in each clock partition of a buffer pool. Buffer pools with
+    // fewer frames use fewer partitions.
+    static constexpr uint64_t MIN_NUM_FRAMES_PER_CLOCK_PARTITION = 64;
+    // The number of times the clock hand skips a frame that has been repeatedly accessed under the
+    // CLOCK_2Q replacement policy.
+    static constexpr uint8_t CLOCK_2Q_MAX_RECENT_ACCESS_COUNT = 3;
+    // The maximum number of pages of a Column or Lists that are prefetched at once for a
+    // sequential read.
+    static constexpr uint64_t MAX_NUM_PAGES_TO_PREFETCH = 64;
+    // The maximum number of contiguous pages of a file that are written with a single write, e.g.,
+    // by the WALReplayer when checkpointing and by InMemDiskArrayBuilder when saving to disk.
+    static constexpr uint64_t MAX_NUM_PAGES_PER_WRITE = 64;
     static constexpr char OVERFLOW_FILE_SUFFIX[] = ".ovf";
     static constexpr char COLUMN_FILE_SUFFIX[] = ".col";
+    static constexpr char ZONE_MAP_FILE_SUFFIX[] = ".zonemap";
     static constexpr char LISTS_FILE_SUFFIX[] = ".lists";
     static constexpr char WAL_FILE_SUFFIX[] = ".wal";
     static constexpr char INDEX_FILE_SUFFIX[] = ".hindex";
@@ -62,6 +83,15 @@ struct StorageConfig {
     static constexpr char RELS_METADATA_FILE_NAME_FOR_WAL[] = "rels.statistics.wal";
     static constexpr char CATALOG_FILE_NAME[] = "catalog.bin";
     static constexpr char CATALOG_FILE_NAME_FOR_WAL[] = "catalog.bin.wal";
+    // The catalog file starts with these magic bytes and the version of the layout of the database
+    // files. The version must be bumped whenever the layout changes, so that a database that was
+    // written with a different layout is rejected when it is opened instead of being misread.
+    // Version 1 bit-packs BOOL property columns.
+    static constexpr char CATALOG_MAGIC_BYTES[] = "KUZU";
+    static constexpr uint64_t STORAGE_VERSION = 1;
+    // Temporary files of query operators that spill to disk, which are removed when the database
+    // is opened for writing.
+    static constexpr char SPILL_DIR_NAME[] = "spill";
     constexpr static double ARRAY_RESIZING_FACTOR = 1.2;
 
     constexpr static uint8_t UNSTR_PROP_KEY_IDX_LEN = 4;
@@ -84,13 +114,61 @@ struct ListsMetadataConfig {
 
 // Hash Index Configurations
 struct HashIndexConfig {
-    static constexpr uint8_t SLOT_CAPACITY_LOG_2 = 2;
-    static constexpr uint8_t SLOT_CAPACITY = (uint64_t)1 << SLOT_CAPACITY_LOG_2;
+    // The size of a slot, which spans whole cache lines. The number of entries in a slot depends on
+    // the size of the key type, see Slot<T>::CAPACITY.
+    static constexpr uint64_t SLOT_SIZE = 256;
+    // The number of partitions that HashIndexBuilder splits the primary slots into, each of which
+    // can be appended to by a different thread.
+    static constexpr uint64_t NUM_BUILD_PARTITIONS = 64;
+};
+
+struct HashAggregateConfig {
+    // Groups of thread-local aggregate hash tables are radix partitioned by the most significant
+    // bits of their hashes, so that partitions can be merged, finalized and scanned independently.
+    static constexpr uint32_t NUM_PARTITIONS_LOG_2 = 5;
+    static constexpr uint32_t NUM_PARTITIONS = 1 << NUM_PARTITIONS_LOG_2;
+};
+
+struct HashJoinConfig {
+    // The default of SystemConfig::hashJoinBuildMemoryBudgetRatio.
+    static constexpr double BUILD_MEMORY_BUDGET_RATIO = 0.5;
+    // Spilled tuples are partitioned by the most significant bits of the hash of their keys. A
+    // partition that is too large to be loaded is partitioned again by the next bits.
+    static constexpr uint32_t NUM_SPILL_PARTITIONS_LOG_2 = 5;
+    static constexpr uint32_t NUM_SPILL_PARTITIONS = 1 << NUM_SPILL_PARTITIONS_LOG_2;
+};
+
+struct ScanNodeIDConfig {
+    // Each thread scanning node IDs claims a batch of morsels at a time. A batch holds the number
+    // of morsels left divided by NUM_BATCHES_PER_THREAD_LEFT times the number of threads, but at
+    // most MAX_NUM_MORSELS_PER_BATCH morsels. So batches shrink to a single morsel towards the end.
+    static constexpr uint64_t NUM_BATCHES_PER_THREAD_LEFT = 4;
+    static constexpr uint64_t MAX_NUM_MORSELS_PER_BATCH = 16;
+};
+
+struct OrderByConfig {
+    // The fraction of the large pages buffer pool that the tuples of an order by may occupy before
+    // they are sorted into runs and spilled to disk.
+    static constexpr double MEMORY_BUDGET_RATIO = 0.5;
+    // Size (in bytes) of the buffer through which each spilled run is written and read.
+    static constexpr uint64_t RUN_BUFFER_SIZE = 1 << 16;
+};
+
+struct TopKConfig {
+    // ORDER BY with SKIP and/or LIMIT is executed by TopK if it needs at most MAX_K tuples, and by
+    // OrderBy otherwise. TopK does not spill, and each thread holds up to
+    // COMPACTION_THRESHOLD_FACTOR * k tuples before compacting them to its top k.
+    static constexpr uint64_t MAX_K = 1 << 16;
+    static constexpr uint64_t COMPACTION_THRESHOLD_FACTOR = 2;
 };
 
 struct CopyCSVConfig {
     // Size (in bytes) of the chunks to be read in InMemNode/RelCSVCopier
     static constexpr uint64_t CSV_READING_BLOCK_SIZE = 1 << 23;
+    // The nodes of consecutive blocks are added to the pk index in batches of at least this many
+    // nodes, which bounds the memory taken by the partitioned node offsets and hashes of a batch
+    // (16 bytes per node) by that of the batch instead of that of the whole file.
+    static constexpr uint64_t NUM_NODES_PER_PK_INDEX_BATCH = 1 << 22;
 
     static constexpr char UNSTR_PROPERTY_SEPARATOR[] = ":";
 
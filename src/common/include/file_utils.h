@@ -27,6 +27,15 @@ public:
         FileInfo* fileInfo, void* buffer, uint64_t numBytes, uint64_t position);
     static void writeToFile(
         FileInfo* fileInfo, uint8_t* buffer, uint64_t numBytes, uint64_t offset);
+    // Advises the OS to asynchronously read the given range of the file into its page cache, so
+    // that later reads of the range do not block on I/O. This is only a hint and never fails.
+    static void prefetchFromFile(FileInfo* fileInfo, uint64_t numBytes, uint64_t position);
+    // Blocks until all writes to the file are on stable storage.
+    static void syncFile(FileInfo* fileInfo);
+    // Maps the first numBytes of the file into memory for reading. The mapping is shared, so it is
+    // backed by the page cache of the OS, which is shared by all processes that map the file.
+    static uint8_t* mapFileForReading(FileInfo* fileInfo, uint64_t numBytes);
+    static void unmapFile(uint8_t* mappedFile, uint64_t numBytes);
     // This function is a no-op if either file, from or to, does not exist.
     static void overwriteFile(const string& from, const string& to);
     static void createDir(const string& dir);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -60,6 +61,10 @@ public:
         return (numThreadsRegistered > 0 && numThreadsFinished == numThreadsRegistered);
     }
 
+    // Blocks the calling thread until the task is completed. Note that a task is completed once all
+    // threads registered to it have finished, regardless of whether any of them has errored.
+    void waitUntilCompleted();
+
     inline void setSingleThreadedTask() { maxNumThreads = 1; }
 
     bool registerThread();
@@ -96,6 +101,7 @@ public:
 
 protected:
     mutex mtx;
+    condition_variable completedCV;
     uint64_t maxNumThreads, numThreadsFinished{0}, numThreadsRegistered{0};
     std::exception_ptr exceptionsPtr = nullptr;
     uint64_t ID;
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <deque>
 #include <thread>
+#include <unordered_map>
 
 #include "src/common/include/task_system/task.h"
 #include "src/common/include/utils.h"
@@ -11,18 +13,23 @@ namespace kuzu {
 namespace common {
 
 struct ScheduledTask {
-    ScheduledTask(shared_ptr<Task> task, uint64_t ID) : task{task}, ID{ID} {};
+    ScheduledTask(shared_ptr<Task> task, uint64_t ID, uint64_t priority)
+        : task{task}, ID{ID}, priority{priority} {};
     shared_ptr<Task> task;
     uint64_t ID;
+    uint64_t priority;
 };
 
 /**
  * TaskScheduler is a library that manages a set of worker threads that can execute tasks that are
  * put into a task queue. Each task accepts a maximum number of threads. Users of TaskScheduler
  * schedule tasks to be executed by calling schedule functions, e.g., scheduleTask or
- * scheduleTaskAndWaitOrError. New tasks are put at the end of the queue. Workers grab the first
+ * scheduleTaskAndWaitOrError. Each task is scheduled with a priority (0 by default). New tasks are
+ * put in the queue after all tasks with the same or a higher priority. Workers grab the first
  * task from the beginning of the queue that they can register themselves to work on. Any task that
- * is completed is removed automatically from the queue. If there is a task that raises an
+ * is completed is removed automatically from the queue. Idle workers and users waiting on tasks
+ * block on condition variables and are woken up when a task is scheduled or finished, so they do
+ * not poll the queue. If there is a task that raises an
  * exception, the worker threads catch it and store it with the tasks. The user thread that is
  * waiting on the completion of the task (or tasks) will throw the exception (the user thread could
  * be waiting on a tasks through a function that waits, e.g., scheduleTaskAndWaitOrError or
@@ -39,24 +46,34 @@ struct ScheduledTask {
  * (2) Schedule one task T and wait for T to finish or error if there was an exception raised by
  * one of the threads working on T that errored. This is simply done by the call:
  *      scheduleTaskAndWaitOrError(T);
+ * The dependencies of T (its children, recursively) form a tree, and each task of the tree is
+ * scheduled as soon as all of its children have completed. So sibling tasks, e.g., the build
+ * pipelines of multiple hash joins, run concurrently, and workers that finish one of them early
+ * move on to the others. Tasks that are scheduled once their children have completed, e.g., the
+ * probe pipeline of a hash join or the parallel finalization of a sink, get
+ * DEPENDENT_TASK_PRIORITY. So workers first finish queries that are already running before they
+ * start the leaf pipelines, e.g., long scans, of new queries.
  *
- * TaskScheduler guarantees that workers will register themselves to tasks in FIFO order. However
+ * TaskScheduler guarantees that workers will register themselves to tasks with the same priority
+ * in FIFO order. However
  * this does not guarantee that the tasks will be completed in FIFO order: a long running task
  * that is not accepting more registration can stay in the queue for an unlimited time until
  * completion.
  */
 class TaskScheduler {
 public:
+    static constexpr uint64_t DEPENDENT_TASK_PRIORITY = 1;
+
     explicit TaskScheduler(uint64_t numThreads);
     ~TaskScheduler();
 
     // Functions for the users of the task scheduler, e.g., processor to use.
 
-    // Schedules the dependencies of the given task and finally the task one after another (so
-    // not concurrently), and throws an exception if any of the tasks errors. Regardless of
-    // whether or not the given task or one of its dependencies errors, when this function
-    // returns, no task related to the given task will be in the task queue. Further no worker
-    // thread will be working on the given task.
+    // Schedules the dependencies of the given task and finally the task, where each task is
+    // scheduled once its dependencies have completed, and throws an exception if any of the tasks
+    // errors. Regardless of whether or not the given task or one of its dependencies errors, when
+    // this function returns, no task related to the given task will be in the task queue. Further
+    // no worker thread will be working on the given task or any of its dependencies.
     void scheduleTaskAndWaitOrError(const shared_ptr<Task>& task);
 
     // If a user, e.g., currently the copier, adds a set of tasks T1, ..., Tk, to the task scheduler
@@ -67,7 +84,7 @@ public:
     // removed from the task queue, so it will remain there permanently. We only remove erroring
     // tasks inside waitAllTasksToCompleteOrError and scheduleTaskAndWaitOrError. Also, see the note
     // below in waitAllTasksToCompleteOrError for details of the behavior when multiple tasks fail.
-    shared_ptr<ScheduledTask> scheduleTask(const shared_ptr<Task>& task);
+    shared_ptr<ScheduledTask> scheduleTask(const shared_ptr<Task>& task, uint64_t priority = 0);
 
     // Also note that if a user has scheduled multiple concrete tasks and calls
     // waitAllTasksToCompleteOrError and multiple tasks error, then waitAllTasksToCompleteOrError
@@ -76,18 +93,36 @@ public:
     // from the task queue and remain in the queue. So for now, use this function if you
     // want the system to crash if any of the tasks fails.
     void waitAllTasksToCompleteOrError();
-    bool isTaskQueueEmpty() { return taskQueue.empty(); }
+    bool isTaskQueueEmpty() {
+        lock_t lck{mtx};
+        return taskQueue.empty();
+    }
 
 private:
     void removeErroringTask(uint64_t scheduledTaskID);
 
+    // Schedules the tasks in the dependency tree of the given task that are not scheduled yet and
+    // whose dependencies have all completed successfully. Returns true if the given task has
+    // completed successfully.
+    bool scheduleTasksWithCompletedDependencies(const shared_ptr<Task>& task,
+        unordered_map<Task*, shared_ptr<ScheduledTask>>& scheduledTasks);
+    static uint64_t getNumFinishedTasks(
+        const unordered_map<Task*, shared_ptr<ScheduledTask>>& scheduledTasks);
+
     // Functions to launch worker threads and for the worker threads to use to grab task from queue.
     void runWorkerThread();
-    shared_ptr<ScheduledTask> getTaskAndRegister();
+    shared_ptr<ScheduledTask> getTaskAndRegisterNoLock();
+    void removeTaskIfCompletedSuccessfullyAndNotifyWaiters(
+        const shared_ptr<ScheduledTask>& scheduledTask);
 
 private:
     shared_ptr<spdlog::logger> logger;
     mutex mtx;
+    // Idle worker threads wait on workerCV for new tasks to be scheduled.
+    condition_variable workerCV;
+    // Users waiting in waitAllTasksToCompleteOrError wait on taskFinishedCV for worker threads to
+    // finish working on tasks.
+    condition_variable taskFinishedCV;
     deque<shared_ptr<ScheduledTask>> taskQueue;
     atomic<bool> stopThreads{false};
     vector<thread> threads;
@@ -61,6 +61,7 @@ public:
     }
 
     inline void setSequential() { _isSequential = true; }
+    inline void resetSequential() { _isSequential = false; }
     inline bool isSequential() const { return _isSequential; }
 
     inline InMemOverflowBuffer& getOverflowBuffer() const { return *inMemOverflowBuffer; }
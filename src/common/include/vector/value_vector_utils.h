@@ -18,8 +18,6 @@ public:
         ValueVector& resultVector, uint64_t pos, const uint8_t* srcData);
     static void copyNonNullDataWithSameTypeOutFromPos(const ValueVector& srcVector, uint64_t pos,
         uint8_t* dstData, InMemOverflowBuffer& dstOverflowBuffer);
-
-private:
     static void copyNonNullDataWithSameType(const DataType& dataType, const uint8_t* srcData,
         uint8_t* dstData, InMemOverflowBuffer& inMemOverflowBuffer);
 };
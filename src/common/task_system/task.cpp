@@ -17,9 +17,18 @@ bool Task::registerThread() {
 void Task::deRegisterThreadAndFinalizeTaskIfNecessary() {
     lock_t lck{mtx};
     ++numThreadsFinished;
-    if (!hasExceptionNoLock() && isCompletedNoLock()) {
+    if (!isCompletedNoLock()) {
+        return;
+    }
+    if (!hasExceptionNoLock()) {
         finalizeIfNecessary();
     }
+    completedCV.notify_all();
+}
+
+void Task::waitUntilCompleted() {
+    lock_t lck{mtx};
+    completedCV.wait(lck, [&] { return isCompletedNoLock(); });
 }
 
 } // namespace common
@@ -17,24 +17,34 @@ TaskScheduler::TaskScheduler(uint64_t numThreads)
 }
 
 TaskScheduler::~TaskScheduler() {
-    stopThreads.store(true);
+    lock_t lck{mtx};
+    stopThreads = true;
+    lck.unlock();
+    workerCV.notify_all();
     for (auto& thread : threads) {
         thread.join();
     }
 }
 
-shared_ptr<ScheduledTask> TaskScheduler::scheduleTask(const shared_ptr<Task>& task) {
+shared_ptr<ScheduledTask> TaskScheduler::scheduleTask(
+    const shared_ptr<Task>& task, uint64_t priority) {
     lock_t lck{mtx};
-    auto scheduledTask = make_shared<ScheduledTask>(task, nextScheduledTaskID++);
-    taskQueue.push_back(scheduledTask);
+    auto scheduledTask = make_shared<ScheduledTask>(task, nextScheduledTaskID++, priority);
+    // The queue is ordered by descending priority and tasks with the same priority are kept in FIFO
+    // order, so the new task is inserted before the first task with a lower priority.
+    auto it = find_if(taskQueue.begin(), taskQueue.end(),
+        [priority](const shared_ptr<ScheduledTask>& t) { return t->priority < priority; });
+    taskQueue.insert(it, scheduledTask);
+    lck.unlock();
+    workerCV.notify_all();
     return scheduledTask;
 }
 
 void TaskScheduler::waitAllTasksToCompleteOrError() {
     logger->debug("Thread {} called waitAllTasksToCompleteOrError. Beginning to wait.",
         ThreadUtils::getThreadIDString());
+    lock_t lck{mtx};
     while (true) {
-        lock_t lck{mtx};
         if (taskQueue.empty()) {
             logger->debug("Thread {} successfully waited all tasks to be complete. Returning from "
                           "waitAllTasksToCompleteOrError.",
@@ -51,33 +61,75 @@ void TaskScheduler::waitAllTasksToCompleteOrError() {
             // because tasks after the first registrable task in the queue cannot have any thread
             // yet registered to them, so they cannot have errored.
         }
-        lck.unlock();
-        this_thread::sleep_for(chrono::microseconds(THREAD_SLEEP_TIME_WHEN_WAITING_IN_MICROS));
+        // Worker threads notify waiters each time they finish working on a task, which is when a
+        // task can be completed and removed from the queue or can have errored.
+        taskFinishedCV.wait(lck);
     }
 }
 
 void TaskScheduler::scheduleTaskAndWaitOrError(const shared_ptr<Task>& task) {
     logger->debug("Thread {} called scheduleTaskAndWaitOrError. Scheduling task.",
         ThreadUtils::getThreadIDString());
-    for (auto& dependency : task->children) {
-        scheduleTaskAndWaitOrError(dependency);
-    }
-    auto scheduledTask = scheduleTask(task);
-    while (!task->isCompleted()) {
-        this_thread::sleep_for(chrono::microseconds(THREAD_SLEEP_TIME_WHEN_WAITING_IN_MICROS));
-    }
-    if (task->hasException()) {
-        logger->debug("Thread {} found a task with exception. Will call removeErroringTask.",
-            ThreadUtils::getThreadIDString());
-        removeErroringTask(scheduledTask->ID);
-        std::rethrow_exception(task->getExceptionPtr());
+    unordered_map<Task*, shared_ptr<ScheduledTask>> scheduledTasks;
+    auto numFinishedTasks = 0ul;
+    while (!scheduleTasksWithCompletedDependencies(task, scheduledTasks)) {
+        lock_t lck{mtx};
+        // Worker threads notify waiters each time they finish working on a task, which is when a
+        // scheduled task can be completed, so the tasks depending on it can be scheduled, or can
+        // have errored.
+        taskFinishedCV.wait(
+            lck, [&] { return getNumFinishedTasks(scheduledTasks) > numFinishedTasks; });
+        numFinishedTasks = getNumFinishedTasks(scheduledTasks);
+        lck.unlock();
+        for (auto& [_, scheduledTask] : scheduledTasks) {
+            if (!scheduledTask->task->hasException()) {
+                continue;
+            }
+            logger->debug("Thread {} found a task with exception. Will call removeErroringTask.",
+                ThreadUtils::getThreadIDString());
+            // Other scheduled tasks may still be running, so we wait for them to complete before
+            // removing them from the queue.
+            for (auto& taskAndScheduledTask : scheduledTasks) {
+                auto& scheduledTaskToRemove = taskAndScheduledTask.second;
+                scheduledTaskToRemove->task->waitUntilCompleted();
+                removeErroringTask(scheduledTaskToRemove->ID);
+            }
+            std::rethrow_exception(scheduledTask->task->getExceptionPtr());
+        }
     }
     logger->debug("Thread {} exiting scheduleTaskAndWaitOrError (task was successfully complete)",
         ThreadUtils::getThreadIDString());
 }
 
-shared_ptr<ScheduledTask> TaskScheduler::getTaskAndRegister() {
-    lock_t lck{mtx};
+bool TaskScheduler::scheduleTasksWithCompletedDependencies(
+    const shared_ptr<Task>& task, unordered_map<Task*, shared_ptr<ScheduledTask>>& scheduledTasks) {
+    if (scheduledTasks.contains(task.get())) {
+        return task->isCompletedSuccessfully();
+    }
+    auto areDependenciesCompleted = true;
+    for (auto& dependency : task->children) {
+        // Dependencies are independent of each other, so all of them are scheduled at once. Tasks
+        // that must run after a sibling are made a dependency of that sibling instead, see
+        // QueryProcessor::decomposePlanIntoTasks().
+        areDependenciesCompleted &=
+            scheduleTasksWithCompletedDependencies(dependency, scheduledTasks);
+    }
+    if (areDependenciesCompleted) {
+        auto priority = task->children.empty() ? 0 : DEPENDENT_TASK_PRIORITY;
+        scheduledTasks.insert({task.get(), scheduleTask(task, priority)});
+    }
+    return false;
+}
+
+uint64_t TaskScheduler::getNumFinishedTasks(
+    const unordered_map<Task*, shared_ptr<ScheduledTask>>& scheduledTasks) {
+    return count_if(scheduledTasks.begin(), scheduledTasks.end(),
+        [](auto& taskAndScheduledTask) {
+            return taskAndScheduledTask.second->task->isCompletedOrHasException();
+        });
+}
+
+shared_ptr<ScheduledTask> TaskScheduler::getTaskAndRegisterNoLock() {
     if (taskQueue.empty()) {
         return nullptr;
     }
@@ -124,15 +176,38 @@ void TaskScheduler::removeErroringTask(uint64_t scheduledTaskID) {
         ThreadUtils::getThreadIDString());
 }
 
+void TaskScheduler::removeTaskIfCompletedSuccessfullyAndNotifyWaiters(
+    const shared_ptr<ScheduledTask>& scheduledTask) {
+    lock_t lck{mtx};
+    if (scheduledTask->task->isCompletedSuccessfully()) {
+        auto it = find(taskQueue.begin(), taskQueue.end(), scheduledTask);
+        if (it != taskQueue.end()) {
+            logger->debug("Thread {} is removing completed schedule task {} from queue.",
+                ThreadUtils::getThreadIDString(), scheduledTask->ID);
+            taskQueue.erase(it);
+        }
+    }
+    lck.unlock();
+    taskFinishedCV.notify_all();
+}
+
 void TaskScheduler::runWorkerThread() {
     while (true) {
-        if (stopThreads.load()) {
-            break;
-        }
-        auto scheduledTask = getTaskAndRegister();
+        shared_ptr<ScheduledTask> scheduledTask;
+        lock_t lck{mtx};
+        // Idle workers block until a new task is scheduled or the scheduler is stopped instead of
+        // polling the queue. A worker that cannot register to any task in the queue cannot register
+        // to them later either, so it only needs to check the queue again after new tasks arrive.
+        workerCV.wait(lck, [&] {
+            if (stopThreads) {
+                return true;
+            }
+            scheduledTask = getTaskAndRegisterNoLock();
+            return scheduledTask != nullptr;
+        });
+        lck.unlock();
         if (!scheduledTask) {
-            this_thread::sleep_for(chrono::microseconds(THREAD_SLEEP_TIME_WHEN_WAITING_IN_MICROS));
-            continue;
+            break;
         }
         try {
             scheduledTask->task->run();
@@ -144,8 +219,8 @@ void TaskScheduler::runWorkerThread() {
                 e.what(), ThreadUtils::getThreadIDString());
             scheduledTask->task->setException(current_exception());
             scheduledTask->task->deRegisterThreadAndFinalizeTaskIfNecessary();
-            continue;
         }
+        removeTaskIfCompletedSuccessfullyAndNotifyWaiters(scheduledTask);
     }
 }
 
@@ -11,15 +11,16 @@ namespace function {
 
 unique_ptr<AggregateFunction> AggregateFunctionUtil::getCountStarFunction() {
     return make_unique<AggregateFunction>(CountStarFunction::initialize,
-        CountStarFunction::updateAll, CountStarFunction::updatePos, CountStarFunction::combine,
+        CountStarFunction::updateAll, CountStarFunction::updatePos,
+        updateStates<CountStarFunction::updatePos>, CountStarFunction::combine,
         CountStarFunction::finalize, DataType(ANY) /* dummy input data type */);
 }
 
 unique_ptr<AggregateFunction> AggregateFunctionUtil::getCountFunction(
     const DataType& inputType, bool isDistinct) {
     return make_unique<AggregateFunction>(CountFunction::initialize, CountFunction::updateAll,
-        CountFunction::updatePos, CountFunction::combine, CountFunction::finalize, inputType,
-        isDistinct);
+        CountFunction::updatePos, updateStates<CountFunction::updatePos>, CountFunction::combine,
+        CountFunction::finalize, inputType, isDistinct);
 }
 
 unique_ptr<AggregateFunction> AggregateFunctionUtil::getAvgFunction(
@@ -28,15 +29,18 @@ unique_ptr<AggregateFunction> AggregateFunctionUtil::getAvgFunction(
     case INT64:
         return make_unique<AggregateFunction>(AvgFunction<int64_t>::initialize,
             AvgFunction<int64_t>::updateAll, AvgFunction<int64_t>::updatePos,
-            AvgFunction<int64_t>::combine, AvgFunction<int64_t>::finalize, inputType, isDistinct);
+            updateStates<AvgFunction<int64_t>::updatePos>, AvgFunction<int64_t>::combine,
+            AvgFunction<int64_t>::finalize, inputType, isDistinct);
     case DOUBLE:
         return make_unique<AggregateFunction>(AvgFunction<double_t>::initialize,
             AvgFunction<double_t>::updateAll, AvgFunction<double_t>::updatePos,
-            AvgFunction<double_t>::combine, AvgFunction<double_t>::finalize, inputType, isDistinct);
+            updateStates<AvgFunction<double_t>::updatePos>, AvgFunction<double_t>::combine,
+            AvgFunction<double_t>::finalize, inputType, isDistinct);
     case UNSTRUCTURED:
         return make_unique<AggregateFunction>(AvgFunction<Value>::initialize,
             AvgFunction<Value>::updateAll, AvgFunction<Value>::updatePos,
-            AvgFunction<Value>::combine, AvgFunction<Value>::finalize, inputType, isDistinct);
+            updateStates<AvgFunction<Value>::updatePos>, AvgFunction<Value>::combine,
+            AvgFunction<Value>::finalize, inputType, isDistinct);
     default:
         assert(false);
     }
@@ -48,15 +52,18 @@ unique_ptr<AggregateFunction> AggregateFunctionUtil::getSumFunction(
     case INT64:
         return make_unique<AggregateFunction>(SumFunction<int64_t>::initialize,
             SumFunction<int64_t>::updateAll, SumFunction<int64_t>::updatePos,
-            SumFunction<int64_t>::combine, SumFunction<int64_t>::finalize, inputType, isDistinct);
+            updateStates<SumFunction<int64_t>::updatePos>, SumFunction<int64_t>::combine,
+            SumFunction<int64_t>::finalize, inputType, isDistinct);
     case DOUBLE:
         return make_unique<AggregateFunction>(SumFunction<double_t>::initialize,
             SumFunction<double_t>::updateAll, SumFunction<double_t>::updatePos,
-            SumFunction<double_t>::combine, SumFunction<double_t>::finalize, inputType, isDistinct);
+            updateStates<SumFunction<double_t>::updatePos>, SumFunction<double_t>::combine,
+            SumFunction<double_t>::finalize, inputType, isDistinct);
     case UNSTRUCTURED:
         return make_unique<AggregateFunction>(SumFunction<Value>::initialize,
             SumFunction<Value>::updateAll, SumFunction<Value>::updatePos,
-            SumFunction<Value>::combine, SumFunction<Value>::finalize, inputType, isDistinct);
+            updateStates<SumFunction<Value>::updatePos>, SumFunction<Value>::combine,
+            SumFunction<Value>::finalize, inputType, isDistinct);
     default:
         assert(false);
     }
@@ -79,37 +86,44 @@ unique_ptr<AggregateFunction> AggregateFunctionUtil::getMinMaxFunction(
     case BOOL:
         return make_unique<AggregateFunction>(MinMaxFunction<bool>::initialize,
             MinMaxFunction<bool>::updateAll<FUNC>, MinMaxFunction<bool>::updatePos<FUNC>,
+            updateStates<MinMaxFunction<bool>::updatePos<FUNC>>,
             MinMaxFunction<bool>::combine<FUNC>, MinMaxFunction<bool>::finalize, inputType,
             isDistinct);
     case INT64:
         return make_unique<AggregateFunction>(MinMaxFunction<int64_t>::initialize,
             MinMaxFunction<int64_t>::updateAll<FUNC>, MinMaxFunction<int64_t>::updatePos<FUNC>,
+            updateStates<MinMaxFunction<int64_t>::updatePos<FUNC>>,
             MinMaxFunction<int64_t>::combine<FUNC>, MinMaxFunction<int64_t>::finalize, inputType,
             isDistinct);
     case DOUBLE:
         return make_unique<AggregateFunction>(MinMaxFunction<double_t>::initialize,
             MinMaxFunction<double_t>::updateAll<FUNC>, MinMaxFunction<double_t>::updatePos<FUNC>,
+            updateStates<MinMaxFunction<double_t>::updatePos<FUNC>>,
             MinMaxFunction<double_t>::combine<FUNC>, MinMaxFunction<double_t>::finalize, inputType,
             isDistinct);
     case DATE:
         return make_unique<AggregateFunction>(MinMaxFunction<date_t>::initialize,
             MinMaxFunction<date_t>::updateAll<FUNC>, MinMaxFunction<date_t>::updatePos<FUNC>,
+            updateStates<MinMaxFunction<date_t>::updatePos<FUNC>>,
             MinMaxFunction<date_t>::combine<FUNC>, MinMaxFunction<date_t>::finalize, inputType,
             isDistinct);
     case STRING:
         return make_unique<AggregateFunction>(MinMaxFunction<ku_string_t>::initialize,
             MinMaxFunction<ku_string_t>::updateAll<FUNC>,
             MinMaxFunction<ku_string_t>::updatePos<FUNC>,
+            updateStates<MinMaxFunction<ku_string_t>::updatePos<FUNC>>,
             MinMaxFunction<ku_string_t>::combine<FUNC>, MinMaxFunction<ku_string_t>::finalize,
             inputType, isDistinct);
     case NODE_ID:
         return make_unique<AggregateFunction>(MinMaxFunction<nodeID_t>::initialize,
             MinMaxFunction<nodeID_t>::updateAll<FUNC>, MinMaxFunction<nodeID_t>::updatePos<FUNC>,
+            updateStates<MinMaxFunction<nodeID_t>::updatePos<FUNC>>,
             MinMaxFunction<nodeID_t>::combine<FUNC>, MinMaxFunction<nodeID_t>::finalize, inputType,
             isDistinct);
     case UNSTRUCTURED:
         return make_unique<AggregateFunction>(MinMaxFunction<Value>::initialize,
             MinMaxFunction<Value>::updateAll<FUNC>, MinMaxFunction<Value>::updatePos<FUNC>,
+            updateStates<MinMaxFunction<Value>::updatePos<FUNC>>,
             MinMaxFunction<Value>::combine<FUNC>, MinMaxFunction<Value>::finalize, inputType,
             isDistinct);
     default:
@@ -32,25 +32,63 @@ struct AggregateState {
     bool isNull = true;
 };
 
-using aggr_initialize_function_t = std::function<unique_ptr<AggregateState>()>;
+// Aggregate kernels are static functions, so we keep them as plain function pointers rather than
+// std::function to avoid the type-erased call on every tuple.
+using aggr_initialize_function_t = unique_ptr<AggregateState> (*)();
 using aggr_update_all_function_t =
-    std::function<void(uint8_t* state, ValueVector* input, uint64_t multiplicity)>;
+    void (*)(uint8_t* state, ValueVector* input, uint64_t multiplicity);
 using aggr_update_pos_function_t =
-    std::function<void(uint8_t* state, ValueVector* input, uint64_t multiplicity, uint32_t pos)>;
-using aggr_combine_function_t = std::function<void(uint8_t* state, uint8_t* otherState)>;
-using aggr_finalize_function_t = std::function<void(uint8_t* state)>;
+    void (*)(uint8_t* state, ValueVector* input, uint64_t multiplicity, uint32_t pos);
+using aggr_update_states_function_t = void (*)(
+    uint8_t** states, ValueVector* input, uint64_t multiplicity, const SelectionVector& selVector);
+using aggr_combine_function_t = void (*)(uint8_t* state, uint8_t* otherState);
+using aggr_finalize_function_t = void (*)(uint8_t* state);
+
+// Updates states[pos] for each selected pos with the input value at pos, or with the input value at
+// its current position if input is flat. Null input values are skipped and input is nullptr for
+// COUNT(*). The kernel is instantiated per aggregate function, so UPDATE_POS is inlined into the
+// loop instead of being called indirectly for every state.
+template<aggr_update_pos_function_t UPDATE_POS>
+void updateStates(
+    uint8_t** states, ValueVector* input, uint64_t multiplicity, const SelectionVector& selVector) {
+    if (input == nullptr) {
+        for (auto i = 0u; i < selVector.selectedSize; i++) {
+            UPDATE_POS(states[selVector.selectedPositions[i]], input, multiplicity, 0 /* dummy */);
+        }
+    } else if (input->state->isFlat()) {
+        auto inputPos = input->state->getPositionOfCurrIdx();
+        if (input->isNull(inputPos)) {
+            return;
+        }
+        for (auto i = 0u; i < selVector.selectedSize; i++) {
+            UPDATE_POS(states[selVector.selectedPositions[i]], input, multiplicity, inputPos);
+        }
+    } else if (input->hasNoNullsGuarantee()) {
+        for (auto i = 0u; i < selVector.selectedSize; i++) {
+            auto pos = selVector.selectedPositions[i];
+            UPDATE_POS(states[pos], input, multiplicity, pos);
+        }
+    } else {
+        for (auto i = 0u; i < selVector.selectedSize; i++) {
+            auto pos = selVector.selectedPositions[i];
+            if (!input->isNull(pos)) {
+                UPDATE_POS(states[pos], input, multiplicity, pos);
+            }
+        }
+    }
+}
 
 class AggregateFunction {
 
 public:
     AggregateFunction(aggr_initialize_function_t initializeFunc,
         aggr_update_all_function_t updateAllFunc, aggr_update_pos_function_t updatePosFunc,
-        aggr_combine_function_t combineFunc, aggr_finalize_function_t finalizeFunc,
-        DataType inputDataType, bool isDistinct = false)
-        : initializeFunc{move(initializeFunc)}, updateAllFunc{move(updateAllFunc)},
-          updatePosFunc{move(updatePosFunc)}, combineFunc{move(combineFunc)},
-          finalizeFunc{move(finalizeFunc)}, inputDataType{move(inputDataType)}, isDistinct{
-                                                                                    isDistinct} {
+        aggr_update_states_function_t updateStatesFunc, aggr_combine_function_t combineFunc,
+        aggr_finalize_function_t finalizeFunc, DataType inputDataType, bool isDistinct = false)
+        : initializeFunc{initializeFunc}, updateAllFunc{updateAllFunc},
+          updatePosFunc{updatePosFunc}, updateStatesFunc{updateStatesFunc},
+          combineFunc{combineFunc}, finalizeFunc{finalizeFunc},
+          inputDataType{move(inputDataType)}, isDistinct{isDistinct} {
         initialNullAggregateState = createInitialNullAggregateState();
     }
 
@@ -71,6 +109,11 @@ public:
         return updatePosFunc(state, input, multiplicity, pos);
     }
 
+    inline void updateStates(uint8_t** states, ValueVector* input, uint64_t multiplicity,
+        const SelectionVector& selVector) {
+        return updateStatesFunc(states, input, multiplicity, selVector);
+    }
+
     inline void combineState(uint8_t* state, uint8_t* otherState) {
         return combineFunc(state, otherState);
     }
@@ -83,13 +126,14 @@ public:
 
     unique_ptr<AggregateFunction> clone() {
         return make_unique<AggregateFunction>(initializeFunc, updateAllFunc, updatePosFunc,
-            combineFunc, finalizeFunc, inputDataType, isDistinct);
+            updateStatesFunc, combineFunc, finalizeFunc, inputDataType, isDistinct);
     }
 
 private:
     aggr_initialize_function_t initializeFunc;
     aggr_update_all_function_t updateAllFunc;
     aggr_update_pos_function_t updatePosFunc;
+    aggr_update_states_function_t updateStatesFunc;
     aggr_combine_function_t combineFunc;
     aggr_finalize_function_t finalizeFunc;
 
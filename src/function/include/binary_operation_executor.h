@@ -50,6 +50,73 @@ struct BinaryOperationExecutor {
             (void*)&resultValueVector);
     }
 
+    // Executes on positions [startPos, endPos) of unfiltered vectors that have no nulls in that
+    // range. Value pointers are hoisted out of the loop and flat operands are read at a fixed
+    // position, so the compiler can vectorize the loop for fixed-size types and simple operations.
+    template<typename LEFT_TYPE, typename RIGHT_TYPE, typename RESULT_TYPE, typename FUNC,
+        typename OP_WRAPPER, bool IS_LEFT_FLAT, bool IS_RIGHT_FLAT>
+    static inline void executeOnRange(ValueVector& left, ValueVector& right, ValueVector& result,
+        uint64_t lPos, uint64_t rPos, uint64_t startPos, uint64_t endPos) {
+        auto lValues = (LEFT_TYPE*)left.values;
+        auto rValues = (RIGHT_TYPE*)right.values;
+        auto resultValues = (RESULT_TYPE*)result.values;
+        for (auto i = startPos; i < endPos; i++) {
+            OP_WRAPPER::template operation<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC>(
+                lValues[IS_LEFT_FLAT ? lPos : i], rValues[IS_RIGHT_FLAT ? rPos : i],
+                resultValues[i], (void*)&left, (void*)&right, (void*)&result);
+        }
+    }
+
+    // Executes on unfiltered vectors, of which flat ones are known to be not null. Nulls are
+    // processed one null entry (64 positions) at a time: the result null entry is the OR of the
+    // null entries of the unflat operands, and the positions of an entry without nulls are
+    // executed in a single tight loop.
+    template<typename LEFT_TYPE, typename RIGHT_TYPE, typename RESULT_TYPE, typename FUNC,
+        typename OP_WRAPPER, bool IS_LEFT_FLAT, bool IS_RIGHT_FLAT>
+    static void executeOnUnfilteredVectors(
+        ValueVector& left, ValueVector& right, ValueVector& result) {
+        auto lPos = IS_LEFT_FLAT ? left.state->getPositionOfCurrIdx() : 0;
+        auto rPos = IS_RIGHT_FLAT ? right.state->getPositionOfCurrIdx() : 0;
+        uint64_t size = result.state->selVector->selectedSize;
+        if ((IS_LEFT_FLAT || left.hasNoNullsGuarantee()) &&
+            (IS_RIGHT_FLAT || right.hasNoNullsGuarantee())) {
+            executeOnRange<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER, IS_LEFT_FLAT,
+                IS_RIGHT_FLAT>(left, right, result, lPos, rPos, 0, size);
+            return;
+        }
+        auto lNullEntries = left.getNullMaskData();
+        auto rNullEntries = right.getNullMaskData();
+        auto resultNullEntries = result.getNullMaskData();
+        auto numNullEntries = (size + NullMask::NUM_BITS_PER_NULL_ENTRY - 1) >>
+                              NullMask::NUM_BITS_PER_NULL_ENTRY_LOG2;
+        for (auto entryIdx = 0u; entryIdx < numNullEntries; entryIdx++) {
+            auto startPos = (uint64_t)entryIdx << NullMask::NUM_BITS_PER_NULL_ENTRY_LOG2;
+            auto endPos = min(startPos + NullMask::NUM_BITS_PER_NULL_ENTRY, size);
+            // Null bits of positions beyond the selected size are left untouched.
+            auto rangeMask = NULL_LOWER_MASKS[endPos - startPos];
+            auto nullEntry = rangeMask & (IS_LEFT_FLAT ? NullMask::NO_NULL_ENTRY :
+                                                         lNullEntries[entryIdx]);
+            nullEntry |= rangeMask & (IS_RIGHT_FLAT ? NullMask::NO_NULL_ENTRY :
+                                                      rNullEntries[entryIdx]);
+            resultNullEntries[entryIdx] = (resultNullEntries[entryIdx] & ~rangeMask) | nullEntry;
+            if (nullEntry == NullMask::NO_NULL_ENTRY) {
+                executeOnRange<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER, IS_LEFT_FLAT,
+                    IS_RIGHT_FLAT>(left, right, result, lPos, rPos, startPos, endPos);
+                continue;
+            }
+            result.setMayContainNulls();
+            if (nullEntry == rangeMask) {
+                continue;
+            }
+            for (auto i = startPos; i < endPos; i++) {
+                if (!(nullEntry & NULL_BITMASKS_WITH_SINGLE_ONE[i - startPos])) {
+                    executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(left,
+                        right, result, IS_LEFT_FLAT ? lPos : i, IS_RIGHT_FLAT ? rPos : i, i);
+                }
+            }
+        }
+    }
+
     template<typename LEFT_TYPE, typename RIGHT_TYPE, typename RESULT_TYPE, typename FUNC,
         typename OP_WRAPPER>
     static void executeBothFlat(ValueVector& left, ValueVector& right, ValueVector& result) {
@@ -71,36 +138,22 @@ struct BinaryOperationExecutor {
         auto lPos = left.state->getPositionOfCurrIdx();
         if (left.isNull(lPos)) {
             result.setAllNull();
+        } else if (right.state->selVector->isUnfiltered()) {
+            executeOnUnfilteredVectors<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER,
+                true /* IS_LEFT_FLAT */, false /* IS_RIGHT_FLAT */>(left, right, result);
         } else if (right.hasNoNullsGuarantee()) {
-            if (right.state->selVector->isUnfiltered()) {
-                for (auto i = 0u; i < right.state->selVector->selectedSize; ++i) {
-                    executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
-                        left, right, result, lPos, i, i);
-                }
-            } else {
-                for (auto i = 0u; i < right.state->selVector->selectedSize; ++i) {
-                    auto rPos = right.state->selVector->selectedPositions[i];
-                    executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
-                        left, right, result, lPos, rPos, rPos);
-                }
+            for (auto i = 0u; i < right.state->selVector->selectedSize; ++i) {
+                auto rPos = right.state->selVector->selectedPositions[i];
+                executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
+                    left, right, result, lPos, rPos, rPos);
             }
         } else {
-            if (right.state->selVector->isUnfiltered()) {
-                for (auto i = 0u; i < right.state->selVector->selectedSize; ++i) {
-                    result.setNull(i, right.isNull(i)); // left is always not null
-                    if (!result.isNull(i)) {
-                        executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
-                            left, right, result, lPos, i, i);
-                    }
-                }
-            } else {
-                for (auto i = 0u; i < right.state->selVector->selectedSize; ++i) {
-                    auto rPos = right.state->selVector->selectedPositions[i];
-                    result.setNull(rPos, right.isNull(rPos)); // left is always not null
-                    if (!result.isNull(rPos)) {
-                        executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
-                            left, right, result, lPos, rPos, rPos);
-                    }
+            for (auto i = 0u; i < right.state->selVector->selectedSize; ++i) {
+                auto rPos = right.state->selVector->selectedPositions[i];
+                result.setNull(rPos, right.isNull(rPos)); // left is always not null
+                if (!result.isNull(rPos)) {
+                    executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
+                        left, right, result, lPos, rPos, rPos);
                 }
             }
         }
@@ -113,36 +166,22 @@ struct BinaryOperationExecutor {
         auto rPos = right.state->getPositionOfCurrIdx();
         if (right.isNull(rPos)) {
             result.setAllNull();
+        } else if (left.state->selVector->isUnfiltered()) {
+            executeOnUnfilteredVectors<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER,
+                false /* IS_LEFT_FLAT */, true /* IS_RIGHT_FLAT */>(left, right, result);
         } else if (left.hasNoNullsGuarantee()) {
-            if (left.state->selVector->isUnfiltered()) {
-                for (auto i = 0u; i < left.state->selVector->selectedSize; ++i) {
-                    executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
-                        left, right, result, i, rPos, i);
-                }
-            } else {
-                for (auto i = 0u; i < left.state->selVector->selectedSize; ++i) {
-                    auto lPos = left.state->selVector->selectedPositions[i];
-                    executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
-                        left, right, result, lPos, rPos, lPos);
-                }
+            for (auto i = 0u; i < left.state->selVector->selectedSize; ++i) {
+                auto lPos = left.state->selVector->selectedPositions[i];
+                executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
+                    left, right, result, lPos, rPos, lPos);
             }
         } else {
-            if (left.state->selVector->isUnfiltered()) {
-                for (auto i = 0u; i < left.state->selVector->selectedSize; ++i) {
-                    result.setNull(i, left.isNull(i)); // right is always not null
-                    if (!result.isNull(i)) {
-                        executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
-                            left, right, result, i, rPos, i);
-                    }
-                }
-            } else {
-                for (auto i = 0u; i < left.state->selVector->selectedSize; ++i) {
-                    auto lPos = left.state->selVector->selectedPositions[i];
-                    result.setNull(lPos, left.isNull(lPos)); // right is always not null
-                    if (!result.isNull(lPos)) {
-                        executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
-                            left, right, result, lPos, rPos, lPos);
-                    }
+            for (auto i = 0u; i < left.state->selVector->selectedSize; ++i) {
+                auto lPos = left.state->selVector->selectedPositions[i];
+                result.setNull(lPos, left.isNull(lPos)); // right is always not null
+                if (!result.isNull(lPos)) {
+                    executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
+                        left, right, result, lPos, rPos, lPos);
                 }
             }
         }
@@ -153,36 +192,22 @@ struct BinaryOperationExecutor {
     static void executeBothUnFlat(ValueVector& left, ValueVector& right, ValueVector& result) {
         assert(left.state == right.state);
         result.state = left.state;
-        if (left.hasNoNullsGuarantee() && right.hasNoNullsGuarantee()) {
-            if (result.state->selVector->isUnfiltered()) {
-                for (uint64_t i = 0; i < result.state->selVector->selectedSize; i++) {
-                    executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
-                        left, right, result, i, i, i);
-                }
-            } else {
-                for (uint64_t i = 0; i < result.state->selVector->selectedSize; i++) {
-                    auto pos = result.state->selVector->selectedPositions[i];
-                    executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
-                        left, right, result, pos, pos, pos);
-                }
+        if (result.state->selVector->isUnfiltered()) {
+            executeOnUnfilteredVectors<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER,
+                false /* IS_LEFT_FLAT */, false /* IS_RIGHT_FLAT */>(left, right, result);
+        } else if (left.hasNoNullsGuarantee() && right.hasNoNullsGuarantee()) {
+            for (uint64_t i = 0; i < result.state->selVector->selectedSize; i++) {
+                auto pos = result.state->selVector->selectedPositions[i];
+                executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
+                    left, right, result, pos, pos, pos);
             }
         } else {
-            if (result.state->selVector->isUnfiltered()) {
-                for (uint64_t i = 0; i < result.state->selVector->selectedSize; i++) {
-                    result.setNull(i, left.isNull(i) || right.isNull(i));
-                    if (!result.isNull(i)) {
-                        executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
-                            left, right, result, i, i, i);
-                    }
-                }
-            } else {
-                for (uint64_t i = 0; i < result.state->selVector->selectedSize; i++) {
-                    auto pos = result.state->selVector->selectedPositions[i];
-                    result.setNull(pos, left.isNull(pos) || right.isNull(pos));
-                    if (!result.isNull(pos)) {
-                        executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
-                            left, right, result, pos, pos, pos);
-                    }
+            for (uint64_t i = 0; i < result.state->selVector->selectedSize; i++) {
+                auto pos = result.state->selVector->selectedPositions[i];
+                result.setNull(pos, left.isNull(pos) || right.isNull(pos));
+                if (!result.isNull(pos)) {
+                    executeOnValue<LEFT_TYPE, RIGHT_TYPE, RESULT_TYPE, FUNC, OP_WRAPPER>(
+                        left, right, result, pos, pos, pos);
                 }
             }
         }
@@ -239,6 +264,92 @@ struct BinaryOperationExecutor {
         numSelectedValues += (resultValue == true);
     }
 
+    // Selects positions [startPos, endPos) of unfiltered vectors without nulls in that range. The
+    // selected positions buffer is written branch-free: every position is written and the number
+    // of selected values is only advanced if the position is selected.
+    template<class LEFT_TYPE, class RIGHT_TYPE, class FUNC, bool IS_LEFT_FLAT, bool IS_RIGHT_FLAT>
+    static inline void selectOnRange(ValueVector& left, ValueVector& right, uint64_t lPos,
+        uint64_t rPos, uint64_t startPos, uint64_t endPos, uint64_t& numSelectedValues,
+        sel_t* selectedPositionsBuffer) {
+        auto lValues = (LEFT_TYPE*)left.values;
+        auto rValues = (RIGHT_TYPE*)right.values;
+        auto numSelected = numSelectedValues;
+        for (auto i = startPos; i < endPos; i++) {
+            uint8_t resultValue = 0;
+            FUNC::operation(lValues[IS_LEFT_FLAT ? lPos : i], rValues[IS_RIGHT_FLAT ? rPos : i],
+                resultValue);
+            selectedPositionsBuffer[numSelected] = i;
+            numSelected += (resultValue == true);
+        }
+        numSelectedValues = numSelected;
+    }
+
+    // Values of fixed-size types can be compared at null positions without side effects, so
+    // positions of a null entry that has some nulls are selected branch-free as well.
+    template<class T>
+    static constexpr bool canCompareAtNullPositions() {
+        return is_arithmetic_v<T> || is_same_v<T, date_t> || is_same_v<T, timestamp_t> ||
+               is_same_v<T, interval_t> || is_same_v<T, nodeID_t>;
+    }
+
+    // See executeOnUnfilteredVectors() for how nulls are processed.
+    template<class LEFT_TYPE, class RIGHT_TYPE, class FUNC, bool IS_LEFT_FLAT, bool IS_RIGHT_FLAT>
+    static uint64_t selectOnUnfilteredVectors(
+        ValueVector& left, ValueVector& right, sel_t* selectedPositionsBuffer) {
+        auto lPos = IS_LEFT_FLAT ? left.state->getPositionOfCurrIdx() : 0;
+        auto rPos = IS_RIGHT_FLAT ? right.state->getPositionOfCurrIdx() : 0;
+        uint64_t size = IS_LEFT_FLAT ? right.state->selVector->selectedSize :
+                                       left.state->selVector->selectedSize;
+        uint64_t numSelectedValues = 0;
+        if ((IS_LEFT_FLAT || left.hasNoNullsGuarantee()) &&
+            (IS_RIGHT_FLAT || right.hasNoNullsGuarantee())) {
+            selectOnRange<LEFT_TYPE, RIGHT_TYPE, FUNC, IS_LEFT_FLAT, IS_RIGHT_FLAT>(
+                left, right, lPos, rPos, 0, size, numSelectedValues, selectedPositionsBuffer);
+            return numSelectedValues;
+        }
+        auto lNullEntries = left.getNullMaskData();
+        auto rNullEntries = right.getNullMaskData();
+        auto lValues = (LEFT_TYPE*)left.values;
+        auto rValues = (RIGHT_TYPE*)right.values;
+        auto numNullEntries = (size + NullMask::NUM_BITS_PER_NULL_ENTRY - 1) >>
+                              NullMask::NUM_BITS_PER_NULL_ENTRY_LOG2;
+        for (auto entryIdx = 0u; entryIdx < numNullEntries; entryIdx++) {
+            auto startPos = (uint64_t)entryIdx << NullMask::NUM_BITS_PER_NULL_ENTRY_LOG2;
+            auto endPos = min(startPos + NullMask::NUM_BITS_PER_NULL_ENTRY, size);
+            auto rangeMask = NULL_LOWER_MASKS[endPos - startPos];
+            auto nullEntry = rangeMask & (IS_LEFT_FLAT ? NullMask::NO_NULL_ENTRY :
+                                                         lNullEntries[entryIdx]);
+            nullEntry |= rangeMask & (IS_RIGHT_FLAT ? NullMask::NO_NULL_ENTRY :
+                                                      rNullEntries[entryIdx]);
+            if (nullEntry == NullMask::NO_NULL_ENTRY) {
+                selectOnRange<LEFT_TYPE, RIGHT_TYPE, FUNC, IS_LEFT_FLAT, IS_RIGHT_FLAT>(left,
+                    right, lPos, rPos, startPos, endPos, numSelectedValues,
+                    selectedPositionsBuffer);
+            } else if (nullEntry == rangeMask) {
+                continue;
+            } else if constexpr (canCompareAtNullPositions<LEFT_TYPE>() &&
+                                 canCompareAtNullPositions<RIGHT_TYPE>()) {
+                for (auto i = startPos; i < endPos; i++) {
+                    uint8_t resultValue = 0;
+                    FUNC::operation(lValues[IS_LEFT_FLAT ? lPos : i],
+                        rValues[IS_RIGHT_FLAT ? rPos : i], resultValue);
+                    selectedPositionsBuffer[numSelectedValues] = i;
+                    numSelectedValues +=
+                        (resultValue == true) & !((nullEntry >> (i - startPos)) & 1);
+                }
+            } else {
+                for (auto i = startPos; i < endPos; i++) {
+                    if (!(nullEntry & NULL_BITMASKS_WITH_SINGLE_ONE[i - startPos])) {
+                        selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(left, right,
+                            IS_LEFT_FLAT ? lPos : i, IS_RIGHT_FLAT ? rPos : i, i,
+                            numSelectedValues, selectedPositionsBuffer);
+                    }
+                }
+            }
+        }
+        return numSelectedValues;
+    }
+
     template<class LEFT_TYPE, class RIGHT_TYPE, class FUNC>
     static uint64_t selectBothFlat(ValueVector& left, ValueVector& right) {
         auto lPos = left.state->getPositionOfCurrIdx();
@@ -260,34 +371,22 @@ struct BinaryOperationExecutor {
         auto selectedPositionsBuffer = selVector.getSelectedPositionsBuffer();
         if (left.isNull(lPos)) {
             return numSelectedValues;
+        } else if (right.state->selVector->isUnfiltered()) {
+            numSelectedValues = selectOnUnfilteredVectors<LEFT_TYPE, RIGHT_TYPE, FUNC,
+                true /* IS_LEFT_FLAT */, false /* IS_RIGHT_FLAT */>(
+                left, right, selectedPositionsBuffer);
         } else if (right.hasNoNullsGuarantee()) {
-            if (right.state->selVector->isUnfiltered()) {
-                for (auto i = 0u; i < right.state->selVector->selectedSize; ++i) {
-                    selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(
-                        left, right, lPos, i, i, numSelectedValues, selectedPositionsBuffer);
-                }
-            } else {
-                for (auto i = 0u; i < right.state->selVector->selectedSize; ++i) {
-                    auto rPos = right.state->selVector->selectedPositions[i];
-                    selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(
-                        left, right, lPos, rPos, rPos, numSelectedValues, selectedPositionsBuffer);
-                }
+            for (auto i = 0u; i < right.state->selVector->selectedSize; ++i) {
+                auto rPos = right.state->selVector->selectedPositions[i];
+                selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(
+                    left, right, lPos, rPos, rPos, numSelectedValues, selectedPositionsBuffer);
             }
         } else {
-            if (right.state->selVector->isUnfiltered()) {
-                for (auto i = 0u; i < right.state->selVector->selectedSize; ++i) {
-                    if (!right.isNull(i)) {
-                        selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(
-                            left, right, lPos, i, i, numSelectedValues, selectedPositionsBuffer);
-                    }
-                }
-            } else {
-                for (auto i = 0u; i < right.state->selVector->selectedSize; ++i) {
-                    auto rPos = right.state->selVector->selectedPositions[i];
-                    if (!right.isNull(rPos)) {
-                        selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(left, right, lPos, rPos, rPos,
-                            numSelectedValues, selectedPositionsBuffer);
-                    }
+            for (auto i = 0u; i < right.state->selVector->selectedSize; ++i) {
+                auto rPos = right.state->selVector->selectedPositions[i];
+                if (!right.isNull(rPos)) {
+                    selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(
+                        left, right, lPos, rPos, rPos, numSelectedValues, selectedPositionsBuffer);
                 }
             }
         }
@@ -303,34 +402,22 @@ struct BinaryOperationExecutor {
         auto selectedPositionsBuffer = selVector.getSelectedPositionsBuffer();
         if (right.isNull(rPos)) {
             return numSelectedValues;
+        } else if (left.state->selVector->isUnfiltered()) {
+            numSelectedValues = selectOnUnfilteredVectors<LEFT_TYPE, RIGHT_TYPE, FUNC,
+                false /* IS_LEFT_FLAT */, true /* IS_RIGHT_FLAT */>(
+                left, right, selectedPositionsBuffer);
         } else if (left.hasNoNullsGuarantee()) {
-            if (left.state->selVector->isUnfiltered()) {
-                for (auto i = 0u; i < left.state->selVector->selectedSize; ++i) {
-                    selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(
-                        left, right, i, rPos, i, numSelectedValues, selectedPositionsBuffer);
-                }
-            } else {
-                for (auto i = 0u; i < left.state->selVector->selectedSize; ++i) {
-                    auto lPos = left.state->selVector->selectedPositions[i];
-                    selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(
-                        left, right, lPos, rPos, lPos, numSelectedValues, selectedPositionsBuffer);
-                }
+            for (auto i = 0u; i < left.state->selVector->selectedSize; ++i) {
+                auto lPos = left.state->selVector->selectedPositions[i];
+                selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(
+                    left, right, lPos, rPos, lPos, numSelectedValues, selectedPositionsBuffer);
             }
         } else {
-            if (left.state->selVector->isUnfiltered()) {
-                for (auto i = 0u; i < left.state->selVector->selectedSize; ++i) {
-                    if (!left.isNull(i)) {
-                        selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(
-                            left, right, i, rPos, i, numSelectedValues, selectedPositionsBuffer);
-                    }
-                }
-            } else {
-                for (auto i = 0u; i < left.state->selVector->selectedSize; ++i) {
-                    auto lPos = left.state->selVector->selectedPositions[i];
-                    if (!left.isNull(lPos)) {
-                        selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(left, right, lPos, rPos, lPos,
-                            numSelectedValues, selectedPositionsBuffer);
-                    }
+            for (auto i = 0u; i < left.state->selVector->selectedSize; ++i) {
+                auto lPos = left.state->selVector->selectedPositions[i];
+                if (!left.isNull(lPos)) {
+                    selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(
+                        left, right, lPos, rPos, lPos, numSelectedValues, selectedPositionsBuffer);
                 }
             }
         }
@@ -344,36 +431,23 @@ struct BinaryOperationExecutor {
         ValueVector& left, ValueVector& right, SelectionVector& selVector) {
         uint64_t numSelectedValues = 0;
         auto selectedPositionsBuffer = selVector.getSelectedPositionsBuffer();
-        if (left.hasNoNullsGuarantee() && right.hasNoNullsGuarantee()) {
-            if (left.state->selVector->isUnfiltered()) {
-                for (auto i = 0u; i < left.state->selVector->selectedSize; i++) {
-                    selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(
-                        left, right, i, i, i, numSelectedValues, selectedPositionsBuffer);
-                }
-            } else {
-                for (auto i = 0u; i < left.state->selVector->selectedSize; i++) {
-                    auto pos = left.state->selVector->selectedPositions[i];
-                    selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(
-                        left, right, pos, pos, pos, numSelectedValues, selectedPositionsBuffer);
-                }
+        if (left.state->selVector->isUnfiltered()) {
+            numSelectedValues = selectOnUnfilteredVectors<LEFT_TYPE, RIGHT_TYPE, FUNC,
+                false /* IS_LEFT_FLAT */, false /* IS_RIGHT_FLAT */>(
+                left, right, selectedPositionsBuffer);
+        } else if (left.hasNoNullsGuarantee() && right.hasNoNullsGuarantee()) {
+            for (auto i = 0u; i < left.state->selVector->selectedSize; i++) {
+                auto pos = left.state->selVector->selectedPositions[i];
+                selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(
+                    left, right, pos, pos, pos, numSelectedValues, selectedPositionsBuffer);
             }
         } else {
-            if (left.state->selVector->isUnfiltered()) {
-                for (uint64_t i = 0; i < left.state->selVector->selectedSize; i++) {
-                    auto isNull = left.isNull(i) || right.isNull(i);
-                    if (!isNull) {
-                        selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(
-                            left, right, i, i, i, numSelectedValues, selectedPositionsBuffer);
-                    }
-                }
-            } else {
-                for (uint64_t i = 0; i < left.state->selVector->selectedSize; i++) {
-                    auto pos = left.state->selVector->selectedPositions[i];
-                    auto isNull = left.isNull(pos) || right.isNull(pos);
-                    if (!isNull) {
-                        selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(
-                            left, right, pos, pos, pos, numSelectedValues, selectedPositionsBuffer);
-                    }
+            for (uint64_t i = 0; i < left.state->selVector->selectedSize; i++) {
+                auto pos = left.state->selVector->selectedPositions[i];
+                auto isNull = left.isNull(pos) || right.isNull(pos);
+                if (!isNull) {
+                    selectOnValue<LEFT_TYPE, RIGHT_TYPE, FUNC>(
+                        left, right, pos, pos, pos, numSelectedValues, selectedPositionsBuffer);
                 }
             }
         }
@@ -240,7 +240,8 @@ std::unique_ptr<QueryResult> Connection::executeAndAutoCommitIfNecessaryNoLock(
     auto queryResult = make_unique<QueryResult>(preparedStatement->preparedSummary);
     auto profiler = make_unique<Profiler>();
     auto executionContext = make_unique<ExecutionContext>(clientContext->numThreadsForExecution,
-        profiler.get(), database->memoryManager.get(), database->bufferManager.get());
+        profiler.get(), database->memoryManager.get(), database->bufferManager.get(),
+        database->spillDirPath, database->systemConfig.hashJoinBuildMemoryBudgetRatio);
     // Execute query if EXPLAIN is not enabled.
     if (!preparedStatement->preparedSummary.isExplain) {
         profiler->enabled = preparedStatement->preparedSummary.isProfile;
@@ -248,12 +249,33 @@ std::unique_ptr<QueryResult> Connection::executeAndAutoCommitIfNecessaryNoLock(
         executingTimer.start();
         shared_ptr<FactorizedTable> resultFT;
         try {
-            beginTransactionIfAutoCommit(preparedStatement);
-            executionContext->transaction = activeTransaction.get();
-            resultFT =
-                database->queryProcessor->execute(physicalPlan.get(), executionContext.get());
-            if (AUTO_COMMIT == transactionMode) {
-                commitNoLock();
+            if (AUTO_COMMIT == transactionMode && !preparedStatement->isReadOnly() &&
+                preparedStatement->allowActiveTransaction && database->isGroupCommitEnabled()) {
+                auto isFirstExecution = true;
+                resultFT = database->executeInGroupCommit([&](Transaction* transaction) {
+                    // A physical plan and its profiler hold the state of one execution, so they
+                    // are created again if the query is executed again because its group commit
+                    // was rolled back.
+                    if (!isFirstExecution) {
+                        physicalPlan =
+                            mapper.mapLogicalPlanToPhysical(preparedStatement->logicalPlan.get());
+                        profiler = make_unique<Profiler>();
+                        profiler->enabled = preparedStatement->preparedSummary.isProfile;
+                        executionContext->profiler = profiler.get();
+                    }
+                    isFirstExecution = false;
+                    executionContext->transaction = transaction;
+                    return database->queryProcessor->execute(
+                        physicalPlan.get(), executionContext.get());
+                });
+            } else {
+                beginTransactionIfAutoCommit(preparedStatement);
+                executionContext->transaction = activeTransaction.get();
+                resultFT =
+                    database->queryProcessor->execute(physicalPlan.get(), executionContext.get());
+                if (AUTO_COMMIT == transactionMode) {
+                    commitNoLock();
+                }
             }
         } catch (Exception& exception) {
             rollbackIfNecessaryNoLock();
@@ -279,6 +301,9 @@ void Connection::beginTransactionNoLock(TransactionType type) {
             "transactions, please open other connections. Current active transaction is not "
             "affected by this exception and can still be used.");
     }
+    if (type == WRITE && database->databaseConfig.readOnlyMode) {
+        throw ConnectionException("Cannot begin a write transaction in a read-only database.");
+    }
     activeTransaction = type == READ_ONLY ?
                             database->transactionManager->beginReadOnlyTransaction() :
                             database->transactionManager->beginWriteTransaction();
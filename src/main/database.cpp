@@ -13,17 +13,56 @@ Database::Database(const DatabaseConfig& databaseConfig, const SystemConfig& sys
     : databaseConfig{databaseConfig},
       systemConfig{systemConfig}, logger{LoggerUtils::getOrCreateLogger("database")} {
     initLoggers();
-    initDBDirAndCoreFilesIfNecessary();
-    bufferManager = make_unique<BufferManager>(
-        systemConfig.defaultPageBufferPoolSize, systemConfig.largePageBufferPoolSize);
+    if (databaseConfig.readOnlyMode) {
+        if (!FileUtils::fileOrPathExists(databaseConfig.databasePath)) {
+            throw Exception("Cannot open database " + databaseConfig.databasePath +
+                            " in read-only mode as it does not exist.");
+        }
+    } else {
+        initDBDirAndCoreFilesIfNecessary();
+    }
+    // Read-only databases can be on read-only file systems and opened by multiple processes, so
+    // each of them spills into a temporary directory of its own instead of the database directory.
+    spillDirPath = databaseConfig.readOnlyMode ?
+                       StorageUtils::getTempSpillDirPath() :
+                       StorageUtils::getSpillDirPath(databaseConfig.databasePath);
+    bufferManager = make_unique<BufferManager>(systemConfig.defaultPageBufferPoolSize,
+        systemConfig.largePageBufferPoolSize, systemConfig.bufferPoolReplacementPolicy,
+        databaseConfig.readOnlyMode);
     memoryManager = make_unique<MemoryManager>(bufferManager.get());
-    wal = make_unique<WAL>(databaseConfig.databasePath, *bufferManager);
-    recoverIfNecessary();
+    wal = make_unique<WAL>(
+        databaseConfig.databasePath, *bufferManager, databaseConfig.readOnlyMode);
+    // The query processor is constructed first, so that recovery can replay the WAL on its
+    // threads.
     queryProcessor = make_unique<processor::QueryProcessor>(systemConfig.maxNumThreads);
+    recoverIfNecessary();
     catalog = make_unique<catalog::Catalog>(wal.get());
     storageManager = make_unique<storage::StorageManager>(
         *catalog, *bufferManager, *memoryManager, databaseConfig.inMemoryMode, wal.get());
     transactionManager = make_unique<transaction::TransactionManager>(*wal);
+    if (systemConfig.checkpointInBackground) {
+        checkpointThread = thread(&Database::runBackgroundCheckpoints, this);
+    }
+}
+
+Database::~Database() {
+    if (checkpointThread.joinable()) {
+        {
+            lock_t lck{checkpointMtx};
+            isCheckpointThreadStopping = true;
+        }
+        checkpointCV.notify_one();
+        // The thread finishes a requested checkpoint before it stops.
+        checkpointThread.join();
+    }
+    // Spill files are removed by the operators that create them, so the spill directory is only
+    // removed if it is empty. A temporary spill directory is only used by this database.
+    if (databaseConfig.readOnlyMode) {
+        FileUtils::removeDir(spillDirPath);
+    } else {
+        error_code errorCode;
+        filesystem::remove(spillDirPath, errorCode);
+    }
 }
 
 void Database::initDBDirAndCoreFilesIfNecessary() const {
@@ -114,6 +153,21 @@ void Database::commitAndCheckpointOrRollback(
     storageManager->prepareCommitOrRollbackIfNecessary(isCommit);
 
     if (isCommit) {
+        if (systemConfig.checkpointInBackground && !skipCheckpointForTestingRecovery &&
+            !wal->containsDDLOrCopyCSVRecords()) {
+            // The commit is made visible to new read-only transactions only once it is durable.
+            // Flushing the WAL also removes its pages from their frames, which is safe because
+            // only the committing write transaction has accessed the WAL pages until then.
+            transactionManager->commitButKeepActiveWriteTransaction(writeTransaction);
+            wal->flushAllPages();
+            transactionManager->startPendingCheckpoint();
+            {
+                lock_t lck{checkpointMtx};
+                isCheckpointRequested = true;
+            }
+            checkpointCV.notify_one();
+            return;
+        }
         // Note: It is enough to stop and wait transactions to leave the system instead of
         // for example checking on the query processor's task scheduler. This is because the
         // first and last steps that a connection performs when executing a query is to
@@ -144,8 +198,111 @@ void Database::commitAndCheckpointOrRollback(
     }
 }
 
+shared_ptr<processor::FactorizedTable> Database::executeInGroupCommit(
+    const std::function<shared_ptr<processor::FactorizedTable>(transaction::Transaction*)>&
+        executeQuery) {
+    unique_lock lck{groupCommitMtx};
+    while (true) {
+        numTransactionsWaitingForGroupCommit++;
+        groupCommitCV.wait(lck, [&] { return !isExecutingInGroupCommit; });
+        numTransactionsWaitingForGroupCommit--;
+        if (openGroupCommit == nullptr) {
+            openGroupCommit =
+                make_shared<GroupCommit>(transactionManager->beginWriteTransaction());
+        }
+        auto groupCommit = openGroupCommit;
+        isExecutingInGroupCommit = true;
+        lck.unlock();
+        shared_ptr<processor::FactorizedTable> resultFT;
+        string errMsg;
+        bool isSuccess = true;
+        try {
+            resultFT = executeQuery(groupCommit->writeTransaction.get());
+        } catch (exception& exception) {
+            errMsg = exception.what();
+            isSuccess = false;
+        }
+        lck.lock();
+        isExecutingInGroupCommit = false;
+        if (!isSuccess) {
+            finishGroupCommitNoLock(false /* rollback */);
+            throw Exception(errMsg);
+        }
+        groupCommit->numTransactions++;
+        if (groupCommit->numTransactions >= systemConfig.maxNumTransactionsPerGroupCommit ||
+            wal->fileHandle->getNumPages() >= systemConfig.maxNumWALPagesPerGroupCommit ||
+            numTransactionsWaitingForGroupCommit == 0) {
+            finishGroupCommitNoLock(true /* commit */);
+        } else {
+            groupCommitCV.notify_all();
+            groupCommitCV.wait(lck, [&] { return groupCommit->isFinished; });
+        }
+        if (groupCommit->isRolledBack) {
+            continue;
+        }
+        if (!groupCommit->errMsg.empty()) {
+            throw Exception(groupCommit->errMsg);
+        }
+        return resultFT;
+    }
+}
+
+void Database::finishGroupCommitNoLock(bool isCommit) {
+    auto groupCommit = move(openGroupCommit);
+    groupCommit->isRolledBack = !isCommit;
+    try {
+        commitAndCheckpointOrRollback(groupCommit->writeTransaction.get(), isCommit);
+    } catch (exception& exception) {
+        groupCommit->errMsg = exception.what();
+        // The queries of the group wait for isFinished, so it is set even if rolling back fails.
+        try {
+            commitAndCheckpointOrRollback(
+                groupCommit->writeTransaction.get(), false /* rollback */);
+        } catch (std::exception& rollbackException) {
+            groupCommit->errMsg += " Rolling back failed: " + string(rollbackException.what());
+        }
+    }
+    groupCommit->isFinished = true;
+    groupCommitCV.notify_all();
+}
+
+void Database::runBackgroundCheckpoints() {
+    while (true) {
+        {
+            lock_t lck{checkpointMtx};
+            checkpointCV.wait(
+                lck, [&] { return isCheckpointRequested || isCheckpointThreadStopping; });
+            if (!isCheckpointRequested) {
+                return;
+            }
+            isCheckpointRequested = false;
+        }
+        // If the checkpoint fails, the committed transaction stays in the WAL and is replayed when
+        // the database is restarted. New write transactions fail with the error until then.
+        auto isStoppingNewTransactions = false;
+        try {
+            transactionManager->waitUntilReadTransactionsBeforePendingCheckpointLeave();
+            transactionManager->stopNewTransactionsForPendingCheckpoint();
+            isStoppingNewTransactions = true;
+            checkpointAndClearWAL();
+            transactionManager->finishPendingCheckpoint();
+        } catch (exception& exception) {
+            logger->error("Background checkpoint failed: " + string(exception.what()));
+            transactionManager->failPendingCheckpoint(exception.what());
+        }
+        if (isStoppingNewTransactions) {
+            transactionManager->allowReceivingNewTransactions();
+        }
+    }
+}
+
 void Database::recoverIfNecessary() {
     if (!wal->isEmptyWAL()) {
+        if (databaseConfig.readOnlyMode) {
+            throw Exception("Cannot open database " + databaseConfig.databasePath +
+                            " in read-only mode as its WAL is not empty. Open it in read-write "
+                            "mode once to recover it.");
+        }
         if (wal->isLastLoggedRecordCommit()) {
             logger->info("Starting up StorageManager and found a non-empty WAL with a committed "
                          "transaction. Replaying to checkpoint.");
@@ -164,10 +321,11 @@ void Database::checkpointOrRollbackAndClearWAL(bool isRecovering, bool isCheckpo
         (isCheckpoint ? string("checkpointing") : string("rolling back the wal contents")) +
         " in the storage manager during " +
         (isRecovering ? "recovery." : "normal db execution (i.e., not recovering)."));
-    WALReplayer walReplayer = isRecovering ?
-                                  WALReplayer(wal.get()) :
-                                  WALReplayer(wal.get(), storageManager.get(), bufferManager.get(),
-                                      memoryManager.get(), catalog.get(), isCheckpoint);
+    auto taskScheduler = queryProcessor->getTaskScheduler();
+    WALReplayer walReplayer =
+        isRecovering ? WALReplayer(wal.get(), taskScheduler) :
+                       WALReplayer(wal.get(), storageManager.get(), bufferManager.get(),
+                           memoryManager.get(), catalog.get(), isCheckpoint, taskScheduler);
     walReplayer.replay();
     logger->info(
         "Finished " +
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <condition_variable>
+#include <functional>
+
 // TODO: Consider using forward declaration
 #include "src/common/include/configs.h"
 #include "src/processor/include/processor.h"
@@ -33,6 +36,29 @@ struct SystemConfig {
     uint64_t largePageBufferPoolSize;
 
     uint64_t maxNumThreads = std::thread::hardware_concurrency();
+
+    storage::BufferPoolReplacementPolicy bufferPoolReplacementPolicy =
+        storage::BufferPoolReplacementPolicy::CLOCK;
+
+    // The fraction of the large page buffer pool that the build sides of the hash joins of a query
+    // may occupy together before the build side that exceeds it spills its tuples to disk.
+    double hashJoinBuildMemoryBudgetRatio = HashJoinConfig::BUILD_MEMORY_BUDGET_RATIO;
+
+    // If larger than 1, auto-committed write queries of concurrent connections are executed one
+    // after the other in a shared write transaction, which is committed with a single WAL flush
+    // and checkpoint once it holds this many queries, has written maxNumWALPagesPerGroupCommit
+    // WAL pages, or no other connection is waiting to join it. Queries return only after their
+    // group is committed. If a query fails, only that query returns an error: its group is rolled
+    // back and the other queries of the group are executed again in a new group.
+    uint64_t maxNumTransactionsPerGroupCommit = 1;
+    uint64_t maxNumWALPagesPerGroupCommit = DEFAULT_MAX_NUM_WAL_PAGES_PER_GROUP_COMMIT;
+
+    // If true, write transactions other than DDL and COPY CSV return once their commit is durable
+    // in the WAL and are checkpointed by a background thread. The checkpoint waits for the
+    // read-only transactions that started before the commit to leave, while new read-only
+    // transactions read the committed WAL versions. New transactions are only stopped for the
+    // final replay of the WAL, and new write transactions wait until the checkpoint finishes.
+    bool checkpointInBackground = false;
 };
 
 struct DatabaseConfig {
@@ -41,6 +67,27 @@ struct DatabaseConfig {
 
     std::string databasePath;
     bool inMemoryMode;
+    // If true, the database can only be read. The column, lists, overflow and index files are
+    // memory mapped instead of being read into the buffer pools, so processes that read the same
+    // database share the page cache of the OS. Write transactions cannot be started and the
+    // database cannot be opened if its WAL is not empty.
+    bool readOnlyMode = false;
+};
+
+// A write transaction that is shared by the auto-committed write queries of a group commit.
+struct GroupCommit {
+    explicit GroupCommit(unique_ptr<transaction::Transaction> writeTransaction)
+        : writeTransaction{move(writeTransaction)}, numTransactions{0}, isFinished{false},
+          isRolledBack{false} {}
+
+    unique_ptr<transaction::Transaction> writeTransaction;
+    uint64_t numTransactions;
+    bool isFinished;
+    // Set if the group is rolled back because one of its queries failed. The other queries of the
+    // group have not returned yet, so they are executed again in a new group.
+    bool isRolledBack;
+    // Set if the group fails to commit.
+    string errMsg;
 };
 
 class Database {
@@ -59,7 +106,7 @@ public:
 
     void resizeBufferManager(uint64_t newSize);
 
-    ~Database() = default;
+    ~Database();
 
 private:
     // TODO(Semih): This is refactored here for now to be able to test transaction behavior
@@ -71,6 +118,19 @@ private:
     void commitAndCheckpointOrRollback(transaction::Transaction* writeTransaction, bool isCommit,
         bool skipCheckpointForTestingRecovery = false);
 
+    inline bool isGroupCommitEnabled() const {
+        return systemConfig.maxNumTransactionsPerGroupCommit > 1 && !databaseConfig.readOnlyMode;
+    }
+    // Executes an auto-committed write query in the open group commit, opening one if there is
+    // none, and returns once the group is committed. The storage layer cannot roll back a single
+    // query of a write transaction, so if the query fails, the group is rolled back and the other
+    // queries of the group are executed again in a new group. executeQuery executes the query in
+    // the given write transaction, and may therefore be called more than once.
+    shared_ptr<processor::FactorizedTable> executeInGroupCommit(
+        const std::function<shared_ptr<processor::FactorizedTable>(transaction::Transaction*)>&
+            executeQuery);
+    void finishGroupCommitNoLock(bool isCommit);
+
     void initDBDirAndCoreFilesIfNecessary() const;
     void initLoggers();
 
@@ -81,12 +141,14 @@ private:
         checkpointOrRollbackAndClearWAL(
             false /* is not recovering */, false /* rolling back updates */);
     }
+    void runBackgroundCheckpoints();
     void recoverIfNecessary();
     void checkpointOrRollbackAndClearWAL(bool isRecovering, bool isCheckpoint);
 
 private:
     DatabaseConfig databaseConfig;
     SystemConfig systemConfig;
+    string spillDirPath;
     std::unique_ptr<storage::MemoryManager> memoryManager;
     std::unique_ptr<processor::QueryProcessor> queryProcessor;
     std::unique_ptr<storage::BufferManager> bufferManager;
@@ -95,6 +157,18 @@ private:
     std::unique_ptr<transaction::TransactionManager> transactionManager;
     unique_ptr<storage::WAL> wal;
     shared_ptr<spdlog::logger> logger;
+    // Only one query of the open group commit is executed at a time, since queries are not
+    // isolated from each other within the write transaction of the group.
+    mutex groupCommitMtx;
+    condition_variable groupCommitCV;
+    shared_ptr<GroupCommit> openGroupCommit;
+    bool isExecutingInGroupCommit = false;
+    uint64_t numTransactionsWaitingForGroupCommit = 0;
+    mutex checkpointMtx;
+    condition_variable checkpointCV;
+    bool isCheckpointRequested = false;
+    bool isCheckpointThreadStopping = false;
+    thread checkpointThread;
 };
 
 } // namespace main
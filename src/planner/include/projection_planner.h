@@ -27,8 +27,8 @@ private:
     void appendProjection(const expression_vector& expressionsToProject, LogicalPlan& plan);
     void appendAggregate(const expression_vector& expressionsToGroupBy,
         const expression_vector& expressionsToAggregate, LogicalPlan& plan);
-    void appendOrderBy(
-        const expression_vector& expressions, const vector<bool>& isAscOrders, LogicalPlan& plan);
+    void appendOrderBy(const expression_vector& expressions, const vector<bool>& isAscOrders,
+        uint64_t limitNumber, LogicalPlan& plan);
     void appendMultiplicityReducer(LogicalPlan& plan);
     void appendLimit(uint64_t limitNumber, LogicalPlan& plan);
     void appendSkip(uint64_t skipNumber, LogicalPlan& plan);
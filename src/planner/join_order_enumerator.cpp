@@ -164,7 +164,34 @@ static bool isIndexScanExpression(Expression& expression, uint32_t primaryKeyID)
     return false;
 }
 
+// Checks if the expression is list_contains([literal, ...], primaryKey), in which case the nodes are
+// looked up with all keys of the list.
+static bool isMultiKeyIndexScanExpression(Expression& expression, uint32_t primaryKeyID) {
+    if (expression.expressionType != FUNCTION ||
+        expression.getUniqueName().rfind(LIST_CONTAINS_FUNC_NAME + "(", 0) != 0) {
+        return false;
+    }
+    auto list = expression.getChild(0);
+    auto key = expression.getChild(1);
+    if (list->expressionType != FUNCTION ||
+        list->getUniqueName().rfind(LIST_CREATION_FUNC_NAME + "(", 0) != 0 ||
+        key->expressionType != PROPERTY ||
+        ((PropertyExpression&)*key).getPropertyID() != primaryKeyID ||
+        list->dataType.childType->typeID != key->dataType.typeID) {
+        return false;
+    }
+    for (auto& element : list->getChildren()) {
+        if (element->expressionType != LITERAL) {
+            return false;
+        }
+    }
+    return true;
+}
+
 static shared_ptr<Expression> extractIndexExpression(Expression& expression) {
+    if (expression.expressionType == FUNCTION) { // list_contains(list, primaryKey)
+        return expression.getChild(0);
+    }
     if (expression.getChild(0)->expressionType == LITERAL) {
         return expression.getChild(0);
     }
@@ -188,7 +215,9 @@ void JoinOrderEnumerator::planNodeScan(uint32_t nodePos) {
         shared_ptr<Expression> indexExpression;
         expression_vector predicatesToApply;
         for (auto& predicate : predicates) { // push predicate into index scan if any.
-            if (isIndexScanExpression(*predicate, primaryKeyID)) {
+            if (indexExpression == nullptr &&
+                (isIndexScanExpression(*predicate, primaryKeyID) ||
+                    isMultiKeyIndexScanExpression(*predicate, primaryKeyID))) {
                 indexExpression = extractIndexExpression(*predicate);
             } else {
                 predicatesToApply.push_back(predicate);
@@ -527,7 +556,9 @@ void JoinOrderEnumerator::appendIndexScanNode(
     scan->computeSchema(*schema);
     // update cardinality
     auto group = schema->getGroup(node->getIDProperty());
-    group->setMultiplier(1);
+    auto& keyExpression = *scan->getIndexExpression();
+    group->setMultiplier(
+        keyExpression.dataType.typeID == LIST ? keyExpression.getChildren().size() : 1);
     plan.setLastOperator(std::move(scan));
 }
 
@@ -635,6 +666,7 @@ void JoinOrderEnumerator::appendHashJoin(const vector<shared_ptr<NodeExpression>
     }
     QueryPlanner::appendFlattensButOne(joinNodesGroupPos, buildPlan);
 
+    auto probeSideSchemaBeforeMerging = probeSideSchema->copy();
     auto numGroupsBeforeMerging = probeSideSchema->getNumGroups();
     vector<string> keys;
     for (auto& joinNode : joinNodes) {
@@ -650,6 +682,7 @@ void JoinOrderEnumerator::appendHashJoin(const vector<shared_ptr<NodeExpression>
     auto hashJoin = make_shared<LogicalHashJoin>(joinNodes, joinType, isProbeAcc,
         buildSideSchema.copy(), flatOutputGroupPositions, buildSideSchema.getExpressionsInScope(),
         probePlan.getLastOperator(), buildPlan.getLastOperator());
+    hashJoin->setProbeSideSchema(std::move(probeSideSchemaBeforeMerging));
     probePlan.setLastOperator(move(hashJoin));
 }
 
@@ -667,9 +700,11 @@ void JoinOrderEnumerator::appendMarkJoin(const vector<shared_ptr<NodeExpression>
     auto markGroupPos = QueryPlanner::appendFlattensButOne(joinNodeGroupsPosInProbeSide, probePlan);
     QueryPlanner::appendFlattensButOne(joinNodeGroupsPosInBuildSide, buildPlan);
     probePlan.increaseCost(probePlan.getCardinality() + buildPlan.getCardinality());
+    auto probeSchemaBeforeMark = probeSchema->copy();
     probeSchema->insertToGroupAndScope(mark, markGroupPos);
     auto hashJoin = make_shared<LogicalHashJoin>(joinNodes, mark, isProbeAcc, buildSchema->copy(),
         probePlan.getLastOperator(), buildPlan.getLastOperator());
+    hashJoin->setProbeSideSchema(std::move(probeSchemaBeforeMark));
     probePlan.setLastOperator(std::move(hashJoin));
 }
 
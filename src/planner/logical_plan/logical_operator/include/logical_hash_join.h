@@ -69,11 +69,18 @@ public:
     inline bool getIsProbeAcc() const { return isProbeAcc; }
     inline Schema* getBuildSideSchema() const { return buildSideSchema.get(); }
     inline vector<uint64_t> getFlatOutputGroupPositions() const { return flatOutputGroupPositions; }
+    // The schema of the probe side before the build side is merged into it.
+    inline void setProbeSideSchema(unique_ptr<Schema> schema) { probeSideSchema = move(schema); }
+    inline Schema* getProbeSideSchema() const { return probeSideSchema.get(); }
 
     inline unique_ptr<LogicalOperator> copy() override {
-        return make_unique<LogicalHashJoin>(joinNodes, joinType, mark, isProbeAcc,
+        auto hashJoin = make_unique<LogicalHashJoin>(joinNodes, joinType, mark, isProbeAcc,
             buildSideSchema->copy(), flatOutputGroupPositions, expressionsToMaterialize,
             children[0]->copy(), children[1]->copy());
+        if (probeSideSchema != nullptr) {
+            hashJoin->setProbeSideSchema(probeSideSchema->copy());
+        }
+        return hashJoin;
     }
 
 private:
@@ -82,6 +89,7 @@ private:
     shared_ptr<Expression> mark; // when joinType is Mark
     bool isProbeAcc;
     unique_ptr<Schema> buildSideSchema;
+    unique_ptr<Schema> probeSideSchema;
     // TODO(Xiyang): solve this with issue 606
     vector<uint64_t> flatOutputGroupPositions;
     expression_vector expressionsToMaterialize;
@@ -12,10 +12,10 @@ class LogicalOrderBy : public LogicalOperator {
 public:
     LogicalOrderBy(expression_vector expressionsToOrderBy, vector<bool> sortOrders,
         expression_vector expressionsToMaterialize, unique_ptr<Schema> schemaBeforeOrderBy,
-        shared_ptr<LogicalOperator> child)
+        uint64_t limitNumber, shared_ptr<LogicalOperator> child)
         : LogicalOperator{move(child)}, expressionsToOrderBy{move(expressionsToOrderBy)},
           isAscOrders{move(sortOrders)}, expressionsToMaterialize{move(expressionsToMaterialize)},
-          schemaBeforeOrderBy{move(schemaBeforeOrderBy)} {}
+          schemaBeforeOrderBy{move(schemaBeforeOrderBy)}, limitNumber{limitNumber} {}
 
     inline LogicalOperatorType getLogicalOperatorType() const override {
         return LogicalOperatorType::LOGICAL_ORDER_BY;
@@ -29,10 +29,14 @@ public:
     inline expression_vector getExpressionsToMaterialize() const {
         return expressionsToMaterialize;
     }
+    // If the order by has a limit, only its first limitNumber tuples are needed.
+    inline bool hasLimit() const { return limitNumber != UINT64_MAX; }
+    inline uint64_t getLimitNumber() const { return limitNumber; }
 
     unique_ptr<LogicalOperator> copy() override {
         return make_unique<LogicalOrderBy>(expressionsToOrderBy, isAscOrders,
-            expressionsToMaterialize, schemaBeforeOrderBy->copy(), children[0]->copy());
+            expressionsToMaterialize, schemaBeforeOrderBy->copy(), limitNumber,
+            children[0]->copy());
     }
 
 private:
@@ -40,6 +44,7 @@ private:
     vector<bool> isAscOrders;
     expression_vector expressionsToMaterialize;
     unique_ptr<Schema> schemaBeforeOrderBy;
+    uint64_t limitNumber;
 };
 
 } // namespace planner
@@ -44,8 +44,11 @@ public:
 
     inline void computeSchema(Schema& schema) override {
         LogicalScanNode::computeSchema(schema);
-        auto groupPos = schema.getGroupPos(node->getIDProperty());
-        schema.getGroup(groupPos)->setIsFlat(true);
+        // A list of keys, e.g. list_contains([0, 5], a.ID), may match multiple nodes.
+        if (indexExpression->dataType.typeID != LIST) {
+            auto groupPos = schema.getGroupPos(node->getIDProperty());
+            schema.getGroup(groupPos)->setIsFlat(true);
+        }
     }
 
     inline shared_ptr<Expression> getIndexExpression() const { return indexExpression; }
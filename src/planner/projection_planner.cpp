@@ -48,8 +48,17 @@ void ProjectionPlanner::planProjectionBody(
         planAggregate(expressionsToAggregate, expressionsToGroupBy, plan);
     }
     if (projectionBody.hasOrderByExpressions()) {
-        appendOrderBy(
-            projectionBody.getOrderByExpressions(), projectionBody.getSortingOrders(), plan);
+        // Projection does not change the number of tuples, so if there is no DISTINCT, only the
+        // first SKIP + LIMIT tuples of the order by can reach the result.
+        auto orderByLimitNumber = UINT64_MAX;
+        if (projectionBody.hasLimit() && !projectionBody.getIsDistinct()) {
+            auto skipNumber = projectionBody.hasSkip() ? projectionBody.getSkipNumber() : 0;
+            orderByLimitNumber = skipNumber > UINT64_MAX - projectionBody.getLimitNumber() ?
+                                     UINT64_MAX :
+                                     skipNumber + projectionBody.getLimitNumber();
+        }
+        appendOrderBy(projectionBody.getOrderByExpressions(), projectionBody.getSortingOrders(),
+            orderByLimitNumber, plan);
     }
     appendProjection(expressionsToProject, plan);
     if (projectionBody.getIsDistinct()) {
@@ -187,8 +196,8 @@ void ProjectionPlanner::appendAggregate(const expression_vector& expressionsToGr
     plan.setLastOperator(move(aggregate));
 }
 
-void ProjectionPlanner::appendOrderBy(
-    const expression_vector& expressions, const vector<bool>& isAscOrders, LogicalPlan& plan) {
+void ProjectionPlanner::appendOrderBy(const expression_vector& expressions,
+    const vector<bool>& isAscOrders, uint64_t limitNumber, LogicalPlan& plan) {
     auto schema = plan.getSchema();
     for (auto& expression : expressions) {
         queryPlanner->planSubqueryIfNecessary(expression, plan);
@@ -213,7 +222,7 @@ void ProjectionPlanner::appendOrderBy(
     auto schemaBeforeOrderBy = schema->copy();
     SinkOperatorUtil::recomputeSchema(*schemaBeforeOrderBy, *schema);
     auto orderBy = make_shared<LogicalOrderBy>(expressions, isAscOrders,
-        schemaBeforeOrderBy->getExpressionsInScope(), schemaBeforeOrderBy->copy(),
+        schemaBeforeOrderBy->getExpressionsInScope(), schemaBeforeOrderBy->copy(), limitNumber,
         plan.getLastOperator());
     plan.setLastOperator(move(orderBy));
 }
@@ -15,14 +15,19 @@ namespace processor {
 struct ExecutionContext {
 
     ExecutionContext(uint64_t numThreads, Profiler* profiler, MemoryManager* memoryManager,
-        BufferManager* bufferManager)
+        BufferManager* bufferManager, string spillDirPath, double hashJoinBuildMemoryBudgetRatio)
         : numThreads{numThreads}, profiler{profiler}, memoryManager{memoryManager},
-          bufferManager{bufferManager}, transaction{nullptr} {}
+          bufferManager{bufferManager}, spillDirPath{move(spillDirPath)},
+          hashJoinBuildMemoryBudgetRatio{hashJoinBuildMemoryBudgetRatio}, transaction{nullptr} {}
 
     uint64_t numThreads;
     Profiler* profiler;
     MemoryManager* memoryManager;
     BufferManager* bufferManager;
+    // Operators that spill to disk create their temporary files in the spill directory of the
+    // database.
+    string spillDirPath;
+    double hashJoinBuildMemoryBudgetRatio;
 
     Transaction* transaction;
 };
@@ -4,6 +4,7 @@
 
 #include "src/common/include/task_system/task_scheduler.h"
 #include "src/processor/include/physical_plan.h"
+#include "src/processor/operator/include/sink.h"
 #include "src/processor/result/include/factorized_table.h"
 #include "src/storage/buffer_manager/include/memory_manager.h"
 
@@ -19,9 +20,15 @@ public:
 
     shared_ptr<FactorizedTable> execute(PhysicalPlan* physicalPlan, ExecutionContext* context);
 
+    inline TaskScheduler* getTaskScheduler() { return taskScheduler.get(); }
+
 private:
     void decomposePlanIntoTasks(PhysicalOperator* op, PhysicalOperator* parent, Task* parentTask,
         ExecutionContext* context);
+    // Makes the task of a sink that finalizes in parallel a child of a ParallelFinalizeTask, which
+    // is returned in its place.
+    static unique_ptr<Task> addParallelFinalizeTaskIfNecessary(
+        Sink* sink, unique_ptr<Task> sinkTask, ExecutionContext* context);
 
     static shared_ptr<FactorizedTable> getFactorizedTableForOutputMsg(
         string& outputMsg, MemoryManager* memoryManager);
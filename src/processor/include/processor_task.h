@@ -22,5 +22,20 @@ private:
     ExecutionContext* executionContext;
 };
 
+// Runs the parallel part of the finalization of a sink. Its only child is the ProcessorTask of the
+// sink's pipeline.
+class ParallelFinalizeTask : public Task {
+
+public:
+    ParallelFinalizeTask(Sink* sinkOp, ExecutionContext* executionContext)
+        : Task{executionContext->numThreads}, sinkOp{sinkOp}, executionContext{executionContext} {}
+
+    inline void run() override { sinkOp->finalizeInParallel(executionContext); }
+
+private:
+    Sink* sinkOp;
+    ExecutionContext* executionContext;
+};
+
 } // namespace processor
 } // namespace kuzu
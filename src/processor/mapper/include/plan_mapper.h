@@ -16,6 +16,8 @@ namespace kuzu {
 namespace processor {
 
 struct BuildDataInfo;
+class HashJoinBuildMemoryUsage;
+class SemiJoinFilter;
 
 class PlanMapper {
 public:
@@ -26,6 +28,10 @@ public:
 
     unique_ptr<PhysicalPlan> mapLogicalPlanToPhysical(LogicalPlan* logicalPlan);
 
+    // Values of these data types have a fixed size and do not point to overflow memory, so tuples
+    // holding them in flat columns can be spilled to disk as they are.
+    static bool isSpillableDataType(DataTypeID typeID);
+
 private:
     unique_ptr<PhysicalOperator> mapLogicalOperatorToPhysical(
         const shared_ptr<LogicalOperator>& logicalOperator, MapperContext& mapperContext);
@@ -99,6 +105,11 @@ private:
 
     inline uint32_t getOperatorID() { return physicalOperatorID++; }
 
+    // Inner hash joins push a SemiJoinFilter into their probe side pipeline right after the
+    // operator producing the join key. See map_hash_join.cpp for details.
+    unique_ptr<PhysicalOperator> appendSemiJoinFilterIfNecessary(LogicalOperator* logicalOperator,
+        unique_ptr<PhysicalOperator> prevOperator, MapperContext& mapperContext);
+
     unique_ptr<PhysicalOperator> createHashAggregate(
         vector<unique_ptr<AggregateFunction>> aggregateFunctions,
         vector<DataPos> inputAggVectorsPos, vector<DataPos> outputAggVectorsPos,
@@ -125,6 +136,12 @@ public:
 
 private:
     uint32_t physicalOperatorID;
+    // Key producer operator -> the hash join whose bloom filter should be checked after it.
+    unordered_map<LogicalOperator*, LogicalOperator*> keyProducerToHashJoin;
+    // Hash join -> the semi join filter created for it while mapping its probe side.
+    unordered_map<LogicalOperator*, SemiJoinFilter*> hashJoinToSemiJoinFilter;
+    // Shared by the hash joins of the plan being mapped that can spill.
+    shared_ptr<HashJoinBuildMemoryUsage> hashJoinBuildMemoryUsage;
 };
 
 } // namespace processor
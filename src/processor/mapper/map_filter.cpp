@@ -1,15 +1,97 @@
 #include "include/plan_mapper.h"
 
+#include "src/binder/expression/include/literal_expression.h"
+#include "src/binder/expression/include/property_expression.h"
 #include "src/planner/logical_plan/logical_operator/include/logical_filter.h"
 #include "src/processor/operator/include/filter.h"
+#include "src/processor/operator/include/scan_node_id.h"
 
 namespace kuzu {
 namespace processor {
 
+// Returns the ScanNodeID of the node if it is on the same pipeline as the filter and only
+// operators that keep or drop tuples of the scanned nodes sit in between, so that skipping nodes
+// in the scan cannot change the result of the filter.
+static ScanNodeID* findScanNodeIDOnPipeline(PhysicalOperator* op, const string& nodeName) {
+    while (true) {
+        switch (op->getOperatorType()) {
+        case SCAN_NODE_ID: {
+            auto scanNodeID = (ScanNodeID*)op;
+            return scanNodeID->getNodeName() == nodeName ? scanNodeID : nullptr;
+        }
+        case FLATTEN:
+        case FILTER:
+        case SCAN_STRUCTURED_PROPERTY:
+        case SCAN_UNSTRUCTURED_PROPERTY:
+        case SEMI_JOIN_FILTER:
+        case COLUMN_EXTEND:
+        case LIST_EXTEND:
+        case SCAN_REL_PROPERTY:
+            break;
+        default:
+            return nullptr;
+        }
+        op = op->getChild(0);
+    }
+}
+
+static ExpressionType flipComparison(ExpressionType comparisonType) {
+    switch (comparisonType) {
+    case GREATER_THAN:
+        return LESS_THAN;
+    case GREATER_THAN_EQUALS:
+        return LESS_THAN_EQUALS;
+    case LESS_THAN:
+        return GREATER_THAN;
+    case LESS_THAN_EQUALS:
+        return GREATER_THAN_EQUALS;
+    default:
+        return comparisonType;
+    }
+}
+
+// Pushes each conjunct of the form "node.property comparison literal" (or the flipped form) on a
+// structured property with a zone map into the scan of the node, if the scan is on the same
+// pipeline. The filter itself is kept, as zone maps only rule out whole pages.
+static void pushZoneMapPredicatesIntoScanNodeID(const shared_ptr<Expression>& expression,
+    PhysicalOperator* prevOperator, NodesStore& nodesStore) {
+    for (auto& conjunct : expression->splitOnAND()) {
+        if (!isExpressionComparison(conjunct->expressionType)) {
+            continue;
+        }
+        auto left = conjunct->getChild(0);
+        auto right = conjunct->getChild(1);
+        auto comparisonType = conjunct->expressionType;
+        if (left->expressionType == LITERAL) {
+            swap(left, right);
+            comparisonType = flipComparison(comparisonType);
+        }
+        if (left->expressionType != PROPERTY || right->expressionType != LITERAL ||
+            left->getChild(0)->dataType.typeID != NODE ||
+            !ZoneMap::isSupported(left->dataType.typeID) ||
+            right->dataType.typeID != left->dataType.typeID) {
+            continue;
+        }
+        auto property = (PropertyExpression*)left.get();
+        auto node = (NodeExpression*)property->getChild(0).get();
+        auto scanNodeID = findScanNodeIDOnPipeline(prevOperator, node->getUniqueName());
+        if (scanNodeID == nullptr) {
+            continue;
+        }
+        auto column =
+            nodesStore.getNodePropertyColumn(node->getTableID(), property->getPropertyID());
+        auto& literal = *((LiteralExpression*)right.get())->literal;
+        scanNodeID->getSharedState()->addZoneMapPredicate(
+            ZoneMapPredicate(column, comparisonType, literal));
+    }
+}
+
 unique_ptr<PhysicalOperator> PlanMapper::mapLogicalFilterToPhysical(
     LogicalOperator* logicalOperator, MapperContext& mapperContext) {
     auto& logicalFilter = (const LogicalFilter&)*logicalOperator;
     auto prevOperator = mapLogicalOperatorToPhysical(logicalOperator->getChild(0), mapperContext);
+    pushZoneMapPredicatesIntoScanNodeID(
+        logicalFilter.expression, prevOperator.get(), storageManager.getNodesStore());
     auto dataChunkToSelectPos = logicalFilter.groupPosToSelect;
     auto physicalRootExpr = expressionMapper.mapExpression(logicalFilter.expression, mapperContext);
     return make_unique<Filter>(move(physicalRootExpr), dataChunkToSelectPos, move(prevOperator),
@@ -1,10 +1,13 @@
 #include "include/plan_mapper.h"
 
 #include "src/planner/logical_plan/include/logical_plan_util.h"
+#include "src/planner/logical_plan/logical_operator/include/logical_extend.h"
 #include "src/planner/logical_plan/logical_operator/include/logical_hash_join.h"
+#include "src/planner/logical_plan/logical_operator/include/logical_scan_node.h"
 #include "src/planner/logical_plan/logical_operator/include/logical_semi_masker.h"
 #include "src/processor/operator/hash_join/include/hash_join_build.h"
 #include "src/processor/operator/hash_join/include/hash_join_probe.h"
+#include "src/processor/operator/hash_join/include/semi_join_filter.h"
 #include "src/processor/operator/include/scan_node_id.h"
 #include "src/processor/operator/include/semi_masker.h"
 #include "src/processor/operator/table_scan/include/factorized_table_scan.h"
@@ -89,6 +92,90 @@ static void mapAccJoin(HashJoinProbe* hashJoinProbe) {
     constructAccPipeline(tableScan, hashJoinProbe);
 }
 
+// Returns the operator producing the join key if it is on the same pipeline as the hash join probe
+// and only filter-like operators sit in between, so that dropping probe tuples right after it
+// cannot change the join result.
+static LogicalOperator* findKeyProducerOnProbePipeline(LogicalHashJoin* logicalHashJoin) {
+    if (logicalHashJoin->getJoinType() != JoinType::INNER || logicalHashJoin->getIsProbeAcc() ||
+        logicalHashJoin->getJoinNodes().size() != 1) {
+        return nullptr;
+    }
+    auto keyName = logicalHashJoin->getJoinNodes()[0]->getIDProperty();
+    auto op = logicalHashJoin->getChild(0).get();
+    while (true) {
+        switch (op->getLogicalOperatorType()) {
+        case LOGICAL_SCAN_NODE: {
+            return ((LogicalScanNode*)op)->getNode()->getIDProperty() == keyName ? op : nullptr;
+        }
+        case LOGICAL_EXTEND: {
+            if (((LogicalExtend*)op)->getNbrNodeExpression()->getIDProperty() == keyName) {
+                return op;
+            }
+        } break;
+        case LOGICAL_HASH_JOIN: {
+            if (((LogicalHashJoin*)op)->getIsProbeAcc()) {
+                return nullptr;
+            }
+        } break;
+        case LOGICAL_FLATTEN:
+        case LOGICAL_FILTER:
+        case LOGICAL_SCAN_NODE_PROPERTY:
+        case LOGICAL_SCAN_REL_PROPERTY:
+            break;
+        default:
+            return nullptr;
+        }
+        op = op->getChild(0).get();
+    }
+}
+
+unique_ptr<PhysicalOperator> PlanMapper::appendSemiJoinFilterIfNecessary(
+    LogicalOperator* logicalOperator, unique_ptr<PhysicalOperator> prevOperator,
+    MapperContext& mapperContext) {
+    if (!keyProducerToHashJoin.contains(logicalOperator)) {
+        return prevOperator;
+    }
+    auto hashJoin = (LogicalHashJoin*)keyProducerToHashJoin.at(logicalOperator);
+    keyProducerToHashJoin.erase(logicalOperator);
+    auto key = hashJoin->getJoinNodes()[0];
+    auto keyDataPos = mapperContext.getDataPos(key->getIDProperty());
+    auto semiJoinFilter = make_unique<SemiJoinFilter>(
+        keyDataPos, std::move(prevOperator), getOperatorID(), key->getRawName());
+    hashJoinToSemiJoinFilter.insert({hashJoin, semiJoinFilter.get()});
+    return semiJoinFilter;
+}
+
+// Tuples of a hash join can only be spilled if they can be written out as they are, i.e. they do
+// not point to overflow memory. This requires fixed size data types in flat columns on the build
+// side and at most one unflat data chunk on the probe side, which is flattened when spilled.
+static bool canSpill(LogicalHashJoin* hashJoin, const BuildDataInfo& buildDataInfo,
+    const vector<DataType>& payloadsDataTypes) {
+    auto probeSideSchema = hashJoin->getProbeSideSchema();
+    if (hashJoin->getIsProbeAcc() || probeSideSchema == nullptr) {
+        return false;
+    }
+    for (auto i = 0u; i < payloadsDataTypes.size(); i++) {
+        if (!PlanMapper::isSpillableDataType(payloadsDataTypes[i].typeID) ||
+            !(buildDataInfo.isPayloadsFlat[i] || buildDataInfo.isPayloadsInKeyChunk[i])) {
+            return false;
+        }
+    }
+    auto numUnflatGroups = 0u;
+    for (auto i = 0u; i < probeSideSchema->getNumGroups(); i++) {
+        auto group = probeSideSchema->getGroup(i);
+        if (group->getExpressions().empty()) {
+            continue;
+        }
+        numUnflatGroups += !group->getIsFlat();
+        for (auto& expression : group->getExpressions()) {
+            if (!PlanMapper::isSpillableDataType(expression->getDataType().typeID)) {
+                return false;
+            }
+        }
+    }
+    return numUnflatGroups <= 1;
+}
+
 BuildDataInfo PlanMapper::generateBuildDataInfo(MapperContext& mapperContext,
     Schema* buildSideSchema, const vector<shared_ptr<NodeExpression>>& keys,
     const expression_vector& payloads) {
@@ -128,6 +215,10 @@ unique_ptr<PhysicalOperator> PlanMapper::mapLogicalHashJoinToPhysical(
         MapperContext(make_unique<ResultSetDescriptor>(*hashJoin->getBuildSideSchema()));
     auto buildSidePrevOperator =
         mapLogicalOperatorToPhysical(hashJoin->getChild(1), buildSideMapperContext);
+    auto keyProducer = findKeyProducerOnProbePipeline(hashJoin);
+    if (keyProducer != nullptr && !keyProducerToHashJoin.contains(keyProducer)) {
+        keyProducerToHashJoin.insert({keyProducer, hashJoin});
+    }
     auto probeSidePrevOperator = mapLogicalOperatorToPhysical(hashJoin->getChild(0), mapperContext);
     // Populate build side and probe side vector positions
     auto paramsString = hashJoin->getExpressionsForPrinting();
@@ -147,11 +238,31 @@ unique_ptr<PhysicalOperator> PlanMapper::mapLogicalHashJoinToPhysical(
         probePayloadsDataPos.push_back(mapperContext.getDataPos(expression->getUniqueName()));
     }
     auto sharedState = make_shared<HashJoinSharedState>(payloadsDataTypes);
+    if (hashJoinToSemiJoinFilter.contains(hashJoin)) {
+        hashJoinToSemiJoinFilter.at(hashJoin)->setSharedState(sharedState);
+        hashJoinToSemiJoinFilter.erase(hashJoin);
+        sharedState->enableBloomFilter();
+    }
     // create hashJoin build
     auto hashJoinBuild = make_unique<HashJoinBuild>(sharedState, buildDataInfo,
         std::move(buildSidePrevOperator), getOperatorID(), paramsString);
     // create hashJoin probe
     ProbeDataInfo probeDataInfo(probeKeysDataPos, probePayloadsDataPos);
+    if (canSpill(hashJoin, buildDataInfo, payloadsDataTypes)) {
+        if (hashJoinBuildMemoryUsage == nullptr) {
+            hashJoinBuildMemoryUsage = make_shared<HashJoinBuildMemoryUsage>();
+        }
+        sharedState->enableSpilling(hashJoinBuildMemoryUsage);
+        auto probeSideSchema = hashJoin->getProbeSideSchema();
+        for (auto i = 0u; i < probeSideSchema->getNumGroups(); i++) {
+            auto group = probeSideSchema->getGroup(i);
+            for (auto& expression : group->getExpressions()) {
+                probeDataInfo.probeSideDataPos.push_back(
+                    mapperContext.getDataPos(expression->getUniqueName()));
+                probeDataInfo.isProbeSideVectorFlat.push_back(group->getIsFlat());
+            }
+        }
+    }
     if (hashJoin->getJoinType() == JoinType::MARK) {
         auto mark = hashJoin->getMark();
         auto markOutputPos = mapperContext.getDataPos(mark->getUniqueName());
@@ -4,6 +4,7 @@
 #include "src/processor/operator/order_by/include/order_by.h"
 #include "src/processor/operator/order_by/include/order_by_merge.h"
 #include "src/processor/operator/order_by/include/order_by_scan.h"
+#include "src/processor/operator/order_by/include/top_k.h"
 
 namespace kuzu {
 namespace processor {
@@ -36,7 +37,30 @@ unique_ptr<PhysicalOperator> PlanMapper::mapLogicalOrderByToPhysical(
     auto orderByDataInfo = OrderByDataInfo(
         keyDataPoses, inputDataPoses, isInputVectorFlat, logicalOrderBy.getIsAscOrders());
     auto orderBySharedState = make_shared<SharedFactorizedTablesAndSortedKeyBlocks>();
+    // All columns are flat in the factorizedTable if they all come from flat data chunks or from a
+    // single data chunk (see OrderBy::initLocalStateAndSharedState()).
+    auto areAllColumnsFlat = all_of(isInputVectorFlat.begin(), isInputVectorFlat.end(),
+                                 [](bool isFlat) { return isFlat; }) ||
+                             schemaBeforeOrderBy.getNumGroups() == 1;
+    // Tuples can be spilled as they are if all columns are flat and hold fixed size values only.
+    auto canSpill = areAllColumnsFlat;
+    for (auto& expression : logicalOrderBy.getExpressionsToMaterialize()) {
+        canSpill &= isSpillableDataType(expression->getDataType().typeID);
+    }
 
+    // TopK compacts its tuples by moving them within the factorizedTable, which requires all
+    // columns to be flat. Large limits are left to OrderBy, which can spill.
+    if (logicalOrderBy.hasLimit() && logicalOrderBy.getLimitNumber() <= TopKConfig::MAX_K &&
+        areAllColumnsFlat) {
+        auto topK = make_unique<TopK>(orderByDataInfo, orderBySharedState,
+            make_shared<TopKSharedState>(), logicalOrderBy.getLimitNumber(),
+            move(orderByPrevOperator), getOperatorID(), paramsString);
+        return make_unique<OrderByScan>(mapperContext.getResultSetDescriptor()->copy(),
+            outputDataPoses, orderBySharedState, move(topK), getOperatorID(), paramsString);
+    }
+    if (canSpill) {
+        orderBySharedState->enableSpilling();
+    }
     auto orderBy = make_unique<OrderBy>(orderByDataInfo, orderBySharedState,
         move(orderByPrevOperator), getOperatorID(), paramsString);
     auto orderByMerge =
@@ -13,6 +13,7 @@ namespace processor {
 
 unique_ptr<PhysicalPlan> PlanMapper::mapLogicalPlanToPhysical(LogicalPlan* logicalPlan) {
     auto mapperContext = MapperContext(make_unique<ResultSetDescriptor>(*logicalPlan->getSchema()));
+    hashJoinBuildMemoryUsage = nullptr;
     auto prevOperator = mapLogicalOperatorToPhysical(logicalPlan->getLastOperator(), mapperContext);
     auto lastOperator = appendResultCollector(logicalPlan->getExpressionsToCollect(),
         *logicalPlan->getSchema(), move(prevOperator), mapperContext);
@@ -125,7 +126,8 @@ unique_ptr<PhysicalOperator> PlanMapper::mapLogicalOperatorToPhysical(
     default:
         assert(false);
     }
-    return physicalOperator;
+    return appendSemiJoinFilterIfNecessary(
+        logicalOperator.get(), std::move(physicalOperator), mapperContext);
 }
 
 unique_ptr<ResultCollector> PlanMapper::appendResultCollector(
@@ -147,5 +149,20 @@ unique_ptr<ResultCollector> PlanMapper::appendResultCollector(
         valueVectorsToCollectInfo, sharedState, move(prevOperator), getOperatorID(), paramsString);
 }
 
+bool PlanMapper::isSpillableDataType(DataTypeID typeID) {
+    switch (typeID) {
+    case NODE_ID:
+    case BOOL:
+    case INT64:
+    case DOUBLE:
+    case DATE:
+    case TIMESTAMP:
+    case INTERVAL:
+        return true;
+    default:
+        return false;
+    }
+}
+
 } // namespace processor
 } // namespace kuzu
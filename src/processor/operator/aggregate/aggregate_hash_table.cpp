@@ -65,6 +65,15 @@ bool AggregateHashTable::isAggregateValueDistinctForGroupByKeys(
 }
 
 void AggregateHashTable::merge(AggregateHashTable& other) {
+    vector<uint8_t*> entries(other.getNumEntries());
+    for (auto i = 0u; i < entries.size(); i++) {
+        entries[i] = other.getEntry(i);
+    }
+    mergeEntries(*other.factorizedTable, entries);
+}
+
+void AggregateHashTable::mergeEntries(
+    const FactorizedTable& otherTable, const vector<uint8_t*>& entries) {
     shared_ptr<DataChunkState> vectorsToScanState = make_shared<DataChunkState>();
     vector<shared_ptr<ValueVector>> vectorsToScan(
         groupByHashKeysDataTypes.size() + groupByNonHashKeysDataTypes.size());
@@ -95,25 +104,38 @@ void AggregateHashTable::merge(AggregateHashTable& other) {
     iota(colIdxesToScan.begin(), colIdxesToScan.end(), 0);
     // Note: we store hash values at the last column of factorizedTable.
     colIdxesToScan.push_back(factorizedTable->getTableSchema()->getNumColumns() - 1);
-    uint64_t startTupleIdx = 0;
-    while (startTupleIdx < other.factorizedTable->getNumTuples()) {
-        auto numTuplesToScan =
-            min(other.factorizedTable->getNumTuples() - startTupleIdx, DEFAULT_VECTOR_CAPACITY);
-        other.factorizedTable->scan(vectorsToScan, startTupleIdx, numTuplesToScan, colIdxesToScan);
+    uint64_t startEntryIdx = 0;
+    while (startEntryIdx < entries.size()) {
+        auto numEntriesToScan = min(entries.size() - startEntryIdx, DEFAULT_VECTOR_CAPACITY);
+        otherTable.lookup(vectorsToScan, colIdxesToScan, (uint8_t**)entries.data(),
+            startEntryIdx, numEntriesToScan);
         findHashSlots(vector<ValueVector*>(), groupByHashVectors, groupByNonHashVectors);
         auto aggregateStateOffset = aggStateColOffsetInFT;
         for (auto& aggregateFunction : aggregateFunctions) {
-            for (auto i = 0u; i < numTuplesToScan; i++) {
+            for (auto i = 0u; i < numEntriesToScan; i++) {
                 aggregateFunction->combineState(
                     hashSlotsToUpdateAggState[i]->entry + aggregateStateOffset,
-                    other.factorizedTable->getTuple(startTupleIdx + i) + aggregateStateOffset);
+                    entries[startEntryIdx + i] + aggregateStateOffset);
             }
             aggregateStateOffset += aggregateFunction->getAggregateStateSize();
         }
-        startTupleIdx += numTuplesToScan;
+        startEntryIdx += numEntriesToScan;
     }
 }
 
+vector<vector<uint8_t*>> AggregateHashTable::partitionEntries() const {
+    vector<vector<uint8_t*>> partitions(HashAggregateConfig::NUM_PARTITIONS);
+    auto numBytesPerTuple = factorizedTable->getTableSchema()->getNumBytesPerTuple();
+    for (auto& tupleBlock : factorizedTable->getTupleDataBlocks()) {
+        uint8_t* tuple = tupleBlock->getData();
+        for (auto i = 0u; i < tupleBlock->numTuples; i++) {
+            partitions[getPartitionIdx(*(hash_t*)(tuple + hashColOffsetInFT))].push_back(tuple);
+            tuple += numBytesPerTuple;
+        }
+    }
+    return partitions;
+}
+
 void AggregateHashTable::finalizeAggregateStates() {
     for (auto i = 0u; i < getNumEntries(); ++i) {
         auto entry = getEntry(i);
@@ -189,6 +211,7 @@ void AggregateHashTable::initializeTmpVectors() {
     hashVector = make_shared<ValueVector>(INT64, &memoryManager);
     hashVector->state = hashState;
     hashSlotsToUpdateAggState = make_unique<HashSlot*[]>(DEFAULT_VECTOR_CAPACITY);
+    aggStatesToUpdate = make_unique<uint8_t*[]>(DEFAULT_VECTOR_CAPACITY);
     tmpValueIdxes = make_unique<uint64_t[]>(DEFAULT_VECTOR_CAPACITY);
     entryIdxesToInitialize = make_unique<uint64_t[]>(DEFAULT_VECTOR_CAPACITY);
     mayMatchIdxes = make_unique<uint64_t[]>(DEFAULT_VECTOR_CAPACITY);
@@ -468,7 +491,7 @@ void AggregateHashTable::updateAggStates(const vector<ValueVector*>& groupByFlat
     const vector<ValueVector*>& aggregateVectors, uint64_t multiplicity) {
     auto aggregateStateOffset = aggStateColOffsetInFT;
     for (auto i = 0u; i < aggregateFunctions.size(); i++) {
-        updateAggFuncs[i](this, groupByFlatHashKeyVectors, groupByUnFlatHashKeyVectors,
+        (this->*updateAggFuncs[i])(groupByFlatHashKeyVectors, groupByUnFlatHashKeyVectors,
             aggregateFunctions[i], aggregateVectors[i], multiplicity, i, aggregateStateOffset);
         aggregateStateOffset += aggregateFunctions[i]->getAggregateStateSize();
     }
@@ -499,8 +522,9 @@ bool AggregateHashTable::matchFlatGroupByKeys(
     return true;
 }
 
-uint64_t AggregateHashTable::matchUnflatVecWithFTColumn(
-    ValueVector* vector, uint64_t numMayMatches, uint64_t& numNoMatches, uint32_t colIdx) {
+template<typename COMPARE>
+uint64_t AggregateHashTable::matchUnflatVecWithFTColumn(ValueVector* vector, uint64_t numMayMatches,
+    uint64_t& numNoMatches, uint32_t colIdx, COMPARE compare) {
     assert(!vector->state->isFlat());
     auto colOffset = factorizedTable->getTableSchema()->getColOffset(colIdx);
     uint64_t mayMatchIdx = 0;
@@ -508,7 +532,7 @@ uint64_t AggregateHashTable::matchUnflatVecWithFTColumn(
         if (factorizedTable->hasNoNullGuarantee(colIdx)) {
             for (auto i = 0u; i < numMayMatches; i++) {
                 auto idx = mayMatchIdxes[i];
-                if (compareFuncs[colIdx](vector->values + idx * vector->getNumBytesPerValue(),
+                if (compare(vector->values + idx * vector->getNumBytesPerValue(),
                         hashSlotsToUpdateAggState[idx]->entry + colOffset)) {
                     mayMatchIdxes[mayMatchIdx++] = idx;
                 } else {
@@ -527,7 +551,7 @@ uint64_t AggregateHashTable::matchUnflatVecWithFTColumn(
                     noMatchIdxes[numNoMatches++] = idx;
                     continue;
                 }
-                if (compareFuncs[colIdx](
+                if (compare(
                         value, hashSlotsToUpdateAggState[idx]->entry + colOffset)) {
                     mayMatchIdxes[mayMatchIdx++] = idx;
                 } else {
@@ -552,7 +576,7 @@ uint64_t AggregateHashTable::matchUnflatVecWithFTColumn(
                 continue;
             }
 
-            if (compareFuncs[colIdx](value, hashSlotsToUpdateAggState[idx]->entry + colOffset)) {
+            if (compare(value, hashSlotsToUpdateAggState[idx]->entry + colOffset)) {
                 mayMatchIdxes[mayMatchIdx++] = idx;
             } else {
                 noMatchIdxes[numNoMatches++] = idx;
@@ -562,8 +586,30 @@ uint64_t AggregateHashTable::matchUnflatVecWithFTColumn(
     return mayMatchIdx;
 }
 
-uint64_t AggregateHashTable::matchFlatVecWithFTColumn(
+uint64_t AggregateHashTable::matchUnflatVecWithFTColumn(
     ValueVector* vector, uint64_t numMayMatches, uint64_t& numNoMatches, uint32_t colIdx) {
+    switch (vector->dataType.typeID) {
+    case INT64:
+        return matchUnflatVecWithFTColumn(vector, numMayMatches, numNoMatches, colIdx,
+            EntryWithKeysComparator<int64_t>());
+    case DOUBLE:
+        return matchUnflatVecWithFTColumn(vector, numMayMatches, numNoMatches, colIdx,
+            EntryWithKeysComparator<double_t>());
+    case NODE_ID:
+        return matchUnflatVecWithFTColumn(vector, numMayMatches, numNoMatches, colIdx,
+            EntryWithKeysComparator<nodeID_t>());
+    case STRING:
+        return matchUnflatVecWithFTColumn(vector, numMayMatches, numNoMatches, colIdx,
+            EntryWithKeysComparator<ku_string_t>());
+    default:
+        return matchUnflatVecWithFTColumn(
+            vector, numMayMatches, numNoMatches, colIdx, compareFuncs[colIdx]);
+    }
+}
+
+template<typename COMPARE>
+uint64_t AggregateHashTable::matchFlatVecWithFTColumn(ValueVector* vector, uint64_t numMayMatches,
+    uint64_t& numNoMatches, uint32_t colIdx, COMPARE compare) {
     assert(vector->state->isFlat());
     auto colOffset = factorizedTable->getTableSchema()->getColOffset(colIdx);
     uint64_t mayMatchIdx = 0;
@@ -583,7 +629,7 @@ uint64_t AggregateHashTable::matchFlatVecWithFTColumn(
             noMatchIdxes[numNoMatches++] = idx;
             continue;
         }
-        if (compareFuncs[colIdx](value, hashSlotsToUpdateAggState[idx]->entry + colOffset)) {
+        if (compare(value, hashSlotsToUpdateAggState[idx]->entry + colOffset)) {
             mayMatchIdxes[mayMatchIdx++] = idx;
         } else {
             noMatchIdxes[numNoMatches++] = idx;
@@ -592,6 +638,27 @@ uint64_t AggregateHashTable::matchFlatVecWithFTColumn(
     return mayMatchIdx;
 }
 
+uint64_t AggregateHashTable::matchFlatVecWithFTColumn(
+    ValueVector* vector, uint64_t numMayMatches, uint64_t& numNoMatches, uint32_t colIdx) {
+    switch (vector->dataType.typeID) {
+    case INT64:
+        return matchFlatVecWithFTColumn(vector, numMayMatches, numNoMatches, colIdx,
+            EntryWithKeysComparator<int64_t>());
+    case DOUBLE:
+        return matchFlatVecWithFTColumn(vector, numMayMatches, numNoMatches, colIdx,
+            EntryWithKeysComparator<double_t>());
+    case NODE_ID:
+        return matchFlatVecWithFTColumn(vector, numMayMatches, numNoMatches, colIdx,
+            EntryWithKeysComparator<nodeID_t>());
+    case STRING:
+        return matchFlatVecWithFTColumn(vector, numMayMatches, numNoMatches, colIdx,
+            EntryWithKeysComparator<ku_string_t>());
+    default:
+        return matchFlatVecWithFTColumn(
+            vector, numMayMatches, numNoMatches, colIdx, compareFuncs[colIdx]);
+    }
+}
+
 uint64_t AggregateHashTable::matchFTEntries(const vector<ValueVector*>& groupByFlatHashKeyVectors,
     const vector<ValueVector*>& groupByUnflatHashKeyVectors,
     const vector<ValueVector*>& groupByNonHashKeyVectors, uint64_t numMayMatches,
@@ -700,6 +767,14 @@ compare_function_t AggregateHashTable::getCompareEntryWithKeysFunc(DataTypeID ty
     }
 }
 
+void AggregateHashTable::fillAggStatesToUpdate(
+    const SelectionVector& selVector, uint32_t aggStateOffset) {
+    for (auto i = 0u; i < selVector.selectedSize; i++) {
+        auto pos = selVector.selectedPositions[i];
+        aggStatesToUpdate[pos] = hashSlotsToUpdateAggState[pos]->entry + aggStateOffset;
+    }
+}
+
 void AggregateHashTable::updateNullAggVectorState(
     const vector<ValueVector*>& groupByFlatHashKeyVectors,
     const vector<ValueVector*>& groupByUnflatHashKeyVectors,
@@ -709,20 +784,10 @@ void AggregateHashTable::updateNullAggVectorState(
         auto pos = groupByFlatHashKeyVectors[0]->state->getPositionOfCurrIdx();
         aggregateFunction->updatePosState(hashSlotsToUpdateAggState[pos]->entry + aggStateOffset,
             nullptr, multiplicity, 0 /* dummy pos */);
-    } else if (groupByUnflatHashKeyVectors[0]->state->selVector->isUnfiltered()) {
-        auto selectedSize = groupByUnflatHashKeyVectors[0]->state->selVector->selectedSize;
-        for (auto i = 0u; i < selectedSize; i++) {
-            aggregateFunction->updatePosState(hashSlotsToUpdateAggState[i]->entry + aggStateOffset,
-                nullptr, multiplicity, 0 /* dummy pos */);
-        }
     } else {
-        auto selectedSize = groupByUnflatHashKeyVectors[0]->state->selVector->selectedSize;
-        for (auto i = 0u; i < selectedSize; i++) {
-            auto pos = groupByUnflatHashKeyVectors[0]->state->selVector->selectedPositions[i];
-            aggregateFunction->updatePosState(
-                hashSlotsToUpdateAggState[pos]->entry + aggStateOffset, nullptr, multiplicity,
-                0 /* dummy pos */);
-        }
+        auto& selVector = *groupByUnflatHashKeyVectors[0]->state->selVector;
+        fillAggStatesToUpdate(selVector, aggStateOffset);
+        aggregateFunction->updateStates(aggStatesToUpdate.get(), nullptr, multiplicity, selVector);
     }
 }
 
@@ -744,66 +809,20 @@ void AggregateHashTable::updateFlatUnflatKeyFlatAggVectorState(
     const vector<ValueVector*>& groupByUnflatHashKeyVectors,
     unique_ptr<AggregateFunction>& aggregateFunction, ValueVector* aggVector, uint64_t multiplicity,
     uint32_t aggStateOffset) {
-    auto aggPos = aggVector->state->getPositionOfCurrIdx();
-    auto selectedSize = groupByUnflatHashKeyVectors[0]->state->selVector->selectedSize;
-    if (!aggVector->isNull(aggPos)) {
-        if (groupByUnflatHashKeyVectors[0]->state->selVector->isUnfiltered()) {
-            for (auto i = 0u; i < selectedSize; i++) {
-                aggregateFunction->updatePosState(
-                    hashSlotsToUpdateAggState[i]->entry + aggStateOffset, aggVector, multiplicity,
-                    aggPos);
-            }
-        } else {
-            for (auto i = 0u; i < selectedSize; i++) {
-                auto pos = groupByUnflatHashKeyVectors[0]->state->selVector->selectedPositions[i];
-                aggregateFunction->updatePosState(
-                    hashSlotsToUpdateAggState[pos]->entry + aggStateOffset, aggVector, multiplicity,
-                    aggPos);
-            }
-        }
-    }
+    auto& selVector = *groupByUnflatHashKeyVectors[0]->state->selVector;
+    fillAggStatesToUpdate(selVector, aggStateOffset);
+    aggregateFunction->updateStates(aggStatesToUpdate.get(), aggVector, multiplicity, selVector);
 }
 
 void AggregateHashTable::updateFlatKeyUnflatAggVectorState(
     const vector<ValueVector*>& groupByFlatHashKeyVectors,
     unique_ptr<AggregateFunction>& aggregateFunction, ValueVector* aggVector, uint64_t multiplicity,
     uint32_t aggStateOffset) {
-    auto groupByKeyPos = groupByFlatHashKeyVectors[0]->state->getPositionOfCurrIdx();
-    auto aggVecSelectedSize = aggVector->state->selVector->selectedSize;
-    if (aggVector->hasNoNullsGuarantee()) {
-        if (aggVector->state->selVector->isUnfiltered()) {
-            for (auto i = 0u; i < aggVecSelectedSize; i++) {
-                aggregateFunction->updatePosState(
-                    hashSlotsToUpdateAggState[groupByKeyPos]->entry + aggStateOffset, aggVector,
-                    multiplicity, aggVector->state->selVector->selectedPositions[i]);
-            }
-        } else {
-            for (auto i = 0u; i < aggVecSelectedSize; i++) {
-                aggregateFunction->updatePosState(
-                    hashSlotsToUpdateAggState[groupByKeyPos]->entry + aggStateOffset, aggVector,
-                    multiplicity, aggVector->state->selVector->selectedPositions[i]);
-            }
-        }
-    } else {
-        if (aggVector->state->selVector->isUnfiltered()) {
-            for (auto i = 0u; i < aggVecSelectedSize; i++) {
-                if (!aggVector->isNull(i)) {
-                    aggregateFunction->updatePosState(
-                        hashSlotsToUpdateAggState[0]->entry + aggStateOffset, aggVector,
-                        multiplicity, i);
-                }
-            }
-        } else {
-            for (auto i = 0u; i < aggVecSelectedSize; i++) {
-                auto pos = aggVector->state->selVector->selectedPositions[i];
-                if (!aggVector->isNull(pos)) {
-                    aggregateFunction->updatePosState(
-                        hashSlotsToUpdateAggState[0]->entry + aggStateOffset, aggVector,
-                        multiplicity, pos);
-                }
-            }
-        }
-    }
+    // All tuples of the aggregate vector fall into the single group of the flat keys.
+    aggregateFunction->updateAllState(
+        hashSlotsToUpdateAggState[hashVector->state->getPositionOfCurrIdx()]->entry +
+            aggStateOffset,
+        aggVector, multiplicity);
 }
 
 void AggregateHashTable::updateBothUnflatSameDCAggVectorState(
@@ -811,41 +830,9 @@ void AggregateHashTable::updateBothUnflatSameDCAggVectorState(
     const vector<ValueVector*>& groupByUnflatHashKeyVectors,
     unique_ptr<AggregateFunction>& aggregateFunction, ValueVector* aggVector, uint64_t multiplicity,
     uint32_t aggStateOffset) {
-    if (aggVector->hasNoNullsGuarantee()) {
-        if (aggVector->state->selVector->isUnfiltered()) {
-            for (auto i = 0u; i < aggVector->state->selVector->selectedSize; i++) {
-                aggregateFunction->updatePosState(
-                    hashSlotsToUpdateAggState[i]->entry + aggStateOffset, aggVector, multiplicity,
-                    i);
-            }
-        } else {
-            for (auto i = 0u; i < aggVector->state->selVector->selectedSize; i++) {
-                auto pos = aggVector->state->selVector->selectedPositions[i];
-                aggregateFunction->updatePosState(
-                    hashSlotsToUpdateAggState[pos]->entry + aggStateOffset, aggVector, multiplicity,
-                    pos);
-            }
-        }
-    } else {
-        if (aggVector->state->selVector->isUnfiltered()) {
-            for (auto i = 0u; i < aggVector->state->selVector->selectedSize; i++) {
-                if (!aggVector->isNull(i)) {
-                    aggregateFunction->updatePosState(
-                        hashSlotsToUpdateAggState[i]->entry + aggStateOffset, aggVector,
-                        multiplicity, i);
-                }
-            }
-        } else {
-            for (auto i = 0u; i < aggVector->state->selVector->selectedSize; i++) {
-                auto pos = aggVector->state->selVector->selectedPositions[i];
-                if (!aggVector->isNull(pos)) {
-                    aggregateFunction->updatePosState(
-                        hashSlotsToUpdateAggState[pos]->entry + aggStateOffset, aggVector,
-                        multiplicity, pos);
-                }
-            }
-        }
-    }
+    auto& selVector = *aggVector->state->selVector;
+    fillAggStatesToUpdate(selVector, aggStateOffset);
+    aggregateFunction->updateStates(aggStatesToUpdate.get(), aggVector, multiplicity, selVector);
 }
 
 void AggregateHashTable::updateBothUnflatDifferentDCAggVectorState(
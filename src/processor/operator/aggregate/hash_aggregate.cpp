@@ -5,42 +5,72 @@ namespace processor {
 
 void HashAggregateSharedState::appendAggregateHashTable(
     unique_ptr<AggregateHashTable> aggregateHashTable) {
+    // Partitioning happens on the appending thread, outside the lock.
+    auto partitionedEntries = aggregateHashTable->partitionEntries();
     auto lck = acquireLock();
     localAggregateHashTables.push_back(move(aggregateHashTable));
+    localPartitionedEntries.push_back(move(partitionedEntries));
 }
 
-void HashAggregateSharedState::combineAggregateHashTable(MemoryManager& memoryManager) {
+void HashAggregateSharedState::prepareToCombineAggregateHashTables() {
     auto lck = acquireLock();
     if (localAggregateHashTables.size() == 1) {
-        globalAggregateHashTable = move(localAggregateHashTables[0]);
-    } else {
-        auto numEntries = 0u;
-        for (auto& ht : localAggregateHashTables) {
-            numEntries += ht->getNumEntries();
-        }
-        localAggregateHashTables[0]->resize(HashTableUtils::nextPowerOfTwo(numEntries));
-        globalAggregateHashTable = move(localAggregateHashTables[0]);
-        for (auto i = 1u; i < localAggregateHashTables.size(); i++) {
-            globalAggregateHashTable->merge(*localAggregateHashTables[i]);
+        globalPartitions.push_back(move(localAggregateHashTables[0]));
+        globalPartitions[0]->finalizeAggregateStates();
+        return;
+    }
+    for (auto partitionIdx = 0u; partitionIdx < HashAggregateConfig::NUM_PARTITIONS;
+         partitionIdx++) {
+        for (auto& partitionedEntries : localPartitionedEntries) {
+            if (!partitionedEntries[partitionIdx].empty()) {
+                nonEmptyPartitionIdxes.push_back(partitionIdx);
+                break;
+            }
         }
     }
+    globalPartitions.resize(nonEmptyPartitionIdxes.size());
 }
 
-void HashAggregateSharedState::finalizeAggregateHashTable() {
-    auto lck = acquireLock();
-    globalAggregateHashTable->finalizeAggregateStates();
+void HashAggregateSharedState::combinePartitions(MemoryManager& memoryManager) {
+    // Partitions are disjoint in their groups, so each thread merges and finalizes the partitions
+    // it grabs without synchronizing with the others.
+    auto idx = nextPartitionToCombine.fetch_add(1, memory_order_relaxed);
+    while (idx < nonEmptyPartitionIdxes.size()) {
+        auto partitionIdx = nonEmptyPartitionIdxes[idx];
+        auto numEntries = 0ul;
+        for (auto& partitionedEntries : localPartitionedEntries) {
+            numEntries += partitionedEntries[partitionIdx].size();
+        }
+        auto& firstLocalHashTable = localAggregateHashTables[0];
+        auto partition = make_unique<AggregateHashTable>(memoryManager,
+            firstLocalHashTable->getGroupByHashKeysDataTypes(),
+            firstLocalHashTable->getGroupByNonHashKeysDataTypes(), aggregateFunctions,
+            HashTableUtils::nextPowerOfTwo(numEntries));
+        for (auto i = 0u; i < localAggregateHashTables.size(); i++) {
+            partition->mergeEntries(*localAggregateHashTables[i]->getFactorizedTable(),
+                localPartitionedEntries[i][partitionIdx]);
+        }
+        partition->finalizeAggregateStates();
+        globalPartitions[idx] = move(partition);
+        idx = nextPartitionToCombine.fetch_add(1, memory_order_relaxed);
+    }
 }
 
-pair<uint64_t, uint64_t> HashAggregateSharedState::getNextRangeToRead() {
+tuple<AggregateHashTable*, uint64_t, uint64_t> HashAggregateSharedState::getNextRangeToRead() {
     auto lck = acquireLock();
-    if (currentOffset >= globalAggregateHashTable->getNumEntries()) {
-        return make_pair(currentOffset, currentOffset);
+    while (currentPartitionIdx < globalPartitions.size() &&
+           currentOffset >= globalPartitions[currentPartitionIdx]->getNumEntries()) {
+        currentPartitionIdx++;
+        currentOffset = 0;
+    }
+    if (currentPartitionIdx >= globalPartitions.size()) {
+        return make_tuple(nullptr, currentOffset, currentOffset);
     }
+    auto partition = globalPartitions[currentPartitionIdx].get();
     auto startOffset = currentOffset;
-    auto range =
-        min(DEFAULT_VECTOR_CAPACITY, globalAggregateHashTable->getNumEntries() - currentOffset);
+    auto range = min(DEFAULT_VECTOR_CAPACITY, partition->getNumEntries() - currentOffset);
     currentOffset += range;
-    return make_pair(startOffset, startOffset + range);
+    return make_tuple(partition, startOffset, startOffset + range);
 }
 
 shared_ptr<ResultSet> HashAggregate::init(ExecutionContext* context) {
@@ -81,8 +111,7 @@ void HashAggregate::execute(ExecutionContext* context) {
 }
 
 void HashAggregate::finalize(ExecutionContext* context) {
-    sharedState->combineAggregateHashTable(*context->memoryManager);
-    sharedState->finalizeAggregateHashTable();
+    sharedState->prepareToCombineAggregateHashTables();
 }
 
 unique_ptr<PhysicalOperator> HashAggregate::clone() {
@@ -19,18 +19,19 @@ shared_ptr<ResultSet> HashAggregateScan::init(ExecutionContext* context) {
 
 bool HashAggregateScan::getNextTuples() {
     metrics->executionTime.start();
-    auto [startOffset, endOffset] = sharedState->getNextRangeToRead();
+    auto [partition, startOffset, endOffset] = sharedState->getNextRangeToRead();
     if (startOffset >= endOffset) {
         metrics->executionTime.stop();
         return false;
     }
     auto numRowsToScan = endOffset - startOffset;
-    sharedState->getFactorizedTable()->scan(
+    partition->getFactorizedTable()->scan(
         groupByKeyVectors, startOffset, numRowsToScan, groupByKeyVectorsColIdxes);
+    auto aggregateStatesOffset = partition->getFactorizedTable()->getTableSchema()->getColOffset(
+        groupByKeyVectors.size());
     for (auto pos = 0u; pos < numRowsToScan; ++pos) {
-        auto entry = sharedState->getRow(startOffset + pos);
-        auto offset = sharedState->getFactorizedTable()->getTableSchema()->getColOffset(
-            groupByKeyVectors.size());
+        auto entry = partition->getEntry(startOffset + pos);
+        auto offset = aggregateStatesOffset;
         for (auto& vector : aggregateVectors) {
             auto aggState = (AggregateState*)(entry + offset);
             writeAggregateResultToVector(*vector, pos, aggState);
@@ -33,10 +33,10 @@ struct HashSlot {
  *
  */
 class AggregateHashTable;
-using compare_function_t = std::function<bool(const uint8_t*, const uint8_t*)>;
-using update_agg_function_t = std::function<void(AggregateHashTable*, const vector<ValueVector*>&,
+using compare_function_t = bool (*)(const uint8_t*, const uint8_t*);
+using update_agg_function_t = void (AggregateHashTable::*)(const vector<ValueVector*>&,
     const vector<ValueVector*>&, unique_ptr<AggregateFunction>&, ValueVector*, uint64_t, uint32_t,
-    uint32_t)>;
+    uint32_t);
 
 class AggregateHashTable : public BaseHashTable {
 public:
@@ -77,6 +77,24 @@ public:
 
     //! merge aggregate hash table by combining aggregate states under the same key
     void merge(AggregateHashTable& other);
+    //! merge the given entries of another aggregate hash table with the same layout. The
+    //! entries are read through otherTable, which must be the factorizedTable holding them.
+    void mergeEntries(const FactorizedTable& otherTable, const vector<uint8_t*>& entries);
+
+    //! radix partition the entries by the most significant bits of their hash values. The
+    //! returned pointers are valid as long as this hash table is alive.
+    vector<vector<uint8_t*>> partitionEntries() const;
+
+    static inline uint32_t getPartitionIdx(hash_t hash) {
+        return hash >> (sizeof(hash_t) * 8 - HashAggregateConfig::NUM_PARTITIONS_LOG_2);
+    }
+
+    inline const vector<DataType>& getGroupByHashKeysDataTypes() const {
+        return groupByHashKeysDataTypes;
+    }
+    inline const vector<DataType>& getGroupByNonHashKeysDataTypes() const {
+        return groupByNonHashKeysDataTypes;
+    }
 
     void finalizeAggregateStates();
 
@@ -139,11 +157,19 @@ private:
     // are flat.
     bool matchFlatGroupByKeys(const vector<ValueVector*>& keyVectors, uint8_t* entry);
 
+    // Key columns of the common types are matched by loops specialized on the type at compile
+    // time. Other types go through the compare function of the column.
     uint64_t matchUnflatVecWithFTColumn(
         ValueVector* vector, uint64_t numMayMatches, uint64_t& numNoMatches, uint32_t colIdx);
+    template<typename COMPARE>
+    uint64_t matchUnflatVecWithFTColumn(ValueVector* vector, uint64_t numMayMatches,
+        uint64_t& numNoMatches, uint32_t colIdx, COMPARE compare);
 
     uint64_t matchFlatVecWithFTColumn(
         ValueVector* vector, uint64_t numMayMatches, uint64_t& numNoMatches, uint32_t colIdx);
+    template<typename COMPARE>
+    uint64_t matchFlatVecWithFTColumn(ValueVector* vector, uint64_t numMayMatches,
+        uint64_t& numNoMatches, uint32_t colIdx, COMPARE compare);
 
     uint64_t matchFTEntries(const vector<ValueVector*>& groupByFlatHashKeyVectors,
         const vector<ValueVector*>& groupByUnflatHashKeyVectors,
@@ -172,8 +198,17 @@ private:
     template<typename type>
     static bool compareEntryWithKeys(const uint8_t* keyValue, const uint8_t* entry);
 
+    template<typename type>
+    struct EntryWithKeysComparator {
+        inline bool operator()(const uint8_t* keyValue, const uint8_t* entry) const {
+            return compareEntryWithKeys<type>(keyValue, entry);
+        }
+    };
+
     static compare_function_t getCompareEntryWithKeysFunc(DataTypeID typeId);
 
+    void fillAggStatesToUpdate(const SelectionVector& selVector, uint32_t aggStateOffset);
+
     void updateNullAggVectorState(const vector<ValueVector*>& groupByFlatHashKeyVectors,
         const vector<ValueVector*>& groupByUnflatHashKeyVectors,
         unique_ptr<AggregateFunction>& aggregateFunction, uint64_t multiplicity,
@@ -224,6 +259,7 @@ private:
     shared_ptr<DataChunkState> hashState;
     shared_ptr<ValueVector> hashVector;
     unique_ptr<HashSlot*[]> hashSlotsToUpdateAggState;
+    unique_ptr<uint8_t*[]> aggStatesToUpdate;
     unique_ptr<uint64_t[]> tmpValueIdxes;
     unique_ptr<uint64_t[]> entryIdxesToInitialize;
     unique_ptr<uint64_t[]> mayMatchIdxes;
@@ -16,8 +16,6 @@ protected:
 
     unique_lock<mutex> acquireLock() { return unique_lock<mutex>{mtx}; }
 
-    virtual pair<uint64_t, uint64_t> getNextRangeToRead() = 0;
-
     virtual ~BaseAggregateSharedState() {}
 
 protected:
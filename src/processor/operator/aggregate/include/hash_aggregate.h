@@ -16,19 +16,30 @@ public:
 
     void appendAggregateHashTable(unique_ptr<AggregateHashTable> aggregateHashTable);
 
-    void combineAggregateHashTable(MemoryManager& memoryManager);
+    // Decides which partitions combinePartitions() builds. Partitions without entries in any
+    // thread-local hash table are skipped. A single thread-local hash table is used as it is.
+    void prepareToCombineAggregateHashTables();
 
-    void finalizeAggregateHashTable();
+    // Merges the thread-local hash tables into one global hash table per partition and finalizes
+    // the aggregate states of each partition. Called by all threads of the parallel finalize task,
+    // which grab the partitions one at a time.
+    void combinePartitions(MemoryManager& memoryManager);
 
-    pair<uint64_t, uint64_t> getNextRangeToRead() override;
+    inline uint64_t getNumGlobalPartitions() const { return globalPartitions.size(); }
 
-    inline uint8_t* getRow(uint64_t idx) { return globalAggregateHashTable->getEntry(idx); }
-
-    FactorizedTable* getFactorizedTable() { return globalAggregateHashTable->getFactorizedTable(); }
+    // Returns the global partition and the range of its entries to be scanned next. The range is
+    // empty once all partitions have been scanned.
+    tuple<AggregateHashTable*, uint64_t, uint64_t> getNextRangeToRead();
 
 private:
     vector<unique_ptr<AggregateHashTable>> localAggregateHashTables;
-    unique_ptr<AggregateHashTable> globalAggregateHashTable;
+    // The entries of each thread-local hash table grouped by partition.
+    vector<vector<vector<uint8_t*>>> localPartitionedEntries;
+    // The partitions with at least one entry, and their global hash tables.
+    vector<uint32_t> nonEmptyPartitionIdxes;
+    vector<unique_ptr<AggregateHashTable>> globalPartitions;
+    atomic<uint32_t> nextPartitionToCombine{0};
+    uint32_t currentPartitionIdx = 0;
 };
 
 class HashAggregate : public BaseAggregate {
@@ -52,6 +63,10 @@ public:
     void execute(ExecutionContext* context) override;
 
     void finalize(ExecutionContext* context) override;
+    inline bool hasParallelFinalize() override { return true; }
+    inline void finalizeInParallel(ExecutionContext* context) override {
+        sharedState->combinePartitions(*context->memoryManager);
+    }
 
     unique_ptr<PhysicalOperator> clone() override;
 
@@ -16,7 +16,7 @@ public:
 
     void finalizeAggregateStates();
 
-    pair<uint64_t, uint64_t> getNextRangeToRead() override;
+    pair<uint64_t, uint64_t> getNextRangeToRead();
 
     inline AggregateState* getAggregateState(uint64_t idx) {
         return globalAggregateStates[idx].get();
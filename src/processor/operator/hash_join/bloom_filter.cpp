@@ -0,0 +1,17 @@
+#include "include/bloom_filter.h"
+
+#include "src/common/include/utils.h"
+
+namespace kuzu {
+namespace processor {
+
+BloomFilter::BloomFilter(uint64_t numKeys) {
+    auto numBitsNeeded = numKeys * NUM_BITS_PER_KEY;
+    auto numBlocks = HashTableUtils::nextPowerOfTwo(
+        max((uint64_t)1, (numBitsNeeded + NUM_BITS_PER_BLOCK - 1) / NUM_BITS_PER_BLOCK));
+    blockIdxMask = numBlocks - 1;
+    blocks = make_unique<uint32_t[]>(numBlocks * NUM_WORDS_PER_BLOCK);
+}
+
+} // namespace processor
+} // namespace kuzu
@@ -1,6 +1,7 @@
 #include "include/hash_join_build.h"
 
 #include "src/common/include/utils.h"
+#include "src/storage/include/storage_utils.h"
 
 namespace kuzu {
 namespace processor {
@@ -13,9 +14,67 @@ void HashJoinSharedState::initEmptyHashTableIfNecessary(MemoryManager& memoryMan
     }
 }
 
-void HashJoinSharedState::mergeLocalHashTable(JoinHashTable& localHashTable) {
+bool HashJoinSharedState::mergeLocalHashTable(JoinHashTable& localHashTable) {
     unique_lock lck(hashJoinSharedStateMutex);
+    if (hasSpilled) {
+        return false;
+    }
     hashTable->merge(localHashTable);
+    return true;
+}
+
+void HashJoinSharedState::startSpilling(const string& spillDirPath, MemoryManager& memoryManager) {
+    unique_lock lck(hashJoinSharedStateMutex);
+    if (hasSpilled) {
+        return;
+    }
+    spilledBuildPartitions = make_unique<SpilledPartitions>(
+        StorageUtils::getNewSpillFilePath(spillDirPath, "hash_join_build"), 0 /* level */);
+    spilledProbePartitions = make_unique<SpilledPartitions>(
+        StorageUtils::getNewSpillFilePath(spillDirPath, "hash_join_probe"), 0 /* level */);
+    SpillPartitionWriter spillPartitionWriter(*spilledBuildPartitions,
+        hashTable->getTableSchema()->getNumBytesPerTuple(), memoryManager);
+    auto numBlocks = hashTable->getFactorizedTable()->getTupleDataBlocks().size();
+    hashTable->spillTuples(spillPartitionWriter);
+    spillPartitionWriter.flush();
+    // The spilled blocks are released, which leaves their memory to the other hash joins.
+    buildMemoryUsage->decreaseNumBlocksInMemory(numBlocks);
+    hasSpilled = true;
+}
+
+void HashJoinSharedState::loadResidentPartition() {
+    if (spilledBuildPartitions->getMaxNumBlocksToLoad(0 /* partitionIdx */) >
+        buildMemoryUsage->getMemoryBudgetInBlocks()) {
+        return;
+    }
+    hashTable->loadSpilledPartition(*spilledBuildPartitions, 0 /* partitionIdx */);
+    buildMemoryUsage->increaseNumBlocksInMemory(
+        hashTable->getFactorizedTable()->getTupleDataBlocks().size());
+    hasResidentPartition = true;
+    nextSpilledPartitionIdx = 1;
+}
+
+bool HashJoinSharedState::registerProbeThread() {
+    unique_lock lck(hashJoinSharedStateMutex);
+    if (isResidentPartitionProbed) {
+        return false;
+    }
+    numThreadsProbingResidentPartition++;
+    return true;
+}
+
+void HashJoinSharedState::finishProbingResidentPartition() {
+    unique_lock lck(hashJoinSharedStateMutex);
+    assert(numThreadsProbingResidentPartition > 0);
+    if (--numThreadsProbingResidentPartition == 0) {
+        isResidentPartitionProbed = true;
+        residentPartitionProbedCV.notify_all();
+    }
+}
+
+void HashJoinSharedState::waitForResidentPartitionToBeProbed() {
+    unique_lock lck(hashJoinSharedStateMutex);
+    residentPartitionProbedCV.wait(lck, [this] { return isResidentPartitionProbed; });
 }
 
 shared_ptr<ResultSet> HashJoinBuild::init(ExecutionContext* context) {
@@ -48,6 +107,11 @@ shared_ptr<ResultSet> HashJoinBuild::init(ExecutionContext* context) {
         UINT32_MAX /* For now, we just put UINT32_MAX for prev pointer */,
         Types::getDataTypeSize(INT64)));
     initHashTable(*context->memoryManager, move(tableSchema));
+    if (sharedState->getIsSpillingEnabled()) {
+        sharedState->getBuildMemoryUsage()->setMemoryBudgetInBlocks(
+            context->bufferManager->getNumLargePageFrames() *
+            context->hashJoinBuildMemoryBudgetRatio);
+    }
     return resultSet;
 }
 
@@ -60,9 +124,16 @@ void HashJoinBuild::initHashTable(
 }
 
 void HashJoinBuild::finalize(ExecutionContext* context) {
-    auto numTuples = sharedState->getHashTable()->getNumTuples();
-    sharedState->getHashTable()->allocateHashSlots(numTuples);
-    sharedState->getHashTable()->buildHashSlots();
+    auto globalHashTable = sharedState->getHashTable();
+    if (sharedState->getHasSpilled()) {
+        sharedState->loadResidentPartition();
+    }
+    auto numTuples = globalHashTable->getNumTuples();
+    globalHashTable->allocateHashSlots(numTuples);
+    // A bloom filter of the resident partition only would drop probe tuples of other partitions.
+    if (sharedState->getIsBloomFilterEnabled() && !sharedState->getHasSpilled()) {
+        globalHashTable->allocateBloomFilter(numTuples);
+    }
 }
 
 void HashJoinBuild::execute(ExecutionContext* context) {
@@ -73,11 +144,49 @@ void HashJoinBuild::execute(ExecutionContext* context) {
         for (auto i = 0u; i < resultSet->multiplicity; ++i) {
             appendVectors();
         }
+        if (sharedState->getIsSpillingEnabled()) {
+            spillLocalHashTableIfNecessary(context);
+        }
     }
     // Merge with global hash table once local tuples are all appended.
-    sharedState->mergeLocalHashTable(*hashTable);
+    if (!sharedState->mergeLocalHashTable(*hashTable)) {
+        spillLocalHashTable(*context->memoryManager);
+    }
+    if (spillPartitionWriter != nullptr) {
+        spillPartitionWriter->flush();
+        spillPartitionWriter.reset();
+    }
     metrics->executionTime.stop();
 }
 
+void HashJoinBuild::spillLocalHashTableIfNecessary(ExecutionContext* context) {
+    auto numLocalBlocks = hashTable->getFactorizedTable()->getTupleDataBlocks().size();
+    if (!sharedState->getHasSpilled()) {
+        auto buildMemoryUsage = sharedState->getBuildMemoryUsage();
+        auto numBlocksInMemory =
+            buildMemoryUsage->increaseNumBlocksInMemory(numLocalBlocks - numLocalBlocksCounted);
+        numLocalBlocksCounted = numLocalBlocks;
+        if (numBlocksInMemory <= buildMemoryUsage->getMemoryBudgetInBlocks()) {
+            return;
+        }
+        sharedState->startSpilling(context->spillDirPath, *context->memoryManager);
+    } else if (numLocalBlocks < 2) {
+        // Wait for at least one full block before spilling again.
+        return;
+    }
+    spillLocalHashTable(*context->memoryManager);
+}
+
+void HashJoinBuild::spillLocalHashTable(MemoryManager& memoryManager) {
+    if (spillPartitionWriter == nullptr) {
+        spillPartitionWriter = make_unique<SpillPartitionWriter>(
+            *sharedState->getSpilledBuildPartitions(),
+            hashTable->getTableSchema()->getNumBytesPerTuple(), memoryManager);
+    }
+    hashTable->spillTuples(*spillPartitionWriter);
+    sharedState->getBuildMemoryUsage()->decreaseNumBlocksInMemory(numLocalBlocksCounted);
+    numLocalBlocksCounted = 0;
+}
+
 } // namespace processor
 } // namespace kuzu
@@ -2,15 +2,25 @@
 
 #include "src/function/hash/include/vector_hash_operations.h"
 #include "src/function/hash/operations/include/hash_operations.h"
+#include "src/storage/include/storage_utils.h"
 
 using namespace kuzu::function::operation;
 
 namespace kuzu {
 namespace processor {
 
+HashJoinProbe::~HashJoinProbe() {
+    // Do not block the other probe threads if this one fails before finishing the resident
+    // partition.
+    if (spillState != nullptr && spillState->isProbingResidentPartition) {
+        sharedState->finishProbingResidentPartition();
+    }
+}
+
 shared_ptr<ResultSet> HashJoinProbe::init(ExecutionContext* context) {
     resultSet = PhysicalOperator::init(context);
     probeState = make_unique<ProbeState>();
+    hashTable = sharedState->getHashTable();
     for (auto& keyDataPos : probeDataInfo.keysDataPos) {
         auto keyVector =
             resultSet->dataChunks[keyDataPos.dataChunkPos]->valueVectors[keyDataPos.valueVectorPos];
@@ -36,13 +46,66 @@ shared_ptr<ResultSet> HashJoinProbe::init(ExecutionContext* context) {
     // We only need to read nonKeys from the factorizedTable. Key columns are always kept as first k
     // columns in the factorizedTable, so we skip the first k columns.
     assert(probeDataInfo.keysDataPos.size() + probeDataInfo.payloadsOutputDataPos.size() + 1 ==
-           sharedState->getHashTable()->getTableSchema()->getNumColumns());
+           hashTable->getTableSchema()->getNumColumns());
     columnIdxsToReadFrom.resize(probeDataInfo.payloadsOutputDataPos.size());
     iota(
         columnIdxsToReadFrom.begin(), columnIdxsToReadFrom.end(), probeDataInfo.keysDataPos.size());
+    numSpilledPartitions =
+        context->profiler->registerNumericMetric(getNumSpilledPartitionsMetricKey());
+    if (sharedState->getHasSpilled()) {
+        initSpillState(context);
+    }
     return resultSet;
 }
 
+void HashJoinProbe::initSpillState(ExecutionContext* context) {
+    spillState = make_unique<ProbeSpillState>();
+    spillState->memoryManager = context->memoryManager;
+    spillState->spillDirPath = context->spillDirPath;
+    auto tableSchema = make_unique<FactorizedTableSchema>();
+    for (auto i = 0u; i < probeDataInfo.probeSideDataPos.size(); i++) {
+        auto dataPos = probeDataInfo.probeSideDataPos[i];
+        auto vector = resultSet->getValueVector(dataPos);
+        auto colIdx = tableSchema->getNumColumns();
+        tableSchema->appendColumn(make_unique<ColumnSchema>(false /* is flat */,
+            dataPos.dataChunkPos, Types::getDataTypeSize(vector->dataType)));
+        // Spilled tuples are appended by different threads, so nulls are always tracked.
+        tableSchema->setMayContainsNullsToTrue(colIdx);
+        spillState->vectors.push_back(vector);
+        auto state = resultSet->dataChunks[dataPos.dataChunkPos]->state.get();
+        if (probeDataInfo.isProbeSideVectorFlat[i]) {
+            spillState->flatVectors.push_back(vector);
+            spillState->flatColIdxes.push_back(colIdx);
+            if (find(spillState->flatStates.begin(), spillState->flatStates.end(), state) ==
+                spillState->flatStates.end()) {
+                spillState->flatStates.push_back(state);
+            }
+        } else {
+            assert(spillState->unflatState == nullptr || spillState->unflatState == state);
+            spillState->unflatVectors.push_back(vector);
+            spillState->unflatColIdxes.push_back(colIdx);
+            spillState->unflatState = state;
+        }
+    }
+    for (auto& keyDataPos : probeDataInfo.keysDataPos) {
+        auto& probeSideDataPos = probeDataInfo.probeSideDataPos;
+        uint32_t colIdx = find(probeSideDataPos.begin(), probeSideDataPos.end(), keyDataPos) -
+                          probeSideDataPos.begin();
+        assert(colIdx < probeSideDataPos.size());
+        spillState->keyColIdxes.push_back(colIdx);
+    }
+    spillState->tuplesToSpill =
+        make_unique<FactorizedTable>(context->memoryManager, move(tableSchema));
+    if (!sharedState->registerProbeThread()) {
+        return;
+    }
+    spillState->isProbingResidentPartition = true;
+    spillState->spillPartitionWriter =
+        make_unique<SpillPartitionWriter>(*sharedState->getSpilledProbePartitions(),
+            spillState->tuplesToSpill->getTableSchema()->getNumBytesPerTuple(),
+            *context->memoryManager);
+}
+
 bool HashJoinProbe::hasMoreLeft() {
     if (keyVectors[0]->state->isFlat() && probeState->probedTuples[0] != nullptr) {
         return true;
@@ -50,17 +113,321 @@ bool HashJoinProbe::hasMoreLeft() {
     return false;
 }
 
+bool HashJoinProbe::getNextProbeTuples() {
+    if (spillState != nullptr && spillState->isProbingSpilledPartitions) {
+        return getNextSpilledProbeTuples();
+    }
+    if (spillState != nullptr && !spillState->isProbingResidentPartition) {
+        // The thread was accepted by the task after the other threads exhausted the probe side and
+        // finished the resident partition, so the probe side must be exhausted for it as well.
+        // Otherwise its tuples of the spilled partitions would be lost.
+        if (children[0]->getNextTuples()) {
+            throw RuntimeException("A hash join probe thread started after the resident "
+                                   "partition was probed, but its probe side is not exhausted.");
+        }
+        startProbingSpilledPartitions();
+        return getNextSpilledProbeTuples();
+    }
+    do {
+        restoreSelVectors(keySelVectors);
+        if (!children[0]->getNextTuples()) {
+            if (spillState == nullptr) {
+                return false;
+            }
+            finishProbingResidentPartition();
+            return getNextSpilledProbeTuples();
+        }
+        saveSelVectors(keySelVectors);
+    } while (spillState != nullptr && !spillNonResidentProbeTuples());
+    return true;
+}
+
+static void selectPositions(SelectionVector& selVector, const vector<sel_t>& positions) {
+    memcpy(selVector.getSelectedPositionsBuffer(), positions.data(),
+        positions.size() * sizeof(sel_t));
+    selVector.resetSelectorToValuePosBufferWithSize(positions.size());
+}
+
+bool HashJoinProbe::spillNonResidentProbeTuples() {
+    auto keyState = keyVectors[0]->state.get();
+    if (keyState->isFlat()) {
+        vector<nodeID_t> keys(keyVectors.size());
+        for (auto i = 0u; i < keyVectors.size(); i++) {
+            auto pos = keyVectors[i]->state->getPositionOfCurrIdx();
+            // Null keys never match, but left and mark joins still need to output them.
+            if (keyVectors[i]->isNull(pos)) {
+                return true;
+            }
+            keys[i] = ((nodeID_t*)keyVectors[i]->values)[pos];
+        }
+        auto partitionIdx =
+            SpilledPartitions::getPartitionIdx(hashTable->hashKeys(keys.data()), 0 /* level */);
+        if (sharedState->isResidentPartition(partitionIdx)) {
+            return true;
+        }
+        spillProbeTuples(partitionIdx);
+        return false;
+    }
+    assert(keyVectors.size() == 1);
+    auto keyValues = (nodeID_t*)keyVectors[0]->values;
+    auto selVector = keyState->selVector.get();
+    auto& positionsInPartitions = spillState->positionsInPartitions;
+    auto& positionsToProbe = spillState->positionsToProbe;
+    for (auto& positions : positionsInPartitions) {
+        positions.clear();
+    }
+    positionsToProbe.clear();
+    for (auto i = 0u; i < selVector->selectedSize; i++) {
+        auto pos = selVector->selectedPositions[i];
+        if (keyVectors[0]->isNull(pos)) {
+            positionsToProbe.push_back(pos);
+            continue;
+        }
+        auto partitionIdx = SpilledPartitions::getPartitionIdx(
+            hashTable->hashKeys(&keyValues[pos]), 0 /* level */);
+        if (sharedState->isResidentPartition(partitionIdx)) {
+            positionsToProbe.push_back(pos);
+        } else {
+            positionsInPartitions[partitionIdx].push_back(pos);
+        }
+    }
+    if (positionsToProbe.size() == selVector->selectedSize) {
+        return true;
+    }
+    for (auto partitionIdx = 0u; partitionIdx < positionsInPartitions.size(); partitionIdx++) {
+        if (!positionsInPartitions[partitionIdx].empty()) {
+            selectPositions(*selVector, positionsInPartitions[partitionIdx]);
+            spillProbeTuples(partitionIdx);
+        }
+    }
+    selectPositions(*selVector, positionsToProbe);
+    return !positionsToProbe.empty();
+}
+
+void HashJoinProbe::spillProbeTuples(uint32_t partitionIdx) {
+    auto& tuplesToSpill = *spillState->tuplesToSpill;
+    for (auto i = 0u; i < resultSet->multiplicity; i++) {
+        tuplesToSpill.append(spillState->vectors);
+    }
+    auto numBytesPerTuple = tuplesToSpill.getTableSchema()->getNumBytesPerTuple();
+    for (auto& block : tuplesToSpill.getTupleDataBlocks()) {
+        auto tuple = block->getData();
+        for (auto i = 0u; i < block->numTuples; i++) {
+            spillState->spillPartitionWriter->append(partitionIdx, tuple);
+            tuple += numBytesPerTuple;
+        }
+    }
+    tuplesToSpill.clear();
+}
+
+void HashJoinProbe::finishProbingResidentPartition() {
+    spillState->spillPartitionWriter->flush();
+    spillState->spillPartitionWriter.reset();
+    spillState->isProbingResidentPartition = false;
+    sharedState->finishProbingResidentPartition();
+    sharedState->waitForResidentPartitionToBeProbed();
+    startProbingSpilledPartitions();
+}
+
+void HashJoinProbe::startProbingSpilledPartitions() {
+    spillState->isProbingSpilledPartitions = true;
+    spillState->block = make_unique<DataBlock>(spillState->memoryManager);
+    // Replayed tuples are already expanded by their multiplicity, and node IDs scanned from them
+    // are no longer sequential.
+    resultSet->multiplicity = 1;
+    for (auto& vector : spillState->vectors) {
+        vector->resetSequential();
+    }
+}
+
+bool HashJoinProbe::getNextSpilledProbeTuples() {
+    auto block = spillState->block.get();
+    while (spillState->nextTupleIdxInBlock == block->numTuples) {
+        if (spillState->partitionIdx == UINT32_MAX ||
+            spillState->nextBlockIdx ==
+                spillState->probePartitions->getNumPages(spillState->partitionIdx)) {
+            if (!loadNextSpilledPartition()) {
+                return false;
+            }
+            continue;
+        }
+        block->numTuples = spillState->probePartitions->readPage(
+            spillState->partitionIdx, spillState->nextBlockIdx++, block->getData());
+        spillState->nextTupleIdxInBlock = 0;
+    }
+    readSpilledProbeTuples();
+    return true;
+}
+
+bool HashJoinProbe::loadNextSpilledPartition() {
+    while (claimNextSpilledPartition()) {
+        auto partitionIdx = spillState->partitionIdx;
+        // No join type outputs anything for a partition without probe side tuples.
+        if (spillState->probePartitions->getNumPages(partitionIdx) == 0) {
+            continue;
+        }
+        if (spillState->buildPartitions->getMaxNumBlocksToLoad(partitionIdx) >
+            sharedState->getBuildMemoryUsage()->getMemoryBudgetInBlocks()) {
+            repartitionSpilledPartition();
+            continue;
+        }
+        spillState->nextBlockIdx = 0;
+        // Release the previous partition before loading the next one.
+        spillState->hashTable.reset();
+        spillState->hashTable = make_unique<JoinHashTable>(*spillState->memoryManager,
+            keyVectors.size(),
+            make_unique<FactorizedTableSchema>(*sharedState->getHashTable()->getTableSchema()));
+        spillState->hashTable->loadSpilledPartition(*spillState->buildPartitions, partitionIdx);
+        spillState->hashTable->allocateHashSlots(spillState->hashTable->getNumTuples());
+        spillState->hashTable->buildHashSlots();
+        hashTable = spillState->hashTable.get();
+        numSpilledPartitions->increase(1);
+        return true;
+    }
+    return false;
+}
+
+bool HashJoinProbe::claimNextSpilledPartition() {
+    auto& repartitionedPartitions = spillState->repartitionedPartitions;
+    while (!repartitionedPartitions.empty()) {
+        auto& partitions = repartitionedPartitions.back();
+        if (partitions.nextPartitionIdx < HashJoinConfig::NUM_SPILL_PARTITIONS) {
+            spillState->buildPartitions = partitions.buildPartitions.get();
+            spillState->probePartitions = partitions.probePartitions.get();
+            spillState->partitionIdx = partitions.nextPartitionIdx++;
+            return true;
+        }
+        repartitionedPartitions.pop_back();
+    }
+    auto partitionIdx = sharedState->getNextSpilledPartitionIdx();
+    if (partitionIdx == UINT32_MAX) {
+        return false;
+    }
+    spillState->buildPartitions = sharedState->getSpilledBuildPartitions();
+    spillState->probePartitions = sharedState->getSpilledProbePartitions();
+    spillState->partitionIdx = partitionIdx;
+    return true;
+}
+
+void HashJoinProbe::repartitionSpilledPartition() {
+    auto buildPartitions = spillState->buildPartitions;
+    auto partitionIdx = spillState->partitionIdx;
+    auto level = buildPartitions->getLevel() + 1;
+    if (level > SpilledPartitions::MAX_LEVEL) {
+        throw RuntimeException("A spilled partition of a hash join exceeds the memory budget, "
+                               "but the hashes of its keys cannot partition it any further.");
+    }
+    RepartitionedPartitions repartitioned;
+    repartitioned.buildPartitions = make_unique<SpilledPartitions>(
+        StorageUtils::getNewSpillFilePath(spillState->spillDirPath, "hash_join_build"), level);
+    repartitioned.probePartitions = make_unique<SpilledPartitions>(
+        StorageUtils::getNewSpillFilePath(spillState->spillDirPath, "hash_join_probe"), level);
+    auto globalHashTable = sharedState->getHashTable();
+    // Tuples with the same hash cannot be split, so we fail right away if there are too many of
+    // them instead of repartitioning them until the hash bits run out.
+    hash_t firstHash;
+    auto haveSameHash = true;
+    auto isFirstTuple = true;
+    {
+        SpillPartitionWriter spillPartitionWriter(*repartitioned.buildPartitions,
+            globalHashTable->getTableSchema()->getNumBytesPerTuple(), *spillState->memoryManager);
+        buildPartitions->repartition(partitionIdx,
+            globalHashTable->getTableSchema()->getNumBytesPerTuple(), spillPartitionWriter,
+            [&](const uint8_t* tuple) {
+                // The keys are the first columns of the build side tuples.
+                auto hash = globalHashTable->hashKeys((nodeID_t*)tuple);
+                if (isFirstTuple) {
+                    firstHash = hash;
+                    isFirstTuple = false;
+                }
+                haveSameHash &= hash == firstHash;
+                return SpilledPartitions::getPartitionIdx(hash, level);
+            });
+    }
+    if (haveSameHash) {
+        throw RuntimeException("A spilled partition of a hash join exceeds the memory budget, "
+                               "but all of its keys have the same hash.");
+    }
+    {
+        auto tableSchema = spillState->tuplesToSpill->getTableSchema();
+        SpillPartitionWriter spillPartitionWriter(*repartitioned.probePartitions,
+            tableSchema->getNumBytesPerTuple(), *spillState->memoryManager);
+        vector<nodeID_t> keys(spillState->keyColIdxes.size());
+        spillState->probePartitions->repartition(partitionIdx, tableSchema->getNumBytesPerTuple(),
+            spillPartitionWriter, [&](const uint8_t* tuple) {
+                for (auto i = 0u; i < keys.size(); i++) {
+                    keys[i] =
+                        *(nodeID_t*)(tuple + tableSchema->getColOffset(spillState->keyColIdxes[i]));
+                }
+                return SpilledPartitions::getPartitionIdx(
+                    globalHashTable->hashKeys(keys.data()), level);
+            });
+    }
+    spillState->repartitionedPartitions.push_back(move(repartitioned));
+}
+
+// Reads the next spilled probe tuple into the probe side vectors. If the probe side has an unflat
+// data chunk, the following tuples with the same flat values are read into it as well.
+void HashJoinProbe::readSpilledProbeTuples() {
+    auto& tuplesToSpill = *spillState->tuplesToSpill;
+    auto numBytesPerTuple = tuplesToSpill.getTableSchema()->getNumBytesPerTuple();
+    auto block = spillState->block.get();
+    auto tuplesToRead = spillState->tuplesToRead.get();
+    auto tuple = block->getData() + spillState->nextTupleIdxInBlock * numBytesPerTuple;
+    auto maxNumTuplesToRead =
+        spillState->unflatState == nullptr ?
+            1 :
+            min((uint32_t)DEFAULT_VECTOR_CAPACITY,
+                block->numTuples - spillState->nextTupleIdxInBlock);
+    auto numTuplesToRead = 0u;
+    do {
+        tuplesToRead[numTuplesToRead++] = tuple;
+        tuple += numBytesPerTuple;
+    } while (numTuplesToRead < maxNumTuplesToRead && hasSameFlatValues(tuplesToRead[0], tuple));
+    spillState->nextTupleIdxInBlock += numTuplesToRead;
+    for (auto state : spillState->flatStates) {
+        state->currIdx = 0;
+        state->selVector->resetSelectorToUnselected();
+        state->initOriginalAndSelectedSize(1);
+    }
+    tuplesToSpill.lookup(spillState->flatVectors, spillState->flatColIdxes, tuplesToRead,
+        0 /* startPos */, 1 /* numTuplesToRead */);
+    if (spillState->unflatState != nullptr) {
+        spillState->unflatState->selVector->resetSelectorToUnselected();
+        spillState->unflatState->initOriginalAndSelectedSize(numTuplesToRead);
+        tuplesToSpill.lookup(spillState->unflatVectors, spillState->unflatColIdxes, tuplesToRead,
+            0 /* startPos */, numTuplesToRead);
+    }
+}
+
+bool HashJoinProbe::hasSameFlatValues(const uint8_t* tuple, const uint8_t* otherTuple) const {
+    auto& tuplesToSpill = *spillState->tuplesToSpill;
+    auto tableSchema = tuplesToSpill.getTableSchema();
+    for (auto colIdx : spillState->flatColIdxes) {
+        auto isNull =
+            tuplesToSpill.isNonOverflowColNull(tuple + tableSchema->getNullMapOffset(), colIdx);
+        if (isNull != tuplesToSpill.isNonOverflowColNull(
+                          otherTuple + tableSchema->getNullMapOffset(), colIdx)) {
+            return false;
+        }
+        auto colOffset = tableSchema->getColOffset(colIdx);
+        if (!isNull && memcmp(tuple + colOffset, otherTuple + colOffset,
+                           tableSchema->getColumn(colIdx)->getNumBytes()) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool HashJoinProbe::getNextBatchOfMatchedTuples() {
     if (probeState->nextMatchedTupleIdx < probeState->matchedSelVector->selectedSize) {
         return true;
     }
     if (!hasMoreLeft()) {
-        restoreSelVectors(keySelVectors);
-        if (!children[0]->getNextTuples()) {
+        if (!getNextProbeTuples()) {
             return false;
         }
-        saveSelVectors(keySelVectors);
-        sharedState->getHashTable()->probe(keyVectors, probeState->probedTuples.get());
+        hashTable->probe(keyVectors, probeState->probedTuples.get());
     }
     auto numMatchedTuples = 0;
     if (keyVectors[0]->state->isFlat()) {
@@ -81,22 +448,28 @@ bool HashJoinProbe::getNextBatchOfMatchedTuples() {
                 }
             }
             numMatchedTuples += isKeysEqual;
-            probeState->probedTuples[0] = *sharedState->getHashTable()->getPrevTuple(currentTuple);
+            probeState->probedTuples[0] = *hashTable->getPrevTuple(currentTuple);
         }
     } else {
         assert(keyVectors.size() == 1);
         auto keyValues = (nodeID_t*)keyVectors[0]->values;
         for (auto i = 0u; i < keyVectors[0]->state->selVector->selectedSize; i++) {
             auto pos = keyVectors[0]->state->selVector->selectedPositions[i];
-            while (probeState->probedTuples[i]) {
+            auto key = keyValues[pos];
+            auto currentTuple = probeState->probedTuples[i];
+            while (currentTuple) {
                 assert(numMatchedTuples <= DEFAULT_VECTOR_CAPACITY);
-                auto currentTuple = probeState->probedTuples[i];
+                // Issue the load of the next tuple in the chain before comparing the current one.
+                auto nextTuple = *hashTable->getPrevTuple(currentTuple);
+                if (nextTuple) {
+                    __builtin_prefetch(nextTuple);
+                }
                 probeState->matchedTuples[numMatchedTuples] = currentTuple;
                 probeState->matchedSelVector->selectedPositions[numMatchedTuples] = pos;
-                numMatchedTuples += *(nodeID_t*)currentTuple == keyValues[pos];
-                probeState->probedTuples[i] =
-                    *sharedState->getHashTable()->getPrevTuple(currentTuple);
+                numMatchedTuples += *(nodeID_t*)currentTuple == key;
+                currentTuple = nextTuple;
             }
+            probeState->probedTuples[i] = nullptr;
         }
     }
     probeState->matchedSelVector->selectedSize = numMatchedTuples;
@@ -134,7 +507,7 @@ uint64_t HashJoinProbe::getNextInnerJoinResult() {
         keyVectors[0]->state->selVector->selectedSize = numTuplesToRead;
         keyVectors[0]->state->selVector->resetSelectorToValuePosBuffer();
     }
-    sharedState->getHashTable()->lookup(vectorsToReadInto, columnIdxsToReadFrom,
+    hashTable->lookup(vectorsToReadInto, columnIdxsToReadFrom,
         probeState->matchedTuples.get(), probeState->nextMatchedTupleIdx, numTuplesToRead);
     probeState->nextMatchedTupleIdx += numTuplesToRead;
     return numTuplesToRead;
@@ -199,5 +572,18 @@ bool HashJoinProbe::getNextTuples() {
     return true;
 }
 
+void HashJoinProbe::printMetricsToJson(nlohmann::json& json, Profiler& profiler) {
+    printTimeAndNumOutputMetrics(json, profiler);
+    json["numSpilledPartitions"] =
+        profiler.sumAllNumericMetricsWithKey(getNumSpilledPartitionsMetricKey());
+}
+
+vector<string> HashJoinProbe::getAttributes(Profiler& profiler) const {
+    auto attributes = PhysicalOperator::getAttributes(profiler);
+    attributes.emplace_back("NumSpilledPartitions: " +
+        to_string(profiler.sumAllNumericMetricsWithKey(getNumSpilledPartitionsMetricKey())));
+    return attributes;
+}
+
 } // namespace processor
 } // namespace kuzu
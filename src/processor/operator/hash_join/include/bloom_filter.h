@@ -0,0 +1,67 @@
+#pragma once
+
+#include <memory>
+
+#include "src/common/types/include/types.h"
+
+using namespace kuzu::common;
+using namespace std;
+
+namespace kuzu {
+namespace processor {
+
+// A split block bloom filter. Each key sets one bit in each of the 8 words of a 256-bit block, so
+// both insertion and lookup touch a single cache line. The block is chosen by the high 32 bits of
+// the hash and the bits inside the block by the low 32 bits, which keeps it independent of the
+// slot idx of the join hash table (computed from the low bits only).
+class BloomFilter {
+public:
+    explicit BloomFilter(uint64_t numKeys);
+
+    inline void insert(hash_t hash) {
+        auto block = getBlock(hash);
+        for (auto i = 0u; i < NUM_WORDS_PER_BLOCK; i++) {
+            block[i] |= getBitInWord(hash, i);
+        }
+    }
+    // Same as insert, but safe to call concurrently from multiple threads.
+    inline void insertAtomically(hash_t hash) {
+        auto block = getBlock(hash);
+        for (auto i = 0u; i < NUM_WORDS_PER_BLOCK; i++) {
+            __atomic_fetch_or(&block[i], getBitInWord(hash, i), __ATOMIC_RELAXED);
+        }
+    }
+    inline bool mayContain(hash_t hash) const {
+        auto block = getBlock(hash);
+        for (auto i = 0u; i < NUM_WORDS_PER_BLOCK; i++) {
+            if (!(block[i] & getBitInWord(hash, i))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    inline uint32_t* getBlock(hash_t hash) const {
+        return blocks.get() + ((hash >> 32) & blockIdxMask) * NUM_WORDS_PER_BLOCK;
+    }
+    static inline uint32_t getBitInWord(hash_t hash, uint32_t wordIdx) {
+        return 1u << (((uint32_t)hash * SALTS[wordIdx]) >> 27);
+    }
+
+public:
+    static constexpr uint32_t NUM_BITS_PER_KEY = 16;
+
+private:
+    static constexpr uint32_t NUM_WORDS_PER_BLOCK = 8;
+    static constexpr uint32_t NUM_BITS_PER_BLOCK = NUM_WORDS_PER_BLOCK * 32;
+    // Odd constants used to derive one bit idx per word from a single 32-bit hash.
+    static constexpr uint32_t SALTS[NUM_WORDS_PER_BLOCK] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU,
+        0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+    uint64_t blockIdxMask;
+    unique_ptr<uint32_t[]> blocks;
+};
+
+} // namespace processor
+} // namespace kuzu
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <condition_variable>
+
 #include "join_hash_table.h"
 
 #include "src/function/hash/operations/include/hash_operations.h"
@@ -13,32 +15,114 @@ using namespace kuzu::function::operation;
 namespace kuzu {
 namespace processor {
 
+// Counts the blocks of build side tuples that the hash joins of a query hold in memory, so that
+// their builds share a single memory budget. Build sides on the same probe pipeline are built
+// concurrently, and the hash tables of all hash joins are held in memory until the query ends.
+class HashJoinBuildMemoryUsage {
+public:
+    inline uint64_t increaseNumBlocksInMemory(uint64_t numBlocks) {
+        return numBlocksInMemory.fetch_add(numBlocks) + numBlocks;
+    }
+    inline void decreaseNumBlocksInMemory(uint64_t numBlocks) {
+        numBlocksInMemory.fetch_sub(numBlocks);
+    }
+    // Set by every build thread at init, which all compute the same budget.
+    inline void setMemoryBudgetInBlocks(uint64_t numBlocks) { memoryBudgetInBlocks = numBlocks; }
+    inline uint64_t getMemoryBudgetInBlocks() const { return memoryBudgetInBlocks; }
+
+private:
+    atomic<uint64_t> numBlocksInMemory{0};
+    atomic<uint64_t> memoryBudgetInBlocks{UINT64_MAX};
+};
+
 // This is a shared state between HashJoinBuild and HashJoinProbe operators.
 // Each clone of these two operators will share the same state.
 // Inside the state, we keep the materialized tuples in factorizedTable, which are merged by each
 // HashJoinBuild thread when they finished materializing thread-local tuples. Also, the state holds
 // a global htDirectory, which will be updated by the last thread in the hash join build side
 // task/pipeline, and probed by the HashJoinProbe operators.
+// If spilling is enabled and the build side tuples exceed the memory budget, all build side tuples
+// are hash partitioned to disk and only the first partition is loaded into the global hash table,
+// unless it exceeds the budget on its own. Probe threads then defer the probe side tuples of the
+// other partitions to disk as well, and join the spilled partitions pair by pair once all of them
+// are done with the resident partition.
 class HashJoinSharedState {
 public:
     explicit HashJoinSharedState(vector<DataType> payloadDataTypes)
-        : payloadDataTypes{move(payloadDataTypes)} {}
+        : payloadDataTypes{move(payloadDataTypes)}, isBloomFilterEnabled{false},
+          isSpillingEnabled{false}, hasSpilled{false}, hasResidentPartition{false},
+          numThreadsProbingResidentPartition{0}, isResidentPartitionProbed{false},
+          nextSpilledPartitionIdx{0} {}
 
     virtual ~HashJoinSharedState() = default;
 
     virtual void initEmptyHashTableIfNecessary(MemoryManager& memoryManager, uint64_t numKeyColumns,
         unique_ptr<FactorizedTableSchema> tableSchema);
 
-    void mergeLocalHashTable(JoinHashTable& localHashTable);
+    // Returns false without merging if the build side has spilled, in which case the caller has
+    // to spill its local tuples instead.
+    bool mergeLocalHashTable(JoinHashTable& localHashTable);
 
     inline JoinHashTable* getHashTable() { return hashTable.get(); }
 
     inline vector<DataType> getPayloadDataTypes() { return payloadDataTypes; }
 
+    // Set by the mapper if a SemiJoinFilter is pushed into the probe side pipeline.
+    inline void enableBloomFilter() { isBloomFilterEnabled = true; }
+    inline bool getIsBloomFilterEnabled() const { return isBloomFilterEnabled; }
+
+    // Set by the mapper if the tuples of both sides can be spilled as they are, i.e. they only have
+    // flat columns of fixed size data types. The hash joins of a plan share their buildMemoryUsage.
+    inline void enableSpilling(shared_ptr<HashJoinBuildMemoryUsage> buildMemoryUsage_) {
+        isSpillingEnabled = true;
+        buildMemoryUsage = move(buildMemoryUsage_);
+    }
+    inline bool getIsSpillingEnabled() const { return isSpillingEnabled; }
+    inline HashJoinBuildMemoryUsage* getBuildMemoryUsage() { return buildMemoryUsage.get(); }
+    // Spills the global hash table, after which all build side tuples go to disk.
+    void startSpilling(const string& spillDirPath, MemoryManager& memoryManager);
+    // Loads the first partition into the global hash table once the build side has spilled, if it
+    // fits into the memory budget. Otherwise, the global hash table is left empty and the first
+    // partition is joined like the other spilled partitions.
+    void loadResidentPartition();
+    inline bool getHasSpilled() const { return hasSpilled.load(); }
+    inline bool isResidentPartition(uint32_t partitionIdx) const {
+        return partitionIdx == 0 && hasResidentPartition;
+    }
+    inline SpilledPartitions* getSpilledBuildPartitions() { return spilledBuildPartitions.get(); }
+    inline SpilledPartitions* getSpilledProbePartitions() { return spilledProbePartitions.get(); }
+
+    // Probe threads register themselves at init and finish the resident partition once their
+    // probe side is exhausted. The resident partition is probed once all registered threads have
+    // finished it, after which the spilled probe partitions are read, so no thread can register
+    // anymore. Returns false for a thread that inits after that. Such a thread must not get any
+    // probe side tuples, because they could no longer be spilled.
+    bool registerProbeThread();
+    void finishProbingResidentPartition();
+    void waitForResidentPartitionToBeProbed();
+    // Returns UINT32_MAX if all spilled partitions have been claimed.
+    inline uint32_t getNextSpilledPartitionIdx() {
+        auto partitionIdx = nextSpilledPartitionIdx.fetch_add(1);
+        return partitionIdx < HashJoinConfig::NUM_SPILL_PARTITIONS ? partitionIdx : UINT32_MAX;
+    }
+
 protected:
     mutex hashJoinSharedStateMutex;
     unique_ptr<JoinHashTable> hashTable;
     vector<DataType> payloadDataTypes;
+    bool isBloomFilterEnabled;
+
+private:
+    bool isSpillingEnabled;
+    shared_ptr<HashJoinBuildMemoryUsage> buildMemoryUsage;
+    atomic<bool> hasSpilled;
+    bool hasResidentPartition;
+    unique_ptr<SpilledPartitions> spilledBuildPartitions;
+    unique_ptr<SpilledPartitions> spilledProbePartitions;
+    condition_variable residentPartitionProbedCV;
+    uint64_t numThreadsProbingResidentPartition;
+    bool isResidentPartitionProbed;
+    atomic<uint32_t> nextSpilledPartitionIdx;
 };
 
 struct BuildDataInfo {
@@ -64,8 +148,8 @@ class HashJoinBuild : public Sink {
 public:
     HashJoinBuild(shared_ptr<HashJoinSharedState> sharedState, const BuildDataInfo& buildDataInfo,
         unique_ptr<PhysicalOperator> child, uint32_t id, const string& paramsString)
-        : Sink{move(child), id, paramsString}, sharedState{move(sharedState)}, buildDataInfo{
-                                                                                   buildDataInfo} {}
+        : Sink{move(child), id, paramsString}, sharedState{move(sharedState)},
+          buildDataInfo{buildDataInfo}, numLocalBlocksCounted{0} {}
     ~HashJoinBuild() override = default;
 
     inline PhysicalOperatorType getOperatorType() override { return HASH_JOIN_BUILD; }
@@ -73,7 +157,13 @@ public:
     shared_ptr<ResultSet> init(ExecutionContext* context) override;
 
     void execute(ExecutionContext* context) override;
+    // Loads the resident partition if the build side has spilled and allocates the hash slots,
+    // which are then built by all threads in finalizeInParallel().
     void finalize(ExecutionContext* context) override;
+    inline bool hasParallelFinalize() override { return true; }
+    inline void finalizeInParallel(ExecutionContext* context) override {
+        sharedState->getHashTable()->buildHashSlotsInParallel();
+    }
 
     inline unique_ptr<PhysicalOperator> clone() override {
         return make_unique<HashJoinBuild>(
@@ -85,11 +175,19 @@ protected:
         MemoryManager& memoryManager, unique_ptr<FactorizedTableSchema> tableSchema);
     inline void appendVectors() { hashTable->append(vectorsToAppend); }
 
+private:
+    void spillLocalHashTableIfNecessary(ExecutionContext* context);
+    void spillLocalHashTable(MemoryManager& memoryManager);
+
 protected:
     shared_ptr<HashJoinSharedState> sharedState;
     BuildDataInfo buildDataInfo;
     vector<shared_ptr<ValueVector>> vectorsToAppend;
     unique_ptr<JoinHashTable> hashTable;
+
+private:
+    uint64_t numLocalBlocksCounted;
+    unique_ptr<SpillPartitionWriter> spillPartitionWriter;
 };
 
 } // namespace processor
@@ -26,6 +26,64 @@ struct ProbeState {
     sel_t nextMatchedTupleIdx;
 };
 
+// Spilled partitions of the build and probe side that a probe thread has repartitioned, because
+// the build side partition they were split from exceeded the memory budget.
+struct RepartitionedPartitions {
+    unique_ptr<SpilledPartitions> buildPartitions;
+    unique_ptr<SpilledPartitions> probePartitions;
+    uint32_t nextPartitionIdx = 0;
+};
+
+// Thread-local state of a probe whose build side has spilled. Probe side tuples that do not belong
+// to the resident partition are flattened into tuplesToSpill and deferred to the spilled probe
+// partitions. Once all threads are done with the resident partition, each thread claims spilled
+// partitions, builds a hash table of the build side partition and replays the probe side partition
+// into the probe side vectors. A build side partition that exceeds the memory budget is
+// repartitioned together with its probe side partition by the thread that claimed it, which then
+// joins the resulting partitions before it claims the next one.
+struct ProbeSpillState {
+    explicit ProbeSpillState()
+        : isProbingResidentPartition{false}, isProbingSpilledPartitions{false},
+          buildPartitions{nullptr}, probePartitions{nullptr},
+          partitionIdx{UINT32_MAX} {
+        tuplesToRead = make_unique<uint8_t*[]>(DEFAULT_VECTOR_CAPACITY);
+        positionsInPartitions.resize(HashJoinConfig::NUM_SPILL_PARTITIONS);
+    }
+
+    // Probe side vectors, in the order of the columns in tuplesToSpill.
+    vector<shared_ptr<ValueVector>> vectors;
+    vector<shared_ptr<ValueVector>> flatVectors;
+    vector<uint32_t> flatColIdxes;
+    vector<shared_ptr<ValueVector>> unflatVectors;
+    vector<uint32_t> unflatColIdxes;
+    vector<DataChunkState*> flatStates;
+    DataChunkState* unflatState = nullptr;
+    MemoryManager* memoryManager = nullptr;
+    string spillDirPath;
+    unique_ptr<FactorizedTable> tuplesToSpill;
+    // Columns of the probe side keys in tuplesToSpill.
+    vector<uint32_t> keyColIdxes;
+    unique_ptr<SpillPartitionWriter> spillPartitionWriter;
+    // Positions of unflat keys grouped by their partitions.
+    vector<vector<sel_t>> positionsInPartitions;
+    vector<sel_t> positionsToProbe;
+    // Set if the thread is registered to probe the resident partition. Threads that init after the
+    // resident partition has been probed are not, and start with the spilled partitions.
+    bool isProbingResidentPartition;
+    bool isProbingSpilledPartitions;
+    // A stack of the partitions repartitioned by this thread, with the deepest level on top.
+    vector<RepartitionedPartitions> repartitionedPartitions;
+    // The partitions that the partition being joined belongs to.
+    SpilledPartitions* buildPartitions;
+    SpilledPartitions* probePartitions;
+    uint32_t partitionIdx;
+    unique_ptr<JoinHashTable> hashTable;
+    uint64_t nextBlockIdx = 0;
+    unique_ptr<DataBlock> block;
+    uint32_t nextTupleIdxInBlock = 0;
+    unique_ptr<uint8_t*[]> tuplesToRead;
+};
+
 struct ProbeDataInfo {
 
 public:
@@ -37,12 +95,18 @@ public:
     ProbeDataInfo(const ProbeDataInfo& other)
         : ProbeDataInfo{other.keysDataPos, other.payloadsOutputDataPos} {
         markDataPos = other.markDataPos;
+        probeSideDataPos = other.probeSideDataPos;
+        isProbeSideVectorFlat = other.isProbeSideVectorFlat;
     }
 
 public:
     vector<DataPos> keysDataPos;
     vector<DataPos> payloadsOutputDataPos;
     DataPos markDataPos;
+    // All vectors produced by the probe side pipeline, which are spilled together with the keys.
+    // Only set if spilling is enabled.
+    vector<DataPos> probeSideDataPos;
+    vector<bool> isProbeSideVectorFlat;
 };
 
 // Probe side on left, i.e. children[0] and build side on right, i.e. children[1]
@@ -55,7 +119,8 @@ public:
         : PhysicalOperator{std::move(probeChild), std::move(buildChild), id, paramsString},
           FilteringOperator{probeDataInfo.keysDataPos.size()},
           sharedState{std::move(sharedState)}, joinType{joinType},
-          flatDataChunkPositions{std::move(flatDataChunkPositions)}, probeDataInfo{probeDataInfo} {}
+          flatDataChunkPositions{std::move(flatDataChunkPositions)}, probeDataInfo{probeDataInfo},
+          hashTable{nullptr} {}
 
     // This constructor is used for cloning only.
     // HashJoinProbe do not need to clone hashJoinBuild which is on a different pipeline.
@@ -65,7 +130,10 @@ public:
         : PhysicalOperator{std::move(probeChild), id, paramsString},
           FilteringOperator{probeDataInfo.keysDataPos.size()},
           sharedState{std::move(sharedState)}, joinType{joinType},
-          flatDataChunkPositions{std::move(flatDataChunkPositions)}, probeDataInfo{probeDataInfo} {}
+          flatDataChunkPositions{std::move(flatDataChunkPositions)}, probeDataInfo{probeDataInfo},
+          hashTable{nullptr} {}
+
+    ~HashJoinProbe() override;
 
     inline PhysicalOperatorType getOperatorType() override { return HASH_JOIN_PROBE; }
 
@@ -78,8 +146,17 @@ public:
             probeDataInfo, children[0]->clone(), id, paramsString);
     }
 
+    void printMetricsToJson(nlohmann::json& json, Profiler& profiler) override;
+
+    vector<string> getAttributes(Profiler& profiler) const override;
+
 private:
+    inline string getNumSpilledPartitionsMetricKey() const {
+        return "numSpilledPartitions-" + to_string(id);
+    }
+
     bool hasMoreLeft();
+    bool getNextProbeTuples();
     bool getNextBatchOfMatchedTuples();
     uint64_t getNextInnerJoinResult();
     uint64_t getNextLeftJoinResult();
@@ -88,6 +165,20 @@ private:
 
     uint64_t getNextJoinResult();
 
+    void initSpillState(ExecutionContext* context);
+    // Defers probe tuples of non-resident partitions to disk. Returns false if no probe tuple of
+    // the resident partition is left.
+    bool spillNonResidentProbeTuples();
+    void spillProbeTuples(uint32_t partitionIdx);
+    void finishProbingResidentPartition();
+    void startProbingSpilledPartitions();
+    bool getNextSpilledProbeTuples();
+    bool loadNextSpilledPartition();
+    bool claimNextSpilledPartition();
+    void repartitionSpilledPartition();
+    void readSpilledProbeTuples();
+    bool hasSameFlatValues(const uint8_t* tuple, const uint8_t* otherTuple) const;
+
 private:
     shared_ptr<HashJoinSharedState> sharedState;
     JoinType joinType;
@@ -100,6 +191,10 @@ private:
     vector<SelectionVector*> keySelVectors;
     shared_ptr<ValueVector> markVector;
     unique_ptr<ProbeState> probeState;
+    // The global hash table, or the hash table of the spilled partition being probed.
+    JoinHashTable* hashTable;
+    unique_ptr<ProbeSpillState> spillState;
+    NumericMetric* numSpilledPartitions;
 };
 
 } // namespace processor
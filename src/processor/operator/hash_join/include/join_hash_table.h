@@ -1,5 +1,10 @@
 #pragma once
 
+#include <atomic>
+
+#include "bloom_filter.h"
+#include "spilled_partitions.h"
+
 #include "src/common/include/utils.h"
 #include "src/function/hash/operations/include/hash_operations.h"
 #include "src/processor/operator/include/base_hash_table.h"
@@ -20,8 +25,20 @@ public:
 
     virtual void append(const vector<shared_ptr<ValueVector>>& vectorsToAppend);
     void allocateHashSlots(uint64_t numTuples);
+    // The bloom filter is populated together with hash slots, so it has to be allocated before
+    // buildHashSlots is called. Only single key joins are supported.
+    void allocateBloomFilter(uint64_t numTuples);
     void buildHashSlots();
+    // Can be called by multiple threads at the same time, which then share the tuple blocks to
+    // insert. Hash slots have to be allocated before.
+    void buildHashSlotsInParallel();
     void probe(const vector<shared_ptr<ValueVector>>& keyVectors, uint8_t** probedTuples);
+    // Appends all tuples to the first level partitions of their keys and clears the table.
+    void spillTuples(SpillPartitionWriter& spillPartitionWriter);
+    // Replaces the tuples of the table with the ones of a spilled partition. Hash slots have to be
+    // allocated and built afterwards.
+    void loadSpilledPartition(const SpilledPartitions& spilledPartitions, uint32_t partitionIdx);
+    hash_t hashKeys(const nodeID_t* nodeIDs) const;
 
     inline void lookup(vector<shared_ptr<ValueVector>>& vectors, vector<uint32_t>& colIdxesToScan,
         uint8_t** tuplesToRead, uint64_t startPos, uint64_t numTuplesToRead) {
@@ -37,15 +54,18 @@ public:
         return ((uint8_t**)(hashSlotsBlocks[slotIdx >> numSlotsPerBlockLog2]
                                 ->getData()))[slotIdx & slotIdxInBlockMask];
     }
+    inline BloomFilter* getBloomFilter() { return bloomFilter.get(); }
     inline FactorizedTable* getFactorizedTable() { return factorizedTable.get(); }
     inline const FactorizedTableSchema* getTableSchema() {
         return factorizedTable->getTableSchema();
     }
 
 protected:
-    uint8_t** findHashSlot(nodeID_t* nodeIDs) const;
+    uint8_t** findHashSlot(hash_t hash) const;
     // This function returns the pointer that previously stored in the same slot.
-    uint8_t* insertEntry(uint8_t* tuple) const;
+    uint8_t* insertEntry(uint8_t* tuple);
+    // Same as insertEntry, but safe to call concurrently from multiple threads.
+    uint8_t* insertEntryAtomically(uint8_t* tuple);
 
     // This function returns a boolean flag indicating if there is non-null keys after discarding.
     static bool discardNullFromKeys(
@@ -54,6 +74,8 @@ protected:
 private:
     uint64_t numKeyColumns;
     uint64_t colOffsetOfPrevPtrInTuple;
+    unique_ptr<BloomFilter> bloomFilter;
+    atomic<uint64_t> nextTupleBlockIdxToBuild;
 };
 
 } // namespace processor
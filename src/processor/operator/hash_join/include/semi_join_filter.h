@@ -0,0 +1,55 @@
+#pragma once
+
+#include "src/processor/operator/hash_join/include/hash_join_build.h"
+#include "src/processor/operator/include/filtering_operator.h"
+#include "src/processor/operator/include/physical_operator.h"
+
+namespace kuzu {
+namespace processor {
+
+// SemiJoinFilter sits on the probe side pipeline of an inner hash join, right after the operator
+// that produces the join key, and drops tuples whose key is not in the bloom filter built together
+// with the hash table. This saves the property scans and list reads between the key producer and
+// the hash join probe for tuples that cannot find a match anyway.
+class SemiJoinFilter : public PhysicalOperator, public FilteringOperator {
+
+public:
+    SemiJoinFilter(const DataPos& keyDataPos, unique_ptr<PhysicalOperator> child, uint32_t id,
+        const string& paramsString)
+        : PhysicalOperator{std::move(child), id, paramsString},
+          FilteringOperator{1 /* numStatesToSave */}, keyDataPos{keyDataPos}, bloomFilter{nullptr} {
+    }
+
+    SemiJoinFilter(const SemiJoinFilter& other)
+        : PhysicalOperator{other.children[0]->clone(), other.id, other.paramsString},
+          FilteringOperator{1 /* numStatesToSave */}, keyDataPos{other.keyDataPos},
+          hashJoinSharedState{other.hashJoinSharedState}, bloomFilter{nullptr} {}
+
+    inline void setSharedState(shared_ptr<HashJoinSharedState> sharedState) {
+        hashJoinSharedState = std::move(sharedState);
+    }
+
+    inline PhysicalOperatorType getOperatorType() override { return SEMI_JOIN_FILTER; }
+
+    shared_ptr<ResultSet> init(ExecutionContext* context) override;
+
+    bool getNextTuples() override;
+
+    inline unique_ptr<PhysicalOperator> clone() override {
+        return make_unique<SemiJoinFilter>(*this);
+    }
+
+private:
+    bool selectKeysInBloomFilter();
+
+private:
+    DataPos keyDataPos;
+    shared_ptr<HashJoinSharedState> hashJoinSharedState;
+    shared_ptr<ValueVector> keyVector;
+    // The bloom filter is populated when the hash join build is finalized, which happens before
+    // the probe side pipeline starts, so it can be cached during init.
+    BloomFilter* bloomFilter;
+};
+
+} // namespace processor
+} // namespace kuzu
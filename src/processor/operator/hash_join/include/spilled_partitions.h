@@ -0,0 +1,103 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+
+#include "src/common/include/configs.h"
+#include "src/processor/result/include/factorized_table.h"
+#include "src/storage/buffer_manager/include/file_handle.h"
+
+using namespace kuzu::common;
+using namespace kuzu::storage;
+using namespace std;
+
+namespace kuzu {
+namespace processor {
+
+class SpillPartitionWriter;
+
+// Tuples of a hash join that are spilled to disk. Tuples are hash partitioned on their keys and
+// written to a temporary file in the spill directory of the database, one page of tuples of the
+// same partition at a time. Pages of different partitions interleave in the file, so we keep for
+// each partition its pages and the number of tuples in each of them. The file is removed when the
+// partitions are destroyed.
+class SpilledPartitions {
+    struct SpilledPartition {
+        vector<page_idx_t> pageIdxes;
+        vector<uint32_t> numTuplesInPages;
+    };
+
+public:
+    SpilledPartitions(string filePath, uint32_t level);
+    ~SpilledPartitions();
+
+    // Both functions can be called concurrently. Pages are not read before all of them have been
+    // written.
+    void writePage(uint32_t partitionIdx, const uint8_t* data, uint32_t numTuples);
+    // Returns the number of tuples in the page.
+    uint32_t readPage(uint32_t partitionIdx, uint64_t pageIdxInPartition, uint8_t* data) const;
+    // Appends the tuples of a partition to the partitions of the next level, which are given by
+    // getPartitionIdx for each tuple.
+    void repartition(uint32_t partitionIdx, uint32_t numBytesPerTuple,
+        SpillPartitionWriter& spillPartitionWriter,
+        const std::function<uint32_t(const uint8_t*)>& getPartitionIdx) const;
+
+    inline uint32_t getLevel() const { return level; }
+    inline uint64_t getNumPages(uint32_t partitionIdx) const {
+        return partitions[partitionIdx].pageIdxes.size();
+    }
+    // The number of large blocks of a factorized table that the pages of a partition take at most
+    // once they are loaded.
+    inline uint64_t getMaxNumBlocksToLoad(uint32_t partitionIdx) const {
+        // Pages are loaded into a block as long as it has a page of free space left.
+        auto numPagesPerBlock = LARGE_PAGE_SIZE / DEFAULT_PAGE_SIZE;
+        return (getNumPages(partitionIdx) + numPagesPerBlock - 1) / numPagesPerBlock;
+    }
+
+    // Partitions of a level are split by the next NUM_SPILL_PARTITIONS_LOG_2 bits of the hashes
+    // when they are repartitioned, so the first level uses the most significant bits.
+    static inline uint32_t getPartitionIdx(hash_t hash, uint32_t level) {
+        return (hash << (level * HashJoinConfig::NUM_SPILL_PARTITIONS_LOG_2)) >>
+               (sizeof(hash_t) * 8 - HashJoinConfig::NUM_SPILL_PARTITIONS_LOG_2);
+    }
+    static constexpr uint32_t MAX_LEVEL =
+        sizeof(hash_t) * 8 / HashJoinConfig::NUM_SPILL_PARTITIONS_LOG_2 - 1;
+
+private:
+    mutex mtx;
+    string filePath;
+    uint32_t level;
+    unique_ptr<FileHandle> fileHandle;
+    vector<SpilledPartition> partitions;
+};
+
+// A thread-local writer of SpilledPartitions. Tuples are copied into a page buffer per partition,
+// which is written out once it is full. The page buffers of all partitions share a single block
+// of the memory manager.
+class SpillPartitionWriter {
+    static_assert(HashJoinConfig::NUM_SPILL_PARTITIONS * DEFAULT_PAGE_SIZE <= LARGE_PAGE_SIZE);
+
+public:
+    SpillPartitionWriter(SpilledPartitions& spilledPartitions, uint32_t numBytesPerTuple,
+        MemoryManager& memoryManager);
+
+    void append(uint32_t partitionIdx, const uint8_t* tuple);
+    // Writes out the partially filled buffers. This must be called once the thread is done with
+    // appending tuples.
+    void flush();
+
+private:
+    inline uint8_t* getBuffer(uint32_t partitionIdx) const {
+        return buffers.getData() + partitionIdx * DEFAULT_PAGE_SIZE;
+    }
+
+private:
+    SpilledPartitions& spilledPartitions;
+    uint32_t numBytesPerTuple;
+    uint32_t numTuplesPerPage;
+    DataBlock buffers;
+    vector<uint32_t> numTuplesInBuffers;
+};
+
+} // namespace processor
+} // namespace kuzu
@@ -7,7 +7,7 @@ namespace processor {
 
 JoinHashTable::JoinHashTable(MemoryManager& memoryManager, uint64_t numKeyColumns,
     unique_ptr<FactorizedTableSchema> tableSchema)
-    : BaseHashTable{memoryManager}, numKeyColumns{numKeyColumns} {
+    : BaseHashTable{memoryManager}, numKeyColumns{numKeyColumns}, nextTupleBlockIdxToBuild{0} {
     auto numSlotsPerBlock = LARGE_PAGE_SIZE / sizeof(uint8_t*);
     assert(numSlotsPerBlock == HashTableUtils::nextPowerOfTwo(numSlotsPerBlock));
     numSlotsPerBlockLog2 = log2(numSlotsPerBlock);
@@ -57,6 +57,7 @@ void JoinHashTable::append(const vector<shared_ptr<ValueVector>>& vectorsToAppen
 void JoinHashTable::allocateHashSlots(uint64_t numTuples) {
     maxNumHashSlots = HashTableUtils::nextPowerOfTwo(numTuples * 2);
     bitmask = maxNumHashSlots - 1;
+    nextTupleBlockIdxToBuild = 0;
     auto numSlotsPerBlock = (uint64_t)1 << numSlotsPerBlockLog2;
     auto numBlocksNeeded = (maxNumHashSlots + numSlotsPerBlock - 1) / numSlotsPerBlock;
     while (hashSlotsBlocks.size() < numBlocksNeeded) {
@@ -64,6 +65,11 @@ void JoinHashTable::allocateHashSlots(uint64_t numTuples) {
     }
 }
 
+void JoinHashTable::allocateBloomFilter(uint64_t numTuples) {
+    assert(numKeyColumns == 1);
+    bloomFilter = make_unique<BloomFilter>(numTuples);
+}
+
 void JoinHashTable::buildHashSlots() {
     for (auto& tupleBlock : factorizedTable->getTupleDataBlocks()) {
         uint8_t* tuple = tupleBlock->getData();
@@ -76,6 +82,25 @@ void JoinHashTable::buildHashSlots() {
     }
 }
 
+void JoinHashTable::buildHashSlotsInParallel() {
+    // Each thread grabs one tuple block at a time and prepends its tuples to the chains of their
+    // slots. The prev pointer of a tuple is only written by the thread that inserts it, so the
+    // chains are complete once all threads are done.
+    auto& tupleBlocks = factorizedTable->getTupleDataBlocks();
+    auto numBytesPerTuple = factorizedTable->getTableSchema()->getNumBytesPerTuple();
+    auto blockIdx = nextTupleBlockIdxToBuild.fetch_add(1, memory_order_relaxed);
+    while (blockIdx < tupleBlocks.size()) {
+        auto& tupleBlock = tupleBlocks[blockIdx];
+        uint8_t* tuple = tupleBlock->getData();
+        for (auto i = 0u; i < tupleBlock->numTuples; i++) {
+            auto lastSlotEntryInHT = insertEntryAtomically(tuple);
+            memcpy(getPrevTuple(tuple), &lastSlotEntryInHT, sizeof(uint8_t*));
+            tuple += numBytesPerTuple;
+        }
+        blockIdx = nextTupleBlockIdxToBuild.fetch_add(1, memory_order_relaxed);
+    }
+}
+
 void JoinHashTable::probe(
     const vector<shared_ptr<ValueVector>>& keyVectors, uint8_t** probedTuples) {
     assert(keyVectors.size() == numKeyColumns);
@@ -96,14 +121,68 @@ void JoinHashTable::probe(
     }
     auto hashes = (hash_t*)hashVector->values;
     auto startIdx = hashVector->state->isFlat() ? hashVector->state->currIdx : 0;
-    auto numValues = hashVector->state->isFlat() ? 1 : hashVector->state->selVector->selectedSize;
+    uint64_t numValues =
+        hashVector->state->isFlat() ? 1 : hashVector->state->selVector->selectedSize;
+    // Group prefetching: we first prefetch the hash slots of all keys, then read the slots and
+    // prefetch the tuples they point to. This overlaps the cache misses of different keys instead
+    // of paying for them one after another. probedTuples temporarily holds the slot addresses.
     for (auto i = 0u; i < numValues; i++) {
         auto pos = hashVector->state->selVector->selectedPositions[i + startIdx];
-        probedTuples[i] = getTupleForHash(hashes[pos]);
+        auto slot = findHashSlot(hashes[pos]);
+        __builtin_prefetch(slot);
+        probedTuples[i] = (uint8_t*)slot;
+    }
+    for (auto i = 0u; i < numValues; i++) {
+        probedTuples[i] = *(uint8_t**)probedTuples[i];
+        if (probedTuples[i] != nullptr) {
+            __builtin_prefetch(probedTuples[i]);
+        }
+    }
+}
+
+void JoinHashTable::spillTuples(SpillPartitionWriter& spillPartitionWriter) {
+    auto numBytesPerTuple = factorizedTable->getTableSchema()->getNumBytesPerTuple();
+    for (auto& tupleBlock : factorizedTable->getTupleDataBlocks()) {
+        uint8_t* tuple = tupleBlock->getData();
+        for (auto i = 0u; i < tupleBlock->numTuples; i++) {
+            spillPartitionWriter.append(
+                SpilledPartitions::getPartitionIdx(hashKeys((nodeID_t*)tuple), 0 /* level */),
+                tuple);
+            tuple += numBytesPerTuple;
+        }
     }
+    factorizedTable->clear();
 }
 
-uint8_t** JoinHashTable::findHashSlot(nodeID_t* nodeIDs) const {
+void JoinHashTable::loadSpilledPartition(
+    const SpilledPartitions& spilledPartitions, uint32_t partitionIdx) {
+    factorizedTable->clear();
+    auto numBytesPerTuple = factorizedTable->getTableSchema()->getNumBytesPerTuple();
+    unique_ptr<DataBlock> block;
+    for (auto pageIdx = 0u; pageIdx < spilledPartitions.getNumPages(partitionIdx); pageIdx++) {
+        // Pages are read directly into the block, so a full page has to fit into its free space.
+        if (block == nullptr || block->freeSize < DEFAULT_PAGE_SIZE) {
+            if (block != nullptr) {
+                factorizedTable->flatTupleBlockCollection->append(move(block));
+            }
+            block = make_unique<DataBlock>(&memoryManager);
+        }
+        auto numTuples = spilledPartitions.readPage(
+            partitionIdx, pageIdx, block->getData() + block->numTuples * numBytesPerTuple);
+        block->numTuples += numTuples;
+        block->freeSize -= numTuples * numBytesPerTuple;
+        factorizedTable->numTuples += numTuples;
+    }
+    if (block != nullptr) {
+        factorizedTable->flatTupleBlockCollection->append(move(block));
+    }
+    // The tuples are written by different threads, so we lose track of which columns have nulls.
+    for (auto i = 0u; i < factorizedTable->tableSchema->getNumColumns(); i++) {
+        factorizedTable->tableSchema->setMayContainsNullsToTrue(i);
+    }
+}
+
+hash_t JoinHashTable::hashKeys(const nodeID_t* nodeIDs) const {
     hash_t hash;
     Hash::operation<nodeID_t>(nodeIDs[0], false /* isNull */, hash);
     for (auto i = 1u; i < numKeyColumns; i++) {
@@ -111,17 +190,36 @@ uint8_t** JoinHashTable::findHashSlot(nodeID_t* nodeIDs) const {
         Hash::operation<nodeID_t>(nodeIDs[i], false /* isNull */, newHash);
         CombineHash::operation(hash, newHash, hash);
     }
+    return hash;
+}
+
+uint8_t** JoinHashTable::findHashSlot(hash_t hash) const {
     auto slotIdx = getSlotIdxForHash(hash);
     return (uint8_t**)(hashSlotsBlocks[slotIdx >> numSlotsPerBlockLog2]->getData() +
                        (slotIdx & slotIdxInBlockMask) * sizeof(uint8_t*));
 }
 
-uint8_t* JoinHashTable::insertEntry(uint8_t* tuple) const {
-    auto slot = findHashSlot((nodeID_t*)tuple);
+uint8_t* JoinHashTable::insertEntry(uint8_t* tuple) {
+    auto hash = hashKeys((nodeID_t*)tuple);
+    if (bloomFilter) {
+        bloomFilter->insert(hash);
+    }
+    auto slot = findHashSlot(hash);
     auto prevPtr = *slot;
     *slot = tuple;
     return prevPtr;
 }
 
+uint8_t* JoinHashTable::insertEntryAtomically(uint8_t* tuple) {
+    auto hash = hashKeys((nodeID_t*)tuple);
+    if (bloomFilter) {
+        bloomFilter->insertAtomically(hash);
+    }
+    auto slot = findHashSlot(hash);
+    // Readers of the slots only start once the task building them has completed, which already
+    // synchronizes memory, so a relaxed exchange is enough here.
+    return __atomic_exchange_n(slot, tuple, __ATOMIC_RELAXED);
+}
+
 } // namespace processor
 } // namespace kuzu
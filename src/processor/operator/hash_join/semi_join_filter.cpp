@@ -0,0 +1,61 @@
+#include "include/semi_join_filter.h"
+
+namespace kuzu {
+namespace processor {
+
+shared_ptr<ResultSet> SemiJoinFilter::init(ExecutionContext* context) {
+    resultSet = PhysicalOperator::init(context);
+    keyVector = resultSet->getValueVector(keyDataPos);
+    assert(keyVector->dataType.typeID == NODE_ID);
+    bloomFilter = hashJoinSharedState->getHashTable()->getBloomFilter();
+    return resultSet;
+}
+
+bool SemiJoinFilter::getNextTuples() {
+    metrics->executionTime.start();
+    bool hasAtLeastOneSelectedValue;
+    do {
+        restoreSelVector(keyVector->state->selVector.get());
+        if (!children[0]->getNextTuples()) {
+            metrics->executionTime.stop();
+            return false;
+        }
+        saveSelVector(keyVector->state->selVector.get());
+        hasAtLeastOneSelectedValue = bloomFilter == nullptr || selectKeysInBloomFilter();
+    } while (!hasAtLeastOneSelectedValue);
+    metrics->executionTime.stop();
+    metrics->numOutputTuple.increase(
+        keyVector->state->isFlat() ? 1 : keyVector->state->selVector->selectedSize);
+    return true;
+}
+
+bool SemiJoinFilter::selectKeysInBloomFilter() {
+    auto keyValues = (nodeID_t*)keyVector->values;
+    hash_t hash;
+    if (keyVector->state->isFlat()) {
+        auto pos = keyVector->state->getPositionOfCurrIdx();
+        if (keyVector->isNull(pos)) {
+            return false;
+        }
+        Hash::operation<nodeID_t>(keyValues[pos], false /* isNull */, hash);
+        return bloomFilter->mayContain(hash);
+    }
+    auto selVector = keyVector->state->selVector.get();
+    auto selectedPositionsBuffer = selVector->getSelectedPositionsBuffer();
+    sel_t numSelectedValues = 0;
+    for (auto i = 0u; i < selVector->selectedSize; i++) {
+        auto pos = selVector->selectedPositions[i];
+        if (keyVector->isNull(pos)) {
+            continue;
+        }
+        Hash::operation<nodeID_t>(keyValues[pos], false /* isNull */, hash);
+        selectedPositionsBuffer[numSelectedValues] = pos;
+        numSelectedValues += bloomFilter->mayContain(hash);
+    }
+    selVector->resetSelectorToValuePosBuffer();
+    selVector->selectedSize = numSelectedValues;
+    return numSelectedValues > 0;
+}
+
+} // namespace processor
+} // namespace kuzu
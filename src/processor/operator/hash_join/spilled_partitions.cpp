@@ -0,0 +1,85 @@
+#include "include/spilled_partitions.h"
+
+#include "src/common/include/exception.h"
+#include "src/common/include/file_utils.h"
+
+namespace kuzu {
+namespace processor {
+
+SpilledPartitions::SpilledPartitions(string filePath, uint32_t level)
+    : filePath{move(filePath)}, level{level}, partitions(HashJoinConfig::NUM_SPILL_PARTITIONS) {
+    FileUtils::removeFileIfExists(this->filePath);
+    fileHandle = make_unique<FileHandle>(
+        this->filePath, FileHandle::O_PERSISTENT_FILE_CREATE_NOT_EXISTS);
+}
+
+SpilledPartitions::~SpilledPartitions() {
+    fileHandle.reset();
+    FileUtils::removeFileIfExists(filePath);
+}
+
+void SpilledPartitions::writePage(uint32_t partitionIdx, const uint8_t* data, uint32_t numTuples) {
+    page_idx_t pageIdx;
+    {
+        lock_guard lck{mtx};
+        pageIdx = fileHandle->addNewPage();
+        partitions[partitionIdx].pageIdxes.push_back(pageIdx);
+        partitions[partitionIdx].numTuplesInPages.push_back(numTuples);
+    }
+    fileHandle->writePage(const_cast<uint8_t*>(data), pageIdx);
+}
+
+uint32_t SpilledPartitions::readPage(
+    uint32_t partitionIdx, uint64_t pageIdxInPartition, uint8_t* data) const {
+    auto& partition = partitions[partitionIdx];
+    fileHandle->readPage(data, partition.pageIdxes[pageIdxInPartition]);
+    return partition.numTuplesInPages[pageIdxInPartition];
+}
+
+void SpilledPartitions::repartition(uint32_t partitionIdx, uint32_t numBytesPerTuple,
+    SpillPartitionWriter& spillPartitionWriter,
+    const std::function<uint32_t(const uint8_t*)>& getPartitionIdx) const {
+    auto page = make_unique<uint8_t[]>(DEFAULT_PAGE_SIZE);
+    for (auto pageIdx = 0u; pageIdx < getNumPages(partitionIdx); pageIdx++) {
+        auto numTuples = readPage(partitionIdx, pageIdx, page.get());
+        auto tuple = page.get();
+        for (auto i = 0u; i < numTuples; i++) {
+            spillPartitionWriter.append(getPartitionIdx(tuple), tuple);
+            tuple += numBytesPerTuple;
+        }
+    }
+    spillPartitionWriter.flush();
+}
+
+SpillPartitionWriter::SpillPartitionWriter(
+    SpilledPartitions& spilledPartitions, uint32_t numBytesPerTuple, MemoryManager& memoryManager)
+    : spilledPartitions{spilledPartitions}, numBytesPerTuple{numBytesPerTuple},
+      numTuplesPerPage{(uint32_t)(DEFAULT_PAGE_SIZE / numBytesPerTuple)}, buffers{&memoryManager},
+      numTuplesInBuffers(HashJoinConfig::NUM_SPILL_PARTITIONS, 0) {
+    if (numTuplesPerPage == 0) {
+        throw RuntimeException("Cannot spill hash join tuples of " + to_string(numBytesPerTuple) +
+                               " bytes, which do not fit into a page.");
+    }
+}
+
+void SpillPartitionWriter::append(uint32_t partitionIdx, const uint8_t* tuple) {
+    auto& numTuples = numTuplesInBuffers[partitionIdx];
+    memcpy(getBuffer(partitionIdx) + numTuples * numBytesPerTuple, tuple, numBytesPerTuple);
+    if (++numTuples == numTuplesPerPage) {
+        spilledPartitions.writePage(partitionIdx, getBuffer(partitionIdx), numTuples);
+        numTuples = 0;
+    }
+}
+
+void SpillPartitionWriter::flush() {
+    for (auto partitionIdx = 0u; partitionIdx < numTuplesInBuffers.size(); partitionIdx++) {
+        if (numTuplesInBuffers[partitionIdx] > 0) {
+            spilledPartitions.writePage(
+                partitionIdx, getBuffer(partitionIdx), numTuplesInBuffers[partitionIdx]);
+            numTuplesInBuffers[partitionIdx] = 0;
+        }
+    }
+}
+
+} // namespace processor
+} // namespace kuzu
@@ -11,7 +11,9 @@ using namespace kuzu::evaluator;
 namespace kuzu {
 namespace processor {
 
-// Index scan does not run in parallel. So there is no shared state.
+// Index scan does not run in parallel. So there is no shared state. The index key is either a
+// single key or a list of keys, e.g. for list_contains([0, 5], a.ID), whose nodes are output in
+// an unflat vector.
 class IndexScan : public PhysicalOperator, public SourceOperator {
 public:
     IndexScan(unique_ptr<ResultSetDescriptor> resultSetDescriptor, table_id_t tableID,
@@ -32,6 +34,10 @@ public:
             indexKeyEvaluator->clone(), outDataPos, id, paramsString);
     }
 
+private:
+    bool getNextTuplesOfKeyList();
+    void lookupKeyList();
+
 private:
     table_id_t tableID;
     PrimaryKeyIndex* pkIndex;
@@ -40,6 +46,10 @@ private:
 
     bool hasExecuted = false;
     shared_ptr<ValueVector> outVector;
+    // Only used for a list of keys.
+    shared_ptr<ValueVector> keyVector;
+    vector<node_offset_t> nodeOffsets;
+    uint64_t nextNodeOffsetIdx = 0;
 };
 
 } // namespace processor
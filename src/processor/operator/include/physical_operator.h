@@ -40,6 +40,7 @@ enum PhysicalOperatorType : uint8_t {
     SCAN_NODE_ID,
     SCAN_STRUCTURED_PROPERTY,
     SCAN_UNSTRUCTURED_PROPERTY,
+    SEMI_JOIN_FILTER,
     SEMI_MASKER,
     SET_STRUCTURED_NODE_PROPERTY,
     SET_UNSTRUCTURED_NODE_PROPERTY,
@@ -47,6 +48,7 @@ enum PhysicalOperatorType : uint8_t {
     ORDER_BY,
     ORDER_BY_MERGE,
     ORDER_BY_SCAN,
+    TOP_K,
     UNION_ALL_SCAN,
     UNWIND,
     VAR_LENGTH_ADJ_LIST_EXTEND,
@@ -59,8 +61,9 @@ const string PhysicalOperatorTypeNames[] = {"AGGREGATE", "AGGREGATE_SCAN", "COLU
     "FILTER", "FLATTEN", "HASH_JOIN_BUILD", "HASH_JOIN_PROBE", "INDEX_SCAN", "INTERSECT_BUILD",
     "INTERSECT", "LIMIT", "LIST_EXTEND", "MULTIPLICITY_REDUCER", "PROJECTION", "SCAN_REL_PROPERTY",
     "RESULT_COLLECTOR", "SCAN_NODE_ID", "SCAN_STRUCTURED_PROPERTY", "SCAN_UNSTRUCTURED_PROPERTY",
-    "SEMI_MASKER", "SET_STRUCTURED_NODE_PROPERTY", "SET_UNSTRUCTURED_NODE_PROPERTY", "SKIP",
-    "ORDER_BY", "ORDER_BY_MERGE", "ORDER_BY_SCAN", "UNION_ALL_SCAN", "UNWIND"};
+    "SEMI_JOIN_FILTER", "SEMI_MASKER", "SET_STRUCTURED_NODE_PROPERTY",
+    "SET_UNSTRUCTURED_NODE_PROPERTY", "SKIP", "ORDER_BY", "ORDER_BY_MERGE", "ORDER_BY_SCAN",
+    "TOP_K", "UNION_ALL_SCAN", "UNWIND"};
 
 struct OperatorMetrics {
 
@@ -119,7 +122,7 @@ public:
         return profiler.sumAllNumericMetricsWithKey(getNumTupleMetricKey());
     }
 
-    vector<string> getAttributes(Profiler& profiler) const;
+    virtual vector<string> getAttributes(Profiler& profiler) const;
     inline string getTimeMetricKey() const { return "time-" + to_string(id); }
 
     inline string getParamsString() const { return paramsString; }
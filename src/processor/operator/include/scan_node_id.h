@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <mutex>
 
 #include "src/processor/operator/include/physical_operator.h"
@@ -54,18 +55,42 @@ private:
     unique_ptr<Mask> morselMask;
 };
 
+// A comparison between a structured property of the scanned nodes and a literal, pushed down from
+// a filter in the same pipeline. Morsels whose zone maps rule out any match are skipped.
+struct ZoneMapPredicate {
+    ZoneMapPredicate(Column* column, ExpressionType comparisonType, Literal literal)
+        : column{column}, comparisonType{comparisonType}, literal{move(literal)} {}
+
+    Column* column;
+    ExpressionType comparisonType;
+    Literal literal;
+};
+
+// Morsels are the ranges of DEFAULT_VECTOR_CAPACITY node offsets that start at multiples of
+// DEFAULT_VECTOR_CAPACITY. Threads claim batches of consecutive morsels with an atomic compare and
+// swap, and check whether the morsels of their batch need to be scanned without synchronization.
 class ScanNodeIDSharedState {
 
 public:
     explicit ScanNodeIDSharedState(
         NodesStatisticsAndDeletedIDs* nodesStatisticsAndDeletedIDs, table_id_t tableID)
         : initialized{false}, nodesStatisticsAndDeletedIDs{nodesStatisticsAndDeletedIDs},
-          tableID{tableID}, maxNodeOffset{UINT64_MAX}, maxMorselIdx{UINT64_MAX},
-          currentNodeOffset{0}, numMaskers{0}, semiMask{nullptr} {}
-
-    void initialize(Transaction* transaction);
-
-    pair<uint64_t, uint64_t> getNextRangeToRead();
+          tableID{tableID}, maxNodeOffset{UINT64_MAX}, numMorsels{0}, numThreads{1},
+          nextMorselIdxToClaim{0}, numMaskers{0}, semiMask{nullptr} {}
+
+    void initialize(Transaction* transaction, uint64_t numThreads_);
+
+    // Returns the [start, end) range of the indexes of the claimed morsels, which is empty once all
+    // morsels have been claimed.
+    pair<uint64_t, uint64_t> claimMorsels();
+    // Returns false if the morsel is not selected by the semi mask or if its zone maps rule out
+    // any match of the zone map predicates.
+    bool mayMorselHaveNodesToScan(uint64_t morselIdx) const;
+    inline pair<node_offset_t, node_offset_t> getMorselNodeOffsets(uint64_t morselIdx) const {
+        auto startOffset = morselIdx << DEFAULT_VECTOR_CAPACITY_LOG_2;
+        return make_pair(
+            startOffset, min(startOffset + DEFAULT_VECTOR_CAPACITY, maxNodeOffset + 1));
+    }
 
     void initSemiMask(Transaction* transaction);
 
@@ -76,16 +101,25 @@ public:
     inline uint8_t getNumMaskers() const { return numMaskers; }
     inline void incrementNumMaskers() { numMaskers++; }
 
+    inline void addZoneMapPredicate(ZoneMapPredicate predicate) {
+        zoneMapPredicates.push_back(move(predicate));
+    }
+
+private:
+    bool mayMatchZoneMapPredicates(node_offset_t startOffset, node_offset_t endOffset) const;
+
 private:
     mutex mtx;
     bool initialized;
     NodesStatisticsAndDeletedIDs* nodesStatisticsAndDeletedIDs;
     table_id_t tableID;
     uint64_t maxNodeOffset;
-    uint64_t maxMorselIdx;
-    uint64_t currentNodeOffset;
+    uint64_t numMorsels;
+    uint64_t numThreads;
+    atomic<uint64_t> nextMorselIdxToClaim;
     uint8_t numMaskers;
     unique_ptr<ScanNodeIDSemiMask> semiMask;
+    vector<ZoneMapPredicate> zoneMapPredicates;
 };
 
 class ScanNodeID : public PhysicalOperator, public SourceOperator {
@@ -96,7 +130,8 @@ public:
         shared_ptr<ScanNodeIDSharedState> sharedState, uint32_t id, const string& paramsString)
         : PhysicalOperator{id, paramsString}, SourceOperator{std::move(resultSetDescriptor)},
           nodeName{std::move(nodeName)}, nodeTable{nodeTable}, outDataPos{outDataPos},
-          sharedState{std::move(sharedState)} {}
+          sharedState{std::move(sharedState)}, nextMorselIdx{0}, endMorselIdx{0},
+          numMorselsClaimed{nullptr}, morselClaimTime{nullptr} {}
 
     inline string getNodeName() const { return nodeName; }
     inline ScanNodeIDSharedState* getSharedState() const { return sharedState.get(); }
@@ -116,9 +151,21 @@ public:
         return profiler.sumAllTimeMetricsWithKey(getTimeMetricKey());
     }
 
+    void printMetricsToJson(nlohmann::json& json, Profiler& profiler) override;
+
+    vector<string> getAttributes(Profiler& profiler) const override;
+
 private:
+    // Returns the node offsets of the next morsel of the batch claimed by this thread that may
+    // have nodes to scan, and claims a new batch once the current one is used up.
+    pair<node_offset_t, node_offset_t> getNextRangeToRead();
     void setSelVector(node_offset_t startOffset, node_offset_t endOffset);
 
+    inline string getNumMorselsMetricKey() const { return "numMorsels-" + to_string(id); }
+    inline string getMorselClaimTimeMetricKey() const {
+        return "morselClaimTime-" + to_string(id);
+    }
+
 private:
     string nodeName;
     NodeTable* nodeTable;
@@ -127,6 +174,10 @@ private:
 
     shared_ptr<DataChunk> outDataChunk;
     shared_ptr<ValueVector> outValueVector;
+    uint64_t nextMorselIdx;
+    uint64_t endMorselIdx;
+    NumericMetric* numMorselsClaimed;
+    TimeMetric* morselClaimTime;
 };
 
 } // namespace processor
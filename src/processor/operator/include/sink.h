@@ -19,6 +19,12 @@ public:
 
     virtual void finalize(ExecutionContext* context){};
 
+    // If true, finalizeInParallel() is called by all threads of a task that runs after finalize(),
+    // e.g., to build the hash slots of a hash join. The threads share the work through the shared
+    // state of the sink.
+    virtual bool hasParallelFinalize() { return false; }
+    virtual void finalizeInParallel(ExecutionContext* context){};
+
     unique_ptr<PhysicalOperator> clone() override = 0;
 };
 
@@ -8,16 +8,27 @@ namespace processor {
 shared_ptr<ResultSet> IndexScan::init(ExecutionContext* context) {
     PhysicalOperator::init(context);
     resultSet = populateResultSet();
+    indexKeyEvaluator->init(*resultSet, context->memoryManager);
     auto dataChunk = resultSet->dataChunks[outDataPos.dataChunkPos];
-    dataChunk->state = DataChunkState::getSingleValueDataChunkState();
+    auto& indexKeyDataType = indexKeyEvaluator->resultVector->dataType;
+    if (indexKeyDataType.typeID == LIST) {
+        keyVector = make_shared<ValueVector>(*indexKeyDataType.childType, context->memoryManager);
+        keyVector->state = make_shared<DataChunkState>();
+    } else {
+        dataChunk->state = DataChunkState::getSingleValueDataChunkState();
+    }
     outVector = make_shared<ValueVector>(NODE_ID);
     dataChunk->insert(outDataPos.valueVectorPos, outVector);
-    indexKeyEvaluator->init(*resultSet, context->memoryManager);
     hasExecuted = false;
+    nodeOffsets.clear();
+    nextNodeOffsetIdx = 0;
     return resultSet;
 }
 
 bool IndexScan::getNextTuples() {
+    if (keyVector != nullptr) {
+        return getNextTuplesOfKeyList();
+    }
     metrics->executionTime.start();
     if (hasExecuted) {
         metrics->executionTime.stop();
@@ -39,5 +50,55 @@ bool IndexScan::getNextTuples() {
     return isSuccessfulLookup;
 }
 
+bool IndexScan::getNextTuplesOfKeyList() {
+    metrics->executionTime.start();
+    if (!hasExecuted) {
+        lookupKeyList();
+        hasExecuted = true;
+    }
+    if (nextNodeOffsetIdx == nodeOffsets.size()) {
+        metrics->executionTime.stop();
+        return false;
+    }
+    auto numNodes = min(nodeOffsets.size() - nextNodeOffsetIdx, DEFAULT_VECTOR_CAPACITY);
+    auto nodeIDValues = (nodeID_t*)outVector->values;
+    for (auto i = 0u; i < numNodes; i++) {
+        nodeIDValues[i].tableID = tableID;
+        nodeIDValues[i].offset = nodeOffsets[nextNodeOffsetIdx + i];
+    }
+    nextNodeOffsetIdx += numNodes;
+    outVector->state->initOriginalAndSelectedSize(numNodes);
+    metrics->executionTime.stop();
+    metrics->numOutputTuple.increase(numNodes);
+    return true;
+}
+
+void IndexScan::lookupKeyList() {
+    indexKeyEvaluator->evaluate();
+    auto listVector = indexKeyEvaluator->resultVector.get();
+    assert(listVector->state->isFlat());
+    auto& list = ((ku_list_t*)listVector->values)[listVector->state->getPositionOfCurrIdx()];
+    auto numBytesPerKey = Types::getDataTypeSize(keyVector->dataType);
+    vector<node_offset_t> results(DEFAULT_VECTOR_CAPACITY);
+    auto isFound = make_unique<bool[]>(DEFAULT_VECTOR_CAPACITY);
+    // The keys are looked up a vector at a time, so that the index reads each page of its slots
+    // once for all keys of the vector.
+    for (auto startIdx = 0u; startIdx < list.size; startIdx += DEFAULT_VECTOR_CAPACITY) {
+        auto numKeys = min(list.size - startIdx, DEFAULT_VECTOR_CAPACITY);
+        memcpy(keyVector->values, (uint8_t*)list.overflowPtr + startIdx * numBytesPerKey,
+            numKeys * numBytesPerKey);
+        keyVector->state->initOriginalAndSelectedSize(numKeys);
+        pkIndex->lookup(transaction, keyVector.get(), results.data(), isFound.get());
+        for (auto i = 0u; i < numKeys; i++) {
+            if (isFound[i]) {
+                nodeOffsets.push_back(results[i]);
+            }
+        }
+    }
+    // A key may occur multiple times in the list, but its node is only output once.
+    sort(nodeOffsets.begin(), nodeOffsets.end());
+    nodeOffsets.erase(unique(nodeOffsets.begin(), nodeOffsets.end()), nodeOffsets.end());
+}
+
 } // namespace processor
 } // namespace kuzu
@@ -1,13 +1,16 @@
 #pragma once
 
+#include <atomic>
 #include <queue>
 
 #include "src/common/include/data_chunk/data_chunk_state.h"
 #include "src/common/include/in_mem_overflow_buffer.h"
 #include "src/processor/operator/include/sink.h"
 #include "src/processor/operator/order_by/include/radix_sort.h"
+#include "src/processor/operator/order_by/include/sorted_runs.h"
 #include "src/processor/result/include/factorized_table.h"
 #include "src/processor/result/include/result_set.h"
+#include "src/storage/include/storage_utils.h"
 
 using namespace std;
 using namespace kuzu::common;
@@ -19,21 +22,29 @@ namespace processor {
 // sortedKeyBlocks and the size of each tuple in keyBlocks. The class is shared between the orderBy,
 // orderByMerge, orderByScan operators. All functions are guaranteed to be thread-safe,
 // so caller doesn't need to acquire a lock before calling these functions.
+// If spilling is enabled and the tuples exceed the memory budget, the orderBy threads sort their
+// tuples into runs and spill them to disk, which are merged by the orderByScan instead of being
+// merged by the orderByMerge in memory.
 class SharedFactorizedTablesAndSortedKeyBlocks {
 public:
     explicit SharedFactorizedTablesAndSortedKeyBlocks()
-        : nextFactorizedTableIdx{0}, sortedKeyBlocks{
-                                         make_shared<queue<shared_ptr<MergedKeyBlocks>>>()} {}
+        : isSpillingEnabled{false}, numBlocksInMemory{0}, hasSpilled{false},
+          nextFactorizedTableIdx{0},
+          sortedKeyBlocks{make_shared<queue<shared_ptr<MergedKeyBlocks>>>()} {}
 
     inline DataType getDataType(uint32_t idx) { return dataTypes[idx]; }
 
-    uint8_t getNextFactorizedTableIdx() {
+    uint16_t getNextFactorizedTableIdx() {
         unique_lock lck{orderBySharedStateMutex};
+        if (nextFactorizedTableIdx == UINT16_MAX) {
+            throw RuntimeException("The number of factorizedTables of an orderBy exceeds the "
+                                   "maximum factorizedTableIdx!");
+        }
         return nextFactorizedTableIdx++;
     }
 
     void appendFactorizedTable(
-        uint8_t factorizedTableIdx, shared_ptr<FactorizedTable> factorizedTable) {
+        uint16_t factorizedTableIdx, shared_ptr<FactorizedTable> factorizedTable) {
         unique_lock lck{orderBySharedStateMutex};
         // If the factorizedTables is full, resize the factorizedTables and
         // insert the factorizedTable to the set.
@@ -70,12 +81,37 @@ public:
         this->stringAndUnstructuredKeyColInfo = move(stringAndUnstructuredKeyColInfo_);
     }
 
+    // Set by the mapper if the tuples can be spilled as they are, i.e. they only have flat columns
+    // of fixed size data types.
+    inline void enableSpilling() { isSpillingEnabled = true; }
+    inline bool getIsSpillingEnabled() const { return isSpillingEnabled; }
+    inline uint64_t increaseNumBlocksInMemory(uint64_t numBlocks) {
+        return numBlocksInMemory.fetch_add(numBlocks) + numBlocks;
+    }
+    void startSpilling(const string& spillDirPath, uint32_t numBytesPerTupleInFT) {
+        unique_lock lck{orderBySharedStateMutex};
+        if (!hasSpilled) {
+            sortedRuns = make_unique<SortedRuns>(
+                StorageUtils::getNewSpillFilePath(spillDirPath, "order_by"),
+                numBytesPerTuple - 8, numBytesPerTupleInFT);
+            hasSpilled = true;
+        }
+    }
+    inline bool getHasSpilled() const { return hasSpilled.load(); }
+    inline SortedRuns* getSortedRuns() { return sortedRuns.get(); }
+    // Spills the sorted key blocks of threads that finished before spilling started.
+    void spillSortedKeyBlocks();
+
 private:
     mutex orderBySharedStateMutex;
+    bool isSpillingEnabled;
+    atomic<uint64_t> numBlocksInMemory;
+    atomic<bool> hasSpilled;
+    unique_ptr<SortedRuns> sortedRuns;
 
 public:
     vector<shared_ptr<FactorizedTable>> factorizedTables;
-    uint8_t nextFactorizedTableIdx;
+    uint16_t nextFactorizedTableIdx;
     shared_ptr<queue<shared_ptr<MergedKeyBlocks>>> sortedKeyBlocks;
 
     uint32_t numBytesPerTuple;
@@ -107,9 +143,9 @@ public:
     OrderBy(const OrderByDataInfo& orderByDataInfo,
         shared_ptr<SharedFactorizedTablesAndSortedKeyBlocks> sharedState,
         unique_ptr<PhysicalOperator> child, uint32_t id, const string& paramsString)
-        : Sink{move(child), id, paramsString}, orderByDataInfo{orderByDataInfo}, sharedState{move(
-                                                                                     sharedState)} {
-    }
+        : Sink{move(child), id, paramsString}, orderByDataInfo{orderByDataInfo},
+          sharedState{move(sharedState)}, memoryBudgetInBlocks{UINT64_MAX},
+          localMemoryBudgetInBlocks{UINT64_MAX}, numLocalBlocksCounted{0} {}
 
     PhysicalOperatorType getOperatorType() override { return ORDER_BY; }
 
@@ -123,6 +159,9 @@ public:
         // hasNoNullGuarantee with other factorizedTables. This is not a good way to solve this
         // problem, and should be changed later.
         sharedState->combineFTHasNoNullGuarantee();
+        if (sharedState->getHasSpilled()) {
+            sharedState->spillSortedKeyBlocks();
+        }
     }
 
     unique_ptr<PhysicalOperator> clone() override {
@@ -130,8 +169,18 @@ public:
             orderByDataInfo, sharedState, children[0]->clone(), id, paramsString);
     }
 
+protected:
+    // Creates the local factorizedTable and orderByKeyEncoder, and registers the factorizedTable
+    // and the key encoding information in the sharedState.
+    void initLocalStateAndSharedState(ExecutionContext* context);
+
 private:
-    uint8_t factorizedTableIdx;
+    void spillLocalTuplesIfNecessary(ExecutionContext* context);
+    // Sorts the local tuples into a single run, spills it, and clears the local tuples.
+    void spillLocalTuples();
+
+protected:
+    uint16_t factorizedTableIdx;
     OrderByDataInfo orderByDataInfo;
     unique_ptr<OrderByKeyEncoder> orderByKeyEncoder;
     unique_ptr<RadixSort> radixSorter;
@@ -140,6 +189,13 @@ private:
     vector<StringAndUnstructuredKeyColInfo> stringAndUnstructuredKeyColInfo;
     shared_ptr<SharedFactorizedTablesAndSortedKeyBlocks> sharedState;
     shared_ptr<FactorizedTable> localFactorizedTable;
+
+private:
+    uint64_t memoryBudgetInBlocks;
+    // Once spilling has started, each thread spills its tuples whenever they exceed its share of
+    // the memory budget.
+    uint64_t localMemoryBudgetInBlocks;
+    uint64_t numLocalBlocksCounted;
 };
 
 } // namespace processor
@@ -47,7 +47,7 @@ class OrderByKeyEncoder {
 
 public:
     OrderByKeyEncoder(vector<shared_ptr<ValueVector>>& orderByVectors, vector<bool>& isAscOrder,
-        MemoryManager* memoryManager, uint8_t ftIdx, uint32_t numTuplesPerBlockInFT);
+        MemoryManager* memoryManager, uint16_t ftIdx, uint32_t numTuplesPerBlockInFT);
 
     inline vector<shared_ptr<DataBlock>>& getKeyBlocks() { return keyBlocks; }
 
@@ -57,18 +57,27 @@ public:
 
     inline uint32_t getNumTuplesInCurBlock() const { return keyBlocks.back()->numTuples; }
 
+    // Note: We only encode 3 bytes for ftBlockIdx and ftBlockOffset, but we are reading 4 bytes
+    // from tupleInfoPtr. We need to do a bit mask to set the most significant byte to 0x00.
     static inline uint32_t getEncodedFTBlockIdx(const uint8_t* tupleInfoPtr) {
-        return *(uint32_t*)tupleInfoPtr;
+        return (*(uint32_t*)tupleInfoPtr & 0x00FFFFFF);
     }
 
-    // Note: We only encode 3 bytes for ftBlockOffset, but we are reading 4 bytes from tupleInfoPtr.
-    // We need to do a bit mask to set the most significant byte to 0x00.
     static inline uint32_t getEncodedFTBlockOffset(const uint8_t* tupleInfoPtr) {
-        return (*(uint32_t*)(tupleInfoPtr + 4) & 0x00FFFFFF);
+        return (*(uint32_t*)(tupleInfoPtr + 3) & 0x00FFFFFF);
     }
 
-    static inline uint8_t getEncodedFTIdx(const uint8_t* tupleInfoPtr) {
-        return *(tupleInfoPtr + 7);
+    static inline uint16_t getEncodedFTIdx(const uint8_t* tupleInfoPtr) {
+        return *(uint16_t*)(tupleInfoPtr + 6);
+    }
+
+    // Writes ftBlockIdx, ftBlockOffset and ftIdx in this order, so the 4-byte writes of the first
+    // two are overwritten by the next field.
+    static inline void encodeTupleInfo(
+        uint8_t* tupleInfoPtr, uint32_t ftBlockIdx, uint32_t ftBlockOffset, uint16_t ftIdx) {
+        *(uint32_t*)tupleInfoPtr = ftBlockIdx;
+        *(uint32_t*)(tupleInfoPtr + 3) = ftBlockOffset;
+        *(uint16_t*)(tupleInfoPtr + 6) = ftIdx;
     }
 
     static inline bool isNullVal(const uint8_t* nullBytePtr, bool isAscOrder) {
@@ -83,6 +92,15 @@ public:
 
     void encodeKeys();
 
+    // Removes the last numTuples encoded keys, so that the next encoded keys point to the
+    // factorizedTable positions of the removed ones. Callers must remove the corresponding tuples
+    // from the factorizedTable as well.
+    void removeLastEncodedKeys(uint32_t numTuples);
+
+    // Removes all encoded keys, so that the next encoded keys point to the start of the
+    // factorizedTable. Callers must clear the factorizedTable as well.
+    void clear();
+
 private:
     static inline uint8_t flipSign(uint8_t key_byte) { return key_byte ^ 128; }
 
@@ -122,13 +140,14 @@ private:
     vector<bool> isAscOrder;
     uint32_t numBytesPerTuple;
     uint32_t maxNumTuplesPerBlock;
+    // Since we encode 3 bytes for ftBlockIdx and ftBlockOffset, their maximum values are 2^24 - 1.
+    static const uint32_t MAX_FT_BLOCK_IDX = (1ul << 24) - 1;
     uint32_t ftBlockIdx = 0;
-    // Since we encode 3 bytes for ftBlockOffset, the maxFTBlockOffset is 2^24 - 1.
     static const uint32_t MAX_FT_BLOCK_OFFSET = (1ul << 24) - 1;
     uint32_t ftBlockOffset = 0;
-    // We only encode 1 byte for ftIndex, this limits the maximum number of threads of our system to
-    // 256.
-    uint8_t ftIdx;
+    // We encode 2 bytes for ftIndex, this limits the maximum number of threads of an orderBy to
+    // 65536.
+    uint16_t ftIdx;
     uint32_t numTuplesPerBlockInFT;
     // We need to swap the encoded binary strings if we are using little endian hardware.
     bool swapBytes;
@@ -17,6 +17,17 @@ struct MergedKeyBlockScanState {
     unique_ptr<BlockPtrInfo> blockPtrInfo;
 };
 
+// Tuples of spilled runs are copied out of the merged records into tuplesBuffer, which has the
+// layout of the factorizedTables, so they can be looked up in the same way as in-memory tuples.
+struct SortedRunsScanState {
+    unique_ptr<SortedRunsMerger> sortedRunsMerger;
+    uint32_t numBytesPerKey;
+    uint32_t numBytesPerTuple;
+    vector<uint32_t> colsToScan;
+    unique_ptr<uint8_t[]> tuplesBuffer;
+    unique_ptr<uint8_t*[]> tuplesToRead;
+};
+
 // To preserve the ordering of tuples, the orderByScan operator will only
 // be executed in single-thread mode.
 class OrderByScan : public PhysicalOperator, public SourceOperator {
@@ -53,14 +64,24 @@ public:
         return profiler.sumAllTimeMetricsWithKey(getTimeMetricKey());
     }
 
+    void printMetricsToJson(nlohmann::json& json, Profiler& profiler) override;
+
+    vector<string> getAttributes(Profiler& profiler) const override;
+
 private:
+    inline string getNumSpilledRunsMetricKey() const { return "numSpilledRuns-" + to_string(id); }
+
     void initMergedKeyBlockScanStateIfNecessary();
+    void initSortedRunsScanState();
+    bool scanSortedRuns();
 
 private:
     vector<DataPos> outDataPoses;
     shared_ptr<SharedFactorizedTablesAndSortedKeyBlocks> sharedState;
     vector<shared_ptr<ValueVector>> vectorsToRead;
     unique_ptr<MergedKeyBlockScanState> mergedKeyBlockScanState;
+    unique_ptr<SortedRunsScanState> sortedRunsScanState;
+    NumericMetric* numSpilledRuns;
 };
 
 } // namespace processor
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "src/common/include/configs.h"
+#include "src/common/include/file_utils.h"
+
+using namespace kuzu::common;
+using namespace std;
+
+namespace kuzu {
+namespace processor {
+
+// Sorted runs of an order by that are spilled to disk. A run is a sequence of records in sorted
+// order, where each record is an encoded key (without the position of its tuple in the
+// factorizedTable) followed by the factorizedTable tuple itself. So runs can be merged and scanned
+// without the factorizedTables they were created from. Runs take consecutive ranges of a temporary
+// file in the spill directory of the database, which is removed when the runs are destroyed.
+class SortedRuns {
+    struct SortedRun {
+        SortedRun(uint64_t offset, uint64_t numRecords) : offset{offset}, numRecords{numRecords} {}
+
+        uint64_t offset;
+        uint64_t numRecords;
+    };
+
+public:
+    SortedRuns(string filePath, uint32_t numBytesPerKey, uint32_t numBytesPerTuple);
+    ~SortedRuns();
+
+    // Reserves a range in the file for a run of numRecords records and returns its offset. Runs
+    // are not read before all of them have been written.
+    uint64_t addRun(uint64_t numRecords);
+    void write(uint8_t* data, uint64_t numBytes, uint64_t offset) const;
+    void read(uint8_t* data, uint64_t numBytes, uint64_t offset) const;
+
+    inline uint32_t getNumBytesPerKey() const { return numBytesPerKey; }
+    inline uint32_t getNumBytesPerRecord() const { return numBytesPerKey + numBytesPerTuple; }
+    inline uint64_t getNumRuns() const { return runs.size(); }
+    inline uint64_t getRunOffset(uint64_t runIdx) const { return runs[runIdx].offset; }
+    inline uint64_t getNumRecordsInRun(uint64_t runIdx) const { return runs[runIdx].numRecords; }
+
+private:
+    uint32_t numBytesPerKey;
+    uint32_t numBytesPerTuple;
+    mutex mtx;
+    string filePath;
+    unique_ptr<FileInfo> fileInfo;
+    uint64_t nextRunOffset;
+    vector<SortedRun> runs;
+};
+
+// A thread-local writer of a single run. Records are copied into a buffer, which is written out
+// once full. Like all buffers of spilled runs, it is not allocated from the memory manager because
+// runs are spilled exactly when the large pages buffer pool is running out.
+class SortedRunWriter {
+public:
+    SortedRunWriter(SortedRuns& sortedRuns, uint64_t numRecords);
+
+    void append(const uint8_t* key, const uint8_t* tuple);
+    // Writes out the partially filled buffer. This must be called once all records are appended.
+    void flush();
+
+private:
+    SortedRuns& sortedRuns;
+    uint64_t nextOffsetToWrite;
+    uint32_t numRecordsPerBuffer;
+    unique_ptr<uint8_t[]> buffer;
+    uint32_t numRecordsInBuffer;
+};
+
+// Reads the records of a single run in order through a buffer.
+class SortedRunReader {
+public:
+    SortedRunReader(const SortedRuns& sortedRuns, uint64_t runIdx);
+
+    inline bool hasMoreRecords() const { return numRecordsLeft > 0; }
+    inline const uint8_t* getRecord() const {
+        return buffer.get() + recordIdxInBuffer * sortedRuns.getNumBytesPerRecord();
+    }
+    void moveToNextRecord();
+
+private:
+    void readNextRecords();
+
+private:
+    const SortedRuns& sortedRuns;
+    uint64_t nextOffsetToRead;
+    uint64_t numRecordsLeft;
+    uint32_t numRecordsPerBuffer;
+    unique_ptr<uint8_t[]> buffer;
+    uint32_t recordIdxInBuffer;
+    uint32_t numRecordsInBuffer;
+};
+
+// Merges all runs in a single pass, keeping the reader of each run in a min heap on the key of its
+// current record. Keys are compared with memcmp, so runs can only be spilled if the order by has
+// no string or unstructured key columns.
+class SortedRunsMerger {
+public:
+    explicit SortedRunsMerger(const SortedRuns& sortedRuns);
+
+    // Returns the next record in sorted order, or nullptr once all runs are exhausted. The record
+    // stays valid until the next call.
+    const uint8_t* getNextRecord();
+
+private:
+    inline bool isAfter(uint32_t leftReaderIdx, uint32_t rightReaderIdx) const {
+        return memcmp(readers[leftReaderIdx]->getRecord(), readers[rightReaderIdx]->getRecord(),
+                   numBytesPerKey) > 0;
+    }
+
+private:
+    uint32_t numBytesPerKey;
+    vector<unique_ptr<SortedRunReader>> readers;
+    vector<uint32_t> readerIdxesHeap;
+    // The reader of the last returned record, which is moved to its next record on the next call.
+    uint32_t lastReaderIdx;
+};
+
+} // namespace processor
+} // namespace kuzu
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "src/processor/operator/order_by/include/key_block_merger.h"
+#include "src/processor/operator/order_by/include/order_by.h"
+
+using namespace std;
+using namespace kuzu::common;
+
+namespace kuzu {
+namespace processor {
+
+// This class collects the encoded keys of the top k tuples of each thread, and keeps the key
+// blocks holding them alive until the final top k tuples are selected in TopK::finalize().
+class TopKSharedState {
+public:
+    void appendCandidates(
+        const vector<uint8_t*>& tuples, const vector<shared_ptr<DataBlock>>& keyBlocksOfTuples) {
+        unique_lock lck{mtx};
+        candidates.insert(candidates.end(), tuples.begin(), tuples.end());
+        keyBlocks.insert(keyBlocks.end(), keyBlocksOfTuples.begin(), keyBlocksOfTuples.end());
+    }
+
+private:
+    mutex mtx;
+
+public:
+    vector<uint8_t*> candidates;
+    vector<shared_ptr<DataBlock>> keyBlocks;
+};
+
+// TopK replaces OrderBy when only the first k tuples in the sorted order are needed, i.e., when
+// ORDER BY is followed by SKIP and/or LIMIT. Each thread encodes keys and appends tuples the same
+// way OrderBy does, but keeps the encoded keys of only its first k tuples in a bounded max heap.
+// Encoded keys and tuples that do not make it into the heap are removed right after being
+// appended. Tuples evicted from the heap later are dropped once the local factorizedTable holds
+// more than COMPACTION_THRESHOLD_FACTOR * k tuples, by compacting it to the tuples in the heap, so
+// the memory of a thread is bounded by k. Instead of radix sorting and merging, finalize() sorts
+// the candidates of all threads and writes the first k of them into a single sorted key block,
+// which is read by OrderByScan. TopK requires all columns to be flat in the factorizedTable.
+class TopK : public OrderBy {
+public:
+    TopK(const OrderByDataInfo& orderByDataInfo,
+        shared_ptr<SharedFactorizedTablesAndSortedKeyBlocks> sharedState,
+        shared_ptr<TopKSharedState> topKSharedState, uint64_t k,
+        unique_ptr<PhysicalOperator> child, uint32_t id, const string& paramsString)
+        : OrderBy{orderByDataInfo, move(sharedState), move(child), id, paramsString},
+          topKSharedState{move(topKSharedState)}, k{k},
+          compactionThreshold{max(TopKConfig::COMPACTION_THRESHOLD_FACTOR * k,
+              (uint64_t)DEFAULT_VECTOR_CAPACITY)} {}
+
+    PhysicalOperatorType getOperatorType() override { return TOP_K; }
+
+    shared_ptr<ResultSet> init(ExecutionContext* context) override;
+
+    void execute(ExecutionContext* context) override;
+
+    void finalize(ExecutionContext* context) override;
+
+    unique_ptr<PhysicalOperator> clone() override {
+        return make_unique<TopK>(orderByDataInfo, sharedState, topKSharedState, k,
+            children[0]->clone(), id, paramsString);
+    }
+
+private:
+    void appendTuplesAndInsertKeysToHeap();
+    // Inserts the last numKeys encoded keys into the heap, writes the indexes (in encoding order)
+    // of the inserted keys to filteredSelVector and returns the number of inserted keys.
+    uint32_t insertLastEncodedKeysToHeap(uint32_t numKeys);
+    bool insertEncodedKeyToHeap(uint8_t* keyPtr);
+    void removeEncodedKeysFromHeap(uint64_t startTupleIdxInFT);
+    // Moves the tuples and encoded keys in the heap to the front of the local factorizedTable and
+    // key blocks, copies their overflow values to a new overflow buffer, and removes the rest.
+    void compactLocalState();
+
+    inline uint64_t getTupleIdxInFT(const uint8_t* keyPtr) const {
+        auto tupleInfoPtr = keyPtr + orderByKeyEncoder->getNumBytesPerTuple() - 8;
+        return (uint64_t)OrderByKeyEncoder::getEncodedFTBlockIdx(tupleInfoPtr) *
+                   localFactorizedTable->getNumTuplesPerBlock() +
+               OrderByKeyEncoder::getEncodedFTBlockOffset(tupleInfoPtr);
+    }
+
+private:
+    shared_ptr<TopKSharedState> topKSharedState;
+    uint64_t k;
+    // The local state is compacted when the local factorizedTable holds more tuples than this. It
+    // is at least a vector's worth of tuples, so that compactions are amortized for small k.
+    uint64_t compactionThreshold;
+    // The keyBlockMerger of a thread compares keys of the local factorizedTable only, so it is
+    // given a vector that holds the local factorizedTable at factorizedTableIdx.
+    vector<shared_ptr<FactorizedTable>> localFactorizedTables;
+    unique_ptr<KeyBlockMerger> keyBlockMerger;
+    // A max heap of encoded keys, so the last tuple among the top k is at the front.
+    vector<uint8_t*> heap;
+    // Selects the tuples whose keys made it into the heap, when only some of the tuples of an
+    // unflat key data chunk did.
+    unique_ptr<SelectionVector> filteredSelVector;
+};
+
+} // namespace processor
+} // namespace kuzu
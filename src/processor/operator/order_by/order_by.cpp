@@ -1,11 +1,84 @@
 #include "include/order_by.h"
 
+#include <algorithm>
+
 namespace kuzu {
 namespace processor {
 
+// Merges the sorted key blocks into a single run and spills it. Each record of the run is the key
+// followed by the tuple it points to, which is looked up in the factorizedTable at the
+// factorizedTableIdx encoded in the key.
+static void spillSortedKeyBlocksAsRun(const vector<shared_ptr<MergedKeyBlocks>>& sortedKeyBlocks,
+    const vector<shared_ptr<FactorizedTable>>& factorizedTables, SortedRuns& sortedRuns) {
+    auto numRecords = 0ul;
+    vector<uint32_t> keyBlocksIdxesHeap;
+    for (auto i = 0u; i < sortedKeyBlocks.size(); i++) {
+        if (sortedKeyBlocks[i]->getNumTuples() > 0) {
+            numRecords += sortedKeyBlocks[i]->getNumTuples();
+            keyBlocksIdxesHeap.push_back(i);
+        }
+    }
+    if (numRecords == 0) {
+        return;
+    }
+    auto numBytesPerKey = sortedRuns.getNumBytesPerKey();
+    vector<uint64_t> nextTupleIdxes(sortedKeyBlocks.size(), 0);
+    auto comparator = [&](uint32_t left, uint32_t right) {
+        return memcmp(sortedKeyBlocks[left]->getTuple(nextTupleIdxes[left]),
+                   sortedKeyBlocks[right]->getTuple(nextTupleIdxes[right]), numBytesPerKey) > 0;
+    };
+    make_heap(keyBlocksIdxesHeap.begin(), keyBlocksIdxesHeap.end(), comparator);
+    SortedRunWriter writer{sortedRuns, numRecords};
+    while (!keyBlocksIdxesHeap.empty()) {
+        pop_heap(keyBlocksIdxesHeap.begin(), keyBlocksIdxesHeap.end(), comparator);
+        auto keyBlocksIdx = keyBlocksIdxesHeap.back();
+        auto keyPtr = sortedKeyBlocks[keyBlocksIdx]->getTuple(nextTupleIdxes[keyBlocksIdx]);
+        auto tupleInfoPtr = keyPtr + numBytesPerKey;
+        auto& factorizedTable =
+            factorizedTables[OrderByKeyEncoder::getEncodedFTIdx(tupleInfoPtr)];
+        writer.append(keyPtr,
+            factorizedTable->getTuple(
+                (uint64_t)OrderByKeyEncoder::getEncodedFTBlockIdx(tupleInfoPtr) *
+                    factorizedTable->getNumTuplesPerBlock() +
+                OrderByKeyEncoder::getEncodedFTBlockOffset(tupleInfoPtr)));
+        if (++nextTupleIdxes[keyBlocksIdx] < sortedKeyBlocks[keyBlocksIdx]->getNumTuples()) {
+            push_heap(keyBlocksIdxesHeap.begin(), keyBlocksIdxesHeap.end(), comparator);
+        } else {
+            keyBlocksIdxesHeap.pop_back();
+        }
+    }
+    writer.flush();
+}
+
+void SharedFactorizedTablesAndSortedKeyBlocks::spillSortedKeyBlocks() {
+    vector<shared_ptr<MergedKeyBlocks>> keyBlocksToSpill;
+    while (!sortedKeyBlocks->empty()) {
+        keyBlocksToSpill.push_back(sortedKeyBlocks->front());
+        sortedKeyBlocks->pop();
+    }
+    spillSortedKeyBlocksAsRun(keyBlocksToSpill, factorizedTables, *sortedRuns);
+    // All tuples are in the runs now. The factorizedTables are kept for their schemas only.
+    for (auto& factorizedTable : factorizedTables) {
+        factorizedTable->clear();
+    }
+}
+
 shared_ptr<ResultSet> OrderBy::init(ExecutionContext* context) {
     resultSet = PhysicalOperator::init(context);
+    initLocalStateAndSharedState(context);
+    radixSorter = make_unique<RadixSort>(context->memoryManager, *localFactorizedTable,
+        *orderByKeyEncoder, stringAndUnstructuredKeyColInfo);
+    if (sharedState->getIsSpillingEnabled()) {
+        memoryBudgetInBlocks = context->bufferManager->getNumLargePageFrames() *
+                               OrderByConfig::MEMORY_BUDGET_RATIO;
+        // A thread always holds at least one key block and one factorizedTable block, so it is
+        // given enough blocks to fill both before spilling.
+        localMemoryBudgetInBlocks = max(memoryBudgetInBlocks / context->numThreads, (uint64_t)4);
+    }
+    return resultSet;
+}
 
+void OrderBy::initLocalStateAndSharedState(ExecutionContext* context) {
     // FactorizedTable, numBytesPerTuple, stringAndUnstructuredKeyColInfo are constructed
     // here because they need the data type information, which is contained in the value vectors.
     unique_ptr<FactorizedTableSchema> tableSchema = make_unique<FactorizedTableSchema>();
@@ -63,15 +136,12 @@ shared_ptr<ResultSet> OrderBy::init(ExecutionContext* context) {
         encodedKeyBlockColOffset += OrderByKeyEncoder::getEncodingSize(vector->dataType);
     }
 
-    // Prepare the orderByEncoder, and radix sorter
+    // Prepare the orderByEncoder.
     orderByKeyEncoder = make_unique<OrderByKeyEncoder>(keyVectors, orderByDataInfo.isAscOrder,
         context->memoryManager, factorizedTableIdx, localFactorizedTable->getNumTuplesPerBlock());
-    radixSorter = make_unique<RadixSort>(context->memoryManager, *localFactorizedTable,
-        *orderByKeyEncoder, stringAndUnstructuredKeyColInfo);
 
     sharedState->setStringAndUnstructuredKeyColInfo(stringAndUnstructuredKeyColInfo);
     sharedState->setNumBytesPerTuple(orderByKeyEncoder->getNumBytesPerTuple());
-    return resultSet;
 }
 
 void OrderBy::execute(ExecutionContext* context) {
@@ -90,16 +160,60 @@ void OrderBy::execute(ExecutionContext* context) {
             // factorized table if and only if its corresponding vector is flat.
             localFactorizedTable->append(vectorsToAppend);
         }
+        if (sharedState->getIsSpillingEnabled()) {
+            spillLocalTuplesIfNecessary(context);
+        }
+    }
+
+    if (sharedState->getHasSpilled()) {
+        spillLocalTuples();
+    } else {
+        for (auto& keyBlock : orderByKeyEncoder->getKeyBlocks()) {
+            if (keyBlock->numTuples > 0) {
+                radixSorter->sortSingleKeyBlock(*keyBlock);
+                sharedState->appendSortedKeyBlock(make_shared<MergedKeyBlocks>(
+                    orderByKeyEncoder->getNumBytesPerTuple(), keyBlock));
+            }
+        }
+    }
+    metrics->executionTime.stop();
+}
+
+void OrderBy::spillLocalTuplesIfNecessary(ExecutionContext* context) {
+    auto numLocalBlocks = orderByKeyEncoder->getKeyBlocks().size() +
+                          localFactorizedTable->getTupleDataBlocks().size();
+    if (!sharedState->getHasSpilled()) {
+        auto numBlocksInMemory =
+            sharedState->increaseNumBlocksInMemory(numLocalBlocks - numLocalBlocksCounted);
+        numLocalBlocksCounted = numLocalBlocks;
+        if (numBlocksInMemory <= memoryBudgetInBlocks) {
+            return;
+        }
+        sharedState->startSpilling(context->spillDirPath,
+            localFactorizedTable->getTableSchema()->getNumBytesPerTuple());
+    } else if (numLocalBlocks <= localMemoryBudgetInBlocks) {
+        return;
     }
+    spillLocalTuples();
+}
 
+void OrderBy::spillLocalTuples() {
+    vector<shared_ptr<MergedKeyBlocks>> sortedKeyBlocks;
     for (auto& keyBlock : orderByKeyEncoder->getKeyBlocks()) {
         if (keyBlock->numTuples > 0) {
             radixSorter->sortSingleKeyBlock(*keyBlock);
-            sharedState->appendSortedKeyBlock(
+            sortedKeyBlocks.push_back(
                 make_shared<MergedKeyBlocks>(orderByKeyEncoder->getNumBytesPerTuple(), keyBlock));
         }
     }
-    metrics->executionTime.stop();
+    // The factorizedTables of other threads may be appended to the sharedState concurrently, so
+    // tuples are looked up in a vector that holds the local factorizedTable only.
+    vector<shared_ptr<FactorizedTable>> localFactorizedTables(factorizedTableIdx + 1);
+    localFactorizedTables[factorizedTableIdx] = localFactorizedTable;
+    spillSortedKeyBlocksAsRun(
+        sortedKeyBlocks, localFactorizedTables, *sharedState->getSortedRuns());
+    localFactorizedTable->clear();
+    orderByKeyEncoder->clear();
 }
 
 } // namespace processor
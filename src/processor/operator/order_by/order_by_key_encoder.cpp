@@ -12,7 +12,7 @@ namespace kuzu {
 namespace processor {
 
 OrderByKeyEncoder::OrderByKeyEncoder(vector<shared_ptr<ValueVector>>& orderByVectors,
-    vector<bool>& isAscOrder, MemoryManager* memoryManager, uint8_t ftIdx,
+    vector<bool>& isAscOrder, MemoryManager* memoryManager, uint16_t ftIdx,
     uint32_t numTuplesPerBlockInFT)
     : memoryManager{memoryManager}, orderByVectors{orderByVectors}, isAscOrder{isAscOrder},
       ftIdx{ftIdx}, numTuplesPerBlockInFT{numTuplesPerBlockInFT}, swapBytes{isLittleEndian()} {
@@ -61,6 +61,30 @@ void OrderByKeyEncoder::encodeKeys() {
     }
 }
 
+void OrderByKeyEncoder::removeLastEncodedKeys(uint32_t numTuples) {
+    auto numEncodedTuples = (uint64_t)ftBlockIdx * numTuplesPerBlockInFT + ftBlockOffset;
+    assert(numTuples <= numEncodedTuples);
+    numEncodedTuples -= numTuples;
+    ftBlockIdx = numEncodedTuples / numTuplesPerBlockInFT;
+    ftBlockOffset = numEncodedTuples % numTuplesPerBlockInFT;
+    while (numTuples > 0) {
+        auto& keyBlock = keyBlocks.back();
+        auto numTuplesToRemove = min(numTuples, keyBlock->numTuples);
+        keyBlock->numTuples -= numTuplesToRemove;
+        numTuples -= numTuplesToRemove;
+        if (keyBlock->numTuples == 0 && keyBlocks.size() > 1) {
+            keyBlocks.pop_back();
+        }
+    }
+}
+
+void OrderByKeyEncoder::clear() {
+    keyBlocks.clear();
+    keyBlocks.emplace_back(make_unique<DataBlock>(memoryManager));
+    ftBlockIdx = 0;
+    ftBlockOffset = 0;
+}
+
 uint32_t OrderByKeyEncoder::getEncodingSize(const DataType& dataType) {
     // Add one more byte for null flag.
     switch (dataType.typeID) {
@@ -179,14 +203,16 @@ void OrderByKeyEncoder::encodeFTIdx(uint32_t numEntriesToEncode, uint8_t* tupleI
         auto nextBatchOfEntries = min(
             numEntriesToEncode - numUpdatedFTInfoEntries, numTuplesPerBlockInFT - ftBlockOffset);
         for (auto i = 0u; i < nextBatchOfEntries; i++) {
-            *(uint32_t*)tupleInfoPtr = ftBlockIdx;
-            *(uint32_t*)(tupleInfoPtr + 4) = ftBlockOffset;
-            *(uint8_t*)(tupleInfoPtr + 7) = ftIdx;
+            encodeTupleInfo(tupleInfoPtr, ftBlockIdx, ftBlockOffset, ftIdx);
             tupleInfoPtr += numBytesPerTuple;
             ftBlockOffset++;
         }
         numUpdatedFTInfoEntries += nextBatchOfEntries;
         if (ftBlockOffset == numTuplesPerBlockInFT) {
+            if (ftBlockIdx == MAX_FT_BLOCK_IDX) {
+                throw RuntimeException(
+                    "The number of blocks of factorizedTable exceeds the maximum blockIdx!");
+            }
             ftBlockIdx++;
             ftBlockOffset = 0;
         }
@@ -195,7 +221,7 @@ void OrderByKeyEncoder::encodeFTIdx(uint32_t numEntriesToEncode, uint8_t* tupleI
 
 void OrderByKeyEncoder::allocateMemoryIfFull() {
     if (getNumTuplesInCurBlock() == maxNumTuplesPerBlock) {
-        keyBlocks.emplace_back(make_shared<DataBlock>(memoryManager));
+        keyBlocks.emplace_back(make_unique<DataBlock>(memoryManager));
     }
 }
 
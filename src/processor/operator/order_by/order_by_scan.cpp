@@ -14,12 +14,23 @@ shared_ptr<ResultSet> OrderByScan::init(ExecutionContext* context) {
         outDataChunk->insert(outDataPos.valueVectorPos, valueVector);
         vectorsToRead.emplace_back(valueVector);
     }
-    initMergedKeyBlockScanStateIfNecessary();
+    numSpilledRuns = context->profiler->registerNumericMetric(getNumSpilledRunsMetricKey());
+    if (sharedState->getHasSpilled()) {
+        numSpilledRuns->increase(sharedState->getSortedRuns()->getNumRuns());
+        initSortedRunsScanState();
+    } else {
+        initMergedKeyBlockScanStateIfNecessary();
+    }
     return resultSet;
 }
 
 bool OrderByScan::getNextTuples() {
     metrics->executionTime.start();
+    if (sortedRunsScanState != nullptr) {
+        auto hasTuples = scanSortedRuns();
+        metrics->executionTime.stop();
+        return hasTuples;
+    }
     // If there is no more tuples to read, just return false.
     if (mergedKeyBlockScanState == nullptr ||
         mergedKeyBlockScanState->nextTupleIdxToReadInMergedKeyBlock >=
@@ -106,5 +117,55 @@ void OrderByScan::initMergedKeyBlockScanStateIfNecessary() {
         mergedKeyBlockScanState->mergedKeyBlock);
 }
 
+void OrderByScan::initSortedRunsScanState() {
+    auto& sortedRuns = *sharedState->getSortedRuns();
+    sortedRunsScanState = make_unique<SortedRunsScanState>();
+    sortedRunsScanState->sortedRunsMerger = make_unique<SortedRunsMerger>(sortedRuns);
+    sortedRunsScanState->numBytesPerKey = sortedRuns.getNumBytesPerKey();
+    sortedRunsScanState->numBytesPerTuple =
+        sortedRuns.getNumBytesPerRecord() - sortedRuns.getNumBytesPerKey();
+    sortedRunsScanState->colsToScan = vector<uint32_t>(vectorsToRead.size());
+    iota(sortedRunsScanState->colsToScan.begin(), sortedRunsScanState->colsToScan.end(), 0);
+    sortedRunsScanState->tuplesBuffer = make_unique<uint8_t[]>(
+        DEFAULT_VECTOR_CAPACITY * sortedRunsScanState->numBytesPerTuple);
+    sortedRunsScanState->tuplesToRead = make_unique<uint8_t*[]>(DEFAULT_VECTOR_CAPACITY);
+}
+
+bool OrderByScan::scanSortedRuns() {
+    auto numTuplesRead = 0u;
+    while (numTuplesRead < DEFAULT_VECTOR_CAPACITY) {
+        auto record = sortedRunsScanState->sortedRunsMerger->getNextRecord();
+        if (record == nullptr) {
+            break;
+        }
+        auto tuple = sortedRunsScanState->tuplesBuffer.get() +
+                     numTuplesRead * sortedRunsScanState->numBytesPerTuple;
+        memcpy(tuple, record + sortedRunsScanState->numBytesPerKey,
+            sortedRunsScanState->numBytesPerTuple);
+        sortedRunsScanState->tuplesToRead[numTuplesRead++] = tuple;
+    }
+    if (numTuplesRead == 0) {
+        return false;
+    }
+    // Spilled tuples only have flat columns of fixed size data types, so they do not point to
+    // memory of the factorizedTable they were appended to.
+    sharedState->factorizedTables[0]->lookup(vectorsToRead, sortedRunsScanState->colsToScan,
+        sortedRunsScanState->tuplesToRead.get(), 0 /* startPos */, numTuplesRead);
+    metrics->numOutputTuple.increase(numTuplesRead);
+    return true;
+}
+
+void OrderByScan::printMetricsToJson(nlohmann::json& json, Profiler& profiler) {
+    printTimeAndNumOutputMetrics(json, profiler);
+    json["numSpilledRuns"] = profiler.sumAllNumericMetricsWithKey(getNumSpilledRunsMetricKey());
+}
+
+vector<string> OrderByScan::getAttributes(Profiler& profiler) const {
+    auto attributes = PhysicalOperator::getAttributes(profiler);
+    attributes.emplace_back("NumSpilledRuns: " +
+        to_string(profiler.sumAllNumericMetricsWithKey(getNumSpilledRunsMetricKey())));
+    return attributes;
+}
+
 } // namespace processor
 } // namespace kuzu
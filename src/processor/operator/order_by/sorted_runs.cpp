@@ -0,0 +1,129 @@
+#include "include/sorted_runs.h"
+
+#include <fcntl.h>
+
+#include <algorithm>
+
+namespace kuzu {
+namespace processor {
+
+SortedRuns::SortedRuns(string filePath, uint32_t numBytesPerKey, uint32_t numBytesPerTuple)
+    : numBytesPerKey{numBytesPerKey}, numBytesPerTuple{numBytesPerTuple},
+      filePath{move(filePath)}, nextRunOffset{0} {
+    FileUtils::removeFileIfExists(this->filePath);
+    fileInfo = FileUtils::openFile(this->filePath, O_CREAT | O_RDWR);
+}
+
+SortedRuns::~SortedRuns() {
+    FileUtils::closeFile(fileInfo->fd);
+    FileUtils::removeFileIfExists(filePath);
+}
+
+uint64_t SortedRuns::addRun(uint64_t numRecords) {
+    lock_guard lck{mtx};
+    auto offset = nextRunOffset;
+    runs.emplace_back(offset, numRecords);
+    nextRunOffset += numRecords * getNumBytesPerRecord();
+    return offset;
+}
+
+void SortedRuns::write(uint8_t* data, uint64_t numBytes, uint64_t offset) const {
+    FileUtils::writeToFile(fileInfo.get(), data, numBytes, offset);
+}
+
+void SortedRuns::read(uint8_t* data, uint64_t numBytes, uint64_t offset) const {
+    FileUtils::readFromFile(fileInfo.get(), data, numBytes, offset);
+}
+
+static uint32_t getNumRecordsPerBuffer(uint32_t numBytesPerRecord) {
+    return max(OrderByConfig::RUN_BUFFER_SIZE / numBytesPerRecord, (uint64_t)1);
+}
+
+SortedRunWriter::SortedRunWriter(SortedRuns& sortedRuns, uint64_t numRecords)
+    : sortedRuns{sortedRuns}, nextOffsetToWrite{sortedRuns.addRun(numRecords)},
+      numRecordsPerBuffer{getNumRecordsPerBuffer(sortedRuns.getNumBytesPerRecord())},
+      buffer{make_unique<uint8_t[]>(numRecordsPerBuffer * sortedRuns.getNumBytesPerRecord())},
+      numRecordsInBuffer{0} {}
+
+void SortedRunWriter::append(const uint8_t* key, const uint8_t* tuple) {
+    auto numBytesPerKey = sortedRuns.getNumBytesPerKey();
+    auto record = buffer.get() + numRecordsInBuffer * sortedRuns.getNumBytesPerRecord();
+    memcpy(record, key, numBytesPerKey);
+    memcpy(record + numBytesPerKey, tuple, sortedRuns.getNumBytesPerRecord() - numBytesPerKey);
+    if (++numRecordsInBuffer == numRecordsPerBuffer) {
+        flush();
+    }
+}
+
+void SortedRunWriter::flush() {
+    if (numRecordsInBuffer == 0) {
+        return;
+    }
+    auto numBytes = (uint64_t)numRecordsInBuffer * sortedRuns.getNumBytesPerRecord();
+    sortedRuns.write(buffer.get(), numBytes, nextOffsetToWrite);
+    nextOffsetToWrite += numBytes;
+    numRecordsInBuffer = 0;
+}
+
+SortedRunReader::SortedRunReader(const SortedRuns& sortedRuns, uint64_t runIdx)
+    : sortedRuns{sortedRuns}, nextOffsetToRead{sortedRuns.getRunOffset(runIdx)},
+      numRecordsLeft{sortedRuns.getNumRecordsInRun(runIdx)},
+      numRecordsPerBuffer{getNumRecordsPerBuffer(sortedRuns.getNumBytesPerRecord())},
+      buffer{make_unique<uint8_t[]>(numRecordsPerBuffer * sortedRuns.getNumBytesPerRecord())},
+      recordIdxInBuffer{0}, numRecordsInBuffer{0} {
+    readNextRecords();
+}
+
+void SortedRunReader::moveToNextRecord() {
+    assert(hasMoreRecords());
+    numRecordsLeft--;
+    if (++recordIdxInBuffer == numRecordsInBuffer) {
+        readNextRecords();
+    }
+}
+
+void SortedRunReader::readNextRecords() {
+    numRecordsInBuffer = min((uint64_t)numRecordsPerBuffer, numRecordsLeft);
+    recordIdxInBuffer = 0;
+    if (numRecordsInBuffer == 0) {
+        return;
+    }
+    auto numBytes = (uint64_t)numRecordsInBuffer * sortedRuns.getNumBytesPerRecord();
+    sortedRuns.read(buffer.get(), numBytes, nextOffsetToRead);
+    nextOffsetToRead += numBytes;
+}
+
+SortedRunsMerger::SortedRunsMerger(const SortedRuns& sortedRuns)
+    : numBytesPerKey{sortedRuns.getNumBytesPerKey()}, lastReaderIdx{UINT32_MAX} {
+    for (auto runIdx = 0u; runIdx < sortedRuns.getNumRuns(); runIdx++) {
+        auto reader = make_unique<SortedRunReader>(sortedRuns, runIdx);
+        if (reader->hasMoreRecords()) {
+            readerIdxesHeap.push_back(readers.size());
+        }
+        readers.push_back(move(reader));
+    }
+    make_heap(readerIdxesHeap.begin(), readerIdxesHeap.end(),
+        [this](uint32_t left, uint32_t right) { return isAfter(left, right); });
+}
+
+const uint8_t* SortedRunsMerger::getNextRecord() {
+    auto comparator = [this](uint32_t left, uint32_t right) { return isAfter(left, right); };
+    if (lastReaderIdx != UINT32_MAX) {
+        readers[lastReaderIdx]->moveToNextRecord();
+        if (readers[lastReaderIdx]->hasMoreRecords()) {
+            readerIdxesHeap.push_back(lastReaderIdx);
+            push_heap(readerIdxesHeap.begin(), readerIdxesHeap.end(), comparator);
+        }
+        lastReaderIdx = UINT32_MAX;
+    }
+    if (readerIdxesHeap.empty()) {
+        return nullptr;
+    }
+    pop_heap(readerIdxesHeap.begin(), readerIdxesHeap.end(), comparator);
+    lastReaderIdx = readerIdxesHeap.back();
+    readerIdxesHeap.pop_back();
+    return readers[lastReaderIdx]->getRecord();
+}
+
+} // namespace processor
+} // namespace kuzu
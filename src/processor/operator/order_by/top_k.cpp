@@ -0,0 +1,206 @@
+#include "include/top_k.h"
+
+#include "src/common/include/vector/value_vector_utils.h"
+
+namespace kuzu {
+namespace processor {
+
+shared_ptr<ResultSet> TopK::init(ExecutionContext* context) {
+    resultSet = PhysicalOperator::init(context);
+    initLocalStateAndSharedState(context);
+    localFactorizedTables.resize(factorizedTableIdx + 1);
+    localFactorizedTables[factorizedTableIdx] = localFactorizedTable;
+    keyBlockMerger = make_unique<KeyBlockMerger>(localFactorizedTables,
+        stringAndUnstructuredKeyColInfo, orderByKeyEncoder->getNumBytesPerTuple());
+    filteredSelVector = make_unique<SelectionVector>(DEFAULT_VECTOR_CAPACITY);
+    filteredSelVector->resetSelectorToValuePosBuffer();
+    return resultSet;
+}
+
+void TopK::execute(ExecutionContext* context) {
+    init(context);
+    metrics->executionTime.start();
+    while (children[0]->getNextTuples()) {
+        for (auto i = 0u; i < resultSet->multiplicity; i++) {
+            appendTuplesAndInsertKeysToHeap();
+            if (localFactorizedTable->getNumTuples() > compactionThreshold) {
+                compactLocalState();
+            }
+        }
+    }
+    topKSharedState->appendCandidates(heap, orderByKeyEncoder->getKeyBlocks());
+    metrics->executionTime.stop();
+}
+
+void TopK::finalize(ExecutionContext* context) {
+    // See OrderBy::finalize().
+    sharedState->combineFTHasNoNullGuarantee();
+    auto& candidates = topKSharedState->candidates;
+    auto numTuples = min(k, (uint64_t)candidates.size());
+    if (numTuples == 0) {
+        return;
+    }
+    KeyBlockMerger merger{sharedState->factorizedTables,
+        sharedState->stringAndUnstructuredKeyColInfo, sharedState->numBytesPerTuple};
+    partial_sort(candidates.begin(), candidates.begin() + numTuples, candidates.end(),
+        [&merger](uint8_t* left, uint8_t* right) { return merger.compareTuplePtr(right, left); });
+    auto topKKeyBlocks = make_shared<MergedKeyBlocks>(
+        sharedState->numBytesPerTuple, numTuples, context->memoryManager);
+    for (auto i = 0u; i < numTuples; i++) {
+        memcpy(topKKeyBlocks->getTuple(i), candidates[i], sharedState->numBytesPerTuple);
+    }
+    sharedState->appendSortedKeyBlock(move(topKKeyBlocks));
+}
+
+void TopK::appendTuplesAndInsertKeysToHeap() {
+    // Tuples are appended before comparing keys because comparing long strings needs to read them
+    // from the factorizedTable. See OrderBy::execute() for how key and payload columns are
+    // flattened in the factorizedTable.
+    auto numTuplesBeforeAppend = localFactorizedTable->getNumTuples();
+    orderByKeyEncoder->encodeKeys();
+    localFactorizedTable->append(vectorsToAppend);
+    auto numAppendedTuples = localFactorizedTable->getNumTuples() - numTuplesBeforeAppend;
+    auto numInsertedKeys = insertLastEncodedKeysToHeap(numAppendedTuples);
+    if (numInsertedKeys == numAppendedTuples) {
+        return;
+    }
+    if (numInsertedKeys > 0) {
+        removeEncodedKeysFromHeap(numTuplesBeforeAppend);
+    }
+    orderByKeyEncoder->removeLastEncodedKeys(numAppendedTuples);
+    localFactorizedTable->removeLastTuples(numAppendedTuples);
+    if (numInsertedKeys == 0) {
+        return;
+    }
+    // Only some of the appended tuples made it into the heap, which can only happen if the keys
+    // are unflat. Then all columns are in the same data chunk, so we select the tuples that made
+    // it into the heap in that data chunk and append them again. Keys that were inserted and
+    // evicted by later keys of the same append are appended again as well, because the heap has
+    // lost the keys they evicted.
+    auto& state = keyVectors[0]->state;
+    assert(!state->isFlat());
+    for (auto i = 0u; i < numInsertedKeys; i++) {
+        filteredSelVector->selectedPositions[i] =
+            state->selVector->selectedPositions[filteredSelVector->selectedPositions[i]];
+    }
+    filteredSelVector->selectedSize = numInsertedKeys;
+    swap(state->selVector, filteredSelVector);
+    orderByKeyEncoder->encodeKeys();
+    localFactorizedTable->append(vectorsToAppend);
+    swap(state->selVector, filteredSelVector);
+    insertLastEncodedKeysToHeap(numInsertedKeys);
+}
+
+uint32_t TopK::insertLastEncodedKeysToHeap(uint32_t numKeys) {
+    if (numKeys == 0) {
+        return 0;
+    }
+    auto numBytesPerTuple = orderByKeyEncoder->getNumBytesPerTuple();
+    auto& keyBlocks = orderByKeyEncoder->getKeyBlocks();
+    // The last numKeys encoded keys may span the last few key blocks.
+    auto blockIdx = keyBlocks.size() - 1;
+    auto numKeysInLaterBlocks = 0u;
+    while (numKeysInLaterBlocks + keyBlocks[blockIdx]->numTuples < numKeys) {
+        numKeysInLaterBlocks += keyBlocks[blockIdx]->numTuples;
+        blockIdx--;
+    }
+    auto keyPtr = keyBlocks[blockIdx]->getData() +
+                  (keyBlocks[blockIdx]->numTuples - (numKeys - numKeysInLaterBlocks)) *
+                      numBytesPerTuple;
+    auto blockEndPtr =
+        keyBlocks[blockIdx]->getData() + keyBlocks[blockIdx]->numTuples * numBytesPerTuple;
+    auto numInsertedKeys = 0u;
+    for (auto i = 0u; i < numKeys; i++) {
+        if (keyPtr == blockEndPtr) {
+            blockIdx++;
+            keyPtr = keyBlocks[blockIdx]->getData();
+            blockEndPtr = keyPtr + keyBlocks[blockIdx]->numTuples * numBytesPerTuple;
+        }
+        if (insertEncodedKeyToHeap(keyPtr)) {
+            filteredSelVector->selectedPositions[numInsertedKeys++] = i;
+        }
+        keyPtr += numBytesPerTuple;
+    }
+    return numInsertedKeys;
+}
+
+bool TopK::insertEncodedKeyToHeap(uint8_t* keyPtr) {
+    // compareTuplePtr(left, right) returns true if left comes after right in the sorted order.
+    auto comparator = [this](uint8_t* left, uint8_t* right) {
+        return keyBlockMerger->compareTuplePtr(right, left);
+    };
+    if (heap.size() < k) {
+        heap.push_back(keyPtr);
+        push_heap(heap.begin(), heap.end(), comparator);
+        return true;
+    }
+    if (k == 0 || !keyBlockMerger->compareTuplePtr(heap.front(), keyPtr)) {
+        return false;
+    }
+    pop_heap(heap.begin(), heap.end(), comparator);
+    heap.back() = keyPtr;
+    push_heap(heap.begin(), heap.end(), comparator);
+    return true;
+}
+
+void TopK::removeEncodedKeysFromHeap(uint64_t startTupleIdxInFT) {
+    heap.erase(remove_if(heap.begin(), heap.end(),
+                   [&](uint8_t* keyPtr) { return getTupleIdxInFT(keyPtr) >= startTupleIdxInFT; }),
+        heap.end());
+    make_heap(heap.begin(), heap.end(), [this](uint8_t* left, uint8_t* right) {
+        return keyBlockMerger->compareTuplePtr(right, left);
+    });
+}
+
+void TopK::compactLocalState() {
+    assert(!localFactorizedTable->hasUnflatCol());
+    // The tuple index of an encoded key is also its index among the encoded keys. Moving the tuples
+    // in the heap, in the order of their indexes, to the front of the factorizedTable and key
+    // blocks only moves them towards the front, so no tuple in the heap is overwritten.
+    sort(heap.begin(), heap.end(), [this](const uint8_t* left, const uint8_t* right) {
+        return getTupleIdxInFT(left) < getTupleIdxInFT(right);
+    });
+    auto tableSchema = localFactorizedTable->getTableSchema();
+    auto numBytesPerTupleInFT = tableSchema->getNumBytesPerTuple();
+    auto numTuplesPerBlockInFT = localFactorizedTable->getNumTuplesPerBlock();
+    auto numBytesPerKey = orderByKeyEncoder->getNumBytesPerTuple();
+    auto maxNumKeysPerBlock = orderByKeyEncoder->getMaxNumTuplesPerBlock();
+    auto& keyBlocks = orderByKeyEncoder->getKeyBlocks();
+    auto oldInMemOverflowBuffer = localFactorizedTable->resetInMemOverflowBuffer();
+    auto inMemOverflowBuffer = localFactorizedTable->getInMemOverflowBuffer();
+    vector<uint8_t> tupleBuffer(numBytesPerTupleInFT);
+    for (auto i = 0u; i < heap.size(); i++) {
+        auto tupleIdx = getTupleIdxInFT(heap[i]);
+        // Overflow values are copied from a copy of the tuple, because a tuple may stay in place.
+        memcpy(tupleBuffer.data(), localFactorizedTable->getTuple(tupleIdx), numBytesPerTupleInFT);
+        auto tuple = localFactorizedTable->getTuple(i);
+        memcpy(tuple, tupleBuffer.data(), numBytesPerTupleInFT);
+        for (auto colIdx = 0u; colIdx < tableSchema->getNumColumns(); colIdx++) {
+            if (localFactorizedTable->isNonOverflowColNull(
+                    tuple + tableSchema->getNullMapOffset(), colIdx)) {
+                continue;
+            }
+            auto colOffset = tableSchema->getColOffset(colIdx);
+            ValueVectorUtils::copyNonNullDataWithSameType(vectorsToAppend[colIdx]->dataType,
+                tupleBuffer.data() + colOffset, tuple + colOffset, *inMemOverflowBuffer);
+        }
+        auto keyPtr = keyBlocks[i / maxNumKeysPerBlock]->getData() +
+                      (i % maxNumKeysPerBlock) * numBytesPerKey;
+        if (keyPtr != heap[i]) {
+            memcpy(keyPtr, heap[i], numBytesPerKey);
+            auto tupleInfoPtr = keyPtr + numBytesPerKey - 8;
+            OrderByKeyEncoder::encodeTupleInfo(tupleInfoPtr, i / numTuplesPerBlockInFT,
+                i % numTuplesPerBlockInFT, factorizedTableIdx);
+            heap[i] = keyPtr;
+        }
+    }
+    auto numTuplesToRemove = localFactorizedTable->getNumTuples() - heap.size();
+    orderByKeyEncoder->removeLastEncodedKeys(numTuplesToRemove);
+    localFactorizedTable->removeLastTuples(numTuplesToRemove);
+    make_heap(heap.begin(), heap.end(), [this](uint8_t* left, uint8_t* right) {
+        return keyBlockMerger->compareTuplePtr(right, left);
+    });
+}
+
+} // namespace processor
+} // namespace kuzu
@@ -33,7 +33,7 @@ bool AdjListExtend::getNextTuples() {
         ((AdjLists*)listsWithAdjAndPropertyListsUpdateStore)
             ->initListReadingState(
                 inValueVector->readNodeOffset(inDataChunk->state->getPositionOfCurrIdx()),
-                *listHandle, transaction->getType());
+                *listHandle, transaction->getVersionToRead());
         listsWithAdjAndPropertyListsUpdateStore->readValues(outValueVector, *listHandle);
     } while (outDataChunk->state->selVector->selectedSize == 0);
     metrics->executionTime.stop();
@@ -8,13 +8,17 @@ void ScanNodeIDSemiMask::setMask(uint64_t nodeOffset, uint8_t maskerIdx) {
     morselMask->setMask(nodeOffset >> DEFAULT_VECTOR_CAPACITY_LOG_2, maskerIdx, maskerIdx + 1);
 }
 
-void ScanNodeIDSharedState::initialize(kuzu::transaction::Transaction* transaction) {
+void ScanNodeIDSharedState::initialize(
+    kuzu::transaction::Transaction* transaction, uint64_t numThreads_) {
     unique_lock uLck{mtx};
     if (initialized) {
         return;
     }
     maxNodeOffset = nodesStatisticsAndDeletedIDs->getMaxNodeOffset(transaction, tableID);
-    maxMorselIdx = maxNodeOffset >> DEFAULT_VECTOR_CAPACITY_LOG_2;
+    // Note: we use maxNodeOffset=UINT64_MAX to represent an empty table.
+    numMorsels =
+        maxNodeOffset == UINT64_MAX ? 0 : (maxNodeOffset >> DEFAULT_VECTOR_CAPACITY_LOG_2) + 1;
+    numThreads = numThreads_;
     initialized = true;
 }
 
@@ -26,24 +30,40 @@ void ScanNodeIDSharedState::initSemiMask(Transaction* transaction) {
     }
 }
 
-pair<uint64_t, uint64_t> ScanNodeIDSharedState::getNextRangeToRead() {
-    unique_lock lck{mtx};
-    // Note: we use maxNodeOffset=UINT64_MAX to represent an empty table.
-    if (currentNodeOffset > maxNodeOffset || maxNodeOffset == UINT64_MAX) {
-        return make_pair(currentNodeOffset, currentNodeOffset);
+pair<uint64_t, uint64_t> ScanNodeIDSharedState::claimMorsels() {
+    auto startMorselIdx = nextMorselIdxToClaim.load(memory_order_relaxed);
+    while (startMorselIdx < numMorsels) {
+        // Large batches reduce contention on nextMorselIdxToClaim while many morsels are left, and
+        // small batches towards the end keep threads from finishing long after each other.
+        auto numMorselsLeft = numMorsels - startMorselIdx;
+        auto numMorselsToClaim =
+            clamp(numMorselsLeft / (numThreads * ScanNodeIDConfig::NUM_BATCHES_PER_THREAD_LEFT),
+                (uint64_t)1, ScanNodeIDConfig::MAX_NUM_MORSELS_PER_BATCH);
+        if (nextMorselIdxToClaim.compare_exchange_weak(startMorselIdx,
+                startMorselIdx + numMorselsToClaim, memory_order_relaxed)) {
+            return make_pair(startMorselIdx, startMorselIdx + numMorselsToClaim);
+        }
+    }
+    return make_pair(numMorsels, numMorsels);
+}
+
+bool ScanNodeIDSharedState::mayMorselHaveNodesToScan(uint64_t morselIdx) const {
+    if (semiMask != nullptr && !semiMask->isMorselMasked(morselIdx)) {
+        return false;
     }
-    if (semiMask) {
-        auto currentMorselIdx = currentNodeOffset >> DEFAULT_VECTOR_CAPACITY_LOG_2;
-        assert(currentNodeOffset % DEFAULT_VECTOR_CAPACITY == 0);
-        while (currentMorselIdx <= maxMorselIdx && !semiMask->isMorselMasked(currentMorselIdx)) {
-            currentMorselIdx++;
+    auto [startOffset, endOffset] = getMorselNodeOffsets(morselIdx);
+    return mayMatchZoneMapPredicates(startOffset, endOffset);
+}
+
+bool ScanNodeIDSharedState::mayMatchZoneMapPredicates(
+    node_offset_t startOffset, node_offset_t endOffset) const {
+    for (auto& predicate : zoneMapPredicates) {
+        if (!predicate.column->mayMatch(
+                startOffset, endOffset, predicate.comparisonType, predicate.literal)) {
+            return false;
         }
-        currentNodeOffset = min(currentMorselIdx * DEFAULT_VECTOR_CAPACITY, maxNodeOffset);
     }
-    auto startOffset = currentNodeOffset;
-    auto range = min(DEFAULT_VECTOR_CAPACITY, maxNodeOffset + 1 - currentNodeOffset);
-    currentNodeOffset += range;
-    return make_pair(startOffset, startOffset + range);
+    return true;
 }
 
 shared_ptr<ResultSet> ScanNodeID::init(ExecutionContext* context) {
@@ -53,14 +73,34 @@ shared_ptr<ResultSet> ScanNodeID::init(ExecutionContext* context) {
     outValueVector = make_shared<ValueVector>(NODE_ID, context->memoryManager);
     outValueVector->setSequential();
     outDataChunk->insert(outDataPos.valueVectorPos, outValueVector);
-    sharedState->initialize(transaction);
+    sharedState->initialize(transaction, context->numThreads);
+    numMorselsClaimed = context->profiler->registerNumericMetric(getNumMorselsMetricKey());
+    morselClaimTime = context->profiler->registerTimeMetric(getMorselClaimTimeMetricKey());
     return resultSet;
 }
 
+pair<node_offset_t, node_offset_t> ScanNodeID::getNextRangeToRead() {
+    while (true) {
+        if (nextMorselIdx == endMorselIdx) {
+            morselClaimTime->start();
+            tie(nextMorselIdx, endMorselIdx) = sharedState->claimMorsels();
+            morselClaimTime->stop();
+            if (nextMorselIdx == endMorselIdx) {
+                return make_pair(0, 0);
+            }
+            numMorselsClaimed->increase(endMorselIdx - nextMorselIdx);
+        }
+        auto morselIdx = nextMorselIdx++;
+        if (sharedState->mayMorselHaveNodesToScan(morselIdx)) {
+            return sharedState->getMorselNodeOffsets(morselIdx);
+        }
+    }
+}
+
 bool ScanNodeID::getNextTuples() {
     metrics->executionTime.start();
     do {
-        auto [startOffset, endOffset] = sharedState->getNextRangeToRead();
+        auto [startOffset, endOffset] = getNextRangeToRead();
         if (startOffset >= endOffset) {
             metrics->executionTime.stop();
             return false;
@@ -100,5 +140,21 @@ void ScanNodeID::setSelVector(node_offset_t startOffset, node_offset_t endOffset
         transaction, outValueVector, nodeTable->getTableID());
 }
 
+void ScanNodeID::printMetricsToJson(nlohmann::json& json, Profiler& profiler) {
+    printTimeAndNumOutputMetrics(json, profiler);
+    json["numMorsels"] = profiler.sumAllNumericMetricsWithKey(getNumMorselsMetricKey());
+    json["morselClaimTime"] =
+        to_string(profiler.sumAllTimeMetricsWithKey(getMorselClaimTimeMetricKey()));
+}
+
+vector<string> ScanNodeID::getAttributes(Profiler& profiler) const {
+    auto attributes = PhysicalOperator::getAttributes(profiler);
+    attributes.emplace_back(
+        "NumMorsels: " + to_string(profiler.sumAllNumericMetricsWithKey(getNumMorselsMetricKey())));
+    attributes.emplace_back("MorselClaimTime: " +
+        to_string(profiler.sumAllTimeMetricsWithKey(getMorselClaimTimeMetricKey())));
+    return attributes;
+}
+
 } // namespace processor
 } // namespace kuzu
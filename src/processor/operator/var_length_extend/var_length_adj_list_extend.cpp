@@ -83,7 +83,7 @@ bool VarLengthAdjListExtend::addDFSLevelToStackIfParentExtends(uint64_t parent,
     auto dfsLevelInfo = static_pointer_cast<AdjListExtendDFSLevelInfo>(dfsLevelInfos[level - 1]);
     dfsLevelInfo->reset(parent);
     ((AdjLists*)storage)
-        ->initListReadingState(parent, *dfsLevelInfo->listHandle, transaction->getType());
+        ->initListReadingState(parent, *dfsLevelInfo->listHandle, transaction->getVersionToRead());
     ((AdjLists*)storage)->readValues(dfsLevelInfo->children, *dfsLevelInfo->listHandle);
     if (dfsLevelInfo->children->state->selVector->selectedSize != 0) {
         dfsStack.emplace(move(dfsLevelInfo));
@@ -32,7 +32,8 @@ shared_ptr<FactorizedTable> QueryProcessor::execute(
         // The root pipeline(task) consists of operators and its prevOperator only, because we
         // expect to have linear plans. For binary operators, e.g., HashJoin, we  keep probe and its
         // prevOperator in the same pipeline, and decompose build and its prevOperator into another
-        // one.
+        // one. Child tasks of a task, e.g., the build sides of multiple hash joins on the same
+        // probe pipeline, do not depend on each other and are run concurrently by the scheduler.
         auto task = make_shared<ProcessorTask>(resultCollector, context);
         decomposePlanIntoTasks(lastOperator, lastOperator, task.get(), context);
         taskScheduler->scheduleTaskAndWaitOrError(task);
@@ -62,11 +63,14 @@ void QueryProcessor::decomposePlanIntoTasks(
         parentTask->setSingleThreadedTask();
     } break;
     case ORDER_BY:
+    case TOP_K:
     case HASH_JOIN_BUILD:
     case INTERSECT_BUILD: {
-        auto childTask = make_unique<ProcessorTask>(reinterpret_cast<Sink*>(op), context);
+        auto sink = reinterpret_cast<Sink*>(op);
+        auto childTask = make_unique<ProcessorTask>(sink, context);
         decomposePlanIntoTasks(op->getChild(0), op, childTask.get(), context);
-        parentTask->addChildTask(move(childTask));
+        parentTask->addChildTask(
+            addParallelFinalizeTaskIfNecessary(sink, move(childTask), context));
     } break;
     case AGGREGATE: {
         auto aggregate = (BaseAggregate*)op;
@@ -75,11 +79,34 @@ void QueryProcessor::decomposePlanIntoTasks(
             childTask->setSingleThreadedTask();
         }
         decomposePlanIntoTasks(op->getChild(0), op, childTask.get(), context);
-        parentTask->addChildTask(move(childTask));
+        parentTask->addChildTask(
+            addParallelFinalizeTaskIfNecessary(aggregate, move(childTask), context));
     } break;
     case INDEX_SCAN: {
         parentTask->setSingleThreadedTask();
     } break;
+    case HASH_JOIN_PROBE: {
+        if (op->getNumChildren() == 3) {
+            // The third child of an accumulated (ASP or ACC) hash join is the pipeline that
+            // accumulates the probe side. The build side reads what it produces, i.e., the semi
+            // mask of ASP joins or the accumulated tuples of ACC joins, so the accumulate task is a
+            // dependency of the build task instead of a sibling that may run concurrently with it.
+            auto hashJoinBuild = op->getChild(1);
+            assert(hashJoinBuild->getOperatorType() == HASH_JOIN_BUILD);
+            auto sink = reinterpret_cast<Sink*>(hashJoinBuild);
+            auto buildTask = make_unique<ProcessorTask>(sink, context);
+            decomposePlanIntoTasks(op->getChild(2), op, buildTask.get(), context);
+            decomposePlanIntoTasks(
+                hashJoinBuild->getChild(0), hashJoinBuild, buildTask.get(), context);
+            parentTask->addChildTask(
+                addParallelFinalizeTaskIfNecessary(sink, move(buildTask), context));
+            decomposePlanIntoTasks(op->getChild(0), op, parentTask, context);
+        } else {
+            for (auto i = (int64_t)op->getNumChildren() - 1; i >= 0; --i) {
+                decomposePlanIntoTasks(op->getChild(i), op, parentTask, context);
+            }
+        }
+    } break;
     default: {
         // Schedule the right most side (e.g., build side of the hash join) first.
         for (auto i = (int64_t)op->getNumChildren() - 1; i >= 0; --i) {
@@ -89,6 +116,16 @@ void QueryProcessor::decomposePlanIntoTasks(
     }
 }
 
+unique_ptr<Task> QueryProcessor::addParallelFinalizeTaskIfNecessary(
+    Sink* sink, unique_ptr<Task> sinkTask, ExecutionContext* context) {
+    if (!sink->hasParallelFinalize()) {
+        return sinkTask;
+    }
+    auto finalizeTask = make_unique<ParallelFinalizeTask>(sink, context);
+    finalizeTask->addChildTask(move(sinkTask));
+    return finalizeTask;
+}
+
 shared_ptr<FactorizedTable> QueryProcessor::getFactorizedTableForOutputMsg(
     string& outputMsg, MemoryManager* memoryManager) {
     auto ftTableSchema = make_unique<FactorizedTableSchema>();
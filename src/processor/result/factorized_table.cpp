@@ -125,6 +125,24 @@ uint8_t* FactorizedTable::appendEmptyTuple() {
     return tuplePtr;
 }
 
+void FactorizedTable::removeLastTuples(uint64_t numTuplesToRemove) {
+    assert(numTuplesToRemove <= numTuples);
+    numTuples -= numTuplesToRemove;
+    auto& blocks = flatTupleBlockCollection->getBlocks();
+    while (numTuplesToRemove > 0) {
+        auto& block = blocks.back();
+        auto numTuplesToRemoveInBlock = min(numTuplesToRemove, (uint64_t)block->numTuples);
+        block->numTuples -= numTuplesToRemoveInBlock;
+        block->freeSize += numTuplesToRemoveInBlock * tableSchema->getNumBytesPerTuple();
+        numTuplesToRemove -= numTuplesToRemoveInBlock;
+        // Appending only looks at the last block, so empty blocks are dropped to keep all blocks
+        // but the last one full.
+        if (block->numTuples == 0) {
+            blocks.pop_back();
+        }
+    }
+}
+
 void FactorizedTable::scan(vector<shared_ptr<ValueVector>>& vectors, uint64_t tupleIdx,
     uint64_t numTuplesToScan, vector<uint32_t>& colIdxesToScan) const {
     assert(tupleIdx + numTuplesToScan <= numTuples);
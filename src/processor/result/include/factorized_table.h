@@ -172,6 +172,10 @@ public:
     //! tuple.
     uint8_t* appendEmptyTuple();
 
+    // Removes the last numTuplesToRemove appended tuples. Memory that these tuples hold in unflat
+    // tuple blocks and the overflow buffer is not reclaimed.
+    void removeLastTuples(uint64_t numTuplesToRemove);
+
     // This function scans numTuplesToScan of rows to vectors starting at tupleIdx. Callers are
     // responsible for making sure all the parameters are valid.
     inline void scan(vector<shared_ptr<ValueVector>>& vectors, uint64_t tupleIdx,
@@ -197,6 +201,13 @@ public:
     void merge(FactorizedTable& other);
 
     inline InMemOverflowBuffer* getInMemOverflowBuffer() const { return inMemOverflowBuffer.get(); }
+    // Replaces the inMemOverflowBuffer with an empty one and returns the old one, so the caller can
+    // copy the overflow values it still needs before releasing the old buffer.
+    inline unique_ptr<InMemOverflowBuffer> resetInMemOverflowBuffer() {
+        auto oldInMemOverflowBuffer = move(inMemOverflowBuffer);
+        inMemOverflowBuffer = make_unique<InMemOverflowBuffer>(memoryManager);
+        return oldInMemOverflowBuffer;
+    }
 
     bool hasUnflatCol() const;
     inline bool hasUnflatCol(vector<uint32_t>& colIdxes) const {
@@ -11,10 +11,14 @@ using namespace kuzu::common;
 namespace kuzu {
 namespace storage {
 
-BufferManager::BufferManager(uint64_t maxSizeForDefaultPagePool, uint64_t maxSizeForLargePagePool)
+BufferManager::BufferManager(uint64_t maxSizeForDefaultPagePool, uint64_t maxSizeForLargePagePool,
+    BufferPoolReplacementPolicy replacementPolicy, bool isReadOnlyMemoryMappedMode)
     : logger{LoggerUtils::getOrCreateLogger("buffer_manager")},
-      bufferPoolDefaultPages(make_unique<BufferPool>(DEFAULT_PAGE_SIZE, maxSizeForDefaultPagePool)),
-      bufferPoolLargePages(make_unique<BufferPool>(LARGE_PAGE_SIZE, maxSizeForLargePagePool)) {
+      bufferPoolDefaultPages(make_unique<BufferPool>(
+          DEFAULT_PAGE_SIZE, maxSizeForDefaultPagePool, replacementPolicy)),
+      bufferPoolLargePages(
+          make_unique<BufferPool>(LARGE_PAGE_SIZE, maxSizeForLargePagePool, replacementPolicy)),
+      isReadOnlyMemoryMappedMode{isReadOnlyMemoryMappedMode} {
     logger->info("Done Initializing Buffer Manager.");
 }
 
@@ -37,6 +41,9 @@ void BufferManager::resize(uint64_t newSizeForDefaultPagePool, uint64_t newSizeF
 // (3) If multiple threads are writing to the page, they should coordinate separately because they
 // both get access to the same piece of memory.
 uint8_t* BufferManager::pin(FileHandle& fileHandle, page_idx_t pageIdx) {
+    if (fileHandle.isMemoryMapped()) {
+        return fileHandle.getMappedPage(pageIdx);
+    }
     return fileHandle.isLargePaged() ? bufferPoolLargePages->pin(fileHandle, pageIdx) :
                                        bufferPoolDefaultPages->pin(fileHandle, pageIdx);
 }
@@ -50,6 +57,7 @@ uint8_t* BufferManager::pin(FileHandle& fileHandle, page_idx_t pageIdx) {
 // (with serious side effects). See the detailed explanation in FileHandle::addNewPage() for
 // details.
 uint8_t* BufferManager::pinWithoutReadingFromFile(FileHandle& fileHandle, page_idx_t pageIdx) {
+    assert(!fileHandle.isMemoryMapped());
     return fileHandle.isLargePaged() ?
                bufferPoolLargePages->pinWithoutReadingFromFile(fileHandle, pageIdx) :
                bufferPoolDefaultPages->pinWithoutReadingFromFile(fileHandle, pageIdx);
@@ -57,21 +65,58 @@ uint8_t* BufferManager::pinWithoutReadingFromFile(FileHandle& fileHandle, page_i
 
 // Important Note: The caller should make sure that they have pinned the page before calling this.
 void BufferManager::setPinnedPageDirty(FileHandle& fileHandle, page_idx_t pageIdx) {
+    assert(!fileHandle.isMemoryMapped());
     fileHandle.isLargePaged() ? bufferPoolLargePages->setPinnedPageDirty(fileHandle, pageIdx) :
                                 bufferPoolDefaultPages->setPinnedPageDirty(fileHandle, pageIdx);
 }
 
+void BufferManager::prefetch(
+    FileHandle& fileHandle, page_idx_t startPageIdx, uint64_t numPagesToPrefetch) {
+    if (fileHandle.isNewTmpFile() || startPageIdx >= fileHandle.getNumPages()) {
+        return;
+    }
+    auto endPageIdx = (page_idx_t)min(
+        (uint64_t)fileHandle.getNumPages(), (uint64_t)startPageIdx + numPagesToPrefetch);
+    auto& bmMetrics = fileHandle.isLargePaged() ? bufferPoolLargePages->bmMetrics :
+                                                  bufferPoolDefaultPages->bmMetrics;
+    // Prefetch each run of consecutive pages that are not in frames with a single hint.
+    auto runStartPageIdx = startPageIdx;
+    for (auto pageIdx = startPageIdx; pageIdx < endPageIdx; ++pageIdx) {
+        if (FileHandle::isAFrame(fileHandle.getFrameIdx(pageIdx))) {
+            if (runStartPageIdx < pageIdx) {
+                fileHandle.prefetchPages(runStartPageIdx, pageIdx - runStartPageIdx);
+                bmMetrics.numPrefetchedPages.fetch_add(
+                    pageIdx - runStartPageIdx, memory_order_relaxed);
+            }
+            runStartPageIdx = pageIdx + 1;
+        }
+    }
+    if (runStartPageIdx < endPageIdx) {
+        fileHandle.prefetchPages(runStartPageIdx, endPageIdx - runStartPageIdx);
+        bmMetrics.numPrefetchedPages.fetch_add(endPageIdx - runStartPageIdx, memory_order_relaxed);
+    }
+}
+
 void BufferManager::unpin(FileHandle& fileHandle, page_idx_t pageIdx) {
+    if (fileHandle.isMemoryMapped()) {
+        return;
+    }
     return fileHandle.isLargePaged() ? bufferPoolLargePages->unpin(fileHandle, pageIdx) :
                                        bufferPoolDefaultPages->unpin(fileHandle, pageIdx);
 }
 
 void BufferManager::removeFilePagesFromFrames(FileHandle& fileHandle) {
+    if (fileHandle.isMemoryMapped()) {
+        return;
+    }
     fileHandle.isLargePaged() ? bufferPoolLargePages->removeFilePagesFromFrames(fileHandle) :
                                 bufferPoolDefaultPages->removeFilePagesFromFrames(fileHandle);
 }
 
 void BufferManager::flushAllDirtyPagesInFrames(FileHandle& fileHandle) {
+    if (fileHandle.isMemoryMapped()) {
+        return;
+    }
     fileHandle.isLargePaged() ? bufferPoolLargePages->flushAllDirtyPagesInFrames(fileHandle) :
                                 bufferPoolDefaultPages->flushAllDirtyPagesInFrames(fileHandle);
 }
@@ -94,28 +139,44 @@ void BufferManager::removePageFromFrameIfNecessary(FileHandle& fileHandle, page_
 unique_ptr<nlohmann::json> BufferManager::debugInfo() {
     return make_unique<nlohmann::json>(nlohmann::json{{"BufferManager",
         {
+            {"ReplacementPolicy",
+                getReplacementPolicy() == BufferPoolReplacementPolicy::CLOCK_2Q ? "CLOCK_2Q" :
+                                                                                  "CLOCK"},
             {"BufferPoolDefaultPages-numFrames", bufferPoolDefaultPages->numFrames},
-            {"BufferPoolDefaultPages-numCacheHits", bufferPoolDefaultPages->bmMetrics.numCacheHit},
+            {"BufferPoolDefaultPages-numCacheHits",
+                bufferPoolDefaultPages->bmMetrics.numCacheHit.load()},
             {"BufferPoolDefaultPages-numCacheMisses",
-                bufferPoolDefaultPages->bmMetrics.numCacheMiss},
-            {"BufferPoolDefaultPages-numPins", bufferPoolDefaultPages->bmMetrics.numPins},
-            {"BufferPoolDefaultPages-numEvicts", bufferPoolDefaultPages->bmMetrics.numEvicts},
+                bufferPoolDefaultPages->bmMetrics.numCacheMiss.load()},
+            {"BufferPoolDefaultPages-numPins", bufferPoolDefaultPages->bmMetrics.numPins.load()},
+            {"BufferPoolDefaultPages-numEvicts",
+                bufferPoolDefaultPages->bmMetrics.numEvicts.load()},
             {"BufferPoolDefaultPages-numEvictFails",
-                bufferPoolDefaultPages->bmMetrics.numEvictFails},
+                bufferPoolDefaultPages->bmMetrics.numEvictFails.load()},
             {"BufferPoolDefaultPages-numRecentlyAccessedWalkover",
-                bufferPoolDefaultPages->bmMetrics.numRecentlyAccessedWalkover},
+                bufferPoolDefaultPages->bmMetrics.numRecentlyAccessedWalkover.load()},
             {"BufferPoolDefaultPages-numDirtyPageWriteIO",
-                bufferPoolDefaultPages->bmMetrics.numDirtyPageWriteIO},
+                bufferPoolDefaultPages->bmMetrics.numDirtyPageWriteIO.load()},
+            {"BufferPoolDefaultPages-numOptimisticPinFails",
+                bufferPoolDefaultPages->bmMetrics.numOptimisticPinFails.load()},
+            {"BufferPoolDefaultPages-numPrefetchedPages",
+                bufferPoolDefaultPages->bmMetrics.numPrefetchedPages.load()},
             {"BufferPoolLargePages-numFrames", bufferPoolLargePages->numFrames},
-            {"BufferPoolLargePages-numPins", bufferPoolLargePages->bmMetrics.numPins},
-            {"BufferPoolLargePages-numEvicts", bufferPoolLargePages->bmMetrics.numEvicts},
-            {"BufferPoolLargePages-numEvictFails", bufferPoolLargePages->bmMetrics.numEvictFails},
-            {"BufferPoolLargePages-numCacheHits", bufferPoolLargePages->bmMetrics.numCacheHit},
-            {"BufferPoolLargePages-numCacheMisses", bufferPoolLargePages->bmMetrics.numCacheMiss},
+            {"BufferPoolLargePages-numPins", bufferPoolLargePages->bmMetrics.numPins.load()},
+            {"BufferPoolLargePages-numEvicts", bufferPoolLargePages->bmMetrics.numEvicts.load()},
+            {"BufferPoolLargePages-numEvictFails",
+                bufferPoolLargePages->bmMetrics.numEvictFails.load()},
+            {"BufferPoolLargePages-numCacheHits",
+                bufferPoolLargePages->bmMetrics.numCacheHit.load()},
+            {"BufferPoolLargePages-numCacheMisses",
+                bufferPoolLargePages->bmMetrics.numCacheMiss.load()},
             {"BufferPoolLargePages-numRecentlyAccessedWalkover",
-                bufferPoolLargePages->bmMetrics.numRecentlyAccessedWalkover},
+                bufferPoolLargePages->bmMetrics.numRecentlyAccessedWalkover.load()},
             {"BufferPoolLargePages-numDirtyPageWriteIO",
-                bufferPoolLargePages->bmMetrics.numDirtyPageWriteIO},
+                bufferPoolLargePages->bmMetrics.numDirtyPageWriteIO.load()},
+            {"BufferPoolLargePages-numOptimisticPinFails",
+                bufferPoolLargePages->bmMetrics.numOptimisticPinFails.load()},
+            {"BufferPoolLargePages-numPrefetchedPages",
+                bufferPoolLargePages->bmMetrics.numPrefetchedPages.load()},
         }}});
 }
 
@@ -1,4 +1,6 @@
 
+#include <thread>
+
 #include "spdlog/spdlog.h"
 
 #include "src/common/include/configs.h"
@@ -28,7 +30,7 @@ void Frame::resetFrameWithoutLock() {
     fileHandlePtr = -1u;
     pageIdx = -1u;
     pinCount = -1u;
-    recentlyAccessed = false;
+    recentAccessCount = 0;
     isDirty = false;
 }
 
@@ -41,13 +43,31 @@ bool Frame::acquireFrameLock(bool block) {
     return !frameLock.test_and_set();
 }
 
-BufferPool::BufferPool(uint64_t pageSize, uint64_t maxSize)
-    : logger{LoggerUtils::getOrCreateLogger("buffer_manager")}, pageSize{pageSize}, clockHand{0},
+bool Frame::tryIncrementPinCount() {
+    auto currPinCount = pinCount.load();
+    do {
+        if (-1u == currPinCount || EVICTING_PIN_COUNT == currPinCount) {
+            return false;
+        }
+    } while (!pinCount.compare_exchange_weak(currPinCount, currPinCount + 1));
+    return true;
+}
+
+BufferPool::BufferPool(
+    uint64_t pageSize, uint64_t maxSize, BufferPoolReplacementPolicy replacementPolicy)
+    : logger{LoggerUtils::getOrCreateLogger("buffer_manager")}, pageSize{pageSize},
+      replacementPolicy{replacementPolicy},
       numFrames((page_idx_t)(ceil((double)maxSize / (double)pageSize))) {
     assert(pageSize == DEFAULT_PAGE_SIZE || pageSize == LARGE_PAGE_SIZE);
     for (auto i = 0u; i < numFrames; ++i) {
         bufferCache.emplace_back(make_unique<Frame>(pageSize));
     }
+    // The number of partitions is fixed for the lifetime of the pool. Resizing the pool only
+    // changes the number of frames in each partition.
+    numClockPartitions = max(1u,
+        min(max(1u, thread::hardware_concurrency()),
+            (uint32_t)(numFrames / StorageConfig::MIN_NUM_FRAMES_PER_CLOCK_PARTITION)));
+    clockPartitions = make_unique<ClockPartition[]>(numClockPartitions);
     logger->info("Initializing Buffer Pool.");
     logger->info("BufferPool Size {}B, #{}byte-pages {}.", maxSize, pageSize,
         ceil((double)maxSize / (double)pageSize));
@@ -91,6 +111,19 @@ void BufferPool::removePageFromFrame(FileHandle& fileHandle, page_idx_t pageIdx,
         frame->acquireFrameLock(true /* block */);
         if (shouldFlush) {
             flushIfDirty(frame);
+            frame->setIsDirty(false /* isDirty */);
+        }
+        // Optimistic pins do not acquire the page lock, so the frame is claimed the same way it is
+        // claimed for eviction, by atomically moving its pinCount from 0 to EVICTING_PIN_COUNT.
+        // The page must not stay in its frame, e.g., after WAL::clearWAL resets the page to frame
+        // mapping of the fileHandle, so we wait until concurrent pins are released. Unpinning does
+        // not acquire the page or frame lock.
+        auto expectedPinCount = 0u;
+        while (
+            !frame->pinCount.compare_exchange_weak(expectedPinCount, Frame::EVICTING_PIN_COUNT)) {
+            assert(expectedPinCount != -1u && expectedPinCount != Frame::EVICTING_PIN_COUNT);
+            expectedPinCount = 0u;
+            this_thread::yield();
         }
         clearFrameAndUnswizzleWithoutLock(frame, fileHandle, pageIdx);
         frame->releaseFrameLock();
@@ -121,28 +154,57 @@ void BufferPool::updateFrameIfPageIsInFrameWithoutPageOrFrameLock(
 }
 
 uint8_t* BufferPool::pin(FileHandle& fileHandle, page_idx_t pageIdx, bool doNotReadFromFile) {
+    auto retVal = pinIfInFrameWithoutPageLock(fileHandle, pageIdx);
+    if (retVal != nullptr) {
+        bmMetrics.numCacheHit.fetch_add(1, memory_order_relaxed);
+        bmMetrics.numPins.fetch_add(1, memory_order_relaxed);
+        return retVal;
+    }
     fileHandle.acquirePageLock(pageIdx, true /*block*/);
-    auto retVal = pinWithoutAcquiringPageLock(fileHandle, pageIdx, doNotReadFromFile);
+    retVal = pinWithoutAcquiringPageLock(fileHandle, pageIdx, doNotReadFromFile);
     fileHandle.releasePageLock(pageIdx);
     return retVal;
 }
 
+uint8_t* BufferPool::pinIfInFrameWithoutPageLock(FileHandle& fileHandle, page_idx_t pageIdx) {
+    auto frameIdx = fileHandle.getFrameIdx(pageIdx);
+    if (!FileHandle::isAFrame(frameIdx)) {
+        return nullptr;
+    }
+    auto& frame = bufferCache[frameIdx];
+    if (!frame->tryIncrementPinCount()) {
+        bmMetrics.numOptimisticPinFails.fetch_add(1, memory_order_relaxed);
+        return nullptr;
+    }
+    // The page may have been evicted from the frame and the frame may have been refilled with
+    // another page after we read frameIdx. Validating after the increment is safe because a pinned
+    // frame cannot be evicted and a frame's page is set before its pinCount becomes positive.
+    if (!frame->holdsPage(fileHandle, pageIdx)) {
+        frame->pinCount.fetch_sub(1);
+        bmMetrics.numOptimisticPinFails.fetch_add(1, memory_order_relaxed);
+        return nullptr;
+    }
+    recordAccess(*frame);
+    return frame->buffer.get();
+}
+
 uint8_t* BufferPool::pinWithoutAcquiringPageLock(
     FileHandle& fileHandle, page_idx_t pageIdx, bool doNotReadFromFile) {
     auto frameIdx = fileHandle.getFrameIdx(pageIdx);
     if (FileHandle::isAFrame(frameIdx)) {
+        // The caller holds the page lock, so the page cannot be evicted from its frame.
         auto& frame = bufferCache[frameIdx];
         frame->pinCount.fetch_add(1);
-        frame->recentlyAccessed = true;
-        //        bmMetrics.numCacheHit += 1;
+        recordAccess(*frame);
+        bmMetrics.numCacheHit.fetch_add(1, memory_order_relaxed);
     } else {
         frameIdx = claimAFrame(fileHandle, pageIdx, doNotReadFromFile);
         fileHandle.swizzle(pageIdx, frameIdx);
         if (!doNotReadFromFile) {
-            bmMetrics.numCacheMiss += 1;
+            bmMetrics.numCacheMiss.fetch_add(1, memory_order_relaxed);
         }
     }
-    bmMetrics.numPins += 1;
+    bmMetrics.numPins.fetch_add(1, memory_order_relaxed);
     return bufferCache[fileHandle.getFrameIdx(pageIdx)]->buffer.get();
 }
 
@@ -162,20 +224,41 @@ void BufferPool::setPinnedPageDirty(FileHandle& fileHandle, page_idx_t pageIdx)
 
 page_idx_t BufferPool::claimAFrame(
     FileHandle& fileHandle, page_idx_t pageIdx, bool doNotReadFromFile) {
+    // Threads are mapped to partitions by their ids and move on to the next partitions only if they
+    // cannot claim a frame in their own partition.
+    auto startPartitionIdx = hash<thread::id>{}(this_thread::get_id()) % numClockPartitions;
+    for (auto i = 0u; i < numClockPartitions; ++i) {
+        auto partitionIdx = (startPartitionIdx + i) % numClockPartitions;
+        auto frameIdx =
+            claimAFrameInPartition(partitionIdx, fileHandle, pageIdx, doNotReadFromFile);
+        if (FileHandle::isAFrame(frameIdx)) {
+            return frameIdx;
+        }
+    }
+    throw BufferManagerException("Cannot find a frame to evict from.");
+}
+
+page_idx_t BufferPool::claimAFrameInPartition(
+    uint32_t partitionIdx, FileHandle& fileHandle, page_idx_t pageIdx, bool doNotReadFromFile) {
+    auto startFrameIdx = getPartitionStartFrameIdx(partitionIdx);
+    auto numFramesInPartition = getPartitionStartFrameIdx(partitionIdx + 1) - startFrameIdx;
+    auto& clockHand = clockPartitions[partitionIdx].clockHand;
     auto localClockHand = clockHand.load();
-    auto startFrame = localClockHand % numFrames;
-    for (auto i = 0u; i < 2 * numFrames; ++i) {
-        auto frameIdx = (startFrame + i) % numFrames;
+    // Each visit of an unpinned frame takes one off its recentAccessCount, so a frame is evicted at
+    // the latest in the (getMaxRecentAccessCount() + 1)-th pass over the partition.
+    auto numFramesToVisit = (getMaxRecentAccessCount() + 1ul) * numFramesInPartition;
+    for (auto i = 0ul; i < numFramesToVisit; ++i) {
+        auto frameIdx = startFrameIdx + (localClockHand + i) % numFramesInPartition;
         auto pinCount = bufferCache[frameIdx]->pinCount.load();
         if (-1u == pinCount && fillEmptyFrame(frameIdx, fileHandle, pageIdx, doNotReadFromFile)) {
-            moveClockHand(localClockHand + i + 1);
+            moveClockHand(clockHand, localClockHand + i + 1);
             return frameIdx;
         } else if (0u == pinCount && tryEvict(frameIdx, fileHandle, pageIdx, doNotReadFromFile)) {
-            moveClockHand(localClockHand + i + 1);
+            moveClockHand(clockHand, localClockHand + i + 1);
             return frameIdx;
         }
     }
-    throw BufferManagerException("Cannot find a frame to evict from.");
+    return UINT32_MAX;
 }
 
 bool BufferPool::fillEmptyFrame(
@@ -196,9 +279,9 @@ bool BufferPool::fillEmptyFrame(
 bool BufferPool::tryEvict(
     page_idx_t frameIdx, FileHandle& fileHandle, page_idx_t pageIdx, bool doNotReadFromFile) {
     auto& frame = bufferCache[frameIdx];
-    if (frame->recentlyAccessed) {
-        frame->recentlyAccessed = false;
-        bmMetrics.numRecentlyAccessedWalkover += 1;
+    if (frame->recentAccessCount > 0) {
+        frame->recentAccessCount--;
+        bmMetrics.numRecentlyAccessedWalkover.fetch_add(1, memory_order_relaxed);
         return false;
     }
     if (!frame->acquireFrameLock(false)) {
@@ -207,14 +290,16 @@ bool BufferPool::tryEvict(
     auto pageIdxInFrame = frame->pageIdx.load();
     auto fileHandleInFrame = reinterpret_cast<FileHandle*>(frame->fileHandlePtr.load());
     if (!fileHandleInFrame->acquirePageLock(pageIdxInFrame, false)) {
-        bmMetrics.numEvictFails += 1;
+        bmMetrics.numEvictFails.fetch_add(1, memory_order_relaxed);
         frame->releaseFrameLock();
         return false;
     }
-    // We check pinCount again after acquiring the lock on page currently residing in the frame. At
-    // this point in time, no other thread can change the pinCount.
-    if (0u != frame->pinCount.load()) {
-        bmMetrics.numEvictFails += 1;
+    // We check pinCount again after acquiring the lock on page currently residing in the frame.
+    // Pinning a page in a frame does not require its page lock, so we atomically move the pinCount
+    // from 0 to EVICTING_PIN_COUNT, after which no other thread can pin the frame.
+    auto expectedPinCount = 0u;
+    if (!frame->pinCount.compare_exchange_strong(expectedPinCount, Frame::EVICTING_PIN_COUNT)) {
+        bmMetrics.numEvictFails.fetch_add(1, memory_order_relaxed);
         fileHandleInFrame->releasePageLock(pageIdxInFrame);
         frame->releaseFrameLock();
         return false;
@@ -227,7 +312,7 @@ bool BufferPool::tryEvict(
     // Update the frame information and release the lock on frame.
     readNewPageIntoFrame(*frame, fileHandle, pageIdx, doNotReadFromFile);
     frame->releaseFrameLock();
-    bmMetrics.numEvicts += 1;
+    bmMetrics.numEvicts.fetch_add(1, memory_order_relaxed);
     return true;
 }
 
@@ -235,7 +320,7 @@ void BufferPool::flushIfDirty(const unique_ptr<Frame>& frame) {
     auto fileHandleInFrame = reinterpret_cast<FileHandle*>(frame->fileHandlePtr.load());
     auto pageIdxInFrame = frame->pageIdx.load();
     if (frame->isDirty) {
-        bmMetrics.numDirtyPageWriteIO += 1;
+        bmMetrics.numDirtyPageWriteIO.fetch_add(1, memory_order_relaxed);
         fileHandleInFrame->writePage(frame->buffer.get(), pageIdxInFrame);
     }
 }
@@ -248,17 +333,27 @@ void BufferPool::clearFrameAndUnswizzleWithoutLock(
 
 void BufferPool::readNewPageIntoFrame(
     Frame& frame, FileHandle& fileHandle, page_idx_t pageIdx, bool doNotReadFromFile) {
-    frame.pinCount.store(1);
-    frame.recentlyAccessed = true;
+    // Under CLOCK_2Q, a page that is read into a frame is probationary until it is pinned again.
+    frame.recentAccessCount = replacementPolicy == BufferPoolReplacementPolicy::CLOCK ? 1 : 0;
     frame.isDirty = false;
-    frame.pageIdx.store(pageIdx);
-    frame.fileHandlePtr.store(reinterpret_cast<uint64_t>(&fileHandle));
     if (!doNotReadFromFile) {
         fileHandle.readPage(frame.buffer.get(), pageIdx);
     }
+    frame.pageIdx.store(pageIdx);
+    frame.fileHandlePtr.store(reinterpret_cast<uint64_t>(&fileHandle));
+    // The pinCount is set last, so an optimistic pin that succeeds to increment it observes the
+    // new page and its contents.
+    frame.pinCount.store(1);
+}
+
+void BufferPool::recordAccess(Frame& frame) const {
+    // Avoid writing to the frame's cache line if the count is already at its maximum.
+    if (frame.recentAccessCount < getMaxRecentAccessCount()) {
+        frame.recentAccessCount++;
+    }
 }
 
-void BufferPool::moveClockHand(uint64_t newClockHand) {
+void BufferPool::moveClockHand(atomic<uint64_t>& clockHand, uint64_t newClockHand) {
     do {
         auto currClockHand = clockHand.load();
         if (currClockHand > newClockHand) {
@@ -270,10 +365,10 @@ void BufferPool::moveClockHand(uint64_t newClockHand) {
     } while (true);
 }
 
+// Unpinning does not need the page lock: the page is pinned by the caller, so it cannot be evicted
+// and its frameIdx cannot change until its pinCount is decremented.
 void BufferPool::unpin(FileHandle& fileHandle, page_idx_t pageIdx) {
-    fileHandle.acquirePageLock(pageIdx, true /*block*/);
     unpinWithoutAcquiringPageLock(fileHandle, pageIdx);
-    fileHandle.releasePageLock(pageIdx);
 }
 
 void BufferPool::unpinWithoutAcquiringPageLock(FileHandle& fileHandle, page_idx_t pageIdx) {
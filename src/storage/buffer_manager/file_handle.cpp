@@ -11,7 +11,7 @@ namespace kuzu {
 namespace storage {
 
 FileHandle::FileHandle(const string& path, uint8_t flags)
-    : logger{LoggerUtils::getOrCreateLogger("storage")}, flags(flags) {
+    : logger{LoggerUtils::getOrCreateLogger("storage")}, flags(flags), mappedFile{nullptr} {
     logger->trace("FileHandle: Path {}", path);
     if (!isNewTmpFile()) {
         constructExistingFileHandle(path);
@@ -21,17 +21,25 @@ FileHandle::FileHandle(const string& path, uint8_t flags)
 }
 
 FileHandle::~FileHandle() {
+    if (mappedFile != nullptr) {
+        FileUtils::unmapFile(mappedFile, numPages * getPageSize());
+    }
     if (!isNewTmpFile()) {
         FileUtils::closeFile(fileInfo->fd);
     }
 }
 
 void FileHandle::constructExistingFileHandle(const string& path) {
-    int openFlags = O_RDWR | ((createFileIfNotExists()) ? O_CREAT : 0x00000000);
+    int openFlags =
+        isReadOnly() ? O_RDONLY : O_RDWR | ((createFileIfNotExists()) ? O_CREAT : 0x00000000);
     fileInfo = FileUtils::openFile(path, openFlags);
     auto fileLength = FileUtils::getFileSize(fileInfo->fd);
     numPages = ceil((double)fileLength / (double)getPageSize());
     logger->trace("FileHandle[disk]: Size {}B, #{}B-pages {}", fileLength, getPageSize(), numPages);
+    if (isMemoryMapped() && numPages > 0) {
+        // The part of the last page beyond the end of the file reads as zeros.
+        mappedFile = FileUtils::mapFileForReading(fileInfo.get(), numPages * getPageSize());
+    }
     pageCapacity = numPages;
     initPageIdxToFrameMapAndLocks();
 }
@@ -40,7 +40,9 @@ namespace storage {
  * delegated to the OS).
  *
  * The BM uses CLOCK replacement policy to evict pages from frames, which is an approximate LRU
- * policy that is based of FIFO-like operations.
+ * policy that is based of FIFO-like operations. Alternatively, the BM can be configured to use the
+ * scan-resistant CLOCK_2Q policy (see BufferPoolReplacementPolicy), which protects repeatedly
+ * accessed pages from being evicted by large sequential scans.
  *
  * All access to the BM is through a FileHandle. To use the BM to acquire in-memory blocks users can
  * pin pages, which will then lead the BM to put these pages in memory, and then never unpin them
@@ -56,6 +58,13 @@ namespace storage {
  * call the page_idx_t newPageIdx = fh::addNewPage() function on the FileHandle fh they have, and
  * then call bm::pinWithoutReadingFromFile(fh, newPageIdx), and the BM will not try to read this
  * page from the file (because the page has not yet been written).
+ *
+ * In the read-only memory-mapped mode, storage structures open their files with
+ * FileHandle::O_PERSISTENT_FILE_READ_ONLY_MEMORY_MAPPED (see getStorageStructureFileFlags()).
+ * Pinning a page of a memory-mapped file returns a pointer into the mapping without taking any page
+ * or frame locks, and unpinning it is a no-op. The pages are cached in the page cache of the OS
+ * instead of the BufferPools, which is shared by all processes that read the same database. Pages
+ * of memory-mapped files cannot be written.
  */
 class BufferManager {
 
@@ -64,9 +73,23 @@ public:
         uint64_t maxSizeForDefaultPagePool = StorageConfig::DEFAULT_BUFFER_POOL_SIZE *
                                              StorageConfig::DEFAULT_PAGES_BUFFER_RATIO,
         uint64_t maxSizeForLargePagePool = StorageConfig::DEFAULT_BUFFER_POOL_SIZE *
-                                           StorageConfig::LARGE_PAGES_BUFFER_RATIO);
+                                           StorageConfig::LARGE_PAGES_BUFFER_RATIO,
+        BufferPoolReplacementPolicy replacementPolicy = BufferPoolReplacementPolicy::CLOCK,
+        bool isReadOnlyMemoryMappedMode = false);
     ~BufferManager();
 
+    inline uint8_t getStorageStructureFileFlags() const {
+        return isReadOnlyMemoryMappedMode ? FileHandle::O_PERSISTENT_FILE_READ_ONLY_MEMORY_MAPPED :
+                                            FileHandle::O_PERSISTENT_FILE_NO_CREATE;
+    }
+
+    // Files of structures that are read into memory when they are opened, e.g., list headers, are
+    // opened with the given flags, or only for reading in the read-only mode, as mapping them
+    // would not save any memory.
+    inline uint8_t getInMemStorageStructureFileFlags(uint8_t flags) const {
+        return isReadOnlyMemoryMappedMode ? FileHandle::O_PERSISTENT_FILE_READ_ONLY : flags;
+    }
+
     uint8_t* pin(FileHandle& fileHandle, page_idx_t pageIdx);
 
     // The caller should ensure that the given pageIdx is indeed a new page, so should not be read
@@ -75,6 +98,10 @@ public:
 
     inline uint8_t* pinWithoutAcquiringPageLock(
         FileHandle& fileHandle, page_idx_t pageIdx, bool doNotReadFromFile) {
+        if (fileHandle.isMemoryMapped()) {
+            assert(!doNotReadFromFile);
+            return fileHandle.getMappedPage(pageIdx);
+        }
         return fileHandle.isLargePaged() ? bufferPoolLargePages->pinWithoutAcquiringPageLock(
                                                fileHandle, pageIdx, doNotReadFromFile) :
                                            bufferPoolDefaultPages->pinWithoutAcquiringPageLock(
@@ -83,9 +110,18 @@ public:
 
     void setPinnedPageDirty(FileHandle& fileHandle, page_idx_t pageIdx);
 
+    // Starts reading the pages [startPageIdx, startPageIdx + numPagesToPrefetch) of the file in
+    // the background, so that the pages are not read synchronously one at a time when they are
+    // pinned later. Pages that are already in frames and pages beyond the end of the file are
+    // skipped. Prefetching does not pin pages or claim frames.
+    void prefetch(FileHandle& fileHandle, page_idx_t startPageIdx, uint64_t numPagesToPrefetch);
+
     // The function assumes that the requested page is already pinned.
     void unpin(FileHandle& fileHandle, page_idx_t pageIdx);
     inline void unpinWithoutAcquiringPageLock(FileHandle& fileHandle, page_idx_t pageIdx) {
+        if (fileHandle.isMemoryMapped()) {
+            return;
+        }
         return fileHandle.isLargePaged() ?
                    bufferPoolLargePages->unpinWithoutAcquiringPageLock(fileHandle, pageIdx) :
                    bufferPoolDefaultPages->unpinWithoutAcquiringPageLock(fileHandle, pageIdx);
@@ -93,6 +129,12 @@ public:
 
     unique_ptr<nlohmann::json> debugInfo();
 
+    inline BufferPoolReplacementPolicy getReplacementPolicy() const {
+        return bufferPoolDefaultPages->replacementPolicy;
+    }
+
+    inline uint64_t getNumLargePageFrames() const { return bufferPoolLargePages->numFrames; }
+
     void resize(uint64_t newSizeForDefaultPagePool, uint64_t newSizeForLargePagePool);
 
     void removeFilePagesFromFrames(FileHandle& fileHandle);
@@ -107,6 +149,7 @@ private:
     shared_ptr<spdlog::logger> logger;
     unique_ptr<BufferPool> bufferPoolDefaultPages;
     unique_ptr<BufferPool> bufferPoolLargePages;
+    bool isReadOnlyMemoryMappedMode;
 };
 
 } // namespace storage
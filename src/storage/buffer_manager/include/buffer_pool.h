@@ -17,25 +17,48 @@ class logger;
 namespace kuzu {
 namespace storage {
 
+// The replacement policy a BufferPool uses to choose the frame to evict.
+// CLOCK: Every page that is read into a frame or pinned again is marked as recently accessed, and
+// the clock hand gives recently accessed frames a second chance before evicting them.
+// CLOCK_2Q: A clock approximation of the 2Q policy. A page that is read into a frame starts in a
+// probationary state, i.e., it is not marked as recently accessed, and is evicted the first time
+// the clock hand reaches it unless it is pinned again before. Pages that are pinned again are
+// promoted and get up to CLOCK_2Q_MAX_RECENT_ACCESS_COUNT chances. Pages that are read once by
+// large sequential scans are therefore evicted before the pages that are repeatedly accessed by
+// other queries.
+enum class BufferPoolReplacementPolicy : uint8_t {
+    CLOCK = 0,
+    CLOCK_2Q = 1,
+};
+
+// Metrics are incremented concurrently, including on the lock-free optimistic pin path, so they are
+// atomic counters that are incremented with relaxed ordering.
 struct BufferManagerMetrics {
-    uint64_t numPins{0};
+    atomic<uint64_t> numPins{0};
     // Number of pinning operations that required eviction from a Frame.
-    uint64_t numEvicts{0};
+    atomic<uint64_t> numEvicts{0};
     // Number of failed tries to evict the page from a Frame. This is incremented if either the
     // eviction routine fails to get the lock on the page that is in the Frame or the pinCount of
     // the Frame has increased after taking the locks of Frame and page.
-    uint64_t numEvictFails{0};
+    atomic<uint64_t> numEvictFails{0};
     // Number of failed tried to evict the page frame a Frame because the Frame has been recently
     // accessed and hence is given a second chance.
-    uint64_t numRecentlyAccessedWalkover{0};
-    uint64_t numCacheHit{0};
-    uint64_t numCacheMiss{0};
-    uint64_t numDirtyPageWriteIO{0};
+    atomic<uint64_t> numRecentlyAccessedWalkover{0};
+    // Number of optimistic pins that found the page in a Frame but failed to validate the Frame,
+    // because the Frame was concurrently being evicted or refilled, and fell back to locking.
+    atomic<uint64_t> numOptimisticPinFails{0};
+    atomic<uint64_t> numCacheHit{0};
+    atomic<uint64_t> numCacheMiss{0};
+    atomic<uint64_t> numDirtyPageWriteIO{0};
+    // Number of pages that were hinted to the OS to be read in the background.
+    atomic<uint64_t> numPrefetchedPages{0};
 };
 
 // A frame is a unit of buffer space having a fixed size of 4KB, where a single file page is
 // read from the disk. Frame also stores other metadata to locate and maintain this buffer in the
 // Buffer Manager.
+// A frame's pinCount is -1u when the frame is empty and EVICTING_PIN_COUNT while the page in the
+// frame is being evicted. In both states the frame cannot be pinned without holding its lock.
 class Frame {
     friend class BufferPool;
 
@@ -43,9 +66,17 @@ public:
     explicit Frame(uint64_t pageSize);
     ~Frame() noexcept(false);
 
+    constexpr static uint32_t EVICTING_PIN_COUNT = UINT32_MAX - 1;
+
 private:
     void resetFrameWithoutLock();
     bool acquireFrameLock(bool block);
+    // Increments the pinCount unless the frame is empty or is being evicted.
+    bool tryIncrementPinCount();
+    inline bool holdsPage(FileHandle& fileHandle, page_idx_t pageIdxToCheck) const {
+        return fileHandlePtr.load() == reinterpret_cast<uint64_t>(&fileHandle) &&
+               pageIdx.load() == pageIdxToCheck;
+    }
     void releaseFrameLock() { frameLock.clear(); }
     void setIsDirty(bool _isDirty) { isDirty = _isDirty; }
 
@@ -56,21 +87,38 @@ private:
     atomic<page_idx_t> pageIdx;
     atomic<uint32_t> pinCount;
 
-    bool recentlyAccessed;
+    // The number of times the clock hand skips the frame before evicting it, unless the frame is
+    // accessed again in between. Each access increments it up to a policy-dependent maximum.
+    atomic<uint8_t> recentAccessCount;
     bool isDirty;
     unique_ptr<uint8_t[]> buffer;
     atomic_flag frameLock;
 };
 
+// The frames of a BufferPool are split into contiguous partitions, each with its own clock hand.
+// A thread that needs to claim a frame starts scanning from the partition it is mapped to, so
+// concurrent evictions mostly move different clock hands and scan different frames.
+struct alignas(CACHE_LINE_SIZE) ClockPartition {
+    atomic<uint64_t> clockHand{0};
+};
+
 // The BufferPool is a cache of file pages of a fixed size. It provides the high-level functionality
 // of pin() and unpin() pages of files in memory and operates via their FileHandles
 // to make the page data available in one of the frames. It uses CLOCK replacement policy to evict
-// pages from frames, which is an approximate LRU policy that is based of FIFO-like operations.
+// pages from frames, which is an approximate LRU policy that is based of FIFO-like operations, or
+// its scan-resistant CLOCK_2Q variant (see BufferPoolReplacementPolicy).
+//
+// Pinning a page that is already in a frame is optimistic and does not acquire the page lock: the
+// pinning thread increments the pinCount of the frame the page is swizzled to and then validates
+// that the frame still holds the page. Eviction atomically moves the pinCount of a frame from 0
+// to EVICTING_PIN_COUNT, so a successful increment guarantees that the frame cannot be evicted
+// until it is unpinned. If the validation fails, the pin falls back to acquiring the page lock.
 class BufferPool {
     friend class BufferManager;
 
 public:
-    BufferPool(uint64_t pageSize, uint64_t maxSize);
+    BufferPool(uint64_t pageSize, uint64_t maxSize,
+        BufferPoolReplacementPolicy replacementPolicy = BufferPoolReplacementPolicy::CLOCK);
 
     uint8_t* pin(FileHandle& fileHandle, page_idx_t pageIdx);
 
@@ -92,8 +140,8 @@ public:
     void resize(uint64_t newSize);
 
     // Note: These two functions that remove pages from frames is not designed for concurrency and
-    // therefore not tested under concurrency. If this is called while other threads are accessing
-    // the BM, it should work safely but this is not tested.
+    // therefore not tested under concurrency. If a page is pinned while it is being removed, e.g.,
+    // by a reader that pinned it optimistically, the removal waits until the page is unpinned.
     void removeFilePagesFromFrames(FileHandle& fileHandle);
 
     void flushAllDirtyPagesInFrames(FileHandle& fileHandle);
@@ -105,15 +153,27 @@ public:
 private:
     uint8_t* pin(FileHandle& fileHandle, page_idx_t pageIdx, bool doNotReadFromFile);
 
+    // Returns nullptr if the page is not in a frame or the frame could not be pinned
+    // optimistically.
+    uint8_t* pinIfInFrameWithoutPageLock(FileHandle& fileHandle, page_idx_t pageIdx);
+
     page_idx_t claimAFrame(FileHandle& fileHandle, page_idx_t pageIdx, bool doNotReadFromFile);
 
+    // Returns UINT32_MAX if no frame in the partition could be claimed.
+    page_idx_t claimAFrameInPartition(uint32_t partitionIdx, FileHandle& fileHandle,
+        page_idx_t pageIdx, bool doNotReadFromFile);
+
+    inline page_idx_t getPartitionStartFrameIdx(uint32_t partitionIdx) const {
+        return (uint64_t)numFrames * partitionIdx / numClockPartitions;
+    }
+
     bool fillEmptyFrame(
         page_idx_t frameIdx, FileHandle& fileHandle, page_idx_t pageIdx, bool doNotReadFromFile);
 
     bool tryEvict(
         page_idx_t frameIdx, FileHandle& fileHandle, page_idx_t pageIdx, bool doNotReadFromFile);
 
-    void moveClockHand(uint64_t newClockHand);
+    static void moveClockHand(atomic<uint64_t>& clockHand, uint64_t newClockHand);
     // Performs 2 actions:
     // 1) Clears the contents of the frame.
     // 2) Unswizzles the pageIdx in the frame.
@@ -124,14 +184,23 @@ private:
 
     void flushIfDirty(const unique_ptr<Frame>& frame);
 
+    void recordAccess(Frame& frame) const;
+    inline uint8_t getMaxRecentAccessCount() const {
+        return replacementPolicy == BufferPoolReplacementPolicy::CLOCK ?
+                   1 :
+                   StorageConfig::CLOCK_2Q_MAX_RECENT_ACCESS_COUNT;
+    }
+
     void removePageFromFrame(FileHandle& fileHandle, page_idx_t pageIdx, bool shouldFlush);
 
 private:
     shared_ptr<spdlog::logger> logger;
     uint64_t pageSize;
+    BufferPoolReplacementPolicy replacementPolicy;
     vector<unique_ptr<Frame>> bufferCache;
-    atomic<uint64_t> clockHand;
     page_idx_t numFrames;
+    uint32_t numClockPartitions;
+    unique_ptr<ClockPartition[]> clockPartitions;
 
     BufferManagerMetrics bmMetrics;
 };
@@ -41,9 +41,18 @@ public:
     constexpr static uint8_t isNewInMemoryTmpFileMask{0b0000'0010}; // represents 2nd LSB
     // createIfNotExistsMask only applies to existing db files; tmp i-memory files are not created
     constexpr static uint8_t createIfNotExistsMask{0b0000'0100}; // represents 3rd LSB
+    // isMemoryMappedMask only applies to existing db files that are opened for reading only. The
+    // file is mapped into memory and the Buffer Manager returns pointers into the mapping when its
+    // pages are pinned instead of reading them into frames.
+    constexpr static uint8_t isMemoryMappedMask{0b0000'1000}; // represents 4th LSB
+    // isReadOnlyMask only applies to existing db files. The file is opened for reading only, but
+    // its pages are read into frames of the Buffer Manager or into memory by the caller.
+    constexpr static uint8_t isReadOnlyMask{0b0001'0000}; // represents 5th LSB
 
     constexpr static uint8_t O_PERSISTENT_FILE_NO_CREATE{0b0000'0000};
     constexpr static uint8_t O_PERSISTENT_FILE_CREATE_NOT_EXISTS{0b0000'0100};
+    constexpr static uint8_t O_PERSISTENT_FILE_READ_ONLY_MEMORY_MAPPED{0b0000'1000};
+    constexpr static uint8_t O_PERSISTENT_FILE_READ_ONLY{0b0001'0000};
     constexpr static uint8_t O_IN_MEM_TEMP_FILE{0b0000'0011};
 
     FileHandle(const string& path, uint8_t flags);
@@ -63,6 +72,11 @@ public:
         FileUtils::writeToFile(fileInfo.get(), buffer, getPageSize(), pageIdx * getPageSize());
     }
 
+    inline void prefetchPages(page_idx_t startPageIdx, uint64_t numPagesToPrefetch) const {
+        FileUtils::prefetchFromFile(fileInfo.get(), numPagesToPrefetch * getPageSize(),
+            startPageIdx * getPageSize());
+    }
+
     // Warning: Adding a new page does not write a new page directly to a file. Instead, it only
     // creates a pageLock and a spot in the pageIdxToFrameMap. This may have dangerous consequences
     // if a concurrent thread attempts to read the page. This should be ensured by the caller. To be
@@ -87,6 +101,12 @@ public:
 
     inline bool isNewTmpFile() const { return flags & isNewInMemoryTmpFileMask; }
     inline bool createFileIfNotExists() const { return flags & createIfNotExistsMask; }
+    inline bool isMemoryMapped() const { return flags & isMemoryMappedMask; }
+    inline bool isReadOnly() const { return flags & (isReadOnlyMask | isMemoryMappedMask); }
+    inline uint8_t* getMappedPage(page_idx_t pageIdx) const {
+        assert(isMemoryMapped() && pageIdx < numPages);
+        return mappedFile + pageIdx * getPageSize();
+    }
     inline page_idx_t getNumPages() const { return numPages; }
     static inline bool isAFrame(page_idx_t mappedFrameIdx) { return UINT32_MAX != mappedFrameIdx; }
     inline FileInfo* getFileInfo() const { return fileInfo.get(); }
@@ -129,6 +149,8 @@ protected:
     shared_ptr<spdlog::logger> logger;
     uint8_t flags;
     unique_ptr<FileInfo> fileInfo;
+    // Only set if the file is memory mapped and not empty.
+    uint8_t* mappedFile;
     vector<unique_ptr<atomic_flag>> pageLocks;
     vector<unique_ptr<atomic<page_idx_t>>> pageIdxToFrameMap;
     uint32_t numPages;
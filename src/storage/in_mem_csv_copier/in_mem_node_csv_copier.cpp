@@ -104,45 +104,83 @@ void InMemNodeCSVCopier::populateColumnsAndCountUnstrPropertyListSizes() {
             nodeTableSchema->getPrimaryKey().dataType);
     pkIndex->bulkReserve(numNodes);
     node_offset_t offsetStart = 0;
-    for (auto blockIdx = 0u; blockIdx < numBlocks; blockIdx++) {
-        taskScheduler.scheduleTask(CopyCSVTaskFactory::createCopyCSVTask(
-            populateColumnsAndCountUnstrPropertyListSizesTask<T>,
-            nodeTableSchema->primaryKeyPropertyIdx, blockIdx, offsetStart, pkIndex.get(), this));
-        offsetStart += numLinesPerBlock[blockIdx];
+    auto batchStartBlockIdx = 0u;
+    while (batchStartBlockIdx < numBlocks) {
+        auto batchEndBlockIdx = batchStartBlockIdx;
+        uint64_t numNodesInBatch = 0;
+        while (batchEndBlockIdx < numBlocks &&
+               numNodesInBatch < CopyCSVConfig::NUM_NODES_PER_PK_INDEX_BATCH) {
+            numNodesInBatch += numLinesPerBlock[batchEndBlockIdx++];
+        }
+        vector<vector<vector<NodeOffsetAndPKHash>>> offsetsPerBlockAndPartition(
+            batchEndBlockIdx - batchStartBlockIdx,
+            vector<vector<NodeOffsetAndPKHash>>(pkIndex->getNumPartitions()));
+        for (auto blockIdx = batchStartBlockIdx; blockIdx < batchEndBlockIdx; blockIdx++) {
+            taskScheduler.scheduleTask(CopyCSVTaskFactory::createCopyCSVTask(
+                populateColumnsAndCountUnstrPropertyListSizesTask<T>,
+                nodeTableSchema->primaryKeyPropertyIdx, blockIdx, offsetStart, pkIndex.get(),
+                &offsetsPerBlockAndPartition[blockIdx - batchStartBlockIdx], this));
+            offsetStart += numLinesPerBlock[blockIdx];
+        }
+        taskScheduler.waitAllTasksToCompleteOrError();
+        logger->info("Populate the pk index with blocks {} to {}.", batchStartBlockIdx,
+            batchEndBlockIdx - 1);
+        for (auto partitionIdx = 0u; partitionIdx < pkIndex->getNumPartitions(); partitionIdx++) {
+            taskScheduler.scheduleTask(CopyCSVTaskFactory::createCopyCSVTask(
+                populatePKIndexTask<T>, nodeTableSchema->primaryKeyPropertyIdx, partitionIdx,
+                pkIndex.get(), &offsetsPerBlockAndPartition, this));
+        }
+        taskScheduler.waitAllTasksToCompleteOrError();
+        batchStartBlockIdx = batchEndBlockIdx;
     }
-    taskScheduler.waitAllTasksToCompleteOrError();
     logger->info("Flush the pk index to disk.");
     pkIndex->flush();
+    auto slotChainStatistics = pkIndex->getSlotChainStatistics();
+    logger->debug("The pk index has {} primary slots, {} of which have overflow slots, and {} "
+                  "overflow slots. The longest chain has {} overflow slots.",
+        slotChainStatistics.numPrimarySlots, slotChainStatistics.numPrimarySlotsWithOverflowSlots,
+        slotChainStatistics.numOverflowSlots, slotChainStatistics.maxNumOverflowSlotsInChain);
     logger->info("Done populating structured properties, constructing the pk index and counting "
                  "unstructured properties.");
 }
 
 template<typename T>
-void InMemNodeCSVCopier::addIDsToIndex(InMemColumn* column, HashIndexBuilder<T>* hashIndex,
-    node_offset_t startOffset, uint64_t numValues) {
+void InMemNodeCSVCopier::partitionIDsForIndex(InMemColumn* column, HashIndexBuilder<T>* pkIndex,
+    node_offset_t startOffset, uint64_t numValues,
+    vector<vector<NodeOffsetAndPKHash>>& offsetsPerPartition) {
     for (auto i = 0u; i < numValues; i++) {
         auto offset = i + startOffset;
+        hash_t hash;
+        if constexpr (is_same<T, int64_t>::value) {
+            hash = HashIndexUtils::hashFuncForInt64(column->getElement(offset));
+        } else {
+            auto element = (ku_string_t*)column->getElement(offset);
+            hash = HashIndexUtils::hashFuncForStringView(
+                column->getInMemOverflowFile()->readStringView(element));
+        }
+        offsetsPerPartition[pkIndex->getPartitionIdxForHash(hash)].push_back({offset, hash});
+    }
+}
+
+template<typename T>
+void InMemNodeCSVCopier::addIDsToIndex(InMemColumn* column, HashIndexBuilder<T>* hashIndex,
+    const vector<NodeOffsetAndPKHash>& offsets) {
+    for (auto [offset, hash] : offsets) {
         if constexpr (is_same<T, int64_t>::value) {
             auto key = (int64_t*)column->getElement(offset);
-            if (!hashIndex->append(*key, offset)) {
+            if (!hashIndex->append(*key, offset, hash)) {
                 throw CopyCSVException(Exception::getExistedPKExceptionMsg(to_string(*key)));
             }
         } else {
             auto element = (ku_string_t*)column->getElement(offset);
             auto key = column->getInMemOverflowFile()->readString(element);
-            if (!hashIndex->append(key.c_str(), offset)) {
+            if (!hashIndex->append(key.c_str(), offset, hash)) {
                 throw CopyCSVException(Exception::getExistedPKExceptionMsg(key));
             }
         }
     }
 }
 
-template<typename T>
-void InMemNodeCSVCopier::populatePKIndex(InMemColumn* column, HashIndexBuilder<T>* pkIndex,
-    node_offset_t startOffset, uint64_t numValues) {
-    addIDsToIndex(column, pkIndex, startOffset, numValues);
-}
-
 void InMemNodeCSVCopier::skipFirstRowIfNecessary(
     uint64_t blockId, const CSVDescription& csvDescription, CSVReader& reader) {
     if (0 == blockId && csvDescription.csvReaderConfig.hasHeader && reader.hasNextLine()) {
@@ -153,7 +191,7 @@ void InMemNodeCSVCopier::skipFirstRowIfNecessary(
 template<typename T>
 void InMemNodeCSVCopier::populateColumnsAndCountUnstrPropertyListSizesTask(uint64_t IDColumnIdx,
     uint64_t blockId, uint64_t startOffset, HashIndexBuilder<T>* pkIndex,
-    InMemNodeCSVCopier* copier) {
+    vector<vector<NodeOffsetAndPKHash>>* offsetsPerPartition, InMemNodeCSVCopier* copier) {
     copier->logger->trace("Start: path={0} blkIdx={1}", copier->csvDescription.filePath, blockId);
     vector<PageByteCursor> overflowCursors(copier->nodeTableSchema->getNumStructuredProperties());
     CSVReader reader(
@@ -169,11 +207,24 @@ void InMemNodeCSVCopier::populateColumnsAndCountUnstrPropertyListSizesTask(uint6
         //            reader, startOffset + bufferOffset, copier->unstrPropertyLists.get());
         bufferOffset++;
     }
-    populatePKIndex(copier->structuredColumns[IDColumnIdx].get(), pkIndex, startOffset,
-        copier->numLinesPerBlock[blockId]);
+    partitionIDsForIndex(copier->structuredColumns[IDColumnIdx].get(), pkIndex, startOffset,
+        copier->numLinesPerBlock[blockId], *offsetsPerPartition);
     copier->logger->trace("End: path={0} blkIdx={1}", copier->csvDescription.filePath, blockId);
 }
 
+template<typename T>
+void InMemNodeCSVCopier::populatePKIndexTask(uint64_t IDColumnIdx, uint64_t partitionIdx,
+    HashIndexBuilder<T>* pkIndex,
+    vector<vector<vector<NodeOffsetAndPKHash>>>* offsetsPerBlockAndPartition,
+    InMemNodeCSVCopier* copier) {
+    copier->logger->trace("Start: pk index partition={0}", partitionIdx);
+    for (auto& offsetsPerPartition : *offsetsPerBlockAndPartition) {
+        addIDsToIndex(copier->structuredColumns[IDColumnIdx].get(), pkIndex,
+            offsetsPerPartition[partitionIdx]);
+    }
+    copier->logger->trace("End: pk index partition={0}", partitionIdx);
+}
+
 void InMemNodeCSVCopier::calcLengthOfUnstrPropertyLists(
     CSVReader& reader, node_offset_t nodeOffset, InMemUnstructuredLists* unstrPropertyLists) {
     while (reader.hasNextToken()) {
@@ -9,6 +9,12 @@ namespace kuzu {
 namespace storage {
 
 class InMemNodeCSVCopier : public InMemStructuresCSVCopier {
+    // The hash of the primary key of a node is computed when partitioning the nodes for the pk
+    // index, and reused when appending the key to its partition of the index.
+    struct NodeOffsetAndPKHash {
+        node_offset_t offset;
+        hash_t hash;
+    };
 
 public:
     InMemNodeCSVCopier(CSVDescription& csvDescription, string outputDirectory,
@@ -39,20 +45,30 @@ private:
         const vector<Property>& properties, vector<PageByteCursor>& overflowCursors,
         CSVReader& reader, uint64_t nodeOffset);
     template<typename T>
-    static void addIDsToIndex(InMemColumn* column, HashIndexBuilder<T>* hashIndex,
-        node_offset_t startOffset, uint64_t numValues);
+    static void partitionIDsForIndex(InMemColumn* column, HashIndexBuilder<T>* pkIndex,
+        node_offset_t startOffset, uint64_t numValues,
+        vector<vector<NodeOffsetAndPKHash>>& offsetsPerPartition);
     template<typename T>
-    static void populatePKIndex(InMemColumn* column, HashIndexBuilder<T>* pkIndex,
-        node_offset_t startOffset, uint64_t numValues);
+    static void addIDsToIndex(InMemColumn* column, HashIndexBuilder<T>* hashIndex,
+        const vector<NodeOffsetAndPKHash>& offsets);
     static void skipFirstRowIfNecessary(
         uint64_t blockId, const CSVDescription& csvDescription, CSVReader& reader);
 
     // Concurrent tasks.
     // Note that primaryKeyPropertyIdx is *NOT* the property ID of the primary key property.
     // Instead, it is the index in the structured columns that we expect it to appear.
+    // The offsets of the nodes in each block are partitioned by the pk index partition of their
+    // primary keys, so that each partition of the pk index can then be populated by a single task.
+    // Blocks are processed in batches of CopyCSVConfig::NUM_NODES_PER_PK_INDEX_BATCH nodes, and the
+    // partitioned offsets of a batch are dropped once they have been added to the pk index.
     template<typename T>
     static void populateColumnsAndCountUnstrPropertyListSizesTask(uint64_t primaryKeyPropertyIdx,
         uint64_t blockId, uint64_t offsetStart, HashIndexBuilder<T>* pkIndex,
+        vector<vector<NodeOffsetAndPKHash>>* offsetsPerPartition, InMemNodeCSVCopier* copier);
+    template<typename T>
+    static void populatePKIndexTask(uint64_t primaryKeyPropertyIdx, uint64_t partitionIdx,
+        HashIndexBuilder<T>* pkIndex,
+        vector<vector<vector<NodeOffsetAndPKHash>>>* offsetsPerBlockAndPartition,
         InMemNodeCSVCopier* copier);
     static void populateUnstrPropertyListsTask(
         uint64_t blockId, node_offset_t nodeOffsetStart, InMemNodeCSVCopier* copier);
@@ -3,18 +3,37 @@
 namespace kuzu {
 namespace storage {
 
-InMemColumn::InMemColumn(
-    std::string fName, DataType dataType, uint64_t numBytesForElement, uint64_t numElements)
+InMemColumn::InMemColumn(std::string fName, DataType dataType, uint64_t numBytesForElement,
+    uint64_t numElements, bool isBitPacked)
     : fName{move(fName)}, dataType{move(dataType)}, numBytesForElement{numBytesForElement} {
     assert(this->dataType.typeID != UNSTRUCTURED);
-    numElementsInAPage = PageUtils::getNumElementsInAPage(numBytesForElement, true /* hasNull */);
+    numElementsInAPage =
+        isBitPacked ? PageUtils::getNumElementsInABitPackedPage() :
+                      PageUtils::getNumElementsInAPage(numBytesForElement, true /* hasNull */);
     auto numPages = ceil((double)numElements / (double)numElementsInAPage);
-    inMemFile =
-        make_unique<InMemFile>(this->fName, numBytesForElement, true /* hasNULLBytes */, numPages);
+    inMemFile = make_unique<InMemFile>(
+        this->fName, numBytesForElement, true /* hasNULLBytes */, numPages, isBitPacked);
 }
 
 void InMemColumn::saveToFile() {
     inMemFile->flush();
+    if (ZoneMap::isSupported(dataType.typeID)) {
+        saveZoneMapToFile();
+    }
+}
+
+void InMemColumn::saveZoneMapToFile() {
+    auto numPages = inMemFile->getNumPages();
+    ZoneMap zoneMap(dataType.typeID, StorageUtils::getZoneMapFName(fName), numPages);
+    for (auto pageIdx = 0u; pageIdx < numPages; pageIdx++) {
+        auto page = inMemFile->getPage(pageIdx);
+        for (auto elemPosInPage = 0u; elemPosInPage < numElementsInAPage; elemPosInPage++) {
+            if (!page->isElemPosNull(elemPosInPage)) {
+                zoneMap.update(pageIdx, page->data + elemPosInPage * numBytesForElement);
+            }
+        }
+    }
+    zoneMap.saveToFile();
 }
 
 void InMemColumn::setElement(node_offset_t offset, const uint8_t* val) {
@@ -24,6 +43,11 @@ void InMemColumn::setElement(node_offset_t offset, const uint8_t* val) {
             numBytesForElement);
 }
 
+void InMemBoolColumn::setElement(node_offset_t offset, const uint8_t* val) {
+    auto cursor = getPageElementCursorForOffset(offset);
+    inMemFile->getPage(cursor.pageIdx)->writeBit(cursor.elemPosInPage, *(bool*)val);
+}
+
 InMemColumnWithOverflow::InMemColumnWithOverflow(
     string fName, DataType dataType, uint64_t numElements)
     : InMemColumn{move(fName), move(dataType), Types::getDataTypeSize(dataType), numElements} {
@@ -50,12 +74,13 @@ unique_ptr<InMemColumn> InMemColumnFactory::getInMemPropertyColumn(
     switch (dataType.typeID) {
     case INT64:
     case DOUBLE:
-    case BOOL:
     case DATE:
     case TIMESTAMP:
     case INTERVAL:
         return make_unique<InMemColumn>(
             fName, dataType, Types::getDataTypeSize(dataType), numElements);
+    case BOOL:
+        return make_unique<InMemBoolColumn>(fName, numElements);
     case STRING:
         return make_unique<InMemStringColumn>(fName, numElements);
     case LIST:
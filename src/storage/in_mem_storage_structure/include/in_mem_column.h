@@ -2,6 +2,7 @@
 
 #include "src/storage/include/node_id_compression_scheme.h"
 #include "src/storage/storage_structure/include/in_mem_file.h"
+#include "src/storage/storage_structure/include/zone_map.h"
 
 namespace kuzu {
 namespace storage {
@@ -10,7 +11,8 @@ class InMemColumn {
 
 public:
     // For structured property columns.
-    InMemColumn(string fName, DataType dataType, uint64_t numBytesForElement, uint64_t numElements);
+    InMemColumn(string fName, DataType dataType, uint64_t numBytesForElement, uint64_t numElements,
+        bool isBitPacked = false);
 
     virtual ~InMemColumn() = default;
 
@@ -33,6 +35,9 @@ public:
     }
 
 protected:
+    // Computes the zone map of the column from its pages and saves it next to the column file.
+    void saveZoneMapToFile();
+
     inline PageElementCursor getPageElementCursorForOffset(node_offset_t offset) const {
         return PageElementCursor{
             (page_idx_t)(offset / numElementsInAPage), (uint16_t)(offset % numElementsInAPage)};
@@ -78,6 +83,17 @@ private:
     NodeIDCompressionScheme nodeIDCompressionScheme;
 };
 
+// BOOL values are bit-packed, one bit per value, instead of taking a full byte each.
+class InMemBoolColumn : public InMemColumn {
+
+public:
+    InMemBoolColumn(string fName, uint64_t numElements)
+        : InMemColumn{move(fName), DataType(BOOL), Types::getDataTypeSize(BOOL), numElements,
+              true /* isBitPacked */} {}
+
+    void setElement(node_offset_t offset, const uint8_t* val) override;
+};
+
 class InMemStringColumn : public InMemColumnWithOverflow {
 
 public:
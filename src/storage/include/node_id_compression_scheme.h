@@ -21,6 +21,9 @@ public:
     inline table_id_t getCommonTableID() const { return commonTableID; }
 
     void readNodeID(uint8_t* data, nodeID_t* nodeID) const;
+    // Decodes numNodeIDs consecutive nodeIDs at once. The per-element branch on the scheme is
+    // hoisted out of the loop, so decoding is a plain copy or a loop the compiler vectorizes.
+    void readNodeIDs(const uint8_t* data, nodeID_t* nodeIDs, uint64_t numNodeIDs) const;
     void writeNodeID(uint8_t* data, nodeID_t* nodeID) const;
 
 private:
@@ -51,6 +51,15 @@ struct PageUtils {
 
     static uint32_t getNumElementsInAPage(uint32_t elementSize, bool hasNull);
 
+    // Bit-packed pages store one bit per element followed by the null entries, so a page holds
+    // as many elements as half of its bits, rounded down to full null entries.
+    static constexpr uint32_t getNumElementsInABitPackedPage() {
+        return ((DEFAULT_PAGE_SIZE << 3) / 2) & ~(NullMask::NUM_BITS_PER_NULL_ENTRY - 1);
+    }
+    static constexpr uint32_t getNullEntriesOffsetInABitPackedPage() {
+        return getNumElementsInABitPackedPage() >> 3;
+    }
+
     // This function returns the page pageIdx of the page where element will be found and the pos of
     // the element in the page as the offset.
     static inline PageElementCursor getPageElementCursorForPos(
@@ -199,6 +208,16 @@ public:
         return appendSuffixOrInsertBeforeWALSuffix(fName, StorageConfig::OVERFLOW_FILE_SUFFIX);
     }
 
+    static inline string getZoneMapFName(const string& fName) {
+        return appendSuffixOrInsertBeforeWALSuffix(fName, StorageConfig::ZONE_MAP_FILE_SUFFIX);
+    }
+
+    static inline void overwriteZoneMapFileWithVersionFromWAL(
+        const string& directory, StorageStructureID storageStructureID) {
+        auto zoneMapFName = getZoneMapFName(getFileNameForReadWrite(directory, storageStructureID));
+        FileUtils::overwriteFile(appendWALFileSuffix(zoneMapFName), zoneMapFName);
+    }
+
     static inline void overwriteNodesStatisticsAndDeletedIDsFileWithVersionFromWAL(
         const string& directory) {
         FileUtils::overwriteFile(
@@ -257,6 +276,17 @@ public:
                                                   common::StorageConfig::CATALOG_FILE_NAME_FOR_WAL);
     }
 
+    static inline string getSpillDirPath(const string& directory) {
+        return FileUtils::joinPath(directory, common::StorageConfig::SPILL_DIR_NAME);
+    }
+    // Returns a new directory in the temporary directory of the system, which no other database of
+    // any process spills into.
+    static string getTempSpillDirPath();
+
+    // Returns a path in the spill directory that no other spill file of the process uses. The
+    // spill directory is created if necessary.
+    static string getNewSpillFilePath(const string& spillDirPath, const string& fileNamePrefix);
+
     // Note: This is a relatively slow function because of division and mod and making pair.
     // It is not meant to be used in performance critical code path.
     static inline pair<uint64_t, uint64_t> getQuotientRemainder(uint64_t i, uint64_t divisor) {
@@ -282,6 +312,8 @@ public:
 
     static unique_ptr<FileInfo> getFileInfoForReadWrite(
         const string& directory, StorageStructureID storageStructureID);
+    static string getFileNameForReadWrite(
+        const string& directory, StorageStructureID storageStructureID);
 
     static string getColumnFName(const string& directory, StorageStructureID storageStructureID);
 
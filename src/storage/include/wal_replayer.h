@@ -1,6 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
+
 #include "src/catalog/include/catalog.h"
+#include "src/common/include/task_system/task_scheduler.h"
 #include "src/storage/buffer_manager/include/buffer_manager.h"
 #include "src/storage/buffer_manager/include/versioned_file_handle.h"
 #include "src/storage/wal/include/wal.h"
@@ -20,18 +24,29 @@ public:
     // This interface is used for recovery only. We always recover the disk files before
     // constructing the storageManager and catalog. So this specialized recovery constructor
     // doesn't take in storageManager and bufferManager.
-    WALReplayer(WAL* wal);
+    // If a taskScheduler is given, page records of different files are replayed in parallel on
+    // it. Otherwise, all records are replayed by the calling thread.
+    explicit WALReplayer(WAL* wal, TaskScheduler* taskScheduler = nullptr);
 
     WALReplayer(WAL* wal, StorageManager* storageManager, BufferManager* bufferManager,
-        MemoryManager* memoryManager, catalog::Catalog* catalog, bool isCheckpoint);
+        MemoryManager* memoryManager, catalog::Catalog* catalog, bool isCheckpoint,
+        TaskScheduler* taskScheduler = nullptr);
 
     void replay();
 
 private:
     void init();
     void replayWALRecord(WALRecord& walRecord);
+    // Page records are not replayed one by one. Instead, consecutive page records are grouped by
+    // the file they update and each group is replayed as a whole, once a record of another type or
+    // the end of the WAL is reached. Records of the same file are kept in the order they were
+    // logged.
+    void addPageUpdateOrInsertRecord(const PageUpdateOrInsertRecord& pageInsertOrUpdateRecord);
+    void replayPageUpdateOrInsertRecords();
+    void replayPageUpdateOrInsertRecordsOfNextFiles(atomic<uint64_t>& nextFileIdx);
+    void replayPageUpdateOrInsertRecordsOfFile(vector<PageUpdateOrInsertRecord>& records);
     void checkpointOrRollbackVersionedFileHandleAndBufferManager(
-        const WALRecord& walRecord, const StorageStructureID& storageStructureID);
+        const PageUpdateOrInsertRecord& pageInsertOrUpdateRecord, const uint8_t* walPage);
     void truncateFileIfInsertion(
         VersionedFileHandle* fileHandle, const PageUpdateOrInsertRecord& pageInsertOrUpdateRecord);
     VersionedFileHandle* getVersionedFileHandleIfWALVersionAndBMShouldBeCleared(
@@ -46,7 +61,10 @@ private:
     BufferManager* bufferManager;
     MemoryManager* memoryManager;
     shared_ptr<FileHandle> walFileHandle;
-    unique_ptr<uint8_t[]> pageBuffer;
+    TaskScheduler* taskScheduler;
+    vector<vector<PageUpdateOrInsertRecord>> pageRecordsPerFile;
+    unordered_map<string, uint64_t> fileNameToPageRecordsIdx;
+    uint64_t lastPageRecordsIdx;
     shared_ptr<spdlog::logger> logger;
     WAL* wal;
     catalog::Catalog* catalog;
@@ -150,7 +150,7 @@ HashIndex<T>::HashIndex(const StorageStructureIDAndFName& storageStructureIDAndF
     : BaseHashIndex{keyDataType},
       storageStructureIDAndFName{storageStructureIDAndFName}, bm{bufferManager}, wal{wal} {
     fileHandle = make_unique<VersionedFileHandle>(
-        storageStructureIDAndFName, FileHandle::O_PERSISTENT_FILE_NO_CREATE);
+        storageStructureIDAndFName, bm.getStorageStructureFileFlags());
     headerArray = make_unique<BaseDiskArray<HashIndexHeader>>(
         *fileHandle, INDEX_HEADER_ARRAY_HEADER_PAGE_IDX, &bm, wal);
     // Read indexHeader from the headerArray, which contains only one element.
@@ -181,10 +181,10 @@ HashIndex<T>::HashIndex(const StorageStructureIDAndFName& storageStructureIDAndF
 template<typename T>
 bool HashIndex<T>::lookupInternal(
     Transaction* transaction, const uint8_t* key, node_offset_t& result) {
-    if (transaction->isReadOnly()) {
-        return lookupInPersistentIndex(transaction->getType(), key, result);
+    if (transaction->getVersionToRead() == TransactionType::READ_ONLY) {
+        return lookupInPersistentIndex(transaction->getVersionToRead(), key, result);
     } else {
-        assert(transaction->isWriteTransaction());
+        assert(transaction->getVersionToRead() == TransactionType::WRITE);
         auto localLookupState = localStorage->lookup(key, result);
         if (localLookupState == HashIndexLocalLookupState::KEY_FOUND) {
             return true;
@@ -192,11 +192,32 @@ bool HashIndex<T>::lookupInternal(
             return false;
         } else {
             assert(localLookupState == HashIndexLocalLookupState::KEY_NOT_EXIST);
-            return lookupInPersistentIndex(transaction->getType(), key, result);
+            return lookupInPersistentIndex(transaction->getVersionToRead(), key, result);
         }
     }
 }
 
+// Same as the lookup of a single key above, except that the keys that are not in the local storage
+// are looked up in the persistent storage together.
+template<typename T>
+void HashIndex<T>::lookupInternal(Transaction* transaction, const vector<const uint8_t*>& keys,
+    node_offset_t* results, bool* isFound) {
+    auto trxType = transaction->getVersionToRead();
+    vector<uint64_t> keyIdxsToLookup;
+    keyIdxsToLookup.reserve(keys.size());
+    for (auto keyIdx = 0u; keyIdx < keys.size(); keyIdx++) {
+        if (trxType == TransactionType::WRITE) {
+            auto localLookupState = localStorage->lookup(keys[keyIdx], results[keyIdx]);
+            if (localLookupState != HashIndexLocalLookupState::KEY_NOT_EXIST) {
+                isFound[keyIdx] = localLookupState == HashIndexLocalLookupState::KEY_FOUND;
+                continue;
+            }
+        }
+        keyIdxsToLookup.push_back(keyIdx);
+    }
+    lookupInPersistentIndex(trxType, keys, keyIdxsToLookup, results, isFound);
+}
+
 // For deletions, we don't check if the deleted keys exist or not. Thus, we don't need to check
 // in the persistent storage and directly delete keys in the local storage.
 template<typename T>
@@ -227,17 +248,16 @@ bool HashIndex<T>::insertInternal(const uint8_t* key, node_offset_t value) {
 template<typename T>
 template<ChainedSlotsAction action>
 bool HashIndex<T>::performActionInChainedSlots(TransactionType trxType, HashIndexHeader& header,
-    SlotInfo& slotInfo, const uint8_t* key, node_offset_t& result) {
+    SlotInfo& slotInfo, const uint8_t* key, uint8_t fingerprint, node_offset_t& result) {
     while (slotInfo.slotType == SlotType::PRIMARY || slotInfo.slotId != 0) {
         auto slot = getSlot(trxType, slotInfo);
         if constexpr (action == ChainedSlotsAction::FIND_FREE_SLOT) {
-            if (slot.header.numEntries < HashIndexConfig::SLOT_CAPACITY ||
-                slot.header.nextOvfSlotId == 0) {
+            if (slot.header.numEntries < Slot<T>::CAPACITY || slot.header.nextOvfSlotId == 0) {
                 // Found a slot with empty space.
                 break;
             }
         } else {
-            auto entryPos = findMatchedEntryInSlot(trxType, slot, key);
+            auto entryPos = findMatchedEntryInSlot(trxType, slot, key, fingerprint);
             if (entryPos != SlotHeader::INVALID_ENTRY_POS) {
                 if constexpr (action == ChainedSlotsAction::LOOKUP_IN_SLOTS) {
                     result = *(
@@ -263,9 +283,70 @@ bool HashIndex<T>::lookupInPersistentIndex(
     auto header = trxType == TransactionType::READ_ONLY ?
                       *indexHeader :
                       headerArray->get(INDEX_HEADER_IDX_IN_ARRAY, TransactionType::WRITE);
-    SlotInfo slotInfo{getPrimarySlotIdForKey(header, key), SlotType::PRIMARY};
+    auto hash = keyHashFunc(key);
+    SlotInfo slotInfo{getPrimarySlotIdForHash(header, hash), SlotType::PRIMARY};
     return performActionInChainedSlots<ChainedSlotsAction::LOOKUP_IN_SLOTS>(
-        trxType, header, slotInfo, key, result);
+        trxType, header, slotInfo, key, getFingerprintForHash(hash), result);
+}
+
+// We first hash all keys and sort them on their primary slots. The primary slots are then read in
+// one pass over the pSlots array, which pins each of its pages once. Only keys that are not found
+// in their primary slot and have overflow slots are looked up in the chains one by one.
+template<typename T>
+void HashIndex<T>::lookupInPersistentIndex(TransactionType trxType,
+    const vector<const uint8_t*>& keys, vector<uint64_t>& keyIdxsToLookup, node_offset_t* results,
+    bool* isFound) {
+    if (keyIdxsToLookup.empty()) {
+        return;
+    }
+    auto header = trxType == TransactionType::READ_ONLY ?
+                      *indexHeader :
+                      headerArray->get(INDEX_HEADER_IDX_IN_ARRAY, TransactionType::WRITE);
+    vector<hash_t> hashes(keys.size());
+    if constexpr (is_same_v<T, int64_t>) {
+        // Avoid calling keyHashFunc through std::function, so that the loop can be vectorized.
+        for (auto keyIdx : keyIdxsToLookup) {
+            hashes[keyIdx] = HashIndexUtils::hashFuncForInt64(keys[keyIdx]);
+        }
+    } else {
+        for (auto keyIdx : keyIdxsToLookup) {
+            hashes[keyIdx] = keyHashFunc(keys[keyIdx]);
+        }
+    }
+    vector<slot_id_t> pSlotIds(keys.size());
+    for (auto keyIdx : keyIdxsToLookup) {
+        pSlotIds[keyIdx] = getPrimarySlotIdForHash(header, hashes[keyIdx]);
+    }
+    sort(keyIdxsToLookup.begin(), keyIdxsToLookup.end(),
+        [&](uint64_t left, uint64_t right) { return pSlotIds[left] < pSlotIds[right]; });
+    vector<uint64_t> distinctPSlotIds;
+    for (auto keyIdx : keyIdxsToLookup) {
+        if (distinctPSlotIds.empty() || distinctPSlotIds.back() != pSlotIds[keyIdx]) {
+            distinctPSlotIds.push_back(pSlotIds[keyIdx]);
+        }
+    }
+    vector<Slot<T>> slots(distinctPSlotIds.size());
+    pSlots->get(distinctPSlotIds, slots.data(), trxType);
+    auto slotIdx = 0u;
+    for (auto keyIdx : keyIdxsToLookup) {
+        if (pSlotIds[keyIdx] != distinctPSlotIds[slotIdx]) {
+            slotIdx++;
+        }
+        auto& slot = slots[slotIdx];
+        auto fingerprint = getFingerprintForHash(hashes[keyIdx]);
+        auto entryPos = findMatchedEntryInSlot(trxType, slot, keys[keyIdx], fingerprint);
+        if (entryPos != SlotHeader::INVALID_ENTRY_POS) {
+            results[keyIdx] =
+                *(node_offset_t*)(slot.entries[entryPos].data + indexHeader->numBytesPerKey);
+            isFound[keyIdx] = true;
+        } else if (slot.header.nextOvfSlotId != 0) {
+            SlotInfo slotInfo{slot.header.nextOvfSlotId, SlotType::OVF};
+            isFound[keyIdx] = performActionInChainedSlots<ChainedSlotsAction::LOOKUP_IN_SLOTS>(
+                trxType, header, slotInfo, keys[keyIdx], fingerprint, results[keyIdx]);
+        } else {
+            isFound[keyIdx] = false;
+        }
+    }
 }
 
 template<typename T>
@@ -273,16 +354,17 @@ void HashIndex<T>::insertIntoPersistentIndex(const uint8_t* key, node_offset_t v
     auto header = headerArray->get(INDEX_HEADER_IDX_IN_ARRAY, TransactionType::WRITE);
     slot_id_t numRequiredEntries = getNumRequiredEntries(header.numEntries, 1);
     while (numRequiredEntries >
-           pSlots->getNumElements(TransactionType::WRITE) * HashIndexConfig::SLOT_CAPACITY) {
+           pSlots->getNumElements(TransactionType::WRITE) * Slot<T>::CAPACITY) {
         splitSlot(header);
     }
-    auto pSlotId = getPrimarySlotIdForKey(header, key);
-    SlotInfo slotInfo{pSlotId, SlotType::PRIMARY};
+    auto hash = keyHashFunc(key);
+    auto fingerprint = getFingerprintForHash(hash);
+    SlotInfo slotInfo{getPrimarySlotIdForHash(header, hash), SlotType::PRIMARY};
     node_offset_t result;
     performActionInChainedSlots<ChainedSlotsAction::FIND_FREE_SLOT>(
-        TransactionType::WRITE, header, slotInfo, key, result);
+        TransactionType::WRITE, header, slotInfo, key, fingerprint, result);
     Slot slot = getSlot(TransactionType::WRITE, slotInfo);
-    copyKVOrEntryToSlot(false /* insert kv */, slotInfo, slot, key, value);
+    copyKVOrEntryToSlot(false /* insert kv */, slotInfo, slot, key, value, fingerprint);
     header.numEntries++;
     headerArray->update(INDEX_HEADER_IDX_IN_ARRAY, header);
 }
@@ -290,10 +372,11 @@ void HashIndex<T>::insertIntoPersistentIndex(const uint8_t* key, node_offset_t v
 template<typename T>
 void HashIndex<T>::deleteFromPersistentIndex(const uint8_t* key) {
     auto header = headerArray->get(INDEX_HEADER_IDX_IN_ARRAY, TransactionType::WRITE);
-    SlotInfo slotInfo{getPrimarySlotIdForKey(header, key), SlotType::PRIMARY};
+    auto hash = keyHashFunc(key);
+    SlotInfo slotInfo{getPrimarySlotIdForHash(header, hash), SlotType::PRIMARY};
     node_offset_t result;
     performActionInChainedSlots<ChainedSlotsAction::DELETE_IN_SLOTS>(
-        TransactionType::WRITE, header, slotInfo, key, result);
+        TransactionType::WRITE, header, slotInfo, key, getFingerprintForHash(hash), result);
     headerArray->update(INDEX_HEADER_IDX_IN_ARRAY, header);
 }
 
@@ -301,8 +384,7 @@ template<typename T>
 void HashIndex<T>::loopChainedSlotsToFindOneWithFreeSpace(SlotInfo& slotInfo, Slot<T>& slot) {
     while (slotInfo.slotType == SlotType::PRIMARY || slotInfo.slotId > 0) {
         slot = getSlot(TransactionType::WRITE, slotInfo);
-        if (slot.header.numEntries < HashIndexConfig::SLOT_CAPACITY ||
-            slot.header.nextOvfSlotId == 0) {
+        if (slot.header.numEntries < Slot<T>::CAPACITY || slot.header.nextOvfSlotId == 0) {
             // Found a slot with empty space.
             break;
         }
@@ -325,7 +407,7 @@ void HashIndex<T>::rehashSlots(HashIndexHeader& header) {
         auto slotHeader = slot.header;
         slot.header.reset();
         updateSlot(slotInfo, slot);
-        for (auto entryPos = 0u; entryPos < HashIndexConfig::SLOT_CAPACITY; entryPos++) {
+        for (auto entryPos = 0u; entryPos < Slot<T>::CAPACITY; entryPos++) {
             if (!slotHeader.isEntryValid(entryPos)) {
                 continue; // Skip invalid entries.
             }
@@ -338,17 +420,17 @@ void HashIndex<T>::rehashSlots(HashIndexHeader& header) {
                 hash = keyHashFunc(key);
             }
             auto newSlotId = hash & header.higherLevelHashMask;
-            copyEntryToSlot(newSlotId, key);
+            copyEntryToSlot(newSlotId, key, slot.fingerprints[entryPos]);
         }
     }
 }
 
 template<typename T>
-void HashIndex<T>::copyEntryToSlot(slot_id_t slotId, uint8_t* entry) {
+void HashIndex<T>::copyEntryToSlot(slot_id_t slotId, uint8_t* entry, uint8_t fingerprint) {
     SlotInfo slotInfo{slotId, SlotType::PRIMARY};
     Slot<T> slot;
     loopChainedSlotsToFindOneWithFreeSpace(slotInfo, slot);
-    copyKVOrEntryToSlot(true /* copy entry */, slotInfo, slot, entry, UINT32_MAX);
+    copyKVOrEntryToSlot(true /* copy entry */, slotInfo, slot, entry, UINT32_MAX, fingerprint);
     updateSlot(slotInfo, slot);
 }
 
@@ -367,30 +449,31 @@ vector<pair<SlotInfo, Slot<T>>> HashIndex<T>::getChainedSlots(slot_id_t pSlotId)
 
 template<typename T>
 void HashIndex<T>::copyAndUpdateSlotHeader(bool isCopyEntry, Slot<T>& slot, entry_pos_t entryPos,
-    const uint8_t* key, node_offset_t value) {
+    const uint8_t* key, node_offset_t value, uint8_t fingerprint) {
     if (isCopyEntry) {
         memcpy(slot.entries[entryPos].data, key, indexHeader->numBytesPerEntry);
     } else {
         keyInsertFunc(key, value, slot.entries[entryPos].data, diskOverflowFile.get());
     }
+    slot.fingerprints[entryPos] = fingerprint;
     slot.header.setEntryValid(entryPos);
     slot.header.numEntries++;
 }
 
 template<typename T>
 void HashIndex<T>::copyKVOrEntryToSlot(bool isCopyEntry, const SlotInfo& slotInfo, Slot<T>& slot,
-    const uint8_t* key, node_offset_t value) {
-    if (slot.header.numEntries == HashIndexConfig::SLOT_CAPACITY) {
+    const uint8_t* key, node_offset_t value, uint8_t fingerprint) {
+    if (slot.header.numEntries == Slot<T>::CAPACITY) {
         // Allocate a new oSlot, insert the entry to the new oSlot, and update slot's
         // nextOvfSlotId.
         Slot<T> newSlot;
         auto entryPos = 0u; // Always insert to the first entry when there is a new slot.
-        copyAndUpdateSlotHeader(isCopyEntry, newSlot, entryPos, key, value);
+        copyAndUpdateSlotHeader(isCopyEntry, newSlot, entryPos, key, value, fingerprint);
         slot.header.nextOvfSlotId = oSlots->pushBack(newSlot);
     } else {
-        for (auto entryPos = 0u; entryPos < HashIndexConfig::SLOT_CAPACITY; entryPos++) {
+        for (auto entryPos = 0u; entryPos < Slot<T>::CAPACITY; entryPos++) {
             if (!slot.header.isEntryValid(entryPos)) {
-                copyAndUpdateSlotHeader(isCopyEntry, slot, entryPos, key, value);
+                copyAndUpdateSlotHeader(isCopyEntry, slot, entryPos, key, value, fingerprint);
                 break;
             }
         }
@@ -399,12 +482,12 @@ void HashIndex<T>::copyKVOrEntryToSlot(bool isCopyEntry, const SlotInfo& slotInf
 }
 
 template<typename T>
-entry_pos_t HashIndex<T>::findMatchedEntryInSlot(
-    TransactionType trxType, const Slot<T>& slot, const uint8_t* key) const {
-    for (auto entryPos = 0u; entryPos < HashIndexConfig::SLOT_CAPACITY; entryPos++) {
-        if (!slot.header.isEntryValid(entryPos)) {
-            continue;
-        }
+entry_pos_t HashIndex<T>::findMatchedEntryInSlot(TransactionType trxType, const Slot<T>& slot,
+    const uint8_t* key, uint8_t fingerprint) const {
+    auto entriesToCompare = slot.getEntriesWithFingerprint(fingerprint);
+    while (entriesToCompare) {
+        auto entryPos = __builtin_ctz(entriesToCompare);
+        entriesToCompare &= entriesToCompare - 1;
         if (keyEqualsFunc(trxType, key, slot.entries[entryPos].data, diskOverflowFile.get())) {
             return entryPos;
         }
@@ -412,6 +495,27 @@ entry_pos_t HashIndex<T>::findMatchedEntryInSlot(
     return SlotHeader::INVALID_ENTRY_POS;
 }
 
+template<typename T>
+SlotChainStatistics HashIndex<T>::getSlotChainStatistics(TransactionType trxType) const {
+    SlotChainStatistics statistics;
+    statistics.numPrimarySlots = pSlots->getNumElements(trxType);
+    for (auto pSlotId = 0u; pSlotId < statistics.numPrimarySlots; pSlotId++) {
+        auto numOvfSlotsInChain = 0u;
+        SlotInfo slotInfo{pSlotId, SlotType::PRIMARY};
+        while ((slotInfo.slotId = getSlot(trxType, slotInfo).header.nextOvfSlotId) != 0) {
+            slotInfo.slotType = SlotType::OVF;
+            numOvfSlotsInChain++;
+        }
+        if (numOvfSlotsInChain > 0) {
+            statistics.numOverflowSlots += numOvfSlotsInChain;
+            statistics.numPrimarySlotsWithOverflowSlots++;
+            statistics.maxNumOverflowSlotsInChain =
+                max(statistics.maxNumOverflowSlotsInChain, (uint64_t)numOvfSlotsInChain);
+        }
+    }
+    return statistics;
+}
+
 template<typename T>
 void HashIndex<T>::prepareCommit() {
     localStorage->applyLocalChanges(
@@ -474,6 +578,39 @@ bool PrimaryKeyIndex::lookup(
     }
 }
 
+void PrimaryKeyIndex::lookup(
+    Transaction* trx, ValueVector* keyVector, node_offset_t* results, bool* isFound) {
+    assert(!keyVector->state->isFlat());
+    auto& selVector = keyVector->state->selVector;
+    auto numKeys = selVector->selectedSize;
+    vector<const uint8_t*> keys(numKeys);
+    // The index takes STRING keys as null-terminated strings, which are kept here until the lookup
+    // is done.
+    vector<string> keyStrings(keyDataTypeID == STRING ? numKeys : 0);
+    for (auto keyIdx = 0u; keyIdx < numKeys; keyIdx++) {
+        auto pos = selVector->selectedPositions[keyIdx];
+        assert(!keyVector->isNull(pos));
+        if (keyDataTypeID == INT64) {
+            keys[keyIdx] = reinterpret_cast<const uint8_t*>(&((int64_t*)keyVector->values)[pos]);
+        } else {
+            keyStrings[keyIdx] = ((ku_string_t*)keyVector->values)[pos].getAsString();
+            keys[keyIdx] = reinterpret_cast<const uint8_t*>(keyStrings[keyIdx].c_str());
+        }
+    }
+    vector<node_offset_t> resultsOfKeys(numKeys);
+    auto isFoundOfKeys = make_unique<bool[]>(numKeys);
+    if (keyDataTypeID == INT64) {
+        hashIndexForInt64->lookupInternal(trx, keys, resultsOfKeys.data(), isFoundOfKeys.get());
+    } else {
+        hashIndexForString->lookupInternal(trx, keys, resultsOfKeys.data(), isFoundOfKeys.get());
+    }
+    for (auto keyIdx = 0u; keyIdx < numKeys; keyIdx++) {
+        auto pos = selVector->selectedPositions[keyIdx];
+        results[pos] = resultsOfKeys[keyIdx];
+        isFound[pos] = isFoundOfKeys[keyIdx];
+    }
+}
+
 void PrimaryKeyIndex::deleteKey(ValueVector* keyVector, uint64_t vectorPos) {
     assert(!keyVector->isNull(vectorPos));
     if (keyDataTypeID == INT64) {
@@ -3,9 +3,8 @@
 namespace kuzu {
 namespace storage {
 
-slot_id_t BaseHashIndex::getPrimarySlotIdForKey(
-    const HashIndexHeader& indexHeader_, const uint8_t* key) {
-    auto hash = keyHashFunc(key);
+slot_id_t BaseHashIndex::getPrimarySlotIdForHash(
+    const HashIndexHeader& indexHeader_, hash_t hash) {
     auto slotId = hash & indexHeader_.levelHashMask;
     if (slotId < indexHeader_.nextSplitSlotId) {
         slotId = hash & indexHeader_.higherLevelHashMask;
@@ -15,7 +14,7 @@ slot_id_t BaseHashIndex::getPrimarySlotIdForKey(
 
 template<typename T>
 HashIndexBuilder<T>::HashIndexBuilder(const string& fName, const DataType& keyDataType)
-    : BaseHashIndex{keyDataType}, numEntries{0} {
+    : BaseHashIndex{keyDataType}, numPSlots{0}, numEntries{0} {
     fileHandle = make_unique<FileHandle>(fName, FileHandle::O_PERSISTENT_FILE_CREATE_NOT_EXISTS);
     indexHeader = make_unique<HashIndexHeader>(keyDataType.typeID);
     fileHandle->addNewPage(); // INDEX_HEADER_ARRAY_HEADER_PAGE
@@ -41,8 +40,7 @@ template<typename T>
 void HashIndexBuilder<T>::bulkReserve(uint32_t numEntries_) {
     slot_id_t numRequiredEntries = getNumRequiredEntries(numEntries.load(), numEntries_);
     // Build from scratch.
-    auto numRequiredSlots =
-        (numRequiredEntries + HashIndexConfig::SLOT_CAPACITY - 1) / HashIndexConfig::SLOT_CAPACITY;
+    auto numRequiredSlots = (numRequiredEntries + Slot<T>::CAPACITY - 1) / Slot<T>::CAPACITY;
     auto numSlotsOfCurrentLevel = 1 << indexHeader->currentLevel;
     while ((numSlotsOfCurrentLevel << 1) < numRequiredSlots) {
         indexHeader->incrementLevel();
@@ -52,42 +50,48 @@ void HashIndexBuilder<T>::bulkReserve(uint32_t numEntries_) {
         indexHeader->nextSplitSlotId = numRequiredSlots - numSlotsOfCurrentLevel;
     }
     allocatePSlots(numRequiredSlots);
+    partitions.resize(min(HashIndexConfig::NUM_BUILD_PARTITIONS, numPSlots));
 }
 
 template<typename T>
-bool HashIndexBuilder<T>::appendInternal(const uint8_t* key, node_offset_t value) {
-    SlotInfo pSlotInfo{getPrimarySlotIdForKey(*indexHeader, key), SlotType::PRIMARY};
+bool HashIndexBuilder<T>::appendInternal(const uint8_t* key, node_offset_t value, hash_t hash) {
+    auto fingerprint = getFingerprintForHash(hash);
+    SlotInfo pSlotInfo{getPrimarySlotIdForHash(*indexHeader, hash), SlotType::PRIMARY};
+    auto& partition = partitions[getPartitionIdxOfPSlot(pSlotInfo.slotId)];
     auto currentSlotInfo = pSlotInfo;
+    SlotInfo lastSlotInfo;
     Slot<T>* currentSlot = nullptr;
-    lockSlot(pSlotInfo);
     while (currentSlotInfo.slotType == SlotType::PRIMARY || currentSlotInfo.slotId != 0) {
-        currentSlot = getSlot(currentSlotInfo);
-        if (lookupOrExistsInSlotWithoutLock<false /* exists */>(currentSlot, key)) {
+        currentSlot = getSlot(partition, currentSlotInfo);
+        lastSlotInfo = currentSlotInfo;
+        if (lookupOrExistsInSlotWithoutLock<false /* exists */>(currentSlot, key, fingerprint)) {
             // Key already exists. No append is allowed.
-            unlockSlot(pSlotInfo);
             return false;
         }
-        if (currentSlot->header.numEntries < HashIndexConfig::SLOT_CAPACITY) {
+        if (currentSlot->header.numEntries < Slot<T>::CAPACITY) {
             break;
         }
         currentSlotInfo.slotId = currentSlot->header.nextOvfSlotId;
         currentSlotInfo.slotType = SlotType::OVF;
     }
     assert(currentSlot);
-    insertToSlotWithoutLock(currentSlot, key, value);
-    unlockSlot(pSlotInfo);
-    numEntries.fetch_add(1);
+    insertToSlotWithoutLock(partition, lastSlotInfo, currentSlot, key, fingerprint, value);
+    numEntries.fetch_add(1, memory_order_relaxed);
     return true;
 }
 
 template<typename T>
 bool HashIndexBuilder<T>::lookupInternalWithoutLock(const uint8_t* key, node_offset_t& result) {
-    SlotInfo pSlotInfo{getPrimarySlotIdForKey(*indexHeader, key), SlotType::PRIMARY};
+    auto hash = keyHashFunc(key);
+    auto fingerprint = getFingerprintForHash(hash);
+    SlotInfo pSlotInfo{getPrimarySlotIdForHash(*indexHeader, hash), SlotType::PRIMARY};
+    auto& partition = partitions[getPartitionIdxOfPSlot(pSlotInfo.slotId)];
     SlotInfo currentSlotInfo = pSlotInfo;
     Slot<T>* currentSlot;
     while (currentSlotInfo.slotType == SlotType::PRIMARY || currentSlotInfo.slotId != 0) {
-        currentSlot = getSlot(currentSlotInfo);
-        if (lookupOrExistsInSlotWithoutLock<true /* lookup */>(currentSlot, key, &result)) {
+        currentSlot = getSlot(partition, currentSlotInfo);
+        if (lookupOrExistsInSlotWithoutLock<true /* lookup */>(
+                currentSlot, key, fingerprint, &result)) {
             return true;
         }
         currentSlotInfo.slotId = currentSlot->header.nextOvfSlotId;
@@ -97,46 +101,28 @@ bool HashIndexBuilder<T>::lookupInternalWithoutLock(const uint8_t* key, node_off
 }
 
 template<typename T>
-uint32_t HashIndexBuilder<T>::allocatePSlots(uint32_t numSlotsToAllocate) {
-    unique_lock xLock{pSlotSharedMutex};
-    auto oldNumSlots = pSlots->getNumElements();
-    auto newNumSlots = oldNumSlots + numSlotsToAllocate;
-    pSlots->resize(newNumSlots, true /* setToZero */);
-    pSlotsMutexes.resize(newNumSlots);
-    for (auto i = oldNumSlots; i < newNumSlots; i++) {
-        pSlotsMutexes[i] = make_unique<mutex>();
-    }
-    return oldNumSlots;
-}
-
-template<typename T>
-uint32_t HashIndexBuilder<T>::allocateAOSlot() {
-    unique_lock xLock{oSlotsSharedMutex};
-    auto oldNumSlots = oSlots->getNumElements();
-    auto newNumSlots = oldNumSlots + 1;
-    oSlots->resize(newNumSlots, true /* setToZero */);
-    return oldNumSlots;
+void HashIndexBuilder<T>::allocatePSlots(uint32_t numSlotsToAllocate) {
+    numPSlots += numSlotsToAllocate;
+    pSlots->resize(numPSlots, true /* setToZero */);
 }
 
 template<typename T>
-Slot<T>* HashIndexBuilder<T>::getSlot(const SlotInfo& slotInfo) {
+Slot<T>* HashIndexBuilder<T>::getSlot(BuildPartition& partition, const SlotInfo& slotInfo) {
     if (slotInfo.slotType == SlotType::PRIMARY) {
-        shared_lock sLck{pSlotSharedMutex};
         return &pSlots->operator[](slotInfo.slotId);
     } else {
-        shared_lock sLck{oSlotsSharedMutex};
-        return &oSlots->operator[](slotInfo.slotId);
+        return &partition.oSlots[slotInfo.slotId - 1];
     }
 }
 
 template<typename T>
 template<bool IS_LOOKUP>
 bool HashIndexBuilder<T>::lookupOrExistsInSlotWithoutLock(
-    Slot<T>* slot, const uint8_t* key, node_offset_t* result) {
-    for (auto entryPos = 0u; entryPos < HashIndexConfig::SLOT_CAPACITY; entryPos++) {
-        if (!slot->header.isEntryValid(entryPos)) {
-            continue;
-        }
+    Slot<T>* slot, const uint8_t* key, uint8_t fingerprint, node_offset_t* result) {
+    auto entriesToCompare = slot->getEntriesWithFingerprint(fingerprint);
+    while (entriesToCompare) {
+        auto entryPos = __builtin_ctz(entriesToCompare);
+        entriesToCompare &= entriesToCompare - 1;
         auto& entry = slot->entries[entryPos];
         if (keyEqualsFunc(key, entry.data, inMemOverflowFile.get())) {
             if constexpr (IS_LOOKUP) {
@@ -149,17 +135,23 @@ bool HashIndexBuilder<T>::lookupOrExistsInSlotWithoutLock(
 }
 
 template<typename T>
-void HashIndexBuilder<T>::insertToSlotWithoutLock(
-    Slot<T>* slot, const uint8_t* key, node_offset_t value) {
-    if (slot->header.numEntries == HashIndexConfig::SLOT_CAPACITY) {
-        // Allocate a new oSlot and change the nextOvfSlotId.
-        auto ovfSlotId = allocateAOSlot();
-        slot->header.nextOvfSlotId = ovfSlotId;
-        slot = getSlot(SlotInfo{ovfSlotId, SlotType::OVF});
+void HashIndexBuilder<T>::insertToSlotWithoutLock(BuildPartition& partition,
+    const SlotInfo& slotInfo, Slot<T>* slot, const uint8_t* key, uint8_t fingerprint,
+    node_offset_t value) {
+    if (slot->header.numEntries == Slot<T>::CAPACITY) {
+        // Allocate a new oSlot in the partition and change the nextOvfSlotId. Slots in a deque are
+        // not moved when appending, so slot stays valid.
+        partition.oSlots.emplace_back();
+        slot->header.nextOvfSlotId = partition.oSlots.size();
+        if (slotInfo.slotType == SlotType::PRIMARY) {
+            partition.pSlotIdsWithOvfSlots.push_back(slotInfo.slotId);
+        }
+        slot = &partition.oSlots.back();
     }
-    for (auto entryPos = 0u; entryPos < HashIndexConfig::SLOT_CAPACITY; entryPos++) {
+    for (auto entryPos = 0u; entryPos < Slot<T>::CAPACITY; entryPos++) {
         if (!slot->header.isEntryValid(entryPos)) {
             keyInsertFunc(key, value, slot->entries[entryPos].data, inMemOverflowFile.get());
+            slot->fingerprints[entryPos] = fingerprint;
             slot->header.setEntryValid(entryPos);
             slot->header.numEntries++;
             break;
@@ -167,8 +159,35 @@ void HashIndexBuilder<T>::insertToSlotWithoutLock(
     }
 }
 
+template<typename T>
+void HashIndexBuilder<T>::moveOSlotsOfPartitionsToOSlots() {
+    auto numOSlots = oSlots->getNumElements();
+    for (auto& partition : partitions) {
+        numOSlots += partition.oSlots.size();
+    }
+    oSlots->resize(numOSlots, true /* setToZero */);
+    slot_id_t nextOSlotId = 1;
+    for (auto& partition : partitions) {
+        // The oSlots of the partition get the ids following the oSlots of previous partitions.
+        auto ovfSlotIdOffset = nextOSlotId - 1;
+        for (auto pSlotId : partition.pSlotIdsWithOvfSlots) {
+            pSlots->operator[](pSlotId).header.nextOvfSlotId += ovfSlotIdOffset;
+        }
+        for (auto& slot : partition.oSlots) {
+            auto& oSlot = oSlots->operator[](nextOSlotId++);
+            oSlot = slot;
+            if (oSlot.header.nextOvfSlotId != 0) {
+                oSlot.header.nextOvfSlotId += ovfSlotIdOffset;
+            }
+        }
+        partition.oSlots.clear();
+        partition.pSlotIdsWithOvfSlots.clear();
+    }
+}
+
 template<typename T>
 void HashIndexBuilder<T>::flush() {
+    moveOSlotsOfPartitionsToOSlots();
     indexHeader->numEntries = numEntries.load();
     headerArray->resize(1, true /* setToZero */);
     headerArray->operator[](0) = *indexHeader;
@@ -180,6 +199,27 @@ void HashIndexBuilder<T>::flush() {
     }
 }
 
+template<typename T>
+SlotChainStatistics HashIndexBuilder<T>::getSlotChainStatistics() {
+    SlotChainStatistics statistics;
+    statistics.numPrimarySlots = pSlots->getNumElements();
+    for (auto pSlotId = 0u; pSlotId < statistics.numPrimarySlots; pSlotId++) {
+        auto numOvfSlotsInChain = 0u;
+        auto ovfSlotId = pSlots->operator[](pSlotId).header.nextOvfSlotId;
+        while (ovfSlotId != 0) {
+            numOvfSlotsInChain++;
+            ovfSlotId = oSlots->operator[](ovfSlotId).header.nextOvfSlotId;
+        }
+        if (numOvfSlotsInChain > 0) {
+            statistics.numOverflowSlots += numOvfSlotsInChain;
+            statistics.numPrimarySlotsWithOverflowSlots++;
+            statistics.maxNumOverflowSlotsInChain =
+                max(statistics.maxNumOverflowSlotsInChain, (uint64_t)numOvfSlotsInChain);
+        }
+    }
+    return statistics;
+}
+
 template class HashIndexBuilder<int64_t>;
 template class HashIndexBuilder<ku_string_t>;
 
@@ -86,6 +86,10 @@ public:
 
 public:
     bool lookupInternal(Transaction* transaction, const uint8_t* key, node_offset_t& result);
+    // Looks up a batch of keys. isFound[i] is set to whether keys[i] exists and, if so, results[i]
+    // to its node offset.
+    void lookupInternal(Transaction* transaction, const vector<const uint8_t*>& keys,
+        node_offset_t* results, bool* isFound);
     void deleteInternal(const uint8_t* key) const;
     bool insertInternal(const uint8_t* key, node_offset_t value);
 
@@ -93,30 +97,33 @@ public:
     void checkpointInMemoryIfNecessary();
     void rollbackInMemoryIfNecessary() const;
     inline VersionedFileHandle* getFileHandle() const { return fileHandle.get(); }
+    SlotChainStatistics getSlotChainStatistics(TransactionType trxType) const;
 
 private:
     template<ChainedSlotsAction action>
     bool performActionInChainedSlots(TransactionType trxType, HashIndexHeader& header,
-        SlotInfo& slotInfo, const uint8_t* key, node_offset_t& result);
+        SlotInfo& slotInfo, const uint8_t* key, uint8_t fingerprint, node_offset_t& result);
     bool lookupInPersistentIndex(
         TransactionType trxType, const uint8_t* key, node_offset_t& result);
+    void lookupInPersistentIndex(TransactionType trxType, const vector<const uint8_t*>& keys,
+        vector<uint64_t>& keyIdxsToLookup, node_offset_t* results, bool* isFound);
     // The following two functions are only used in prepareCommit, and are not thread-safe.
     void insertIntoPersistentIndex(const uint8_t* key, node_offset_t value);
     void deleteFromPersistentIndex(const uint8_t* key);
 
     void copyAndUpdateSlotHeader(bool isCopyEntry, Slot<T>& slot, entry_pos_t entryPos,
-        const uint8_t* key, node_offset_t value);
+        const uint8_t* key, node_offset_t value, uint8_t fingerprint);
     void copyKVOrEntryToSlot(bool isCopyEntry, const SlotInfo& slotInfo, Slot<T>& slot,
-        const uint8_t* key, node_offset_t value);
+        const uint8_t* key, node_offset_t value, uint8_t fingerprint);
     void splitSlot(HashIndexHeader& header);
     void rehashSlots(HashIndexHeader& header);
     vector<pair<SlotInfo, Slot<T>>> getChainedSlots(slot_id_t pSlotId);
-    void copyEntryToSlot(slot_id_t slotId, uint8_t* entry);
+    void copyEntryToSlot(slot_id_t slotId, uint8_t* entry, uint8_t fingerprint);
 
     void prepareCommit();
 
-    entry_pos_t findMatchedEntryInSlot(
-        TransactionType trxType, const Slot<T>& slot, const uint8_t* key) const;
+    entry_pos_t findMatchedEntryInSlot(TransactionType trxType, const Slot<T>& slot,
+        const uint8_t* key, uint8_t fingerprint) const;
 
     void loopChainedSlotsToFindOneWithFreeSpace(SlotInfo& slotInfo, Slot<T>& slot);
 
@@ -163,6 +170,10 @@ public:
 
     bool lookup(
         Transaction* trx, ValueVector* keyVector, uint64_t vectorPos, node_offset_t& result);
+    // Looks up the keys at all selected positions of an unflat keyVector, which must not be NULL.
+    // For each selected position, isFound is set to whether the key exists and, if so, results to
+    // its node offset at the same position. A single flat key is looked up with the lookup above.
+    void lookup(Transaction* trx, ValueVector* keyVector, node_offset_t* results, bool* isFound);
 
     void deleteKey(ValueVector* keyVector, uint64_t vectorPos);
 
@@ -197,6 +208,10 @@ public:
         return keyDataTypeID == INT64 ? hashIndexForInt64->getFileHandle() :
                                         hashIndexForString->getFileHandle();
     }
+    inline SlotChainStatistics getSlotChainStatistics(TransactionType trxType) const {
+        return keyDataTypeID == INT64 ? hashIndexForInt64->getSlotChainStatistics(trxType) :
+                                        hashIndexForString->getSlotChainStatistics(trxType);
+    }
     inline DiskOverflowFile* getDiskOverflowFile() {
         return keyDataTypeID == STRING ? hashIndexForString->diskOverflowFile.get() : nullptr;
     }
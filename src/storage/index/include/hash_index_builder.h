@@ -1,5 +1,7 @@
 #pragma once
 
+#include <deque>
+
 #include "hash_index_header.h"
 #include "hash_index_slot.h"
 
@@ -24,15 +26,15 @@ static constexpr uint64_t INDEX_HEADER_IDX_IN_ARRAY = 0;
  *
  * 2. Given a key, it is mapped to one of the pSlots based on its hash value and the level and
  * splitting info. The actual key and value are either stored in the pSlot, or in a chained overflow
- * slots (oSlots) of the pSlot. Each pSlot corresponds to an mutex, whose unique lock is obtained
- * before any insertions or deletions to that pSlot or its chained oSlots.
+ * slots (oSlots) of the pSlot.
  *
  * The slot data structure:
- * Each slot (p/oSlot) consists of a slot header and several entries. The max number of entries in
- * slot is given by HashIndexConfig::SLOT_CAPACITY. The size of the slot is given by
- * (sizeof(SlotHeader) + (SLOT_CAPACITY * sizeof(Entry)).
+ * Each slot (p/oSlot) consists of a slot header, the fingerprints of its entries and several
+ * entries. The max number of entries in slot is given by Slot<T>::CAPACITY, which is the number of
+ * entries that fit into HashIndexConfig::SLOT_SIZE bytes.
  *
  * SlotHeader: [numEntries, validityMask, nextOvfSlotId]
+ * Fingerprints: [most significant byte of the hash of the key of each entry]
  * Entry: [key (fixed sized part), node_offset]
  *
  * 3. oSlots are used to store entries that comes to the designated primary slot that has already
@@ -58,7 +60,10 @@ public:
     virtual ~BaseHashIndex() = default;
 
 protected:
-    slot_id_t getPrimarySlotIdForKey(const HashIndexHeader& indexHeader, const uint8_t* key);
+    static slot_id_t getPrimarySlotIdForHash(const HashIndexHeader& indexHeader, hash_t hash);
+    static inline uint8_t getFingerprintForHash(hash_t hash) {
+        return hash >> ((sizeof(hash_t) - 1) * 8);
+    }
 
     static inline uint64_t getNumRequiredEntries(
         uint64_t numExistingEntries, uint64_t numNewEntries) {
@@ -67,65 +72,90 @@ protected:
 
 protected:
     unique_ptr<HashIndexHeader> indexHeader;
-    shared_mutex pSlotSharedMutex;
     hash_function_t keyHashFunc;
 };
 
+// HashIndexBuilder builds the index in partitions, each owning a contiguous range of pSlots and the
+// oSlots chained to them. As the pSlot of a key is given by the lower bits of its hash, keys are
+// radix partitioned by their hash. Each partition keeps its oSlots in memory while appending, so
+// appends to different partitions do not share any state and need no locks. The oSlots of all
+// partitions are laid out one partition after another when the index is flushed.
 template<typename T>
 class HashIndexBuilder : public BaseHashIndex {
+    // The oSlots of a partition are identified by their position in oSlots + 1 until the index is
+    // flushed, as slot id 0 is treated as NULL. We also keep the pSlots whose chains start in
+    // oSlots to update their nextOvfSlotId when the oSlots get their final ids.
+    struct BuildPartition {
+        deque<Slot<T>> oSlots;
+        vector<slot_id_t> pSlotIdsWithOvfSlots;
+    };
 
 public:
     HashIndexBuilder(const string& fName, const DataType& keyDataType);
 
 public:
-    // Reserves space for at least the specified number of elements.
+    // Reserves space for at least the specified number of elements and splits the pSlots into
+    // partitions. This has to be called once before appending.
     void bulkReserve(uint32_t numEntries);
 
+    inline uint64_t getNumPartitions() const { return partitions.size(); }
+    // Returns the partition of a key given its hash, see HashIndexUtils for the hash functions.
+    inline uint64_t getPartitionIdxForHash(hash_t hash) const {
+        return getPartitionIdxOfPSlot(getPrimarySlotIdForHash(*indexHeader, hash));
+    }
+
     // Note: append assumes that bulkRserve has been called before it and the index has reserved
-    // enough space already.
+    // enough space already. Keys of different partitions can be appended concurrently, but the keys
+    // of a partition have to be appended by a single thread at a time.
     inline bool append(int64_t key, node_offset_t value) {
-        return appendInternal(reinterpret_cast<const uint8_t*>(&key), value);
+        auto keyBytes = reinterpret_cast<const uint8_t*>(&key);
+        return appendInternal(keyBytes, value, keyHashFunc(keyBytes));
     }
     inline bool append(const char* key, node_offset_t value) {
-        return appendInternal(reinterpret_cast<const uint8_t*>(key), value);
+        auto keyBytes = reinterpret_cast<const uint8_t*>(key);
+        return appendInternal(keyBytes, value, keyHashFunc(keyBytes));
+    }
+    // Appends a key whose hash has already been computed, e.g., to partition the keys.
+    inline bool append(int64_t key, node_offset_t value, hash_t hash) {
+        return appendInternal(reinterpret_cast<const uint8_t*>(&key), value, hash);
+    }
+    inline bool append(const char* key, node_offset_t value, hash_t hash) {
+        return appendInternal(reinterpret_cast<const uint8_t*>(key), value, hash);
     }
+    // Lookups can only be done before the index is flushed and not concurrently with appends.
     inline bool lookup(int64_t key, node_offset_t& result) {
         return lookupInternalWithoutLock(reinterpret_cast<const uint8_t*>(&key), result);
     }
 
-    // Non-thread safe. This should only be called in the copyCSV and never be called in parallel.
+    // Non-thread safe. This should only be called in the copyCSV once all keys have been appended.
     void flush();
 
+    SlotChainStatistics getSlotChainStatistics();
+
 private:
-    bool appendInternal(const uint8_t* key, node_offset_t value);
+    inline uint64_t getPartitionIdxOfPSlot(slot_id_t pSlotId) const {
+        return pSlotId * partitions.size() / numPSlots;
+    }
+
+    bool appendInternal(const uint8_t* key, node_offset_t value, hash_t hash);
     bool lookupInternalWithoutLock(const uint8_t* key, node_offset_t& result);
 
     template<bool IS_LOOKUP>
-    bool lookupOrExistsInSlotWithoutLock(
-        Slot<T>* slot, const uint8_t* key, node_offset_t* result = nullptr);
-    void insertToSlotWithoutLock(Slot<T>* slot, const uint8_t* key, node_offset_t value);
-    Slot<T>* getSlot(const SlotInfo& slotInfo);
-    uint32_t allocatePSlots(uint32_t numSlotsToAllocate);
-    uint32_t allocateAOSlot();
-
-    inline void lockSlot(SlotInfo& slotInfo) {
-        assert(slotInfo.slotType == SlotType::PRIMARY);
-        shared_lock sLck{pSlotSharedMutex};
-        pSlotsMutexes[slotInfo.slotId]->lock();
-    }
-    inline void unlockSlot(const SlotInfo& slotInfo) {
-        assert(slotInfo.slotType == SlotType::PRIMARY);
-        shared_lock sLck{pSlotSharedMutex};
-        pSlotsMutexes[slotInfo.slotId]->unlock();
-    }
+    bool lookupOrExistsInSlotWithoutLock(Slot<T>* slot, const uint8_t* key, uint8_t fingerprint,
+        node_offset_t* result = nullptr);
+    void insertToSlotWithoutLock(BuildPartition& partition, const SlotInfo& slotInfo, Slot<T>* slot,
+        const uint8_t* key, uint8_t fingerprint, node_offset_t value);
+    Slot<T>* getSlot(BuildPartition& partition, const SlotInfo& slotInfo);
+    void allocatePSlots(uint32_t numSlotsToAllocate);
+    void moveOSlotsOfPartitionsToOSlots();
 
 private:
     unique_ptr<FileHandle> fileHandle;
     unique_ptr<InMemDiskArrayBuilder<HashIndexHeader>> headerArray;
-    shared_mutex oSlotsSharedMutex;
     unique_ptr<InMemDiskArrayBuilder<Slot<T>>> pSlots;
     unique_ptr<InMemDiskArrayBuilder<Slot<T>>> oSlots;
-    vector<unique_ptr<mutex>> pSlotsMutexes;
+    slot_id_t numPSlots;
+    vector<BuildPartition> partitions;
     in_mem_insert_function_t keyInsertFunc;
     in_mem_equals_function_t keyEqualsFunc;
     unique_ptr<InMemOverflowFile> inMemOverflowFile;
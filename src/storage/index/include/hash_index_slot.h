@@ -2,6 +2,10 @@
 
 #include <cstdint>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "src/common/include/configs.h"
 #include "src/common/types/include/ku_string.h"
 #include "src/common/types/include/node_id_t.h"
@@ -43,10 +47,46 @@ struct SlotEntry {
     uint8_t data[sizeof(T) + sizeof(common::node_offset_t)];
 };
 
+// A slot holds as many entries as fit into HashIndexConfig::SLOT_SIZE bytes together with the
+// slot header and a 1-byte fingerprint per entry. The fingerprint of an entry is the most
+// significant byte of the hash of its key. Lookups first compare the fingerprints of all entries
+// at once and only compare the keys of entries whose fingerprints match, which for STRING keys
+// avoids most reads from the overflow file.
 template<typename T>
 struct Slot {
+    static constexpr entry_pos_t CAPACITY =
+        (common::HashIndexConfig::SLOT_SIZE - sizeof(SlotHeader)) / (1 + sizeof(SlotEntry<T>));
+
+    // Returns the mask of the valid entries whose fingerprint is the given one.
+    inline uint32_t getEntriesWithFingerprint(uint8_t fingerprint) const {
+#ifdef __SSE2__
+        static_assert(CAPACITY <= 16 && sizeof(SlotHeader) + 16 <= sizeof(Slot<T>));
+        // The load may read past the fingerprints into the entries, which are masked out below.
+        auto matches = _mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(fingerprints)),
+                _mm_set1_epi8((char)fingerprint)));
+        return (uint32_t)matches & header.validityMask;
+#else
+        uint32_t matches = 0;
+        for (auto entryPos = 0u; entryPos < CAPACITY; entryPos++) {
+            matches |= (uint32_t)(fingerprints[entryPos] == fingerprint) << entryPos;
+        }
+        return matches & header.validityMask;
+#endif
+    }
+
     SlotHeader header;
-    SlotEntry<T> entries[common::HashIndexConfig::SLOT_CAPACITY];
+    uint8_t fingerprints[CAPACITY];
+    SlotEntry<T> entries[CAPACITY];
+};
+
+// Statistics of the chains of overflow slots of a hash index. Long chains indicate a skewed hash
+// function or an index that is not split often enough, both of which slow down lookups.
+struct SlotChainStatistics {
+    uint64_t numPrimarySlots = 0;
+    uint64_t numOverflowSlots = 0;
+    uint64_t numPrimarySlotsWithOverflowSlots = 0;
+    uint64_t maxNumOverflowSlotsInChain = 0;
 };
 
 } // namespace storage
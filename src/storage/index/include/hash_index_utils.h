@@ -79,6 +79,11 @@ public:
         function::operation::Hash::operation(string((char*)key), hash);
         return hash;
     }
+    // Gives the same hash as hashFuncForString, as std::hash gives the same hash for a string and
+    // a string_view of the same characters, without copying the key into a string.
+    inline static hash_t hashFuncForStringView(string_view key) {
+        return std::hash<string_view>()(key);
+    }
     static hash_function_t initializeHashFunc(DataTypeID dataTypeID);
 
     // EqualsFunc
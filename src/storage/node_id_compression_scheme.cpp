@@ -12,6 +12,19 @@ void NodeIDCompressionScheme::readNodeID(uint8_t* data, nodeID_t* nodeID) const
     }
 }
 
+void NodeIDCompressionScheme::readNodeIDs(
+    const uint8_t* data, nodeID_t* nodeIDs, uint64_t numNodeIDs) const {
+    if (commonTableID == UINT64_MAX) {
+        memcpy(nodeIDs, data, numNodeIDs * Types::getDataTypeSize(NODE_ID));
+    } else {
+        auto offsets = (const node_offset_t*)data;
+        for (auto i = 0u; i < numNodeIDs; i++) {
+            nodeIDs[i].offset = offsets[i];
+            nodeIDs[i].tableID = commonTableID;
+        }
+    }
+}
+
 void NodeIDCompressionScheme::writeNodeID(uint8_t* data, nodeID_t* nodeID) const {
     if (commonTableID == UINT64_MAX) {
         memcpy(data, nodeID, Types::getDataTypeSize(NODE_ID));
@@ -1,11 +1,30 @@
 #include "src/storage/storage_structure/include/column.h"
 
+#include <array>
+
 #include "src/common/include/in_mem_overflow_buffer_utils.h"
 #include "src/storage/storage_structure/include/storage_structure_utils.h"
 
 namespace kuzu {
 namespace storage {
 
+// Maps a byte of bit-packed BOOL values to the 8 bytes of bools it unpacks to.
+static constexpr array<uint64_t, 256> BOOL_UNPACK_TABLE = [] {
+    array<uint64_t, 256> table{};
+    for (auto byte = 0u; byte < 256; byte++) {
+        for (auto bitPos = 0u; bitPos < 8; bitPos++) {
+            if (byte & (1u << bitPos)) {
+                table[byte] |= (uint64_t)1 << (bitPos * 8);
+            }
+        }
+    }
+    return table;
+}();
+
+static inline bool readBoolBit(const uint8_t* frame, uint64_t posInPage) {
+    return frame[posInPage >> 3] & (1u << (posInPage & 7));
+}
+
 void Column::read(Transaction* transaction, const shared_ptr<ValueVector>& nodeIDVector,
     const shared_ptr<ValueVector>& resultVector) {
     if (nodeIDVector->state->isFlat()) {
@@ -16,6 +35,10 @@ void Column::read(Transaction* transaction, const shared_ptr<ValueVector>& nodeI
         auto startOffset = nodeIDVector->readNodeOffset(0);
         auto pageCursor = PageUtils::getPageElementCursorForPos(startOffset, numElementsPerPage);
         if (nodeIDVector->state->selVector->isUnfiltered()) {
+            // Sequential scans read consecutive node offset ranges, so we prefetch the pages ahead
+            // of the range, which are likely to be scanned next.
+            prefetchPagesAheadOfSequentialRead(
+                startOffset, nodeIDVector->state->originalSize, UINT64_MAX, identityMapper);
             scan(transaction, resultVector, pageCursor);
         } else {
             scanWithSelState(transaction, resultVector, pageCursor);
@@ -66,8 +89,8 @@ bool Column::isNull(node_offset_t nodeOffset, Transaction* transaction) {
     auto cursor = PageUtils::getPageElementCursorForPos(nodeOffset, numElementsPerPage);
     auto originalPageIdx = cursor.pageIdx;
     fileHandle.acquirePageLock(originalPageIdx, true /* block */);
-    auto checkWALVersionOfPage =
-        !transaction->isReadOnly() && fileHandle.hasWALPageVersionNoPageLock(originalPageIdx);
+    auto checkWALVersionOfPage = transaction->getVersionToRead() == TransactionType::WRITE &&
+                                 fileHandle.hasWALPageVersionNoPageLock(originalPageIdx);
     uint8_t* frame;
     page_idx_t pageIdxInWAL;
     if (checkWALVersionOfPage) {
@@ -78,7 +101,7 @@ bool Column::isNull(node_offset_t nodeOffset, Transaction* transaction) {
         frame = bufferManager.pinWithoutAcquiringPageLock(
             fileHandle, originalPageIdx, false /* read from file */);
     }
-    auto nullEntries = (uint64_t*)(frame + (elementSize * numElementsPerPage));
+    auto nullEntries = (uint64_t*)(frame + nullEntriesOffsetInPage);
     auto isNull = NullMask::isNull(nullEntries, cursor.elemPosInPage);
     if (checkWALVersionOfPage) {
         bufferManager.unpinWithoutAcquiringPageLock(*wal->fileHandle, pageIdxInWAL);
@@ -111,7 +134,7 @@ void Column::lookup(Transaction* transaction, const shared_ptr<ValueVector>& res
     uint32_t vectorPos, PageElementCursor& cursor) {
     auto [fileHandleToPin, pageIdxToPin] =
         StorageStructureUtils::getFileHandleAndPhysicalPageIdxToPin(
-            fileHandle, cursor.pageIdx, *wal, transaction->getType());
+            fileHandle, cursor.pageIdx, *wal, transaction->getVersionToRead());
     auto frame = bufferManager.pin(*fileHandleToPin, pageIdxToPin);
     auto vectorBytesOffset = vectorPos * elementSize;
     auto frameBytesOffset = cursor.elemPosInPage * elementSize;
@@ -120,12 +143,29 @@ void Column::lookup(Transaction* transaction, const shared_ptr<ValueVector>& res
     bufferManager.unpin(*fileHandleToPin, pageIdxToPin);
 }
 
+void Column::prepareCommitOrRollbackIfNecessary(bool isCommit) {
+    if (zoneMap == nullptr || !zoneMap->hasUpdates()) {
+        return;
+    }
+    if (isCommit) {
+        zoneMap->saveToFile(DBFileType::WAL_VERSION);
+        wal->logZoneMapRecord(fileHandle.getStorageStructureIDIDForWALRecord());
+    }
+    // Zones that a rolled back transaction widened are kept, which only makes scans skip fewer
+    // pages.
+    zoneMap->clearUpdates();
+}
+
 WALPageIdxPosInPageAndFrame Column::beginUpdatingPage(node_offset_t nodeOffset,
     const shared_ptr<ValueVector>& vectorToWriteFrom, uint32_t posInVectorToWriteFrom) {
     auto isNull = vectorToWriteFrom->isNull(posInVectorToWriteFrom);
     auto walPageInfo = beginUpdatingPageAndWriteOnlyNullBit(nodeOffset, isNull);
     if (!isNull) {
         writeToPage(walPageInfo, vectorToWriteFrom, posInVectorToWriteFrom);
+        if (zoneMap) {
+            zoneMap->update(walPageInfo.originalPageIdx,
+                vectorToWriteFrom->values + posInVectorToWriteFrom * elementSize);
+        }
     }
     return walPageInfo;
 }
@@ -145,6 +185,64 @@ void Column::writeValueForSingleNodeIDPosition(node_offset_t nodeOffset,
         updatedPageInfoAndWALPageFrame, fileHandle, bufferManager, *wal);
 }
 
+Literal BoolPropertyColumn::readValue(node_offset_t offset) {
+    auto cursor = PageUtils::getPageElementCursorForPos(offset, numElementsPerPage);
+    auto frame = bufferManager.pin(fileHandle, cursor.pageIdx);
+    auto retVal = Literal(readBoolBit(frame, cursor.elemPosInPage));
+    bufferManager.unpin(fileHandle, cursor.pageIdx);
+    return retVal;
+}
+
+void BoolPropertyColumn::lookup(Transaction* transaction,
+    const shared_ptr<ValueVector>& resultVector, uint32_t vectorPos, PageElementCursor& cursor) {
+    auto [fileHandleToPin, pageIdxToPin] =
+        StorageStructureUtils::getFileHandleAndPhysicalPageIdxToPin(
+            fileHandle, cursor.pageIdx, *wal, transaction->getVersionToRead());
+    auto frame = bufferManager.pin(*fileHandleToPin, pageIdxToPin);
+    ((bool*)resultVector->values)[vectorPos] = readBoolBit(frame, cursor.elemPosInPage);
+    readSingleNullBit(resultVector, frame, cursor.elemPosInPage, vectorPos);
+    bufferManager.unpin(*fileHandleToPin, pageIdxToPin);
+}
+
+void BoolPropertyColumn::readAPageBySequentialCopy(Transaction* transaction,
+    const shared_ptr<ValueVector>& vector, uint64_t vectorStartPos, page_idx_t physicalPageIdx,
+    uint16_t pagePosOfFirstElement, uint64_t numValuesToRead) {
+    auto [fileHandleToPin, pageIdxToPin] =
+        StorageStructureUtils::getFileHandleAndPhysicalPageIdxToPin(
+            fileHandle, physicalPageIdx, *wal, transaction->getVersionToRead());
+    auto frame = bufferManager.pin(*fileHandleToPin, pageIdxToPin);
+    unpackBits(frame, pagePosOfFirstElement, numValuesToRead,
+        (bool*)vector->values + vectorStartPos);
+    readNullBitsFromAPage(vector, frame, pagePosOfFirstElement, vectorStartPos, numValuesToRead);
+    bufferManager.unpin(*fileHandleToPin, pageIdxToPin);
+}
+
+void BoolPropertyColumn::writeToPage(WALPageIdxPosInPageAndFrame& walPageInfo,
+    const shared_ptr<ValueVector>& vectorToWriteFrom, uint32_t posInVectorToWriteFrom) {
+    auto& byte = walPageInfo.frame[walPageInfo.posInPage >> 3];
+    auto bitMask = (uint8_t)(1u << (walPageInfo.posInPage & 7));
+    if (((bool*)vectorToWriteFrom->values)[posInVectorToWriteFrom]) {
+        byte |= bitMask;
+    } else {
+        byte &= ~bitMask;
+    }
+}
+
+void BoolPropertyColumn::unpackBits(
+    const uint8_t* frame, uint64_t posInPage, uint64_t numValuesToRead, bool* values) {
+    auto i = 0u;
+    // Unpack bit by bit up to the first byte boundary, then a whole byte at a time.
+    for (; i < numValuesToRead && ((posInPage + i) & 7); i++) {
+        values[i] = readBoolBit(frame, posInPage + i);
+    }
+    for (; i + 8 <= numValuesToRead; i += 8) {
+        memcpy(values + i, &BOOL_UNPACK_TABLE[frame[(posInPage + i) >> 3]], 8);
+    }
+    for (; i < numValuesToRead; i++) {
+        values[i] = readBoolBit(frame, posInPage + i);
+    }
+}
+
 void StringPropertyColumn::writeValueForSingleNodeIDPosition(node_offset_t nodeOffset,
     const shared_ptr<ValueVector>& vectorToWriteFrom, uint32_t posInVectorToWriteFrom) {
     auto updatedPageInfoAndWALPageFrame =
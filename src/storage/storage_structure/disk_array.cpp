@@ -93,6 +93,43 @@ U BaseDiskArray<U>::get(uint64_t idx, TransactionType trxType) {
     }
 }
 
+template<typename U>
+void BaseDiskArray<U>::get(const vector<uint64_t>& idxs, U* values, TransactionType trxType) {
+    shared_lock slock{diskArraySharedMtx};
+    vector<page_idx_t> apPageIdxs;
+    vector<uint64_t> startPosOfAPs;
+    for (auto i = 0u; i < idxs.size(); i++) {
+        assert(i == 0 || idxs[i - 1] <= idxs[i]);
+        checkOutOfBoundAccess(trxType, idxs[i]);
+        if (i == 0 || getAPIdxAndOffsetInAP(idxs[i]).pageIdx !=
+                          getAPIdxAndOffsetInAP(idxs[i - 1]).pageIdx) {
+            apPageIdxs.push_back(
+                getAPPageIdxNoLock(getAPIdxAndOffsetInAP(idxs[i]).pageIdx, trxType));
+            startPosOfAPs.push_back(i);
+        }
+    }
+    startPosOfAPs.push_back(idxs.size());
+    for (auto apPageIdx : apPageIdxs) {
+        bufferManager->prefetch(fileHandle, apPageIdx, 1 /* numPagesToPrefetch */);
+    }
+    for (auto i = 0u; i < apPageIdxs.size(); i++) {
+        auto readOp = [&](const uint8_t* frame) -> void {
+            for (auto pos = startPosOfAPs[i]; pos < startPosOfAPs[i + 1]; pos++) {
+                values[pos] = *(U*)(frame + getAPIdxAndOffsetInAP(idxs[pos]).offsetInPage);
+            }
+        };
+        if (trxType == READ_ONLY || !hasTransactionalUpdates ||
+            !((VersionedFileHandle&)fileHandle).hasWALPageVersionNoPageLock(apPageIdxs[i])) {
+            auto frame = bufferManager->pin(fileHandle, apPageIdxs[i]);
+            readOp(frame);
+            bufferManager->unpin(fileHandle, apPageIdxs[i]);
+        } else {
+            StorageStructureUtils::readWALVersionOfPage(
+                (VersionedFileHandle&)fileHandle, apPageIdxs[i], *bufferManager, *wal, readOp);
+        }
+    }
+}
+
 template<typename U>
 void BaseDiskArray<U>::update(uint64_t idx, U val) {
     unique_lock xlock{diskArraySharedMtx};
@@ -451,10 +488,24 @@ void InMemDiskArrayBuilder<T>::saveToDisk() {
         this->fileHandle.writePage(
             reinterpret_cast<uint8_t*>(&this->pips[i].pipContents), this->pips[i].pipPageIdx);
     }
-    // Save array pages
-    for (page_idx_t apIdx = 0; apIdx < this->header.numAPs; ++apIdx) {
-        this->fileHandle.writePage(reinterpret_cast<uint8_t*>(this->inMemArrayPages[apIdx].get()),
-            this->getAPPageIdxNoLock(apIdx));
+    // Save array pages. Array pages are mostly allocated one after another in the file, so we
+    // write runs of array pages that are contiguous in the file with a single write.
+    auto pageSize = this->fileHandle.getPageSize();
+    auto pagesBuffer = make_unique<uint8_t[]>(StorageConfig::MAX_NUM_PAGES_PER_WRITE * pageSize);
+    page_idx_t apIdx = 0;
+    while (apIdx < this->header.numAPs) {
+        auto startPageIdx = this->getAPPageIdxNoLock(apIdx);
+        auto numPagesInRun = 0u;
+        while (apIdx < this->header.numAPs &&
+               numPagesInRun < StorageConfig::MAX_NUM_PAGES_PER_WRITE &&
+               this->getAPPageIdxNoLock(apIdx) == startPageIdx + numPagesInRun) {
+            memcpy(pagesBuffer.get() + numPagesInRun * pageSize,
+                this->inMemArrayPages[apIdx].get(), pageSize);
+            numPagesInRun++;
+            apIdx++;
+        }
+        FileUtils::writeToFile(this->fileHandle.getFileInfo(), pagesBuffer.get(),
+            numPagesInRun * pageSize, startPageIdx * pageSize);
     }
 }
 
@@ -7,10 +7,13 @@
 namespace kuzu {
 namespace storage {
 
-InMemFile::InMemFile(
-    string filePath, uint16_t numBytesForElement, bool hasNullMask, uint64_t numPages)
-    : filePath{move(filePath)}, numBytesForElement{numBytesForElement}, hasNullMask{hasNullMask} {
-    numElementsInAPage = PageUtils::getNumElementsInAPage(numBytesForElement, hasNullMask);
+InMemFile::InMemFile(string filePath, uint16_t numBytesForElement, bool hasNullMask,
+    uint64_t numPages, bool isBitPacked)
+    : filePath{move(filePath)}, numBytesForElement{numBytesForElement}, hasNullMask{hasNullMask},
+      isBitPacked{isBitPacked} {
+    numElementsInAPage = isBitPacked ?
+                             PageUtils::getNumElementsInABitPackedPage() :
+                             PageUtils::getNumElementsInAPage(numBytesForElement, hasNullMask);
     for (auto i = 0u; i < numPages; i++) {
         addANewPage();
     }
@@ -24,7 +27,8 @@ void InMemFile::addNewPages(uint64_t numNewPagesToAdd, bool setToZero) {
 
 uint32_t InMemFile::addANewPage(bool setToZero) {
     auto newPageIdx = pages.size();
-    pages.push_back(make_unique<InMemPage>(numElementsInAPage, numBytesForElement, hasNullMask));
+    pages.push_back(make_unique<InMemPage>(
+        numElementsInAPage, numBytesForElement, hasNullMask, isBitPacked));
     if (setToZero) {
         memset(pages[newPageIdx]->data, 0, DEFAULT_PAGE_SIZE);
     }
@@ -234,14 +238,19 @@ uint32_t InMemOverflowFile::addANewOverflowPage() {
 }
 
 string InMemOverflowFile::readString(ku_string_t* strInInMemOvfFile) {
+    return string(readStringView(strInInMemOvfFile));
+}
+
+string_view InMemOverflowFile::readStringView(const ku_string_t* strInInMemOvfFile) const {
     if (ku_string_t::isShortString(strInInMemOvfFile->len)) {
-        return strInInMemOvfFile->getAsShortString();
+        return string_view(
+            reinterpret_cast<const char*>(strInInMemOvfFile->prefix), strInInMemOvfFile->len);
     } else {
         page_idx_t pageIdx = UINT32_MAX;
         uint16_t pagePos = UINT16_MAX;
         TypeUtils::decodeOverflowPtr(strInInMemOvfFile->overflowPtr, pageIdx, pagePos);
-        return string(
-            reinterpret_cast<char*>(pages[pageIdx]->data + pagePos), strInInMemOvfFile->len);
+        return string_view(
+            reinterpret_cast<const char*>(pages[pageIdx]->data + pagePos), strInInMemOvfFile->len);
     }
 }
 
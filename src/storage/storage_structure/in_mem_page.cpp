@@ -3,10 +3,13 @@
 #include <cmath>
 #include <cstring>
 
+#include "src/storage/include/storage_utils.h"
+
 namespace kuzu {
 namespace storage {
 
-InMemPage::InMemPage(uint32_t maxNumElements, uint16_t numBytesForElement, bool hasNullEntries)
+InMemPage::InMemPage(
+    uint32_t maxNumElements, uint16_t numBytesForElement, bool hasNullEntries, bool isBitPacked)
     : nullEntriesInPage{nullptr}, maxNumElements{maxNumElements} {
     buffer = make_unique<uint8_t[]>(DEFAULT_PAGE_SIZE);
     data = buffer.get();
@@ -16,7 +19,9 @@ InMemPage::InMemPage(uint32_t maxNumElements, uint16_t numBytesForElement, bool
         // null or not. By default, we consider all elements in the page to be NULL. When a new
         // element comes in to be put at a pos, its respective NULL bit is reset to denote a
         // non-NULL value.
-        nullEntriesInPage = (uint64_t*)(data + (numBytesForElement * maxNumElements));
+        nullEntriesInPage =
+            (uint64_t*)(data + (isBitPacked ? PageUtils::getNullEntriesOffsetInABitPackedPage() :
+                                              numBytesForElement * maxNumElements));
         auto numNullEntries = (maxNumElements + NullMask::NUM_BITS_PER_NULL_ENTRY - 1) /
                               NullMask::NUM_BITS_PER_NULL_ENTRY;
         fill(nullEntriesInPage, nullEntriesInPage + numNullEntries, NullMask::ALL_NULL_ENTRY);
@@ -49,6 +54,18 @@ uint8_t* InMemPage::write(uint32_t byteOffsetInPage, uint32_t elemPosInPage, con
     return data + byteOffsetInPage;
 }
 
+void InMemPage::writeBit(uint32_t elemPosInPage, bool val) {
+    if (val) {
+        auto entryPos = elemPosInPage >> NullMask::NUM_BITS_PER_NULL_ENTRY_LOG2;
+        auto bitPosInEntry = elemPosInPage - (entryPos << NullMask::NUM_BITS_PER_NULL_ENTRY_LOG2);
+        __atomic_fetch_or(&((uint64_t*)data)[entryPos],
+            NULL_BITMASKS_WITH_SINGLE_ONE[bitPosInEntry], __ATOMIC_RELAXED);
+    }
+    if (nullMask) {
+        nullMask[elemPosInPage] = false;
+    }
+}
+
 void InMemPage::encodeNullBits() {
     if (nullMask == nullptr) {
         return;
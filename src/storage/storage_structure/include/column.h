@@ -4,6 +4,7 @@
 #include "src/common/types/include/literal.h"
 #include "src/storage/storage_structure/include/disk_overflow_file.h"
 #include "src/storage/storage_structure/include/storage_structure.h"
+#include "src/storage/storage_structure/include/zone_map.h"
 
 using namespace kuzu::common;
 using namespace kuzu::catalog;
@@ -18,7 +19,12 @@ public:
     Column(const StorageStructureIDAndFName& structureIDAndFName, const DataType& dataType,
         size_t elementSize, BufferManager& bufferManager, bool isInMemory, WAL* wal)
         : BaseColumnOrList{structureIDAndFName, dataType, elementSize, bufferManager,
-              true /*hasNULLBytes*/, isInMemory, wal} {};
+              true /*hasNULLBytes*/, isInMemory, wal} {
+        if (ZoneMap::isSupported(dataType.typeID)) {
+            zoneMap = ZoneMap::readFromFileIfExists(
+                dataType.typeID, StorageUtils::getZoneMapFName(structureIDAndFName.fName));
+        }
+    };
 
     Column(const StorageStructureIDAndFName& structureIDAndFName, const DataType& dataType,
         BufferManager& bufferManager, bool isInMemory, WAL* wal)
@@ -36,6 +42,19 @@ public:
     bool isNull(node_offset_t nodeOffset, Transaction* transaction);
     void setNodeOffsetToNull(node_offset_t nodeOffset);
 
+    // Returns false if the zone map of the column guarantees that no value of the nodes in
+    // [startOffset, endOffset) satisfies "value comparisonType literal".
+    inline bool mayMatch(node_offset_t startOffset, node_offset_t endOffset,
+        ExpressionType comparisonType, const Literal& literal) const {
+        return zoneMap == nullptr ||
+               zoneMap->mayMatch(startOffset / numElementsPerPage,
+                   (endOffset - 1) / numElementsPerPage, comparisonType, literal);
+    }
+
+    // If the write transaction widened zones of the zone map and commits, saves the WAL version
+    // of the zone map file and logs a ZONE_MAP_RECORD, so that checkpointing replaces the file.
+    void prepareCommitOrRollbackIfNecessary(bool isCommit);
+
 protected:
     void lookup(Transaction* transaction, const shared_ptr<ValueVector>& nodeIDVector,
         const shared_ptr<ValueVector>& resultVector, uint32_t vectorPos);
@@ -76,6 +95,38 @@ private:
 protected:
     // no logical-physical page mapping is required for columns
     std::function<page_idx_t(page_idx_t)> identityMapper = [](uint32_t i) { return i; };
+    // Only set for numeric columns that were copied from csv. See ZoneMap for details.
+    unique_ptr<ZoneMap> zoneMap;
+};
+
+// BOOL values are bit-packed, one bit per value, so a page holds 8x more values than with a byte
+// per value. The layout does not depend on the values, so updates remain in place. Values are
+// unpacked into the byte per value layout of ValueVectors when read.
+class BoolPropertyColumn : public Column {
+
+public:
+    BoolPropertyColumn(const StorageStructureIDAndFName& structureIDAndFName,
+        const DataType& dataType, BufferManager& bufferManager, bool isInMemory, WAL* wal)
+        : Column{structureIDAndFName, dataType, bufferManager, isInMemory, wal} {
+        numElementsPerPage = PageUtils::getNumElementsInABitPackedPage();
+        nullEntriesOffsetInPage = PageUtils::getNullEntriesOffsetInABitPackedPage();
+    }
+
+    // Currently, used only in CopyCSV tests.
+    Literal readValue(node_offset_t offset) override;
+
+private:
+    void lookup(Transaction* transaction, const shared_ptr<ValueVector>& resultVector,
+        uint32_t vectorPos, PageElementCursor& cursor) override;
+    void readAPageBySequentialCopy(Transaction* transaction, const shared_ptr<ValueVector>& vector,
+        uint64_t vectorStartPos, page_idx_t physicalPageIdx, uint16_t pagePosOfFirstElement,
+        uint64_t numValuesToRead) override;
+    void writeToPage(WALPageIdxPosInPageAndFrame& walPageInfo,
+        const shared_ptr<ValueVector>& vectorToWriteFrom,
+        uint32_t posInVectorToWriteFrom) override;
+
+    static void unpackBits(
+        const uint8_t* frame, uint64_t posInPage, uint64_t numValuesToRead, bool* values);
 };
 
 class PropertyColumnWithOverflow : public Column {
@@ -115,18 +166,20 @@ private:
         Column::lookup(transaction, resultVector, vectorPos, cursor);
         if (!resultVector->isNull(vectorPos)) {
             diskOverflowFile.scanSingleStringOverflow(
-                transaction->getType(), *resultVector, vectorPos);
+                transaction->getVersionToRead(), *resultVector, vectorPos);
         }
     }
     inline void scan(Transaction* transaction, const shared_ptr<ValueVector>& resultVector,
         PageElementCursor& cursor) override {
         Column::scan(transaction, resultVector, cursor);
-        diskOverflowFile.scanSequentialStringOverflow(transaction->getType(), *resultVector);
+        diskOverflowFile.scanSequentialStringOverflow(
+            transaction->getVersionToRead(), *resultVector);
     }
     void scanWithSelState(Transaction* transaction, const shared_ptr<ValueVector>& resultVector,
         PageElementCursor& cursor) override {
         Column::scanWithSelState(transaction, resultVector, cursor);
-        diskOverflowFile.scanSequentialStringOverflow(transaction->getType(), *resultVector);
+        diskOverflowFile.scanSequentialStringOverflow(
+            transaction->getVersionToRead(), *resultVector);
     }
 };
 
@@ -149,18 +202,18 @@ private:
         Column::lookup(transaction, resultVector, vectorPos, cursor);
         if (!resultVector->isNull(vectorPos)) {
             diskOverflowFile.scanSingleListOverflow(
-                transaction->getType(), *resultVector, vectorPos);
+                transaction->getVersionToRead(), *resultVector, vectorPos);
         }
     }
     inline void scan(Transaction* transaction, const shared_ptr<ValueVector>& resultVector,
         PageElementCursor& cursor) override {
         Column::scan(transaction, resultVector, cursor);
-        diskOverflowFile.readListsToVector(transaction->getType(), *resultVector);
+        diskOverflowFile.readListsToVector(transaction->getVersionToRead(), *resultVector);
     }
     inline void scanWithSelState(Transaction* transaction,
         const shared_ptr<ValueVector>& resultVector, PageElementCursor& cursor) override {
         Column::scanWithSelState(transaction, resultVector, cursor);
-        diskOverflowFile.readListsToVector(transaction->getType(), *resultVector);
+        diskOverflowFile.readListsToVector(transaction->getVersionToRead(), *resultVector);
     }
 };
 
@@ -213,12 +266,14 @@ public:
         switch (dataType.typeID) {
         case INT64:
         case DOUBLE:
-        case BOOL:
         case DATE:
         case TIMESTAMP:
         case INTERVAL:
             return make_unique<Column>(
                 structureIDAndFName, dataType, bufferManager, isInMemory, wal);
+        case BOOL:
+            return make_unique<BoolPropertyColumn>(
+                structureIDAndFName, dataType, bufferManager, isInMemory, wal);
         case STRING:
             return make_unique<StringPropertyColumn>(
                 structureIDAndFName, dataType, bufferManager, isInMemory, wal);
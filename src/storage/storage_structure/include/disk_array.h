@@ -110,6 +110,10 @@ public:
     uint64_t getNumElements(TransactionType trxType = TransactionType::READ_ONLY);
 
     U get(uint64_t idx, TransactionType trxType);
+    // Reads the elements at the given indices into values. The indices have to be sorted, so that
+    // the elements on the same array page are read with a single pin of the page. Array pages that
+    // are not in the buffer manager are prefetched before any of them is read.
+    void get(const vector<uint64_t>& idxs, U* values, TransactionType trxType);
 
     // Note: This function is to be used only by the WRITE trx.
     void update(uint64_t idx, U val);
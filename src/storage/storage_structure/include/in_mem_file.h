@@ -19,8 +19,8 @@ static const string IN_MEM_TEMP_FILE_PATH = "";
 class InMemFile {
 
 public:
-    InMemFile(
-        std::string filePath, uint16_t numBytesForElement, bool hasNullMask, uint64_t numPages = 0);
+    InMemFile(std::string filePath, uint16_t numBytesForElement, bool hasNullMask,
+        uint64_t numPages = 0, bool isBitPacked = false);
     InMemFile(uint16_t numBytesForElement, bool hasNullMask, uint64_t numPages = 0)
         : InMemFile(IN_MEM_TEMP_FILE_PATH, numBytesForElement, hasNullMask, numPages) {}
 
@@ -41,6 +41,7 @@ protected:
     uint16_t numBytesForElement;
     uint64_t numElementsInAPage;
     bool hasNullMask;
+    bool isBitPacked;
     vector<unique_ptr<InMemPage>> pages;
 };
 
@@ -77,6 +78,8 @@ public:
         ku_list_t* dstKUList, DataType* listChildDataType);
 
     string readString(ku_string_t* strInInMemOvfFile);
+    // The view is valid as long as the string and its overflow page are not modified.
+    string_view readStringView(const ku_string_t* strInInMemOvfFile) const;
 
 private:
     uint32_t addANewOverflowPage();
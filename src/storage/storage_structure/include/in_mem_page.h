@@ -16,8 +16,10 @@ namespace storage {
 class InMemPage {
 
 public:
-    // Creates an in-memory page with a boolean array to store NULL bits
-    InMemPage(uint32_t maxNumElements, uint16_t numBytesForElement, bool hasNullEntries);
+    // Creates an in-memory page with a boolean array to store NULL bits. Elements of a bit-packed
+    // page take a single bit each and numBytesForElement is ignored.
+    InMemPage(uint32_t maxNumElements, uint16_t numBytesForElement, bool hasNullEntries,
+        bool isBitPacked = false);
 
     inline bool isElemPosNull(uint16_t elemPosInPage) const { return nullMask[elemPosInPage]; }
 
@@ -25,6 +27,9 @@ public:
         const NodeIDCompressionScheme& nodeIDCompressionScheme);
     uint8_t* write(uint32_t byteOffsetInPage, uint32_t elemPosInPage, const uint8_t* elem,
         uint32_t numBytesForElem);
+    // Sets the bit of a bit-packed element. Neighbouring elements share the same word of the page,
+    // so bits are set atomically to allow concurrent writes to different positions.
+    void writeBit(uint32_t elemPosInPage, bool val);
 
     void encodeNullBits();
 
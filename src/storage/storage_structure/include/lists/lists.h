@@ -115,6 +115,10 @@ protected:
     virtual inline DiskOverflowFile* getDiskOverflowFileIfExists() { return nullptr; }
     virtual inline NodeIDCompressionScheme* getNodeIDCompressionIfExists() { return nullptr; }
     virtual void prepareCommit(ListsUpdateIterator& listsUpdateIterator) = 0;
+    // Large lists are read in parts, which prefetch the pages of the list ahead of them (see
+    // prefetchPagesAheadOfSequentialRead).
+    void prefetchLargeListPagesIfNecessary(
+        ListHandle& listHandle, uint64_t startElemOffset, uint64_t numValuesToRead);
 
     // storageStructureIDAndFName is the ID and fName for the "main ".lists" file.
     Lists(const StorageStructureIDAndFName& storageStructureIDAndFName, const DataType& dataType,
@@ -25,7 +25,7 @@ public:
     StorageStructure(const StorageStructureIDAndFName& storageStructureIDAndFName,
         BufferManager& bufferManager, bool isInMemory, WAL* wal)
         : logger{LoggerUtils::getOrCreateLogger("storage")},
-          fileHandle{storageStructureIDAndFName, FileHandle::O_PERSISTENT_FILE_NO_CREATE},
+          fileHandle{storageStructureIDAndFName, bufferManager.getStorageStructureFileFlags()},
           bufferManager{bufferManager}, isInMemory_{isInMemory}, wal{wal} {
         if (isInMemory) {
             StorageStructureUtils::pinEachPageOfFile(fileHandle, bufferManager);
@@ -103,15 +103,25 @@ protected:
         uint16_t pagePosOfFirstElement, uint64_t numValuesToRead,
         NodeIDCompressionScheme& nodeIDCompressionScheme, bool isAdjLists);
 
+    // Sequential reads of consecutive element ranges, e.g., the morsels of a node scan or the parts
+    // of a large list, prefetch the pages ahead of them in windows of MAX_NUM_PAGES_TO_PREFETCH
+    // pages. The read that contains the first element of a window prefetches the next window, and
+    // the first read also prefetches the rest of the first window. So each page is prefetched once
+    // and never by the read that reads it. Pages that hold no element below numElements are not
+    // prefetched. Runs of consecutive physical pages are prefetched together.
+    void prefetchPagesAheadOfSequentialRead(uint64_t startElemOffset, uint64_t numValuesToRead,
+        uint64_t numElements,
+        const std::function<page_idx_t(page_idx_t)>& logicalToPhysicalPageMapper);
+
     void readSingleNullBit(const shared_ptr<ValueVector>& valueVector, const uint8_t* frame,
         uint64_t elementPos, uint64_t offsetInVector) const;
 
     void setNullBitOfAPosInFrame(uint8_t* frame, uint16_t elementPos, bool isNull) const;
 
-private:
-    void readAPageBySequentialCopy(Transaction* transaction, const shared_ptr<ValueVector>& vector,
-        uint64_t vectorStartPos, page_idx_t physicalPageIdx, uint16_t pagePosOfFirstElement,
-        uint64_t numValuesToRead);
+    // Virtual so that columns which do not store elements at their full width can decode them.
+    virtual void readAPageBySequentialCopy(Transaction* transaction,
+        const shared_ptr<ValueVector>& vector, uint64_t vectorStartPos, page_idx_t physicalPageIdx,
+        uint16_t pagePosOfFirstElement, uint64_t numValuesToRead);
 
     void readNullBitsFromAPage(const shared_ptr<ValueVector>& valueVector, const uint8_t* frame,
         uint64_t posInPage, uint64_t posInVector, uint64_t numBitsToRead) const;
@@ -120,6 +130,8 @@ public:
     DataType dataType;
     size_t elementSize;
     uint32_t numElementsPerPage;
+    // Byte offset of the null entries in a page, which follow the elements.
+    uint32_t nullEntriesOffsetInPage;
 };
 
 } // namespace storage
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <mutex>
+#include <shared_mutex>
+
+#include "src/common/include/expression_type.h"
+#include "src/common/types/include/literal.h"
+
+using namespace kuzu::common;
+using namespace std;
+
+namespace kuzu {
+namespace storage {
+
+// A zone map keeps the min and max of the non-NULL values in each page of a fixed-width numeric
+// column. Scans use it to skip pages whose values cannot satisfy a comparison with a literal. A
+// zone map is conservative: it may report that a page can match although none of its values do,
+// but never the other way around. Updates only widen the zone of a page, and pages added after the
+// zone map was built have no zone and can always match.
+//
+// Zone maps are computed when a column is copied from csv and saved next to the column file.
+// Updates widen the zones in memory. When a write transaction that widened zones commits, the zone
+// map is saved as the WAL version of the file, which replaces the file when the WAL is
+// checkpointed. Zones widened by a rolled back transaction stay widened.
+class ZoneMap {
+    // DOUBLE values are kept in doubleVal. INT64, DATE and TIMESTAMP values are kept in intVal.
+    union ZoneValue {
+        int64_t intVal;
+        double doubleVal;
+    };
+    struct Zone {
+        ZoneValue min;
+        ZoneValue max;
+    };
+
+public:
+    ZoneMap(DataTypeID dataTypeID, string fName, uint64_t numPages);
+
+    static inline bool isSupported(DataTypeID dataTypeID) {
+        return dataTypeID == INT64 || dataTypeID == DOUBLE || dataTypeID == DATE ||
+               dataTypeID == TIMESTAMP;
+    }
+
+    // Widens the zone of the page to include the value.
+    void update(page_idx_t pageIdx, const uint8_t* value);
+    // Returns if zones have been widened since the updates were last cleared.
+    inline bool hasUpdates() const {
+        shared_lock lck{mtx};
+        return hasUpdates_;
+    }
+    inline void clearUpdates() {
+        unique_lock lck{mtx};
+        hasUpdates_ = false;
+    }
+    // Returns false if no value in pages [startPageIdx, endPageIdx] can satisfy
+    // "value comparisonType literal".
+    bool mayMatch(page_idx_t startPageIdx, page_idx_t endPageIdx, ExpressionType comparisonType,
+        const Literal& literal) const;
+
+    void saveToFile(DBFileType dbFileType = DBFileType::ORIGINAL) const;
+    // Returns nullptr if the zone map file does not exist, e.g., the column was created before
+    // zone maps were introduced.
+    static unique_ptr<ZoneMap> readFromFileIfExists(DataTypeID dataTypeID, const string& fName);
+
+private:
+    template<typename T>
+    static inline T& getValue(ZoneValue& zoneValue) {
+        if constexpr (is_same_v<T, double>) {
+            return zoneValue.doubleVal;
+        } else {
+            return zoneValue.intVal;
+        }
+    }
+    template<typename T>
+    static inline T getValue(const ZoneValue& zoneValue) {
+        return getValue<T>(const_cast<ZoneValue&>(zoneValue));
+    }
+    template<typename T>
+    bool updateZone(Zone& zone, T value);
+    template<typename T>
+    static bool mayMatch(const Zone& zone, ExpressionType comparisonType, T value);
+
+private:
+    DataTypeID dataTypeID;
+    string fName;
+    bool hasUpdates_;
+    vector<Zone> zones;
+    mutable shared_mutex mtx;
+};
+
+} // namespace storage
+} // namespace kuzu
@@ -32,8 +32,9 @@ ListHeaders::ListHeaders(const StorageStructureIDAndFName storageStructureIDAndF
     storageStructureIDAndFName.storageStructureID.listFileID.listFileType = ListFileType::HEADERS;
     storageStructureIDAndFName.fName =
         StorageUtils::getListHeadersFName(storageStructureIDAndFNameForBaseList.fName);
-    versionedFileHandle = make_unique<VersionedFileHandle>(
-        storageStructureIDAndFName, FileHandle::O_PERSISTENT_FILE_CREATE_NOT_EXISTS);
+    versionedFileHandle = make_unique<VersionedFileHandle>(storageStructureIDAndFName,
+        bufferManager->getInMemStorageStructureFileFlags(
+            FileHandle::O_PERSISTENT_FILE_CREATE_NOT_EXISTS));
     storageStructureIDAndFName.storageStructureID.listFileID.listFileType = ListFileType::HEADERS;
     storageStructureIDAndFName.fName = versionedFileHandle->getFileInfo()->path;
     headersDiskArray = make_unique<InMemDiskArray<list_header_t>>(
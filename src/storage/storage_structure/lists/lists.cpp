@@ -28,7 +28,7 @@ void Lists::fillInMemListsFromPersistentStore(
         memcpy(listData, frame + cursorAndMapper.cursor.elemPosInPage * elementSize,
             numElementsToReadInCurPage * elementSize);
         if (inMemList.hasNullBuffer()) {
-            NullMask::copyNullMask((uint64_t*)(frame + numElementsPerPage * elementSize),
+            NullMask::copyNullMask((uint64_t*)(frame + nullEntriesOffsetInPage),
                 cursorAndMapper.cursor.elemPosInPage, inMemList.getNullMask(), numElementsRead,
                 numElementsToReadInCurPage);
         }
@@ -39,6 +39,12 @@ void Lists::fillInMemListsFromPersistentStore(
     }
 }
 
+void Lists::prefetchLargeListPagesIfNecessary(
+    ListHandle& listHandle, uint64_t startElemOffset, uint64_t numValuesToRead) {
+    prefetchPagesAheadOfSequentialRead(startElemOffset, numValuesToRead,
+        listHandle.listSyncState.getNumValuesInList(), listHandle.cursorAndMapper.mapper);
+}
+
 // Note: The given nodeOffset and largeListHandle may not be connected. For example if we
 // are about to read a new nodeOffset, say v5, after having read a previous nodeOffset, say v7, with
 // a largeList, then the input to this function can be nodeOffset: 5 and largeListHandle containing
@@ -122,6 +128,8 @@ void ListsWithAdjAndPropertyListsUpdateStore::readFromSmallList(
 void ListsWithAdjAndPropertyListsUpdateStore::readFromLargeList(
     const shared_ptr<ValueVector>& valueVector, ListHandle& listHandle) {
     // assumes that the associated adjList has already updated the syncState.
+    prefetchLargeListPagesIfNecessary(listHandle, listHandle.listSyncState.getStartElemOffset(),
+        valueVector->state->originalSize);
     auto pageCursor = PageUtils::getPageElementCursorForPos(
         listHandle.listSyncState.getStartElemOffset(), numElementsPerPage);
     auto dummyReadOnlyTrx = Transaction::getDummyReadOnlyTrx();
@@ -269,16 +277,8 @@ unique_ptr<vector<nodeID_t>> AdjLists::readAdjacencyListOfNode(
     }
 
     // Step 2
-    unique_ptr<vector<nodeID_t>> retVal = make_unique<vector<nodeID_t>>();
-    auto sizeLeftToDecompress = listLenInBytes;
-    bufferPtr = buffer.get();
-    while (sizeLeftToDecompress) {
-        nodeID_t nodeID(0, 0);
-        nodeIDCompressionScheme.readNodeID(bufferPtr, &nodeID);
-        bufferPtr += nodeIDCompressionScheme.getNumBytesForNodeIDAfterCompression();
-        retVal->emplace_back(nodeID);
-        sizeLeftToDecompress -= nodeIDCompressionScheme.getNumBytesForNodeIDAfterCompression();
-    }
+    auto retVal = make_unique<vector<nodeID_t>>(numElementsInList);
+    nodeIDCompressionScheme.readNodeIDs(buffer.get(), retVal->data(), numElementsInList);
     return retVal;
 }
 
@@ -304,6 +304,7 @@ void AdjLists::readFromLargeList(
     valueVector->state->initOriginalAndSelectedSize(numValuesToCopy);
     listSyncState.setRangeToRead(
         nextPartBeginElemOffset, valueVector->state->selVector->selectedSize);
+    prefetchLargeListPagesIfNecessary(listHandle, nextPartBeginElemOffset, numValuesToCopy);
     // map logical pageIdx to physical pageIdx
     auto physicalPageId =
         listHandle.cursorAndMapper.mapper(listHandle.cursorAndMapper.cursor.pageIdx);
@@ -16,8 +16,8 @@ ListsMetadata::ListsMetadata(
     storageStructureIDAndFName.storageStructureID.listFileID.listFileType = ListFileType::METADATA;
     storageStructureIDAndFName.fName =
         StorageUtils::getListMetadataFName(storageStructureIDAndFNameForBaseList.fName);
-    metadataVersionedFileHandle = make_unique<VersionedFileHandle>(
-        storageStructureIDAndFName, FileHandle::O_PERSISTENT_FILE_NO_CREATE);
+    metadataVersionedFileHandle = make_unique<VersionedFileHandle>(storageStructureIDAndFName,
+        bufferManager->getInMemStorageStructureFileFlags(FileHandle::O_PERSISTENT_FILE_NO_CREATE));
     chunkToPageListHeadIdxMap = make_unique<InMemDiskArray<uint32_t>>(*metadataVersionedFileHandle,
         CHUNK_PAGE_LIST_HEAD_IDX_MAP_HEADER_PAGE_IDX, bufferManager, wal);
     largeListIdxToPageListHeadIdxMap =
@@ -102,7 +102,8 @@ void UnstructuredPropertyLists::readPropertiesForPosition(Transaction* transacti
     // the else branch executes, data is never used.
     unique_ptr<UnstrPropListWrapper> primaryStoreListWrapper;
     UnstrPropListIterator itr;
-    if (transaction->isReadOnly() || !unstructuredListUpdateStore.hasUpdatedList(nodeOffset)) {
+    if (transaction->getVersionToRead() == TransactionType::READ_ONLY ||
+        !unstructuredListUpdateStore.hasUpdatedList(nodeOffset)) {
         auto header = headers->getHeader(nodeOffset);
         CursorAndMapper cursorAndMapper;
         cursorAndMapper.reset(metadata, numElementsPerPage, header, nodeOffset);
@@ -126,8 +127,8 @@ void UnstructuredPropertyLists::readPropertiesForPosition(Transaction* transacti
             itr.copyValueOfCurrentProp(reinterpret_cast<uint8_t*>(&value->val));
             value->dataType.typeID = propertyKeyDataType.dataTypeID;
             if (propertyKeyDataType.dataTypeID == STRING) {
-                diskOverflowFile.readStringToVector(
-                    transaction->getType(), value->val.strVal, vector->getOverflowBuffer());
+                diskOverflowFile.readStringToVector(transaction->getVersionToRead(),
+                    value->val.strVal, vector->getOverflowBuffer());
             }
         }
         // We skipValue regardless of whether we found a property and called
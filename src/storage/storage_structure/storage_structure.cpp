@@ -45,6 +45,46 @@ BaseColumnOrList::BaseColumnOrList(const StorageStructureIDAndFName& storageStru
     : StorageStructure(storageStructureIDAndFName, bufferManager, isInMemory, wal),
       dataType{move(dataType)}, elementSize{elementSize} {
     numElementsPerPage = PageUtils::getNumElementsInAPage(elementSize, hasNULLBytes);
+    nullEntriesOffsetInPage = numElementsPerPage * elementSize;
+}
+
+void BaseColumnOrList::prefetchPagesAheadOfSequentialRead(uint64_t startElemOffset,
+    uint64_t numValuesToRead, uint64_t numElements,
+    const std::function<page_idx_t(page_idx_t)>& logicalToPhysicalPageMapper) {
+    auto numElementsPerWindow = StorageConfig::MAX_NUM_PAGES_TO_PREFETCH * numElementsPerPage;
+    auto endElemOffset = min(startElemOffset + numValuesToRead, numElements);
+    if (endElemOffset <= startElemOffset) {
+        return;
+    }
+    auto firstWindowIdx = (startElemOffset + numElementsPerWindow - 1) / numElementsPerWindow;
+    auto lastWindowIdx = (endElemOffset - 1) / numElementsPerWindow;
+    if (firstWindowIdx > lastWindowIdx) {
+        // The read does not contain the first element of a window.
+        return;
+    }
+    // The pages of the first window are not prefetched by any previous read.
+    auto startPageIdx = firstWindowIdx == 0 ?
+                            0 :
+                            (firstWindowIdx + 1) * StorageConfig::MAX_NUM_PAGES_TO_PREFETCH;
+    startPageIdx = max(startPageIdx, (endElemOffset - 1) / numElementsPerPage + 1);
+    auto endPageIdx = min((lastWindowIdx + 2) * StorageConfig::MAX_NUM_PAGES_TO_PREFETCH,
+        numElements / numElementsPerPage + (numElements % numElementsPerPage != 0));
+    if (startPageIdx >= endPageIdx) {
+        return;
+    }
+    auto runStartPageIdx = logicalToPhysicalPageMapper(startPageIdx);
+    uint64_t numPagesInRun = 1;
+    for (auto pageIdx = startPageIdx + 1; pageIdx < endPageIdx; ++pageIdx) {
+        auto physicalPageIdx = logicalToPhysicalPageMapper(pageIdx);
+        if (physicalPageIdx == runStartPageIdx + numPagesInRun) {
+            numPagesInRun++;
+            continue;
+        }
+        bufferManager.prefetch(fileHandle, runStartPageIdx, numPagesInRun);
+        runStartPageIdx = physicalPageIdx;
+        numPagesInRun = 1;
+    }
+    bufferManager.prefetch(fileHandle, runStartPageIdx, numPagesInRun);
 }
 
 void BaseColumnOrList::readBySequentialCopy(Transaction* transaction,
@@ -143,7 +183,7 @@ void BaseColumnOrList::readNodeIDsFromAPageBySequentialCopy(Transaction* transac
     auto nodeValues = (nodeID_t*)vector->values;
     auto [fileHandleToPin, pageIdxToPin] =
         StorageStructureUtils::getFileHandleAndPhysicalPageIdxToPin(
-            fileHandle, physicalPageIdx, *wal, transaction->getType());
+            fileHandle, physicalPageIdx, *wal, transaction->getVersionToRead());
     auto frame = bufferManager.pin(*fileHandleToPin, pageIdxToPin);
     if (isAdjLists) {
         vector->setRangeNonNull(vectorStartPos, numValuesToRead);
@@ -151,19 +191,14 @@ void BaseColumnOrList::readNodeIDsFromAPageBySequentialCopy(Transaction* transac
         readNullBitsFromAPage(
             vector, frame, pagePosOfFirstElement, vectorStartPos, numValuesToRead);
     }
-    auto currentFrameHead = frame + pagePosOfFirstElement * elementSize;
-    for (auto i = 0u; i < numValuesToRead; i++) {
-        nodeID_t nodeID{0, 0};
-        nodeIDCompressionScheme.readNodeID(currentFrameHead, &nodeID);
-        currentFrameHead += nodeIDCompressionScheme.getNumBytesForNodeIDAfterCompression();
-        nodeValues[vectorStartPos + i] = nodeID;
-    }
+    nodeIDCompressionScheme.readNodeIDs(frame + pagePosOfFirstElement * elementSize,
+        nodeValues + vectorStartPos, numValuesToRead);
     bufferManager.unpin(*fileHandleToPin, pageIdxToPin);
 }
 
 void BaseColumnOrList::readSingleNullBit(const shared_ptr<ValueVector>& valueVector,
     const uint8_t* frame, uint64_t elementPos, uint64_t offsetInVector) const {
-    auto inputNullEntries = (uint64_t*)(frame + (numElementsPerPage * elementSize));
+    auto inputNullEntries = (uint64_t*)(frame + nullEntriesOffsetInPage);
     bool isNull = NullMask::isNull(inputNullEntries, elementPos);
     valueVector->setNull(offsetInVector, isNull);
 }
@@ -173,7 +208,7 @@ void BaseColumnOrList::readAPageBySequentialCopy(Transaction* transaction,
     uint16_t pagePosOfFirstElement, uint64_t numValuesToRead) {
     auto [fileHandleToPin, pageIdxToPin] =
         StorageStructureUtils::getFileHandleAndPhysicalPageIdxToPin(
-            fileHandle, physicalPageIdx, *wal, transaction->getType());
+            fileHandle, physicalPageIdx, *wal, transaction->getVersionToRead());
     auto vectorBytesOffset = vectorStartPos * elementSize;
     auto frameBytesOffset = pagePosOfFirstElement * elementSize;
     auto frame = bufferManager.pin(*fileHandleToPin, pageIdxToPin);
@@ -186,7 +221,7 @@ void BaseColumnOrList::readAPageBySequentialCopy(Transaction* transaction,
 void BaseColumnOrList::readNullBitsFromAPage(const shared_ptr<ValueVector>& valueVector,
     const uint8_t* frame, uint64_t posInPage, uint64_t posInVector, uint64_t numBitsToRead) const {
     auto hasNullInSrcNullMask =
-        NullMask::copyNullMask((uint64_t*)(frame + (numElementsPerPage * elementSize)), posInPage,
+        NullMask::copyNullMask((uint64_t*)(frame + nullEntriesOffsetInPage), posInPage,
             valueVector->getNullMaskData(), posInVector, numBitsToRead);
     if (hasNullInSrcNullMask) {
         valueVector->setMayContainNulls();
@@ -195,7 +230,7 @@ void BaseColumnOrList::readNullBitsFromAPage(const shared_ptr<ValueVector>& valu
 
 void BaseColumnOrList::setNullBitOfAPosInFrame(
     uint8_t* frame, uint16_t elementPosInPage, bool isNull) const {
-    auto nullMask = (uint64_t*)(frame + (numElementsPerPage * elementSize));
+    auto nullMask = (uint64_t*)(frame + nullEntriesOffsetInPage);
     auto nullEntryPos = elementPosInPage >> NullMask::NUM_BITS_PER_NULL_ENTRY_LOG2;
     auto bitOffsetInEntry =
         elementPosInPage - (nullEntryPos << NullMask::NUM_BITS_PER_NULL_ENTRY_LOG2);
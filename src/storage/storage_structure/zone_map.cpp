@@ -0,0 +1,153 @@
+#include "src/storage/storage_structure/include/zone_map.h"
+
+#include <fcntl.h>
+
+#include <limits>
+
+#include "src/common/include/configs.h"
+#include "src/common/include/file_utils.h"
+
+namespace kuzu {
+namespace storage {
+
+ZoneMap::ZoneMap(DataTypeID dataTypeID, string fName, uint64_t numPages)
+    : dataTypeID{dataTypeID}, fName{move(fName)}, hasUpdates_{false}, zones(numPages) {
+    assert(isSupported(dataTypeID));
+    // Zones start empty, i.e., with min > max, until a value is added.
+    for (auto& zone : zones) {
+        if (dataTypeID == DOUBLE) {
+            zone.min.doubleVal = numeric_limits<double>::infinity();
+            zone.max.doubleVal = -numeric_limits<double>::infinity();
+        } else {
+            zone.min.intVal = INT64_MAX;
+            zone.max.intVal = INT64_MIN;
+        }
+    }
+}
+
+void ZoneMap::update(page_idx_t pageIdx, const uint8_t* value) {
+    unique_lock lck{mtx};
+    if (pageIdx >= zones.size()) {
+        return;
+    }
+    bool isWidened;
+    switch (dataTypeID) {
+    case INT64: {
+        isWidened = updateZone<int64_t>(zones[pageIdx], *(int64_t*)value);
+    } break;
+    case DOUBLE: {
+        isWidened = updateZone<double>(zones[pageIdx], *(double*)value);
+    } break;
+    case DATE: {
+        isWidened = updateZone<int64_t>(zones[pageIdx], ((date_t*)value)->days);
+    } break;
+    case TIMESTAMP: {
+        isWidened = updateZone<int64_t>(zones[pageIdx], ((timestamp_t*)value)->value);
+    } break;
+    default:
+        assert(false);
+    }
+    hasUpdates_ |= isWidened;
+}
+
+template<typename T>
+bool ZoneMap::updateZone(Zone& zone, T value) {
+    auto& min = getValue<T>(zone.min);
+    auto& max = getValue<T>(zone.max);
+    auto isWidened = false;
+    if (value < min) {
+        min = value;
+        isWidened = true;
+    }
+    if (value > max) {
+        max = value;
+        isWidened = true;
+    }
+    return isWidened;
+}
+
+bool ZoneMap::mayMatch(page_idx_t startPageIdx, page_idx_t endPageIdx,
+    ExpressionType comparisonType, const Literal& literal) const {
+    shared_lock lck{mtx};
+    if (endPageIdx >= zones.size()) {
+        return true;
+    }
+    for (auto pageIdx = startPageIdx; pageIdx <= endPageIdx; pageIdx++) {
+        bool pageMayMatch;
+        switch (dataTypeID) {
+        case INT64: {
+            pageMayMatch = mayMatch<int64_t>(zones[pageIdx], comparisonType, literal.val.int64Val);
+        } break;
+        case DOUBLE: {
+            pageMayMatch = mayMatch<double>(zones[pageIdx], comparisonType, literal.val.doubleVal);
+        } break;
+        case DATE: {
+            pageMayMatch =
+                mayMatch<int64_t>(zones[pageIdx], comparisonType, literal.val.dateVal.days);
+        } break;
+        case TIMESTAMP: {
+            pageMayMatch =
+                mayMatch<int64_t>(zones[pageIdx], comparisonType, literal.val.timestampVal.value);
+        } break;
+        default:
+            assert(false);
+        }
+        if (pageMayMatch) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename T>
+bool ZoneMap::mayMatch(const Zone& zone, ExpressionType comparisonType, T value) {
+    auto min = getValue<T>(zone.min);
+    auto max = getValue<T>(zone.max);
+    if (min > max) {
+        // Comparisons with NULLs are never true.
+        return false;
+    }
+    switch (comparisonType) {
+    case EQUALS:
+        return min <= value && value <= max;
+    case NOT_EQUALS:
+        return min != value || max != value;
+    case GREATER_THAN:
+        return max > value;
+    case GREATER_THAN_EQUALS:
+        return max >= value;
+    case LESS_THAN:
+        return min < value;
+    case LESS_THAN_EQUALS:
+        return min <= value;
+    default:
+        return true;
+    }
+}
+
+void ZoneMap::saveToFile(DBFileType dbFileType) const {
+    shared_lock lck{mtx};
+    auto filePath =
+        dbFileType == DBFileType::WAL_VERSION ? fName + StorageConfig::WAL_FILE_SUFFIX : fName;
+    FileUtils::removeFileIfExists(filePath);
+    auto fileInfo = FileUtils::openFile(filePath, O_CREAT | O_WRONLY);
+    FileUtils::writeToFile(
+        fileInfo.get(), (uint8_t*)zones.data(), zones.size() * sizeof(Zone), 0 /* offset */);
+    FileUtils::closeFile(fileInfo->fd);
+}
+
+unique_ptr<ZoneMap> ZoneMap::readFromFileIfExists(DataTypeID dataTypeID, const string& fName) {
+    if (!FileUtils::fileOrPathExists(fName)) {
+        return nullptr;
+    }
+    auto fileInfo = FileUtils::openFile(fName, O_RDONLY);
+    auto numPages = FileUtils::getFileSize(fileInfo->fd) / sizeof(Zone);
+    auto zoneMap = make_unique<ZoneMap>(dataTypeID, fName, numPages);
+    FileUtils::readFromFile(
+        fileInfo.get(), zoneMap->zones.data(), numPages * sizeof(Zone), 0 /* position */);
+    FileUtils::closeFile(fileInfo->fd);
+    return zoneMap;
+}
+
+} // namespace storage
+} // namespace kuzu
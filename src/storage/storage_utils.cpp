@@ -1,9 +1,18 @@
 #include "src/storage/include/storage_utils.h"
 
+#include <unistd.h>
+
+#include <atomic>
+
 namespace kuzu {
 namespace storage {
 
 unique_ptr<FileInfo> StorageUtils::getFileInfoForReadWrite(
+    const string& directory, StorageStructureID storageStructureID) {
+    return FileUtils::openFile(getFileNameForReadWrite(directory, storageStructureID), O_RDWR);
+}
+
+string StorageUtils::getFileNameForReadWrite(
     const string& directory, StorageStructureID storageStructureID) {
     string fName;
     switch (storageStructureID.storageStructureType) {
@@ -22,10 +31,10 @@ unique_ptr<FileInfo> StorageUtils::getFileInfoForReadWrite(
     } break;
     default: {
         throw RuntimeException("Unsupported StorageStructureID in "
-                               "StorageUtils::getFileInfoFromStorageStructureID.");
+                               "StorageUtils::getFileNameForReadWrite.");
     }
     }
-    return FileUtils::openFile(fName, O_RDWR);
+    return fName;
 }
 
 string StorageUtils::getColumnFName(
@@ -113,6 +122,22 @@ string StorageUtils::appendSuffixOrInsertBeforeWALSuffix(string fileName, string
     }
 }
 
+string StorageUtils::getTempSpillDirPath() {
+    static atomic<uint64_t> nextDirIdx{0};
+    return FileUtils::joinPath(filesystem::temp_directory_path().string(),
+        "kuzu_spill_" + to_string(getpid()) + "_" +
+            to_string(nextDirIdx.fetch_add(1, memory_order_relaxed)));
+}
+
+string StorageUtils::getNewSpillFilePath(
+    const string& spillDirPath, const string& fileNamePrefix) {
+    static atomic<uint64_t> nextFileIdx{0};
+    filesystem::create_directories(spillDirPath);
+    return FileUtils::joinPath(spillDirPath,
+        fileNamePrefix + "_" + to_string(getpid()) + "_" +
+            to_string(nextFileIdx.fetch_add(1, memory_order_relaxed)));
+}
+
 uint32_t PageUtils::getNumElementsInAPage(uint32_t elementSize, bool hasNull) {
     auto numBytesPerNullEntry = NullMask::NUM_BITS_PER_NULL_ENTRY >> 3;
     auto numNullEntries =
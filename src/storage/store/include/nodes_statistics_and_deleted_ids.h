@@ -114,9 +114,8 @@ public:
     }
 
     inline node_offset_t getMaxNodeOffset(Transaction* transaction, table_id_t tableID) {
-        return getMaxNodeOffset(transaction == nullptr || transaction->isReadOnly() ?
-                                    TransactionType::READ_ONLY :
-                                    TransactionType::WRITE,
+        return getMaxNodeOffset(
+            transaction == nullptr ? TransactionType::READ_ONLY : transaction->getVersionToRead(),
             tableID);
     }
 
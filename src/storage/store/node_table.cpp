@@ -73,6 +73,9 @@ void NodeTable::deleteNode(
 }
 
 void NodeTable::prepareCommitOrRollbackIfNecessary(bool isCommit) {
+    for (auto& propertyColumn : propertyColumns) {
+        propertyColumn->prepareCommitOrRollbackIfNecessary(isCommit);
+    }
     unstrPropertyLists->prepareCommitOrRollbackIfNecessary(isCommit);
     pkIndex->prepareCommitOrRollbackIfNecessary(isCommit);
 }
@@ -50,6 +50,13 @@ vector<AdjColumn*> RelTable::getAdjColumnsForNodeTable(table_id_t tableID) {
 }
 
 void RelTable::prepareCommitOrRollbackIfNecessary(bool isCommit) {
+    for (auto& propertyColumnsPerTable : propertyColumns) {
+        for (auto& [_, tablePropertyColumns] : propertyColumnsPerTable) {
+            for (auto& propertyColumn : tablePropertyColumns) {
+                propertyColumn->prepareCommitOrRollbackIfNecessary(isCommit);
+            }
+        }
+    }
     performOpOnListsWithUpdates(
         std::bind(&Lists::prepareCommitOrRollbackIfNecessary, std::placeholders::_1, isCommit),
         std::bind(&RelTable::addToUpdatedRelTables, this));
@@ -89,7 +89,8 @@ void RelsStatistics::setNumRelsPerDirectionBoundTableID(
 uint64_t RelsStatistics::getNextRelID(Transaction* transaction) {
     lock_t lck{mtx};
     auto& tableStatisticContent =
-        (transaction->isReadOnly() || tablesStatisticsContentForWriteTrx == nullptr) ?
+        (transaction->getVersionToRead() == TransactionType::READ_ONLY ||
+            tablesStatisticsContentForWriteTrx == nullptr) ?
             tablesStatisticsContentForReadOnlyTrx :
             tablesStatisticsContentForWriteTrx;
     return tableStatisticContent->nextRelID;
@@ -73,7 +73,9 @@ class WAL : public BaseWALAndWALIterator {
     friend WALIterator;
 
 public:
-    WAL(const string& directory, BufferManager& bufferManager);
+    // In read-only mode, the WAL file is only opened for reading, so that the database can be
+    // checked for a non-empty WAL, and nothing can be logged.
+    WAL(const string& directory, BufferManager& bufferManager, bool isReadOnly = false);
 
     // Destructing WAL flushes any unwritten header page but not the other pages. The caller
     // which possibly has access to the buffer manager needs to ensure any unwritten pages
@@ -116,6 +118,8 @@ public:
 
     void logDropTableRecord(bool isNodeTable, table_id_t tableID);
 
+    void logZoneMapRecord(StorageStructureID storageStructureID);
+
     // Removes the contents of WAL file.
     void clearWAL();
 
@@ -126,16 +130,33 @@ public:
         return isLastLoggedRecordCommit_;
     }
 
+    // Writes out all pages of the WAL and syncs the WAL file, which makes the logged records
+    // durable.
     void flushAllPages();
 
+    // DDL and COPY CSV statements replace files and the catalog during checkpointing, which
+    // transactions can only see after the checkpoint.
+    inline bool containsDDLOrCopyCSVRecords() {
+        lock_t lck{mtx};
+        return containsDDLOrCopyCSVRecords_;
+    }
+
     inline bool isEmptyWAL() {
         return currentHeaderPageIdx == 0 && (getNumRecordsInCurrentHeaderPage() == 0);
     }
 
-    inline static shared_ptr<FileHandle> createWALFileHandle(const string& directory) {
-        return make_shared<FileHandle>(
-            FileUtils::joinPath(directory, string(StorageConfig::WAL_FILE_SUFFIX)),
-            FileHandle::O_PERSISTENT_FILE_CREATE_NOT_EXISTS);
+    // In read-only mode, the WAL file is only opened for reading. If it does not exist, it is not
+    // created, as the database directory may not be writable, and the WAL is kept in memory
+    // instead, where it stays empty.
+    inline static shared_ptr<FileHandle> createWALFileHandle(
+        const string& directory, bool isReadOnly = false) {
+        auto path = FileUtils::joinPath(directory, string(StorageConfig::WAL_FILE_SUFFIX));
+        if (isReadOnly) {
+            return make_shared<FileHandle>(path, FileUtils::fileOrPathExists(path) ?
+                                                     FileHandle::O_PERSISTENT_FILE_READ_ONLY :
+                                                     FileHandle::isNewInMemoryTmpFileMask);
+        }
+        return make_shared<FileHandle>(path, FileHandle::O_PERSISTENT_FILE_CREATE_NOT_EXISTS);
     }
 
     inline string getDirectory() const { return directory; }
@@ -150,7 +171,8 @@ public:
 
 private:
     inline void flushHeaderPages() {
-        if (!isEmptyWAL()) {
+        // A WAL that is opened in read-only mode only holds the header page read from its file.
+        if (!isEmptyWAL() && !fileHandle->isReadOnly()) {
             fileHandle->writePage(currentHeaderPageBuffer.get(), currentHeaderPageIdx);
         }
     }
@@ -171,6 +193,7 @@ private:
     mutex mtx;
     BufferManager& bufferManager;
     bool isLastLoggedRecordCommit_;
+    bool containsDDLOrCopyCSVRecords_;
 };
 
 class WALIterator : public BaseWALAndWALIterator {
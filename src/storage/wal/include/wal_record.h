@@ -284,6 +284,7 @@ enum WALRecordType : uint8_t {
     COPY_NODE_CSV_RECORD = 7,
     COPY_REL_CSV_RECORD = 8,
     DROP_TABLE_RECORD = 9,
+    ZONE_MAP_RECORD = 10,
 };
 
 struct PageUpdateOrInsertRecord {
@@ -401,6 +402,21 @@ struct DropTableRecord {
     }
 };
 
+// Records that the zone map of a column has a WAL version, which replaces the zone map file when
+// checkpointing.
+struct ZoneMapRecord {
+    StorageStructureID storageStructureID;
+
+    ZoneMapRecord() = default;
+
+    explicit ZoneMapRecord(StorageStructureID storageStructureID)
+        : storageStructureID{storageStructureID} {}
+
+    inline bool operator==(const ZoneMapRecord& rhs) const {
+        return storageStructureID == rhs.storageStructureID;
+    }
+};
+
 struct WALRecord {
     WALRecordType recordType;
     union {
@@ -413,6 +429,7 @@ struct WALRecord {
         CopyRelCSVRecord copyRelCsvRecord;
         TableStatisticsRecord tableStatisticsRecord;
         DropTableRecord dropTableRecord;
+        ZoneMapRecord zoneMapRecord;
     };
 
     bool operator==(const WALRecord& rhs) const {
@@ -451,6 +468,9 @@ struct WALRecord {
         case DROP_TABLE_RECORD: {
             return dropTableRecord == rhs.dropTableRecord;
         }
+        case ZONE_MAP_RECORD: {
+            return zoneMapRecord == rhs.zoneMapRecord;
+        }
         default: {
             throw RuntimeException(
                 "Unrecognized WAL record type inside ==. recordType: " + to_string(recordType));
@@ -472,6 +492,7 @@ struct WALRecord {
     static WALRecord newCopyNodeCSVRecord(table_id_t tableID);
     static WALRecord newCopyRelCSVRecord(table_id_t tableID);
     static WALRecord newDropTableRecord(bool isNodeTable, table_id_t tableID);
+    static WALRecord newZoneMapRecord(StorageStructureID storageStructureID_);
     static void constructWALRecordFromBytes(WALRecord& retVal, uint8_t* bytes, uint64_t& offset);
     // This functions assumes that the caller ensures there is enough space in the bytes pointer
     // to write the record. This should be checked by calling numBytesToWrite.
@@ -8,10 +8,11 @@
 namespace kuzu {
 namespace storage {
 
-WAL::WAL(const string& directory, BufferManager& bufferManager)
+WAL::WAL(const string& directory, BufferManager& bufferManager, bool isReadOnly)
     : logger{LoggerUtils::getOrCreateLogger("wal")}, directory{directory},
-      bufferManager{bufferManager}, isLastLoggedRecordCommit_{false} {
-    fileHandle = WAL::createWALFileHandle(directory);
+      bufferManager{bufferManager}, isLastLoggedRecordCommit_{false},
+      containsDDLOrCopyCSVRecords_{false} {
+    fileHandle = WAL::createWALFileHandle(directory, isReadOnly);
     initCurrentPage();
 }
 
@@ -91,6 +92,12 @@ void WAL::logDropTableRecord(bool isNodeTable, table_id_t tableID) {
     addNewWALRecordNoLock(walRecord);
 }
 
+void WAL::logZoneMapRecord(StorageStructureID storageStructureID) {
+    lock_t lck{mtx};
+    WALRecord walRecord = WALRecord::newZoneMapRecord(storageStructureID);
+    addNewWALRecordNoLock(walRecord);
+}
+
 void WAL::clearWAL() {
     bufferManager.removeFilePagesFromFrames(*fileHandle);
     fileHandle->resetToZeroPagesAndPageCapacity();
@@ -104,12 +111,14 @@ void WAL::flushAllPages() {
     if (!isEmptyWAL()) {
         flushHeaderPages();
         bufferManager.flushAllDirtyPagesInFrames(*fileHandle);
+        FileUtils::syncFile(fileHandle->getFileInfo());
     }
 }
 
 void WAL::initCurrentPage() {
     currentHeaderPageIdx = 0;
     isLastLoggedRecordCommit_ = false;
+    containsDDLOrCopyCSVRecords_ = false;
     if (fileHandle->getNumPages() == 0) {
         fileHandle->addNewPage();
         resetCurrentHeaderPagePrefix();
@@ -137,6 +146,18 @@ void WAL::addNewWALRecordNoLock(WALRecord& walRecord) {
     incrementNumRecordsInCurrentHeaderPage();
     walRecord.writeWALRecordToBytes(currentHeaderPageBuffer.get(), offsetInCurrentHeaderPage);
     isLastLoggedRecordCommit_ = (COMMIT_RECORD == walRecord.recordType);
+    switch (walRecord.recordType) {
+    case CATALOG_RECORD:
+    case NODE_TABLE_RECORD:
+    case REL_TABLE_RECORD:
+    case COPY_NODE_CSV_RECORD:
+    case COPY_REL_CSV_RECORD:
+    case DROP_TABLE_RECORD: {
+        containsDDLOrCopyCSVRecords_ = true;
+    } break;
+    default:
+        break;
+    }
 }
 
 void WAL::setIsLastRecordCommit() {
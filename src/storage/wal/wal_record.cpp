@@ -155,6 +155,13 @@ WALRecord WALRecord::newDropTableRecord(bool isNodeTable, table_id_t tableID) {
     return retVal;
 }
 
+WALRecord WALRecord::newZoneMapRecord(StorageStructureID storageStructureID_) {
+    WALRecord retVal;
+    retVal.recordType = ZONE_MAP_RECORD;
+    retVal.zoneMapRecord = ZoneMapRecord(storageStructureID_);
+    return retVal;
+}
+
 void WALRecord::constructWALRecordFromBytes(WALRecord& retVal, uint8_t* bytes, uint64_t& offset) {
     ((WALRecord*)&retVal)[0] = ((WALRecord*)(bytes + offset))[0];
     offset += sizeof(WALRecord);
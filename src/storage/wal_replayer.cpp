@@ -7,45 +7,42 @@
 namespace kuzu {
 namespace storage {
 
-WALReplayer::WALReplayer(WAL* wal) : isRecovering{true}, isCheckpoint{true}, wal{wal} {
+// A task on which each worker thread replays the page records of the files it claims.
+class ReplayPageRecordsTask : public Task {
+public:
+    ReplayPageRecordsTask(uint64_t maxNumThreads, std::function<void()> replayFunc)
+        : Task{maxNumThreads}, replayFunc{move(replayFunc)} {}
+
+    void run() override { replayFunc(); }
+
+private:
+    std::function<void()> replayFunc;
+};
+
+WALReplayer::WALReplayer(WAL* wal, TaskScheduler* taskScheduler)
+    : isRecovering{true}, isCheckpoint{true}, taskScheduler{taskScheduler}, wal{wal} {
     init();
 }
 
 WALReplayer::WALReplayer(WAL* wal, StorageManager* storageManager, BufferManager* bufferManager,
-    MemoryManager* memoryManager, Catalog* catalog, bool isCheckpoint)
+    MemoryManager* memoryManager, Catalog* catalog, bool isCheckpoint, TaskScheduler* taskScheduler)
     : isRecovering{false}, isCheckpoint{isCheckpoint}, storageManager{storageManager},
-      bufferManager{bufferManager}, memoryManager{memoryManager}, wal{wal}, catalog{catalog} {
+      bufferManager{bufferManager}, memoryManager{memoryManager},
+      taskScheduler{taskScheduler}, wal{wal}, catalog{catalog} {
     init();
 }
 
 void WALReplayer::init() {
     logger = LoggerUtils::getOrCreateLogger("storage");
     walFileHandle = WAL::createWALFileHandle(wal->getDirectory());
-    pageBuffer = make_unique<uint8_t[]>(DEFAULT_PAGE_SIZE);
 }
 
 void WALReplayer::replayWALRecord(WALRecord& walRecord) {
     switch (walRecord.recordType) {
     case PAGE_UPDATE_OR_INSERT_RECORD: {
-        // 1. As the first step we copy over the page on disk, regardless of if we are recovering
-        // (and checkpointing) or checkpointing while during regular execution.
-        auto storageStructureID = walRecord.pageInsertOrUpdateRecord.storageStructureID;
-        unique_ptr<FileInfo> fileInfoOfStorageStructure =
-            StorageUtils::getFileInfoForReadWrite(wal->getDirectory(), storageStructureID);
-        if (isCheckpoint) {
-            walFileHandle->readPage(
-                pageBuffer.get(), walRecord.pageInsertOrUpdateRecord.pageIdxInWAL);
-            FileUtils::writeToFile(fileInfoOfStorageStructure.get(), pageBuffer.get(),
-                DEFAULT_PAGE_SIZE,
-                walRecord.pageInsertOrUpdateRecord.pageIdxInOriginalFile * DEFAULT_PAGE_SIZE);
-        }
-        if (!isRecovering) {
-            // 2: If we are not recovering, we do any in-memory checkpointing or rolling back work
-            // to make sure that the system's in-memory structures are consistent with what is on
-            // disk. For example, we update the BM's image of the pages or InMemDiskArrays used by
-            // lists or the WALVersion pageIdxs of pages for VersionedFileHandles.
-            checkpointOrRollbackVersionedFileHandleAndBufferManager(walRecord, storageStructureID);
-        }
+        // The record is replayed in replayPageUpdateOrInsertRecords() together with the other
+        // page records of its file.
+        addPageUpdateOrInsertRecord(walRecord.pageInsertOrUpdateRecord);
     } break;
     case TABLE_STATISTICS_RECORD: {
         if (isCheckpoint) {
@@ -301,6 +298,16 @@ void WALReplayer::replayWALRecord(WALRecord& walRecord) {
             // See comments for COPY_NODE_CSV_RECORD.
         }
     } break;
+    case ZONE_MAP_RECORD: {
+        if (isCheckpoint) {
+            // The in-memory zone map already holds the zones of the WAL version, so only the file
+            // is replaced, regardless of if we are recovering.
+            StorageUtils::overwriteZoneMapFileWithVersionFromWAL(
+                wal->getDirectory(), walRecord.zoneMapRecord.storageStructureID);
+        } else {
+            // ZONE_MAP_RECORDs are only logged when committing.
+        }
+    } break;
     default:
         throw RuntimeException(
             "Unrecognized WAL record type inside WALReplayer::replay. recordType: " +
@@ -327,21 +334,124 @@ void WALReplayer::truncateFileIfInsertion(
     }
 }
 
+void WALReplayer::addPageUpdateOrInsertRecord(
+    const PageUpdateOrInsertRecord& pageInsertOrUpdateRecord) {
+    auto& storageStructureID = pageInsertOrUpdateRecord.storageStructureID;
+    // Consecutive page records mostly update the same file, in which case we do not need to look
+    // up the file name.
+    if (pageRecordsPerFile.empty() ||
+        !(pageRecordsPerFile[lastPageRecordsIdx].back().storageStructureID ==
+            storageStructureID)) {
+        auto fName = StorageUtils::getFileNameForReadWrite(wal->getDirectory(), storageStructureID);
+        auto it = fileNameToPageRecordsIdx.find(fName);
+        if (it == fileNameToPageRecordsIdx.end()) {
+            it = fileNameToPageRecordsIdx.emplace(fName, pageRecordsPerFile.size()).first;
+            pageRecordsPerFile.emplace_back();
+        }
+        lastPageRecordsIdx = it->second;
+    }
+    pageRecordsPerFile[lastPageRecordsIdx].push_back(pageInsertOrUpdateRecord);
+}
+
+void WALReplayer::replayPageUpdateOrInsertRecords() {
+    if (pageRecordsPerFile.empty()) {
+        return;
+    }
+    atomic<uint64_t> nextFileIdx{0};
+    if (taskScheduler == nullptr || pageRecordsPerFile.size() == 1) {
+        replayPageUpdateOrInsertRecordsOfNextFiles(nextFileIdx);
+    } else {
+        // Files are disjoint, so their records can be replayed concurrently. Note that we wait
+        // only for this task, as the scheduler may also be executing queries.
+        auto task = make_shared<ReplayPageRecordsTask>(pageRecordsPerFile.size(),
+            [&]() { replayPageUpdateOrInsertRecordsOfNextFiles(nextFileIdx); });
+        taskScheduler->scheduleTaskAndWaitOrError(task);
+    }
+    pageRecordsPerFile.clear();
+    fileNameToPageRecordsIdx.clear();
+}
+
+void WALReplayer::replayPageUpdateOrInsertRecordsOfNextFiles(atomic<uint64_t>& nextFileIdx) {
+    while (true) {
+        auto fileIdx = nextFileIdx.fetch_add(1);
+        if (fileIdx >= pageRecordsPerFile.size()) {
+            return;
+        }
+        replayPageUpdateOrInsertRecordsOfFile(pageRecordsPerFile[fileIdx]);
+    }
+}
+
+void WALReplayer::replayPageUpdateOrInsertRecordsOfFile(vector<PageUpdateOrInsertRecord>& records) {
+    if (!isCheckpoint) {
+        // When rolling back, the original file is not touched, so we only roll back the in-memory
+        // structures. The records are kept in the order they were logged, which
+        // truncateFileIfInsertion relies on.
+        for (auto& record : records) {
+            checkpointOrRollbackVersionedFileHandleAndBufferManager(record, nullptr /* walPage */);
+        }
+        return;
+    }
+    // 1. As the first step we copy over the pages on disk, regardless of if we are recovering
+    // (and checkpointing) or checkpointing while during regular execution. We sort the records on
+    // their page in the original file, so that runs of contiguous pages are written with a single
+    // write. The sort is stable, so if a page has multiple records, the last logged one is last.
+    stable_sort(records.begin(), records.end(),
+        [](const PageUpdateOrInsertRecord& left, const PageUpdateOrInsertRecord& right) {
+            return left.pageIdxInOriginalFile < right.pageIdxInOriginalFile;
+        });
+    auto fileInfo =
+        StorageUtils::getFileInfoForReadWrite(wal->getDirectory(), records[0].storageStructureID);
+    auto pagesBuffer = make_unique<uint8_t[]>(
+        StorageConfig::MAX_NUM_PAGES_PER_WRITE * DEFAULT_PAGE_SIZE);
+    vector<PageUpdateOrInsertRecord*> recordsOfRun;
+    auto recordIdx = 0u;
+    while (recordIdx < records.size()) {
+        auto startPageIdx = records[recordIdx].pageIdxInOriginalFile;
+        recordsOfRun.clear();
+        while (recordIdx < records.size() &&
+               recordsOfRun.size() < StorageConfig::MAX_NUM_PAGES_PER_WRITE &&
+               records[recordIdx].pageIdxInOriginalFile == startPageIdx + recordsOfRun.size()) {
+            // Only the last logged record of a page holds its latest version.
+            while (recordIdx + 1 < records.size() &&
+                   records[recordIdx + 1].pageIdxInOriginalFile ==
+                       records[recordIdx].pageIdxInOriginalFile) {
+                recordIdx++;
+            }
+            walFileHandle->readPage(pagesBuffer.get() + recordsOfRun.size() * DEFAULT_PAGE_SIZE,
+                records[recordIdx].pageIdxInWAL);
+            recordsOfRun.push_back(&records[recordIdx]);
+            recordIdx++;
+        }
+        FileUtils::writeToFile(fileInfo.get(), pagesBuffer.get(),
+            recordsOfRun.size() * DEFAULT_PAGE_SIZE, startPageIdx * DEFAULT_PAGE_SIZE);
+        if (!isRecovering) {
+            // 2: If we are not recovering, we do any in-memory checkpointing or rolling back work
+            // to make sure that the system's in-memory structures are consistent with what is on
+            // disk. For example, we update the BM's image of the pages or InMemDiskArrays used by
+            // lists or the WALVersion pageIdxs of pages for VersionedFileHandles.
+            for (auto i = 0u; i < recordsOfRun.size(); i++) {
+                checkpointOrRollbackVersionedFileHandleAndBufferManager(
+                    *recordsOfRun[i], pagesBuffer.get() + i * DEFAULT_PAGE_SIZE);
+            }
+        }
+    }
+    FileUtils::closeFile(fileInfo->fd);
+}
+
 void WALReplayer::checkpointOrRollbackVersionedFileHandleAndBufferManager(
-    const WALRecord& walRecord, const StorageStructureID& storageStructureID) {
-    VersionedFileHandle* fileHandle =
-        getVersionedFileHandleIfWALVersionAndBMShouldBeCleared(storageStructureID);
+    const PageUpdateOrInsertRecord& pageInsertOrUpdateRecord, const uint8_t* walPage) {
+    VersionedFileHandle* fileHandle = getVersionedFileHandleIfWALVersionAndBMShouldBeCleared(
+        pageInsertOrUpdateRecord.storageStructureID);
     if (fileHandle) {
-        fileHandle->clearWALPageVersionIfNecessary(
-            walRecord.pageInsertOrUpdateRecord.pageIdxInOriginalFile);
+        fileHandle->clearWALPageVersionIfNecessary(pageInsertOrUpdateRecord.pageIdxInOriginalFile);
         if (isCheckpoint) {
-            // Update the page in buffer manager if it is in a frame. Note that we assume
-            // that the pageBuffer currently contains the contents of the WALVersion, so the
-            // caller needs to make sure that this assumption holds.
-            bufferManager->updateFrameIfPageIsInFrameWithoutPageOrFrameLock(*fileHandle,
-                pageBuffer.get(), walRecord.pageInsertOrUpdateRecord.pageIdxInOriginalFile);
+            // Update the page in buffer manager if it is in a frame. Note that we assume that
+            // walPage contains the contents of the WALVersion, so the caller needs to make sure
+            // that this assumption holds.
+            bufferManager->updateFrameIfPageIsInFrameWithoutPageOrFrameLock(
+                *fileHandle, (uint8_t*)walPage, pageInsertOrUpdateRecord.pageIdxInOriginalFile);
         } else {
-            truncateFileIfInsertion(fileHandle, walRecord.pageInsertOrUpdateRecord);
+            truncateFileIfInsertion(fileHandle, pageInsertOrUpdateRecord);
         }
     }
 }
@@ -476,8 +586,14 @@ void WALReplayer::replay() {
     WALRecord walRecord;
     while (walIterator->hasNextRecord()) {
         walIterator->getNextRecord(walRecord);
+        if (walRecord.recordType != PAGE_UPDATE_OR_INSERT_RECORD) {
+            // Records of other types, e.g., NODE_TABLE_RECORD, may depend on the pages logged
+            // before them, so we first replay those.
+            replayPageUpdateOrInsertRecords();
+        }
         replayWALRecord(walRecord);
     }
+    replayPageUpdateOrInsertRecords();
 
     // We next perform an in-memory checkpointing or rolling back of nodeTables.
     for (auto nodeTableID : wal->updatedNodeTables) {
@@ -121,10 +121,12 @@ void WALReplayerUtils::replaceOriginalColumnFilesWithWALVersionIfExists(
     string originalColFileName) {
     auto walColFileName = StorageUtils::appendWALFileSuffix(originalColFileName);
     FileUtils::renameFileIfExists(walColFileName, originalColFileName);
-    // We also check if there is a WAL version of the overflow file for the column and if so
-    // replace the original version.
+    // We also check if there are WAL versions of the overflow file and the zone map for the column
+    // and if so replace the original versions.
     FileUtils::renameFileIfExists(StorageUtils::getOverflowFileName(walColFileName),
         StorageUtils::getOverflowFileName(originalColFileName));
+    FileUtils::renameFileIfExists(StorageUtils::getZoneMapFName(walColFileName),
+        StorageUtils::getZoneMapFName(originalColFileName));
 }
 
 void WALReplayerUtils::replaceOriginalListFilesWithWALVersionIfExists(string originalListFileName) {
@@ -143,6 +145,7 @@ void WALReplayerUtils::replaceOriginalListFilesWithWALVersionIfExists(string ori
 void WALReplayerUtils::removeColumnFilesIfExists(string fileName) {
     FileUtils::removeFileIfExists(fileName);
     FileUtils::removeFileIfExists(StorageUtils::getOverflowFileName(fileName));
+    FileUtils::removeFileIfExists(StorageUtils::getZoneMapFName(fileName));
 }
 
 void WALReplayerUtils::removeListFilesIfExists(string fileName) {
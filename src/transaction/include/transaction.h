@@ -12,14 +12,22 @@ class Transaction {
     friend class TransactionManager;
 
 public:
-    Transaction(TransactionType transactionType, uint64_t transactionID)
-        : type{transactionType}, ID{transactionID} {}
+    Transaction(TransactionType transactionType, uint64_t transactionID,
+        bool readsVersionOfWriteTransaction = false)
+        : type{transactionType}, ID{transactionID},
+          readsVersionOfWriteTransaction{readsVersionOfWriteTransaction} {}
 
 public:
     inline TransactionType getType() const { return type; }
     inline bool isReadOnly() const { return READ_ONLY == type; }
     inline bool isWriteTransaction() const { return WRITE == type; }
     inline uint64_t getID() const { return ID; }
+    // Storage structures keep a version of the database for read-only transactions and one for
+    // the write transaction. Read-only transactions that start after a write transaction has
+    // committed but before it has been checkpointed read the version of the write transaction.
+    inline TransactionType getVersionToRead() const {
+        return readsVersionOfWriteTransaction ? WRITE : type;
+    }
     static inline std::unique_ptr<Transaction> getDummyWriteTrx() {
         return std::make_unique<Transaction>(WRITE, UINT64_MAX);
     }
@@ -30,6 +38,7 @@ public:
 private:
     TransactionType type;
     uint64_t ID;
+    bool readsVersionOfWriteTransaction;
 };
 
 } // namespace transaction
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <unordered_set>
@@ -20,7 +21,8 @@ class TransactionManager {
 public:
     TransactionManager(storage::WAL& wal)
         : logger{LoggerUtils::getOrCreateLogger("transaction_manager")}, wal{wal},
-          activeWriteTransactionID{INT64_MAX}, lastTransactionID{0}, lastCommitID{0} {};
+          activeWriteTransactionID{INT64_MAX}, lastTransactionID{0}, lastCommitID{0},
+          isCheckpointPending{false}, lastTransactionIDBeforePendingCheckpoint{0} {};
     unique_ptr<Transaction> beginWriteTransaction();
     unique_ptr<Transaction> beginReadOnlyTransaction();
     void commit(Transaction* transaction);
@@ -33,6 +35,22 @@ public:
     void stopNewTransactionsAndWaitUntilAllReadTransactionsLeave();
     void allowReceivingNewTransactions();
 
+    // Below functions let a checkpoint run in the background after a write transaction commits.
+    // Until the checkpoint has finished, the committed write transaction stays the active write
+    // transaction, so new write transactions wait, and new read-only transactions read its version.
+    // The write transaction must be committed with commitButKeepActiveWriteTransaction() and its
+    // commit must be durable in the WAL before startPendingCheckpoint() makes it visible.
+    void startPendingCheckpoint();
+    // Waits until the read-only transactions that started before the commit have left. New
+    // transactions can start while waiting.
+    void waitUntilReadTransactionsBeforePendingCheckpointLeave();
+    // Same as stopNewTransactionsAndWaitUntilAllReadTransactionsLeave but instead of throwing on
+    // a timeout, it lets new transactions start again and retries after a backoff.
+    void stopNewTransactionsForPendingCheckpoint();
+    void finishPendingCheckpoint();
+    // New write transactions fail with errMsg instead of waiting for the failed checkpoint.
+    void failPendingCheckpoint(const string& errMsg);
+
     // Warning: Below public functions are for tests only
     inline unordered_set<uint64_t>& getActiveReadOnlyTransactionIDs() {
         lock_t lck{mtxForSerializingPublicFunctionCalls};
@@ -59,6 +77,7 @@ private:
     }
     void commitOrRollbackNoLock(Transaction* transaction, bool isCommit);
     void assertActiveWriteTransationIsCorrectNoLock(Transaction* transaction);
+    bool hasActiveReadOnlyTransactionNoLock(uint64_t maxTransactionID);
 
 private:
     shared_ptr<spdlog::logger> logger;
@@ -83,6 +102,13 @@ private:
     // function, which needs to let calls to comming and rollback.
     mutex mtxForSerializingPublicFunctionCalls;
     mutex mtxForStartingNewTransactions;
+    bool isCheckpointPending;
+    uint64_t lastTransactionIDBeforePendingCheckpoint;
+    string pendingCheckpointErrMsg;
+    // Notified when a pending checkpoint finishes or fails.
+    condition_variable pendingCheckpointCV;
+    // Notified when a read-only transaction commits or rolls back.
+    condition_variable readOnlyTransactionLeftCV;
     uint64_t checkPointWaitTimeoutForTransactionsToLeaveInMicros =
         DEFAULT_CHECKPOINT_WAIT_TIMEOUT_FOR_TRANSACTIONS_TO_LEAVE_IN_MICROS;
 };
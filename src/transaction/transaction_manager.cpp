@@ -1,5 +1,7 @@
 #include "include/transaction_manager.h"
 
+#include "spdlog/spdlog.h"
+
 #include "src/common/include/exception.h"
 
 using namespace kuzu::common;
@@ -12,6 +14,24 @@ unique_ptr<Transaction> TransactionManager::beginWriteTransaction() {
     // ensures calls to other public functions is not restricted.
     lock_t newTransactionLck{mtxForStartingNewTransactions};
     lock_t publicFunctionLck{mtxForSerializingPublicFunctionCalls};
+    // A new write transaction would update the WAL pages that a pending checkpoint copies, so we
+    // wait for the checkpoint to finish. The checkpoint needs to stop new transactions, so the lock
+    // for starting new transactions is released while waiting and both locks are then reacquired
+    // in the same order as above.
+    while (isCheckpointPending && pendingCheckpointErrMsg.empty()) {
+        newTransactionLck.unlock();
+        pendingCheckpointCV.wait(publicFunctionLck,
+            [&] { return !isCheckpointPending || !pendingCheckpointErrMsg.empty(); });
+        publicFunctionLck.unlock();
+        newTransactionLck.lock();
+        publicFunctionLck.lock();
+    }
+    if (!pendingCheckpointErrMsg.empty()) {
+        throw TransactionManagerException(
+            "Cannot start a new write transaction because the checkpoint of the last committed "
+            "write transaction failed: " +
+            pendingCheckpointErrMsg + " Restart the database to recover it from the WAL.");
+    }
     if (hasActiveWriteTransactionNoLock()) {
         throw TransactionManagerException(
             "Cannot start a new write transaction in the system. Only one write transaction at a "
@@ -27,7 +47,8 @@ unique_ptr<Transaction> TransactionManager::beginReadOnlyTransaction() {
     // ensures calls to other public functions is not restricted.
     lock_t newTransactionLck{mtxForStartingNewTransactions};
     lock_t publicFunctionLck{mtxForSerializingPublicFunctionCalls};
-    auto transaction = unique_ptr<Transaction>(new Transaction(READ_ONLY, ++lastTransactionID));
+    auto transaction = unique_ptr<Transaction>(
+        new Transaction(READ_ONLY, ++lastTransactionID, isCheckpointPending));
     activeReadOnlyTransactionIDs.insert(transaction->getID());
     return transaction;
 }
@@ -46,6 +67,7 @@ void TransactionManager::manuallyClearActiveWriteTransaction(Transaction* transa
 void TransactionManager::commitOrRollbackNoLock(Transaction* transaction, bool isCommit) {
     if (transaction->isReadOnly()) {
         activeReadOnlyTransactionIDs.erase(transaction->getID());
+        readOnlyTransactionLeftCV.notify_all();
         return;
     }
     assertActiveWriteTransationIsCorrectNoLock(transaction);
@@ -76,6 +98,62 @@ void TransactionManager::rollback(Transaction* transaction) {
     clearActiveWriteTransactionIfWriteTransactionNoLock(transaction);
 }
 
+void TransactionManager::startPendingCheckpoint() {
+    lock_t lck{mtxForSerializingPublicFunctionCalls};
+    isCheckpointPending = true;
+    lastTransactionIDBeforePendingCheckpoint = lastTransactionID;
+}
+
+void TransactionManager::waitUntilReadTransactionsBeforePendingCheckpointLeave() {
+    lock_t lck{mtxForSerializingPublicFunctionCalls};
+    auto maxTransactionID = lastTransactionIDBeforePendingCheckpoint;
+    readOnlyTransactionLeftCV.wait(
+        lck, [&] { return !hasActiveReadOnlyTransactionNoLock(maxTransactionID); });
+}
+
+void TransactionManager::stopNewTransactionsForPendingCheckpoint() {
+    // New transactions are only stopped for a bounded time. If read-only transactions that started
+    // in the meantime do not leave within it, we let new transactions start again and retry after
+    // an exponentially growing backoff.
+    auto backoffInMicros = THREAD_SLEEP_TIME_WHEN_WAITING_IN_MICROS;
+    while (true) {
+        mtxForStartingNewTransactions.lock();
+        {
+            lock_t lck{mtxForSerializingPublicFunctionCalls};
+            if (readOnlyTransactionLeftCV.wait_for(lck,
+                    chrono::microseconds(checkPointWaitTimeoutForTransactionsToLeaveInMicros),
+                    [&] { return !hasActiveReadOnlyTransactionNoLock(UINT64_MAX); })) {
+                return;
+            }
+        }
+        mtxForStartingNewTransactions.unlock();
+        logger->info("Timeout waiting for read transactions to leave the system before "
+                     "checkpointing. Retrying in " +
+                     to_string(backoffInMicros) + " microseconds.");
+        this_thread::sleep_for(chrono::microseconds(backoffInMicros));
+        backoffInMicros =
+            min(backoffInMicros * 2, checkPointWaitTimeoutForTransactionsToLeaveInMicros);
+    }
+}
+
+void TransactionManager::finishPendingCheckpoint() {
+    lock_t lck{mtxForSerializingPublicFunctionCalls};
+    activeWriteTransactionID = INT64_MAX;
+    isCheckpointPending = false;
+    pendingCheckpointCV.notify_all();
+}
+
+void TransactionManager::failPendingCheckpoint(const string& errMsg) {
+    lock_t lck{mtxForSerializingPublicFunctionCalls};
+    pendingCheckpointErrMsg = errMsg;
+    pendingCheckpointCV.notify_all();
+}
+
+bool TransactionManager::hasActiveReadOnlyTransactionNoLock(uint64_t maxTransactionID) {
+    return any_of(activeReadOnlyTransactionIDs.begin(), activeReadOnlyTransactionIDs.end(),
+        [&](uint64_t transactionID) { return transactionID <= maxTransactionID; });
+}
+
 void TransactionManager::allowReceivingNewTransactions() {
     mtxForStartingNewTransactions.unlock();
 }
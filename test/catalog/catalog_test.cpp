@@ -1,6 +1,7 @@
 #include "include/gtest/gtest.h"
 
 #include "src/catalog/include/catalog.h"
+#include "src/storage/include/storage_utils.h"
 
 using namespace std;
 using namespace kuzu::catalog;
@@ -159,3 +160,17 @@ TEST_F(CatalogTest, SaveAndReadTest) {
                   .at("unstrIntProp"),
         0);
 }
+
+TEST_F(CatalogTest, ReadCatalogOfOtherStorageVersionTest) {
+    catalog->getReadOnlyVersion()->saveToFile(CATALOG_TEMP_DIRECTORY, DBFileType::ORIGINAL);
+    auto fileInfo = FileUtils::openFile(
+        StorageUtils::getCatalogFilePath(CATALOG_TEMP_DIRECTORY, DBFileType::ORIGINAL), O_WRONLY);
+    uint64_t otherStorageVersion = StorageConfig::STORAGE_VERSION + 1;
+    FileUtils::writeToFile(fileInfo.get(), (uint8_t*)&otherStorageVersion, sizeof(uint64_t),
+        strlen(StorageConfig::CATALOG_MAGIC_BYTES));
+    FileUtils::closeFile(fileInfo->fd);
+    auto newCatalog = make_unique<Catalog>();
+    ASSERT_THROW(newCatalog->getReadOnlyVersion()->readFromFile(
+                     CATALOG_TEMP_DIRECTORY, DBFileType::ORIGINAL),
+        CatalogException);
+}
@@ -0,0 +1,108 @@
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "src/common/include/task_system/task_scheduler.h"
+
+using namespace kuzu::common;
+using namespace std;
+
+class FunctionTask : public Task {
+public:
+    FunctionTask(uint64_t maxNumThreads, function<void()> func)
+        : Task{maxNumThreads}, func{move(func)} {}
+
+    void run() override { func(); }
+
+private:
+    function<void()> func;
+};
+
+TEST(TaskSchedulerTest, ChildTasksCompleteBeforeTheirParent) {
+    TaskScheduler taskScheduler{4 /* numThreads */};
+    atomic<uint64_t> numCompletedChildren{0};
+    atomic<uint64_t> numCompletedChildrenWhenParentRan{0};
+    auto parent = make_shared<FunctionTask>(1 /* maxNumThreads */,
+        [&]() { numCompletedChildrenWhenParentRan = numCompletedChildren.load(); });
+    for (auto i = 0u; i < 3; i++) {
+        auto child = make_unique<FunctionTask>(1 /* maxNumThreads */, [&]() {
+            this_thread::sleep_for(chrono::milliseconds(10));
+            numCompletedChildren++;
+        });
+        // A grandchild makes sure dependencies deeper than one level are completed first as well.
+        child->addChildTask(make_unique<FunctionTask>(1 /* maxNumThreads */,
+            [&]() { this_thread::sleep_for(chrono::milliseconds(10)); }));
+        parent->addChildTask(move(child));
+    }
+    taskScheduler.scheduleTaskAndWaitOrError(parent);
+    ASSERT_EQ(numCompletedChildrenWhenParentRan.load(), 3);
+}
+
+// When a child task errors while its sibling is still running, the error must only be rethrown
+// once the sibling has completed, and the parent must never run.
+TEST(TaskSchedulerTest, ErrorInChildTaskWithRunningSibling) {
+    TaskScheduler taskScheduler{4 /* numThreads */};
+    atomic<bool> isSiblingRunning{false};
+    atomic<bool> isSiblingCompleted{false};
+    atomic<bool> hasParentRun{false};
+    auto parent =
+        make_shared<FunctionTask>(1 /* maxNumThreads */, [&]() { hasParentRun = true; });
+    parent->addChildTask(make_unique<FunctionTask>(1 /* maxNumThreads */, [&]() {
+        isSiblingRunning = true;
+        this_thread::sleep_for(chrono::milliseconds(200));
+        isSiblingCompleted = true;
+    }));
+    parent->addChildTask(make_unique<FunctionTask>(1 /* maxNumThreads */, [&]() {
+        while (!isSiblingRunning) {
+            this_thread::yield();
+        }
+        throw runtime_error("Erroring child task.");
+    }));
+    ASSERT_THROW(taskScheduler.scheduleTaskAndWaitOrError(parent), runtime_error);
+    ASSERT_TRUE(isSiblingCompleted);
+    ASSERT_FALSE(hasParentRun);
+    // The erroring tasks are removed from the queue, so the scheduler can run new tasks.
+    atomic<bool> hasNewTaskRun{false};
+    auto newTask =
+        make_shared<FunctionTask>(1 /* maxNumThreads */, [&]() { hasNewTaskRun = true; });
+    taskScheduler.scheduleTaskAndWaitOrError(newTask);
+    ASSERT_TRUE(hasNewTaskRun);
+}
+
+// A single worker is kept busy until all tasks are scheduled, so it then dequeues the tasks by
+// descending priority and tasks with the same priority in the order they were scheduled.
+TEST(TaskSchedulerTest, HigherPriorityTasksAreDequeuedFirst) {
+    TaskScheduler taskScheduler{1 /* numThreads */};
+    atomic<bool> isBlockingTaskRunning{false};
+    atomic<bool> canBlockingTaskFinish{false};
+    taskScheduler.scheduleTask(make_shared<FunctionTask>(1 /* maxNumThreads */, [&]() {
+        isBlockingTaskRunning = true;
+        while (!canBlockingTaskFinish) {
+            this_thread::yield();
+        }
+    }));
+    while (!isBlockingTaskRunning) {
+        this_thread::yield();
+    }
+    mutex mtx;
+    vector<uint64_t> runOrder;
+    auto scheduleRecordingTask = [&](uint64_t taskIdx, uint64_t priority) {
+        taskScheduler.scheduleTask(make_shared<FunctionTask>(1 /* maxNumThreads */, [&, taskIdx]() {
+            lock_t lck{mtx};
+            runOrder.push_back(taskIdx);
+        }),
+            priority);
+    };
+    scheduleRecordingTask(0, 0 /* priority */);
+    scheduleRecordingTask(1, 0 /* priority */);
+    scheduleRecordingTask(2, 1 /* priority */);
+    scheduleRecordingTask(3, 2 /* priority */);
+    scheduleRecordingTask(4, 1 /* priority */);
+    canBlockingTaskFinish = true;
+    taskScheduler.waitAllTasksToCompleteOrError();
+    ASSERT_EQ(runOrder, vector<uint64_t>({3, 2, 4, 0, 1}));
+}
@@ -17,6 +17,11 @@ public:
     string getInputCSVDir() override { return "dataset/copy-csv-node-property-test/"; }
 };
 
+class CopyCSVBoolColumnTest : public InMemoryDBTest {
+public:
+    string getInputCSVDir() override { return "dataset/copy-csv-bool-test/"; }
+};
+
 class CopyCSVSpecialCharTest : public InMemoryDBTest {
 public:
     string getInputCSVDir() override { return "dataset/copy-csv-special-char-test/"; }
@@ -162,6 +167,25 @@ TEST_F(CopyNodeCSVPropertyTest, NodeStructuredStringPropertyTest) {
     }
 }
 
+// BOOL columns are bit-packed, so the 40000 values of isActive span 3 pages of 16384 values.
+TEST_F(CopyCSVBoolColumnTest, NodeStructuredBoolPropertyTest) {
+    auto graph = getStorageManager(*database);
+    auto catalog = getCatalog(*database);
+    auto tableID = catalog->getReadOnlyVersion()->getNodeTableIDFromName("person");
+    auto propertyIdx = catalog->getReadOnlyVersion()->getNodeProperty(tableID, "isActive");
+    auto column = reinterpret_cast<BoolPropertyColumn*>(
+        graph->getNodesStore().getNodePropertyColumn(tableID, propertyIdx.propertyID));
+    auto dummyReadOnlyTrx = Transaction::getDummyReadOnlyTrx();
+    for (auto nodeOffset = 0u; nodeOffset < 20; nodeOffset++) {
+        if (nodeOffset % 7 == 3) {
+            ASSERT_TRUE(column->isNull(nodeOffset, dummyReadOnlyTrx.get()));
+        } else {
+            ASSERT_FALSE(column->isNull(nodeOffset, dummyReadOnlyTrx.get()));
+            ASSERT_EQ(nodeOffset % 3 == 0, column->readValue(nodeOffset).val.booleanVal);
+        }
+    }
+}
+
 // TODO(Semih): Uncomment when enabling ad-hoc properties
 // TEST_F(CopyNodeCSVPropertyTest, NodeUnstructuredPropertyTest) {
 //    auto graph = database->getStorageManager();
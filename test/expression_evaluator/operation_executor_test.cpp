@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 
+#include "src/function/arithmetic/operations/include/arithmetic_operations.h"
+#include "src/function/comparison/operations/include/comparison_operations.h"
 #include "src/function/include/binary_operation_executor.h"
 #include "src/function/include/ternary_operation_executor.h"
 #include "src/function/null/include/null_operation_executor.h"
@@ -225,6 +227,52 @@ TEST_F(OperationExecutorTest, BinaryOperationExecutorUnFlatFlatWithNull) {
         unFlatResultValueVector, unFlatValueVectorA);
 }
 
+// Nulls are processed one null entry at a time, so this test spans several null entries, some of
+// which have no nulls and one of which has only nulls.
+TEST_F(OperationExecutorTest, BinaryOperationExecutorAllUnFlatWithNullsInSomeNullEntries) {
+    auto dataChunk = make_shared<DataChunk>(3);
+    dataChunk->state->selVector->selectedSize = DEFAULT_VECTOR_CAPACITY;
+    auto left = make_shared<ValueVector>(INT64, memoryManager.get());
+    auto right = make_shared<ValueVector>(INT64, memoryManager.get());
+    auto result = make_shared<ValueVector>(INT64, memoryManager.get());
+    dataChunk->insert(0, left);
+    dataChunk->insert(1, right);
+    dataChunk->insert(2, result);
+    for (auto i = 0u; i < DEFAULT_VECTOR_CAPACITY; i++) {
+        ((int64_t*)left->values)[i] = i;
+        ((int64_t*)right->values)[i] = 1;
+    }
+    auto isNull = [](uint64_t pos) { return (pos >= 128 && pos < 192) || pos % 100 == 7; };
+    for (auto i = 0u; i < DEFAULT_VECTOR_CAPACITY; i++) {
+        if (isNull(i)) {
+            // Dividing by zero throws, so division must not be executed on null positions.
+            right->setNull(i, true);
+            ((int64_t*)right->values)[i] = 0;
+        }
+    }
+    BinaryOperationExecutor::execute<int64_t, int64_t, int64_t, operation::Divide>(
+        *left, *right, *result);
+    for (auto i = 0u; i < DEFAULT_VECTOR_CAPACITY; i++) {
+        ASSERT_EQ(result->isNull(i), isNull(i));
+        if (!isNull(i)) {
+            ASSERT_EQ(((int64_t*)result->values)[i], i);
+        }
+    }
+
+    SelectionVector selVector(DEFAULT_VECTOR_CAPACITY);
+    selVector.resetSelectorToValuePosBuffer();
+    ASSERT_EQ((BinaryOperationExecutor::select<int64_t, int64_t, operation::GreaterThan>(
+                  *left, *right, selVector)),
+        true);
+    auto numSelectedValues = 0u;
+    for (auto i = 0u; i < DEFAULT_VECTOR_CAPACITY; i++) {
+        if (!isNull(i) && i > 1) {
+            ASSERT_EQ(selVector.selectedPositions[numSelectedValues++], i);
+        }
+    }
+    ASSERT_EQ(selVector.selectedSize, numSelectedValues);
+}
+
 TEST_F(OperationExecutorTest, TernaryOperationExecutorAllFlat) {
     vector<string> expectedStr = {"his is "};
     TernaryOperationExecutor::executeStringAndList<ku_string_t, int64_t, int64_t, ku_string_t,
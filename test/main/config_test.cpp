@@ -19,3 +19,48 @@ TEST_F(ApiTest, ClientConfig) {
     ASSERT_NO_THROW(conn->setMaxNumThreadForExec(2));
     ASSERT_EQ(conn->getMaxNumThreadForExec(), 2);
 }
+
+static void setWritePermissionsOfDirAndFiles(const string& dir, bool isWritable) {
+    auto writePermissions = filesystem::perms::owner_write | filesystem::perms::group_write |
+                            filesystem::perms::others_write;
+    auto permOptions =
+        isWritable ? filesystem::perm_options::add : filesystem::perm_options::remove;
+    for (auto& entry : filesystem::directory_iterator(dir)) {
+        filesystem::permissions(entry.path(), writePermissions, permOptions);
+    }
+    filesystem::permissions(dir, writePermissions, permOptions);
+}
+
+static set<string> getFileNames(const string& dir) {
+    set<string> fileNames;
+    for (auto& entry : filesystem::directory_iterator(dir)) {
+        fileNames.insert(entry.path().filename().string());
+    }
+    return fileNames;
+}
+
+// The database is opened with its files and directory made read-only, and without its WAL file,
+// which is empty and is not created in read-only mode. All files are opened when the database is
+// opened, so the permissions are restored right after.
+TEST_F(ApiTest, ReadOnlyMode) {
+    conn.reset();
+    database.reset();
+    FileUtils::removeFileIfExists(
+        FileUtils::joinPath(TestHelper::TEMP_TEST_DIR, StorageConfig::WAL_FILE_SUFFIX));
+    auto fileNames = getFileNames(TestHelper::TEMP_TEST_DIR);
+    setWritePermissionsOfDirAndFiles(TestHelper::TEMP_TEST_DIR, false /* isWritable */);
+    databaseConfig->readOnlyMode = true;
+    createDBAndConn();
+    setWritePermissionsOfDirAndFiles(TestHelper::TEMP_TEST_DIR, true /* isWritable */);
+    ASSERT_EQ(getFileNames(TestHelper::TEMP_TEST_DIR), fileNames);
+    assertMatchPersonCountStar(conn.get());
+    auto result = conn->query("MATCH (a:person) WHERE a.ID = 0 RETURN a.fName");
+    ASSERT_TRUE(result->isSuccess());
+    ASSERT_EQ(result->getNext()->getResultValue(0)->getStringVal(), "Alice");
+    ASSERT_FALSE(conn->query("CREATE (a:person {ID: 1000})")->isSuccess());
+    ASSERT_THROW(conn->beginWriteTransaction(), ConnectionException);
+    assertMatchPersonCountStar(conn.get());
+    conn.reset();
+    database.reset();
+    ASSERT_EQ(getFileNames(TestHelper::TEMP_TEST_DIR), fileNames);
+}
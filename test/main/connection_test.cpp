@@ -41,6 +41,173 @@ TEST_F(ApiTest, ParallelConnect) {
     }
 }
 
+static void parallel_create(Database* database, uint64_t threadIdx) {
+    auto conn = make_unique<Connection>(database);
+    for (auto i = 0u; i < 10; ++i) {
+        auto nodeID = to_string(1000 + threadIdx * 10 + i);
+        ASSERT_TRUE(conn->query("CREATE (a:person {ID: " + nodeID + "})")->isSuccess());
+        // Node 0 already exists, so this query fails in the middle of the queries of the others.
+        if (threadIdx == 0 && i == 4) {
+            ASSERT_FALSE(conn->query("CREATE (a:person {ID: 0})")->isSuccess());
+        }
+    }
+}
+
+TEST_F(ApiTest, ParallelCreateWithGroupCommit) {
+    conn.reset();
+    database.reset();
+    systemConfig->maxNumTransactionsPerGroupCommit = 4;
+    createDBAndConn();
+    auto numThreads = 8u;
+    thread threads[numThreads];
+    for (auto i = 0u; i < numThreads; ++i) {
+        threads[i] = thread(parallel_create, database.get(), i);
+    }
+    for (auto i = 0u; i < numThreads; ++i) {
+        threads[i].join();
+    }
+    auto result = conn->query("MATCH (a:person) RETURN COUNT(*)");
+    ASSERT_EQ(result->getNext()->getResultValue(0)->getInt64Val(), 8 + numThreads * 10);
+}
+
+class GroupCommitTest : public ApiTest {
+
+public:
+    void SetUp() override {
+        ApiTest::SetUp();
+        conn.reset();
+        database.reset();
+        systemConfig->maxNumTransactionsPerGroupCommit = 4;
+        createDBAndConn();
+    }
+
+    // Executes one query per thread in group commits. The first query to execute waits until the
+    // queries of all other threads are waiting to join its group, so it shares its group with at
+    // least the next query. The query at failingExecutionIdx, in the order the queries are
+    // executed, fails. Returns the ID of the write transaction of each execution of each thread,
+    // and the number of threads whose query failed.
+    pair<vector<vector<uint64_t>>, uint64_t> executeInGroupCommits(
+        uint64_t numThreads, uint64_t failingExecutionIdx = UINT64_MAX) {
+        vector<vector<uint64_t>> transactionIDs(numThreads);
+        atomic<uint64_t> numExecutions{0};
+        atomic<uint64_t> numFailedThreads{0};
+        auto executeQuery = [&](uint64_t threadIdx, Transaction* transaction) {
+            transactionIDs[threadIdx].push_back(transaction->getID());
+            auto executionIdx = numExecutions++;
+            if (executionIdx == 0) {
+                while (getNumTransactionsWaitingForGroupCommit(*database) < numThreads - 1) {
+                    this_thread::yield();
+                }
+            }
+            if (executionIdx == failingExecutionIdx) {
+                throw runtime_error("Failing query.");
+            }
+            return shared_ptr<FactorizedTable>();
+        };
+        vector<thread> threads;
+        for (auto i = 0u; i < numThreads; ++i) {
+            threads.emplace_back([&, i]() {
+                try {
+                    executeInGroupCommit(*database,
+                        [&, i](Transaction* transaction) { return executeQuery(i, transaction); });
+                } catch (Exception&) {
+                    numFailedThreads++;
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return make_pair(move(transactionIDs), numFailedThreads.load());
+    }
+};
+
+TEST_F(GroupCommitTest, QueriesShareGroupCommit) {
+    auto numThreads = 4u;
+    auto [transactionIDs, numFailedThreads] = executeInGroupCommits(numThreads);
+    ASSERT_EQ(numFailedThreads, 0u);
+    // A group is only committed once it holds 4 queries or no query is waiting to join it, so all
+    // queries share one transaction.
+    for (auto i = 0u; i < numThreads; ++i) {
+        ASSERT_EQ(transactionIDs[i].size(), 1u);
+        ASSERT_EQ(transactionIDs[i][0], transactionIDs[0][0]);
+    }
+}
+
+TEST_F(GroupCommitTest, FailingQueryInGroupCommit) {
+    auto numThreads = 4u;
+    auto [transactionIDs, numFailedThreads] =
+        executeInGroupCommits(numThreads, 1 /* failingExecutionIdx */);
+    // Only the failing query fails. The first query, which shares its group with the failing one,
+    // is rolled back with the group and executed again in a new transaction.
+    ASSERT_EQ(numFailedThreads, 1u);
+    auto numExecutions = 0u;
+    auto numThreadsExecutedAgain = 0u;
+    for (auto i = 0u; i < numThreads; ++i) {
+        numExecutions += transactionIDs[i].size();
+        if (transactionIDs[i].size() == 2) {
+            numThreadsExecutedAgain++;
+            ASSERT_NE(transactionIDs[i][0], transactionIDs[i][1]);
+        }
+    }
+    ASSERT_EQ(numThreadsExecutedAgain, 1u);
+    ASSERT_EQ(numExecutions, numThreads + 1);
+}
+
+class BackgroundCheckpointTest : public ApiTest {
+
+public:
+    void SetUp() override {
+        ApiTest::SetUp();
+        conn.reset();
+        database.reset();
+        systemConfig->checkpointInBackground = true;
+        createDBAndConn();
+    }
+
+    static int64_t getAgeOfPerson0(Connection& connection) {
+        auto result = connection.query("MATCH (a:person) WHERE a.ID = 0 RETURN a.age");
+        return result->getNext()->getResultValue(0)->getInt64Val();
+    }
+};
+
+TEST_F(BackgroundCheckpointTest, ReadAndWriteWhileCheckpointIsPending) {
+    // The read-only transaction started before the commit below, so the checkpoint of the commit
+    // is pending until it leaves.
+    auto oldReadConn = make_unique<Connection>(database.get());
+    oldReadConn->beginReadOnlyTransaction();
+    ASSERT_EQ(getAgeOfPerson0(*oldReadConn), 35);
+    ASSERT_TRUE(conn->query("MATCH (a:person) WHERE a.ID = 0 SET a.age = 36")->isSuccess());
+    ASSERT_TRUE(getTransactionManager(*database)->hasActiveWriteTransactionID());
+    // New read-only queries read the committed version, old ones keep reading the version they
+    // started with.
+    auto newReadConn = make_unique<Connection>(database.get());
+    ASSERT_EQ(getAgeOfPerson0(*newReadConn), 36);
+    ASSERT_EQ(getAgeOfPerson0(*oldReadConn), 35);
+    // A new write waits until the checkpoint has finished.
+    atomic<bool> isWriteFinished{false};
+    thread writeThread([&]() {
+        auto writeConn = make_unique<Connection>(database.get());
+        ASSERT_TRUE(
+            writeConn->query("MATCH (a:person) WHERE a.ID = 0 SET a.age = 37")->isSuccess());
+        isWriteFinished = true;
+    });
+    this_thread::sleep_for(chrono::milliseconds(100));
+    auto isWriteFinishedBeforeCheckpoint = isWriteFinished.load();
+    oldReadConn->commit();
+    writeThread.join();
+    ASSERT_FALSE(isWriteFinishedBeforeCheckpoint);
+    ASSERT_TRUE(isWriteFinished);
+    ASSERT_EQ(getAgeOfPerson0(*newReadConn), 37);
+    // The checkpoint of the second write may still be pending when the database is closed.
+    oldReadConn.reset();
+    newReadConn.reset();
+    conn.reset();
+    database.reset();
+    createDBAndConn();
+    ASSERT_EQ(getAgeOfPerson0(*conn), 37);
+}
+
 TEST_F(ApiTest, TransactionModes) {
     // Test initially connections are in AUTO_COMMIT mode.
     ASSERT_EQ(Connection::ConnectionTransactionMode::AUTO_COMMIT, getTransactionMode(*conn));
@@ -1,9 +1,12 @@
+#include <thread>
+
 #include "include/gtest/gtest.h"
 
 #include "src/function/aggregate/include/avg.h"
 #include "src/function/aggregate/include/count.h"
 #include "src/function/aggregate/include/sum.h"
 #include "src/processor/operator/aggregate/include/aggregate_hash_table.h"
+#include "src/processor/operator/aggregate/include/hash_aggregate.h"
 #include "src/processor/result/include/result_set.h"
 
 using ::testing::Test;
@@ -192,3 +195,102 @@ TEST_F(AggregateHashTableTest, TwoFlatUnflatGroupTest) {
 TEST_F(AggregateHashTableTest, TwoUnflatUnflatGroupTest) {
     twoGroupByKeyTest(false /* isFirstGroupByKeyFlat */, false /* isSecondGroupByKeyFlat */);
 }
+
+TEST_F(AggregateHashTableTest, PartitionAndMergeEntriesTest) {
+    vector<unique_ptr<AggregateFunction>> aggregates;
+    aggregates.push_back(AggregateFunctionUtil::getCountStarFunction());
+    aggregates.push_back(AggregateFunctionUtil::getSumFunction(DataType(INT64), false));
+    vector<ValueVector*> groupVectors{group2Vector.get()};
+    vector<ValueVector*> aggregateVectors{nullptr, aggr2Vector.get()};
+    dataChunk->state->currIdx = -1;
+    vector<unique_ptr<AggregateHashTable>> localHTs;
+    vector<vector<vector<uint8_t*>>> localPartitionedEntries;
+    for (auto i = 0u; i < 2; i++) {
+        auto localHT = make_unique<AggregateHashTable>(*memoryManager,
+            vector<DataType>{DataType(INT64)}, aggregates, 0 /* numEntriesToAllocate */);
+        localHT->append(
+            vector<ValueVector*>(), groupVectors, aggregateVectors, 1 /* multiplicity */);
+        localPartitionedEntries.push_back(localHT->partitionEntries());
+        localHTs.push_back(move(localHT));
+    }
+    auto groupsSize = Types::getDataTypeSize(INT64);
+    auto hashOffset = localHTs[0]->getFactorizedTable()->getTableSchema()->getColOffset(3);
+    auto numEntries = 0ul;
+    for (auto partitionIdx = 0u; partitionIdx < HashAggregateConfig::NUM_PARTITIONS;
+         partitionIdx++) {
+        auto partition = make_unique<AggregateHashTable>(*memoryManager,
+            vector<DataType>{DataType(INT64)}, aggregates, 0 /* numEntriesToAllocate */);
+        for (auto i = 0u; i < localHTs.size(); i++) {
+            partition->mergeEntries(
+                *localHTs[i]->getFactorizedTable(), localPartitionedEntries[i][partitionIdx]);
+        }
+        partition->finalizeAggregateStates();
+        ASSERT_EQ(partition->getNumEntries(), localPartitionedEntries[0][partitionIdx].size());
+        for (auto i = 0u; i < partition->getNumEntries(); i++) {
+            auto entry = partition->getEntry(i);
+            ASSERT_EQ(AggregateHashTable::getPartitionIdx(*(hash_t*)(entry + hashOffset)),
+                partitionIdx);
+            auto key = *(int64_t*)entry;
+            auto countAggrState = (BaseCountFunction::CountState*)(entry + groupsSize);
+            ASSERT_EQ(*(uint64_t*)countAggrState->getResult(), 2);
+            auto sumAggrState = (SumFunction<int64_t>::SumState*)(entry + groupsSize +
+                                                                  countAggrState->getStateSize());
+            ASSERT_EQ(*(int64_t*)sumAggrState->getResult(), 4 * key);
+        }
+        numEntries += partition->getNumEntries();
+    }
+    ASSERT_EQ(numEntries, 100);
+}
+
+TEST_F(AggregateHashTableTest, CombineNonEmptyPartitionsTest) {
+    vector<unique_ptr<AggregateFunction>> aggregates;
+    aggregates.push_back(AggregateFunctionUtil::getCountStarFunction());
+    aggregates.push_back(AggregateFunctionUtil::getSumFunction(DataType(INT64), false));
+    HashAggregateSharedState sharedState{aggregates};
+    // group1Vector holds 4 groups, so at most 4 of the partitions hold entries.
+    vector<ValueVector*> groupVectors{group1Vector.get()};
+    vector<ValueVector*> aggregateVectors{nullptr, aggr2Vector.get()};
+    dataChunk->state->currIdx = -1;
+    for (auto i = 0u; i < 2; i++) {
+        auto localHT = make_unique<AggregateHashTable>(*memoryManager,
+            vector<DataType>{DataType(INT64)}, aggregates, 0 /* numEntriesToAllocate */);
+        localHT->append(
+            vector<ValueVector*>(), groupVectors, aggregateVectors, 1 /* multiplicity */);
+        sharedState.appendAggregateHashTable(move(localHT));
+    }
+    sharedState.prepareToCombineAggregateHashTables();
+    auto numPartitions = sharedState.getNumGlobalPartitions();
+    ASSERT_GT(numPartitions, 0u);
+    ASSERT_LE(numPartitions, 4u);
+    thread otherThread([&]() { sharedState.combinePartitions(*memoryManager); });
+    sharedState.combinePartitions(*memoryManager);
+    otherThread.join();
+    auto groupsSize = Types::getDataTypeSize(INT64);
+    auto numEntries = 0ul;
+    auto numScannedPartitions = 0u;
+    AggregateHashTable* lastPartition = nullptr;
+    while (true) {
+        auto [partition, startOffset, endOffset] = sharedState.getNextRangeToRead();
+        if (startOffset == endOffset) {
+            break;
+        }
+        if (partition != lastPartition) {
+            numScannedPartitions++;
+            lastPartition = partition;
+        }
+        for (auto i = startOffset; i < endOffset; i++) {
+            auto entry = partition->getEntry(i);
+            auto key = *(int64_t*)entry;
+            auto countAggrState = (BaseCountFunction::CountState*)(entry + groupsSize);
+            ASSERT_EQ(*(uint64_t*)countAggrState->getResult(), 50);
+            auto sumAggrState = (SumFunction<int64_t>::SumState*)(entry + groupsSize +
+                                                                  countAggrState->getStateSize());
+            // Each local hash table sums 2 * i over the 25 values i in [0, 100) with i % 4 = key.
+            ASSERT_EQ(*(int64_t*)sumAggrState->getResult(), 2 * 2 * (25 * key + 4 * 300));
+        }
+        numEntries += endOffset - startOffset;
+    }
+    // Every partition that is scanned holds at least one group.
+    ASSERT_EQ(numScannedPartitions, numPartitions);
+    ASSERT_EQ(numEntries, 4u);
+}
@@ -0,0 +1,40 @@
+#include "include/gtest/gtest.h"
+
+#include "src/function/hash/operations/include/hash_operations.h"
+#include "src/processor/operator/hash_join/include/bloom_filter.h"
+
+using ::testing::Test;
+using namespace kuzu::function::operation;
+using namespace kuzu::processor;
+
+static hash_t hashNodeOffset(uint64_t offset) {
+    hash_t hash;
+    Hash::operation<nodeID_t>(nodeID_t(offset, 0 /* tableID */), false /* isNull */, hash);
+    return hash;
+}
+
+TEST(BloomFilterTest, NoFalseNegativesAndFewFalsePositivesTest) {
+    auto numKeys = 10000u;
+    auto bloomFilter = make_unique<BloomFilter>(numKeys);
+    for (auto i = 0u; i < numKeys; i++) {
+        bloomFilter->insert(hashNodeOffset(2 * i));
+    }
+    auto numFalsePositives = 0u;
+    for (auto i = 0u; i < numKeys; i++) {
+        ASSERT_TRUE(bloomFilter->mayContain(hashNodeOffset(2 * i)));
+        numFalsePositives += bloomFilter->mayContain(hashNodeOffset(2 * i + 1));
+    }
+    // With 16 bits per key the expected false positive rate is well below 1%.
+    ASSERT_LT(numFalsePositives, numKeys / 100);
+}
+
+TEST(BloomFilterTest, InsertAtomicallyTest) {
+    auto numKeys = 1000u;
+    auto bloomFilter = make_unique<BloomFilter>(numKeys);
+    for (auto i = 0u; i < numKeys; i++) {
+        bloomFilter->insertAtomically(hashNodeOffset(i));
+    }
+    for (auto i = 0u; i < numKeys; i++) {
+        ASSERT_TRUE(bloomFilter->mayContain(hashNodeOffset(i)));
+    }
+}
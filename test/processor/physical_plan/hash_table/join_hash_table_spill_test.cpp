@@ -0,0 +1,167 @@
+#include <thread>
+
+#include "include/gtest/gtest.h"
+
+#include "src/processor/operator/hash_join/include/hash_join_build.h"
+#include "src/processor/operator/hash_join/include/join_hash_table.h"
+#include "src/storage/include/storage_utils.h"
+
+using ::testing::Test;
+using namespace kuzu::processor;
+
+class JoinHashTableSpillTest : public Test {
+
+public:
+    void SetUp() override {
+        bufferManager =
+            make_unique<BufferManager>(StorageConfig::DEFAULT_BUFFER_POOL_SIZE_FOR_TESTING);
+        memoryManager = make_unique<MemoryManager>(bufferManager.get());
+    }
+
+    void TearDown() override { FileUtils::removeDir(SPILL_DIR_PATH); }
+
+    // A join hash table with a single key, an INT64 payload and the prev pointer column.
+    unique_ptr<JoinHashTable> createHashTable() {
+        auto tableSchema = make_unique<FactorizedTableSchema>();
+        tableSchema->appendColumn(make_unique<ColumnSchema>(
+            false /* is flat */, 0 /* dataChunkPos */, Types::getDataTypeSize(NODE_ID)));
+        tableSchema->appendColumn(make_unique<ColumnSchema>(
+            false /* is flat */, 0 /* dataChunkPos */, Types::getDataTypeSize(INT64)));
+        tableSchema->appendColumn(make_unique<ColumnSchema>(
+            false /* is flat */, UINT32_MAX /* dataChunkPos */, Types::getDataTypeSize(INT64)));
+        return make_unique<JoinHashTable>(*memoryManager, 1 /* numKeyColumns */, move(tableSchema));
+    }
+
+    // Spills the tuples (i, 2 * i) for i < numTuples, where i is the offset of the key.
+    unique_ptr<SpilledPartitions> spillTuples(JoinHashTable& hashTable, uint64_t numTuples) {
+        auto factorizedTable = hashTable.getFactorizedTable();
+        for (auto i = 0u; i < numTuples; i++) {
+            auto tuple = factorizedTable->appendEmptyTuple();
+            *(nodeID_t*)tuple = nodeID_t(i, 0 /* tableID */);
+            *(int64_t*)(tuple + sizeof(nodeID_t)) = 2 * i;
+        }
+        auto spilledPartitions = make_unique<SpilledPartitions>(
+            StorageUtils::getNewSpillFilePath(SPILL_DIR_PATH, "test"), 0 /* level */);
+        SpillPartitionWriter spillPartitionWriter(
+            *spilledPartitions, hashTable.getTableSchema()->getNumBytesPerTuple(), *memoryManager);
+        hashTable.spillTuples(spillPartitionWriter);
+        spillPartitionWriter.flush();
+        return spilledPartitions;
+    }
+
+public:
+    static constexpr char SPILL_DIR_PATH[] = "test/unittest_temp/spill";
+    unique_ptr<BufferManager> bufferManager;
+    unique_ptr<MemoryManager> memoryManager;
+};
+
+TEST_F(JoinHashTableSpillTest, SpillAndLoadPartitionsTest) {
+    auto numTuples = 100000u;
+    auto hashTable = createHashTable();
+    auto spilledPartitions = spillTuples(*hashTable, numTuples);
+    ASSERT_EQ(hashTable->getNumTuples(), 0);
+    vector<bool> isOffsetLoaded(numTuples, false);
+    for (auto partitionIdx = 0u; partitionIdx < HashJoinConfig::NUM_SPILL_PARTITIONS;
+         partitionIdx++) {
+        auto partitionHashTable = createHashTable();
+        partitionHashTable->loadSpilledPartition(*spilledPartitions, partitionIdx);
+        ASSERT_LE(partitionHashTable->getFactorizedTable()->getTupleDataBlocks().size(),
+            spilledPartitions->getMaxNumBlocksToLoad(partitionIdx));
+        for (auto& block : partitionHashTable->getFactorizedTable()->getTupleDataBlocks()) {
+            auto tuple = block->getData();
+            for (auto i = 0u; i < block->numTuples; i++) {
+                auto nodeID = *(nodeID_t*)tuple;
+                ASSERT_EQ(SpilledPartitions::getPartitionIdx(
+                              partitionHashTable->hashKeys(&nodeID), 0 /* level */),
+                    partitionIdx);
+                ASSERT_EQ(*(int64_t*)(tuple + sizeof(nodeID_t)), 2 * nodeID.offset);
+                ASSERT_FALSE(isOffsetLoaded[nodeID.offset]);
+                isOffsetLoaded[nodeID.offset] = true;
+                tuple += partitionHashTable->getTableSchema()->getNumBytesPerTuple();
+            }
+        }
+        // The loaded partition has to be probeable once hash slots are built.
+        partitionHashTable->allocateHashSlots(partitionHashTable->getNumTuples());
+        partitionHashTable->buildHashSlots();
+    }
+    for (auto i = 0u; i < numTuples; i++) {
+        ASSERT_TRUE(isOffsetLoaded[i]);
+    }
+}
+
+TEST_F(JoinHashTableSpillTest, RepartitionSpilledPartitionTest) {
+    auto numTuples = 100000u;
+    auto hashTable = createHashTable();
+    auto spilledPartitions = spillTuples(*hashTable, numTuples);
+    auto numBytesPerTuple = hashTable->getTableSchema()->getNumBytesPerTuple();
+    auto partitionIdx = 3u;
+    SpilledPartitions repartitionedPartitions(
+        StorageUtils::getNewSpillFilePath(SPILL_DIR_PATH, "test"), 1 /* level */);
+    SpillPartitionWriter spillPartitionWriter(
+        repartitionedPartitions, numBytesPerTuple, *memoryManager);
+    spilledPartitions->repartition(partitionIdx, numBytesPerTuple, spillPartitionWriter,
+        [&](const uint8_t* tuple) {
+            return SpilledPartitions::getPartitionIdx(
+                hashTable->hashKeys((nodeID_t*)tuple), 1 /* level */);
+        });
+    // Each tuple of the partition ends up in the partition of the next level given by the next
+    // bits of its hash.
+    vector<bool> isOffsetLoaded(numTuples, false);
+    auto numTuplesInPartition = 0u;
+    auto numNonEmptyPartitions = 0u;
+    for (auto i = 0u; i < HashJoinConfig::NUM_SPILL_PARTITIONS; i++) {
+        auto partitionHashTable = createHashTable();
+        partitionHashTable->loadSpilledPartition(repartitionedPartitions, i);
+        numNonEmptyPartitions += partitionHashTable->getNumTuples() > 0;
+        for (auto& block : partitionHashTable->getFactorizedTable()->getTupleDataBlocks()) {
+            auto tuple = block->getData();
+            for (auto j = 0u; j < block->numTuples; j++) {
+                auto nodeID = *(nodeID_t*)tuple;
+                auto hash = partitionHashTable->hashKeys(&nodeID);
+                ASSERT_EQ(SpilledPartitions::getPartitionIdx(hash, 0 /* level */), partitionIdx);
+                ASSERT_EQ(SpilledPartitions::getPartitionIdx(hash, 1 /* level */), i);
+                ASSERT_EQ(*(int64_t*)(tuple + sizeof(nodeID_t)), 2 * nodeID.offset);
+                ASSERT_FALSE(isOffsetLoaded[nodeID.offset]);
+                isOffsetLoaded[nodeID.offset] = true;
+                numTuplesInPartition++;
+                tuple += numBytesPerTuple;
+            }
+        }
+    }
+    auto expectedNumTuplesInPartition = 0u;
+    for (auto i = 0u; i < numTuples; i++) {
+        auto nodeID = nodeID_t(i, 0 /* tableID */);
+        expectedNumTuplesInPartition += SpilledPartitions::getPartitionIdx(
+                                            hashTable->hashKeys(&nodeID), 0 /* level */) ==
+                                        partitionIdx;
+    }
+    ASSERT_EQ(numTuplesInPartition, expectedNumTuplesInPartition);
+    // The next bits of the hashes still split the partition.
+    ASSERT_GT(numNonEmptyPartitions, 1u);
+}
+
+// Probe threads of a task register at different times. A thread that registers while others are
+// still probing the resident partition holds them at the barrier until it has finished as well,
+// while a thread that registers after the barrier opened is rejected.
+TEST(HashJoinSharedStateTest, ResidentPartitionBarrierWithStaggeredProbeThreadsTest) {
+    HashJoinSharedState sharedState{vector<DataType>{}};
+    ASSERT_TRUE(sharedState.registerProbeThread());
+    ASSERT_TRUE(sharedState.registerProbeThread());
+    atomic<bool> hasPassedBarrier{false};
+    thread firstProbeThread{[&]() {
+        sharedState.finishProbingResidentPartition();
+        sharedState.waitForResidentPartitionToBeProbed();
+        hasPassedBarrier = true;
+    }};
+    this_thread::sleep_for(chrono::milliseconds(50));
+    ASSERT_FALSE(hasPassedBarrier);
+    // A late thread registers before the second thread finishes.
+    ASSERT_TRUE(sharedState.registerProbeThread());
+    sharedState.finishProbingResidentPartition();
+    this_thread::sleep_for(chrono::milliseconds(50));
+    ASSERT_FALSE(hasPassedBarrier);
+    sharedState.finishProbingResidentPartition();
+    firstProbeThread.join();
+    ASSERT_TRUE(hasPassedBarrier);
+    ASSERT_FALSE(sharedState.registerProbeThread());
+}
@@ -0,0 +1,94 @@
+#include <thread>
+
+#include "include/gtest/gtest.h"
+
+#include "src/processor/operator/hash_join/include/join_hash_table.h"
+
+using ::testing::Test;
+using namespace kuzu::processor;
+
+class JoinHashTableTest : public Test {
+
+public:
+    void SetUp() override {
+        bufferManager =
+            make_unique<BufferManager>(StorageConfig::DEFAULT_BUFFER_POOL_SIZE_FOR_TESTING);
+        memoryManager = make_unique<MemoryManager>(bufferManager.get());
+    }
+
+    // A join hash table with a single key, an INT64 payload and the prev pointer column. The
+    // payload of each tuple is its idx, and tuple i has key i % numKeys.
+    unique_ptr<JoinHashTable> createHashTable(uint64_t numTuples, uint64_t numKeys) {
+        auto tableSchema = make_unique<FactorizedTableSchema>();
+        tableSchema->appendColumn(make_unique<ColumnSchema>(
+            false /* is flat */, 0 /* dataChunkPos */, Types::getDataTypeSize(NODE_ID)));
+        tableSchema->appendColumn(make_unique<ColumnSchema>(
+            false /* is flat */, 0 /* dataChunkPos */, Types::getDataTypeSize(INT64)));
+        tableSchema->appendColumn(make_unique<ColumnSchema>(
+            false /* is flat */, UINT32_MAX /* dataChunkPos */, Types::getDataTypeSize(INT64)));
+        auto hashTable =
+            make_unique<JoinHashTable>(*memoryManager, 1 /* numKeyColumns */, move(tableSchema));
+        auto factorizedTable = hashTable->getFactorizedTable();
+        for (auto i = 0u; i < numTuples; i++) {
+            auto tuple = factorizedTable->appendEmptyTuple();
+            *(nodeID_t*)tuple = nodeID_t(i % numKeys, 0 /* tableID */);
+            *(int64_t*)(tuple + sizeof(nodeID_t)) = i;
+        }
+        return hashTable;
+    }
+
+    // Checks that the chain of each key holds exactly the tuples with that key.
+    static void checkChains(JoinHashTable& hashTable, uint64_t numTuples, uint64_t numKeys) {
+        vector<bool> isTupleFound(numTuples, false);
+        for (auto key = 0u; key < numKeys; key++) {
+            auto nodeID = nodeID_t(key, 0 /* tableID */);
+            auto hash = hashTable.hashKeys(&nodeID);
+            if (hashTable.getBloomFilter()) {
+                ASSERT_TRUE(hashTable.getBloomFilter()->mayContain(hash));
+            }
+            auto numTuplesWithKey = 0u;
+            auto tuple = hashTable.getTupleForHash(hash);
+            while (tuple) {
+                if (((nodeID_t*)tuple)->offset == key) {
+                    auto tupleIdx = *(int64_t*)(tuple + sizeof(nodeID_t));
+                    ASSERT_EQ(tupleIdx % numKeys, key);
+                    ASSERT_FALSE(isTupleFound[tupleIdx]);
+                    isTupleFound[tupleIdx] = true;
+                    numTuplesWithKey++;
+                }
+                tuple = *hashTable.getPrevTuple(tuple);
+            }
+            ASSERT_EQ(numTuplesWithKey, (numTuples - key + numKeys - 1) / numKeys);
+        }
+    }
+
+public:
+    unique_ptr<BufferManager> bufferManager;
+    unique_ptr<MemoryManager> memoryManager;
+};
+
+TEST_F(JoinHashTableTest, BuildHashSlotsTest) {
+    auto numTuples = 100000u, numKeys = 3000u;
+    auto hashTable = createHashTable(numTuples, numKeys);
+    hashTable->allocateHashSlots(numTuples);
+    hashTable->allocateBloomFilter(numTuples);
+    hashTable->buildHashSlots();
+    checkChains(*hashTable, numTuples, numKeys);
+}
+
+TEST_F(JoinHashTableTest, BuildHashSlotsInParallelTest) {
+    // Many tuples share a key, so the threads insert into the same slots concurrently.
+    auto numTuples = 300000u, numKeys = 3000u, numThreads = 4u;
+    auto hashTable = createHashTable(numTuples, numKeys);
+    ASSERT_GT(hashTable->getFactorizedTable()->getTupleDataBlocks().size(), numThreads);
+    hashTable->allocateHashSlots(numTuples);
+    hashTable->allocateBloomFilter(numTuples);
+    vector<thread> threads;
+    for (auto i = 0u; i < numThreads; i++) {
+        threads.emplace_back([&]() { hashTable->buildHashSlotsInParallel(); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    checkChains(*hashTable, numTuples, numKeys);
+}
@@ -845,3 +845,17 @@ TEST_F(OrderByKeyEncoderTest, multipleOrderByColMultiBlockTest) {
     checkKeyBlockForInt64TestValueVector(valueVectors, orderByKeyEncoder.getKeyBlocks(),
         numOfElementsPerCol, isAscOrder, orderByKeyEncoder.getMaxNumTuplesPerBlock());
 }
+
+TEST_F(OrderByKeyEncoderTest, encodeTupleInfoTest) {
+    // The ftIdx of a thread above 255 and the maximum ftBlockIdx and ftBlockOffset must not
+    // overlap each other.
+    uint8_t tupleInfo[8];
+    OrderByKeyEncoder::encodeTupleInfo(tupleInfo, (1ul << 24) - 1, (1ul << 24) - 1, 300);
+    ASSERT_EQ(OrderByKeyEncoder::getEncodedFTBlockIdx(tupleInfo), (1ul << 24) - 1);
+    ASSERT_EQ(OrderByKeyEncoder::getEncodedFTBlockOffset(tupleInfo), (1ul << 24) - 1);
+    ASSERT_EQ(OrderByKeyEncoder::getEncodedFTIdx(tupleInfo), 300);
+    OrderByKeyEncoder::encodeTupleInfo(tupleInfo, 5, 0, UINT16_MAX);
+    ASSERT_EQ(OrderByKeyEncoder::getEncodedFTBlockIdx(tupleInfo), 5);
+    ASSERT_EQ(OrderByKeyEncoder::getEncodedFTBlockOffset(tupleInfo), 0);
+    ASSERT_EQ(OrderByKeyEncoder::getEncodedFTIdx(tupleInfo), UINT16_MAX);
+}
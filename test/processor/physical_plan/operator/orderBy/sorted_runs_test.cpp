@@ -0,0 +1,143 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "src/processor/operator/order_by/include/order_by.h"
+#include "src/processor/operator/order_by/include/sorted_runs.h"
+#include "src/storage/include/storage_utils.h"
+
+using ::testing::Test;
+using namespace kuzu::processor;
+using namespace std;
+
+class SortedRunsTest : public Test {
+
+public:
+    void TearDown() override { FileUtils::removeDir(SPILL_DIR_PATH); }
+
+    // Keys are encoded in big endian, so that memcmp orders them the same way as their values.
+    static void encodeKey(uint64_t value, uint8_t* keyBuffer) {
+        for (auto i = 0u; i < sizeof(uint64_t); i++) {
+            keyBuffer[i] = (uint8_t)(value >> (8 * (sizeof(uint64_t) - 1 - i)));
+        }
+    }
+
+    static void writeRun(SortedRuns& sortedRuns, const vector<uint64_t>& sortedValues) {
+        SortedRunWriter writer{sortedRuns, sortedValues.size()};
+        uint8_t keyBuffer[sizeof(uint64_t)];
+        for (auto value : sortedValues) {
+            encodeKey(value, keyBuffer);
+            // The tuple of each record holds the value itself.
+            writer.append(keyBuffer, (uint8_t*)&value);
+        }
+        writer.flush();
+    }
+
+    static void checkMergedRuns(SortedRuns& sortedRuns, uint64_t expectedNumRecords) {
+        SortedRunsMerger merger{sortedRuns};
+        auto numRecords = 0ul;
+        uint8_t expectedKeyBuffer[sizeof(uint64_t)];
+        auto prevValue = 0ul;
+        const uint8_t* record;
+        while ((record = merger.getNextRecord()) != nullptr) {
+            auto value = *(uint64_t*)(record + sortedRuns.getNumBytesPerKey());
+            encodeKey(value, expectedKeyBuffer);
+            ASSERT_EQ(memcmp(record, expectedKeyBuffer, sizeof(uint64_t)), 0);
+            ASSERT_LE(prevValue, value);
+            prevValue = value;
+            numRecords++;
+        }
+        ASSERT_EQ(numRecords, expectedNumRecords);
+    }
+
+public:
+    static constexpr char SPILL_DIR_PATH[] = "test/unittest_temp/spill";
+};
+
+TEST_F(SortedRunsTest, MergeInterleavedRunsTest) {
+    SortedRuns sortedRuns{StorageUtils::getNewSpillFilePath(SPILL_DIR_PATH, "test"),
+        sizeof(uint64_t) /* numBytesPerKey */, sizeof(uint64_t)};
+    // Runs hold the values congruent to their run idx modulo the number of runs. The first run
+    // spans several buffers of the run readers and writers.
+    const uint64_t numRuns = 3, numValuesInFirstRun = 10000;
+    for (auto runIdx = 0u; runIdx < numRuns; runIdx++) {
+        vector<uint64_t> sortedValues;
+        auto numValues = runIdx == 0 ? numValuesInFirstRun : 100;
+        for (auto i = 0u; i < numValues; i++) {
+            sortedValues.push_back(i * numRuns + runIdx);
+        }
+        writeRun(sortedRuns, sortedValues);
+    }
+    ASSERT_EQ(sortedRuns.getNumRuns(), numRuns);
+    checkMergedRuns(sortedRuns, numValuesInFirstRun + 200);
+}
+
+TEST_F(SortedRunsTest, MergeRunsWithDuplicateAndEmptyRunsTest) {
+    SortedRuns sortedRuns{StorageUtils::getNewSpillFilePath(SPILL_DIR_PATH, "test"),
+        sizeof(uint64_t) /* numBytesPerKey */, sizeof(uint64_t)};
+    writeRun(sortedRuns, vector<uint64_t>{1, 5, 5, 9});
+    writeRun(sortedRuns, vector<uint64_t>{});
+    writeRun(sortedRuns, vector<uint64_t>{5, 5, 10});
+    checkMergedRuns(sortedRuns, 7);
+}
+
+TEST_F(SortedRunsTest, MergeNoRunsTest) {
+    SortedRuns sortedRuns{StorageUtils::getNewSpillFilePath(SPILL_DIR_PATH, "test"),
+        sizeof(uint64_t) /* numBytesPerKey */, sizeof(uint64_t)};
+    checkMergedRuns(sortedRuns, 0);
+}
+
+// Threads that finish before spilling starts leave their sorted key blocks in the shared state.
+// spillSortedKeyBlocks() merges them into a single run whose records hold the keys followed by the
+// tuples they point to in the factorizedTables of those threads.
+TEST_F(SortedRunsTest, SpillSortedKeyBlocksOfTwoThreadsTest) {
+    auto bufferManager =
+        make_unique<BufferManager>(StorageConfig::DEFAULT_BUFFER_POOL_SIZE_FOR_TESTING);
+    auto memoryManager = make_unique<MemoryManager>(bufferManager.get());
+    SharedFactorizedTablesAndSortedKeyBlocks sharedState;
+    const uint64_t numThreads = 2, numValuesPerThread = 1000;
+    vector<unique_ptr<OrderByKeyEncoder>> orderByKeyEncoders;
+    for (auto ftIdx = 0u; ftIdx < numThreads; ftIdx++) {
+        auto dataChunk = make_shared<DataChunk>(1);
+        dataChunk->state->initOriginalAndSelectedSize(numValuesPerThread);
+        auto valueVector = make_shared<ValueVector>(INT64, memoryManager.get());
+        dataChunk->insert(0, valueVector);
+        // Thread i holds the values congruent to i modulo the number of threads, in sorted order,
+        // so its key block is sorted as encoded.
+        for (auto i = 0u; i < numValuesPerThread; i++) {
+            ((int64_t*)valueVector->values)[i] = i * numThreads + ftIdx;
+        }
+        auto tableSchema = make_unique<FactorizedTableSchema>();
+        tableSchema->appendColumn(make_unique<ColumnSchema>(
+            false /* isUnflat */, 0 /* dataChunkPos */, Types::getDataTypeSize(INT64)));
+        auto factorizedTable = make_shared<FactorizedTable>(memoryManager.get(), move(tableSchema));
+        vector<shared_ptr<ValueVector>> vectors{valueVector};
+        factorizedTable->append(vectors);
+        vector<bool> isAscOrder{true};
+        orderByKeyEncoders.push_back(make_unique<OrderByKeyEncoder>(vectors, isAscOrder,
+            memoryManager.get(), ftIdx, factorizedTable->getNumTuplesPerBlock()));
+        orderByKeyEncoders.back()->encodeKeys();
+        sharedState.appendFactorizedTable(ftIdx, factorizedTable);
+        sharedState.setNumBytesPerTuple(orderByKeyEncoders.back()->getNumBytesPerTuple());
+        sharedState.appendSortedKeyBlock(
+            make_shared<MergedKeyBlocks>(orderByKeyEncoders.back()->getNumBytesPerTuple(),
+                orderByKeyEncoders.back()->getKeyBlocks()[0]));
+    }
+    sharedState.startSpilling(
+        SPILL_DIR_PATH, sharedState.factorizedTables[0]->getTableSchema()->getNumBytesPerTuple());
+    sharedState.spillSortedKeyBlocks();
+    ASSERT_TRUE(sharedState.sortedKeyBlocks->empty());
+    for (auto& factorizedTable : sharedState.factorizedTables) {
+        ASSERT_EQ(factorizedTable->getNumTuples(), 0u);
+    }
+    auto& sortedRuns = *sharedState.getSortedRuns();
+    ASSERT_EQ(sortedRuns.getNumRuns(), 1u);
+    SortedRunsMerger merger{sortedRuns};
+    const uint8_t* record;
+    auto numRecords = 0ul;
+    while ((record = merger.getNextRecord()) != nullptr) {
+        ASSERT_EQ(*(int64_t*)(record + sortedRuns.getNumBytesPerKey()), (int64_t)numRecords);
+        numRecords++;
+    }
+    ASSERT_EQ(numRecords, numThreads * numValuesPerThread);
+}
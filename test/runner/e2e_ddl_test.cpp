@@ -93,7 +93,9 @@ public:
         catalog = getCatalog(*database);
         profiler = make_unique<Profiler>();
         executionContext = make_unique<ExecutionContext>(1 /* numThreads */, profiler.get(),
-            getMemoryManager(*database), getBufferManager(*database));
+            getMemoryManager(*database), getBufferManager(*database),
+            StorageUtils::getSpillDirPath(databaseConfig->databasePath),
+            HashJoinConfig::BUILD_MEMORY_BUDGET_RATIO);
     }
 
     void initWithoutLoadingGraph() {
@@ -72,6 +72,13 @@ public:
         for (auto& nodeID : nodeIDs) {
             validateNodeExistOrNot(connection, nodeID, exist);
         }
+        // Will trigger a single index scan of all keys.
+        string keys;
+        for (auto& nodeID : nodeIDs) {
+            keys += (keys.empty() ? "" : ", ") + nodeID;
+        }
+        auto query = "MATCH (a:person) WHERE list_contains([" + keys + "], a.ID)";
+        ASSERT_EQ(getCount(connection, query), exist ? (int64_t)nodeIDs.size() : 0);
     }
     // Will trigger index scan.
     void validateNodeExistOrNot(Connection* connection, const string& nodeID, bool exist) {
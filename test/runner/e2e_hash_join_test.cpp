@@ -0,0 +1,180 @@
+#include "test/test_utility/include/test_helper.h"
+
+using namespace kuzu::testing;
+
+// With a large page buffer pool of 16 frames and a budget of 1/16 of it, the build sides of the
+// hash joins of a query may hold a single block of tuples in memory before the build side that
+// exceeds the budget spills.
+class HashJoinSpillingTests : public DBTest {
+
+public:
+    void SetUp() override {
+        DBTest::SetUp();
+        systemConfig->largePageBufferPoolSize = 16 * LARGE_PAGE_SIZE;
+        systemConfig->hashJoinBuildMemoryBudgetRatio = 1.0 / 16;
+        createDBAndConn();
+    }
+
+    // Runs the best plan of a query returning a single tuple of INT64 values, and checks that at
+    // least one hash join of the plan has joined spilled partitions.
+    void checkSpilledHashJoin(
+        const string& query, uint64_t numThreads, const vector<int64_t>& expectedValues) {
+        conn->setMaxNumThreadForExec(numThreads);
+        auto result = conn->query("PROFILE " + query);
+        ASSERT_TRUE(result->isSuccess());
+        checkResult(*result, expectedValues);
+        ASSERT_GT(getNumSpilledPartitions(result->getQuerySummary()->printPlanToJson()), 0u);
+    }
+
+    // Runs all plans of a query, whether their hash joins spill or not.
+    void checkAllPlans(
+        const string& query, uint64_t numThreads, const vector<int64_t>& expectedValues) {
+        conn->setMaxNumThreadForExec(numThreads);
+        for (auto& plan : enumeratePlans(*conn, query)) {
+            auto result = executePlan(*conn, std::move(plan));
+            ASSERT_TRUE(result->isSuccess());
+            checkResult(*result, expectedValues);
+        }
+    }
+
+private:
+    static void checkResult(QueryResult& result, const vector<int64_t>& expectedValues) {
+        ASSERT_TRUE(result.hasNext());
+        auto tuple = result.getNext();
+        for (auto i = 0u; i < expectedValues.size(); i++) {
+            ASSERT_EQ(tuple->getResultValue(i)->getInt64Val(), expectedValues[i]);
+        }
+        ASSERT_FALSE(result.hasNext());
+    }
+
+    static uint64_t getNumSpilledPartitions(nlohmann::json& op) {
+        auto numSpilledPartitions = 0ul;
+        if (op["name"] == "HASH_JOIN_PROBE") {
+            numSpilledPartitions += op["numSpilledPartitions"].get<uint64_t>();
+        }
+        for (auto& child : {"prev", "right"}) {
+            if (op.contains(child)) {
+                numSpilledPartitions += getNumSpilledPartitions(op[child]);
+            }
+        }
+        return numSpilledPartitions;
+    }
+};
+
+// The best plan joins the 10001 knows edges with all 66000 persons on the build side, which take 9
+// blocks together with their IDs. So the build side is spilled, and the probe tuples of all but the
+// resident partition are replayed after every probe thread has finished the resident partition.
+// Each partition takes a single block.
+class InnerHashJoinSpillingTests : public HashJoinSpillingTests {
+
+public:
+    string getInputCSVDir() override { return "dataset/read-list-tests/4-bytes-per-edge/"; }
+
+    void checkSpilledInnerJoin(uint64_t numThreads) {
+        auto query = "MATCH (a:person)-[:knows]->(b:person) RETURN COUNT(*), SUM(a.ID), SUM(b.ID)";
+        vector<int64_t> expectedValues{10001, 12502500, 37502500};
+        checkSpilledHashJoin(query, numThreads, expectedValues);
+        checkAllPlans(query, numThreads, expectedValues);
+    }
+};
+
+// The optional matches and the exists subqueries below are joined on both a and b, so their build
+// sides hold all 10001 knows edges, which take 2 blocks, without payloads that could prevent
+// spilling. Every edge matches itself in the same direction, and only the self loops p0->p0 and
+// p5000->p5000 match in the opposite direction. 4995 edges have an int64Prop, which sum up to
+// 12487500.
+class LeftAndMarkHashJoinSpillingTests : public HashJoinSpillingTests {
+
+public:
+    string getInputCSVDir() override { return "dataset/read-list-tests/2-bytes-per-edge/"; }
+
+    void checkSpilledLeftJoin(uint64_t numThreads) {
+        checkSpilledHashJoin("MATCH (a:person)-[:knows]->(b:person) OPTIONAL MATCH "
+                             "(a)-[r:knows]->(b) RETURN COUNT(*), COUNT(r.int64Prop), "
+                             "SUM(r.int64Prop)",
+            numThreads, vector<int64_t>{10001, 4995, 12487500});
+        checkSpilledHashJoin("MATCH (a:person)-[:knows]->(b:person) OPTIONAL MATCH "
+                             "(b)-[r:knows]->(a) RETURN COUNT(*), COUNT(r.int64Prop)",
+            numThreads, vector<int64_t>{10001, 0});
+    }
+
+    void checkSpilledMarkJoin(uint64_t numThreads) {
+        checkSpilledHashJoin("MATCH (a:person)-[:knows]->(b:person) WHERE EXISTS { MATCH "
+                             "(b)-[:knows]->(a) } RETURN COUNT(*)",
+            numThreads, vector<int64_t>{2});
+        checkSpilledHashJoin("MATCH (a:person)-[:knows]->(b:person) WHERE NOT EXISTS { MATCH "
+                             "(b)-[:knows]->(a) } RETURN COUNT(*)",
+            numThreads, vector<int64_t>{9999});
+    }
+};
+
+// Without any memory budget, every spilled partition exceeds the budget and is repartitioned until
+// one of its partitions holds a single build side tuple, which cannot be split any further.
+class HashJoinSpillingWithoutMemoryBudgetTests : public DBTest {
+
+public:
+    void SetUp() override {
+        DBTest::SetUp();
+        systemConfig->hashJoinBuildMemoryBudgetRatio = 0;
+        createDBAndConn();
+    }
+
+    string getInputCSVDir() override { return "dataset/read-list-tests/2-bytes-per-edge/"; }
+};
+
+TEST_F(InnerHashJoinSpillingTests, InnerHashJoinSpillingSingleThreadTest) {
+    checkSpilledInnerJoin(1 /* numThreads */);
+}
+
+TEST_F(InnerHashJoinSpillingTests, InnerHashJoinSpillingMultiThreadTest) {
+    checkSpilledInnerJoin(2 /* numThreads */);
+}
+
+// With more threads than the probe side has morsels, some threads are only accepted by the probe
+// task after the others have finished the resident partition.
+TEST_F(InnerHashJoinSpillingTests, InnerHashJoinSpillingManyThreadsTest) {
+    checkSpilledInnerJoin(16 /* numThreads */);
+}
+
+// A read-only database spills into a temporary directory of its own, so the database directory can
+// be read-only.
+TEST_F(InnerHashJoinSpillingTests, InnerHashJoinSpillingReadOnlyTest) {
+    conn.reset();
+    database.reset();
+    FileUtils::removeFileIfExists(
+        FileUtils::joinPath(TestHelper::TEMP_TEST_DIR, StorageConfig::WAL_FILE_SUFFIX));
+    filesystem::permissions(TestHelper::TEMP_TEST_DIR, filesystem::perms::owner_write,
+        filesystem::perm_options::remove);
+    databaseConfig->readOnlyMode = true;
+    createDBAndConn();
+    checkSpilledInnerJoin(2 /* numThreads */);
+    filesystem::permissions(TestHelper::TEMP_TEST_DIR, filesystem::perms::owner_write,
+        filesystem::perm_options::add);
+    ASSERT_FALSE(
+        FileUtils::fileOrPathExists(StorageUtils::getSpillDirPath(TestHelper::TEMP_TEST_DIR)));
+}
+
+TEST_F(LeftAndMarkHashJoinSpillingTests, LeftHashJoinSpillingSingleThreadTest) {
+    checkSpilledLeftJoin(1 /* numThreads */);
+}
+
+TEST_F(LeftAndMarkHashJoinSpillingTests, LeftHashJoinSpillingMultiThreadTest) {
+    checkSpilledLeftJoin(2 /* numThreads */);
+}
+
+TEST_F(LeftAndMarkHashJoinSpillingTests, MarkHashJoinSpillingSingleThreadTest) {
+    checkSpilledMarkJoin(1 /* numThreads */);
+}
+
+TEST_F(LeftAndMarkHashJoinSpillingTests, MarkHashJoinSpillingMultiThreadTest) {
+    checkSpilledMarkJoin(2 /* numThreads */);
+}
+
+TEST_F(HashJoinSpillingWithoutMemoryBudgetTests, RepartitionUntilSingleTupleFailsTest) {
+    auto result = conn->query("MATCH (a:person)-[:knows]->(b:person) WHERE EXISTS { MATCH "
+                              "(b)-[:knows]->(a) } RETURN COUNT(*)");
+    ASSERT_FALSE(result->isSuccess());
+    ASSERT_EQ(result->getErrorMessage(), "Runtime exception: A spilled partition of a hash join "
+                                         "exceeds the memory budget, but all of its keys have the "
+                                         "same hash.");
+}
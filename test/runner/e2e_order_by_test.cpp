@@ -16,3 +16,61 @@ TEST_F(OrderByTests, OrderByLargeDatasetTest) {
     }
     ASSERT_TRUE(TestHelper::testQueries(queryConfigs, *conn));
 }
+
+// With a large page buffer pool of 32 frames, ORDER BY may hold 16 blocks of keys and tuples in
+// memory. The 150000 tuples of the cross product below take about 30 blocks, so OrderBy spills them
+// in sorted runs while it appends them, and OrderByScan merges the runs.
+class OrderBySpillingTests : public DBTest {
+
+public:
+    void SetUp() override {
+        DBTest::SetUp();
+        systemConfig->largePageBufferPoolSize = 32 * LARGE_PAGE_SIZE;
+        createDBAndConn();
+    }
+
+    string getInputCSVDir() override { return "dataset/order-by-tests/"; }
+
+    void checkSpilledOrderBy(uint64_t numThreads) {
+        conn->setMaxNumThreadForExec(numThreads);
+        auto result = conn->query("PROFILE MATCH (a:person), (b:person) WHERE b.ID < 50 RETURN "
+                                  "a.balance, b.ID, a.ID ORDER BY a.balance, b.ID");
+        ASSERT_TRUE(result->isSuccess());
+        vector<bool> isPairSeen(3000 * 50, false);
+        auto numTuples = 0u;
+        int64_t prevBalance = INT64_MIN, prevBID = INT64_MIN;
+        while (result->hasNext()) {
+            auto tuple = result->getNext();
+            auto balance = tuple->getResultValue(0)->getInt64Val();
+            auto bID = tuple->getResultValue(1)->getInt64Val();
+            auto aID = tuple->getResultValue(2)->getInt64Val();
+            ASSERT_TRUE(balance > prevBalance || (balance == prevBalance && bID >= prevBID));
+            ASSERT_FALSE(isPairSeen[aID * 50 + bID]);
+            isPairSeen[aID * 50 + bID] = true;
+            prevBalance = balance;
+            prevBID = bID;
+            numTuples++;
+        }
+        ASSERT_EQ(numTuples, 3000u * 50);
+        function<nlohmann::json*(nlohmann::json&)> findOrderByScan =
+            [&](nlohmann::json& op) -> nlohmann::json* {
+            if (op["name"] == "ORDER_BY_SCAN") {
+                return &op;
+            }
+            return op.contains("prev") ? findOrderByScan(op["prev"]) : nullptr;
+        };
+        auto plan = result->getQuerySummary()->printPlanToJson();
+        auto orderByScan = findOrderByScan(plan);
+        ASSERT_NE(orderByScan, nullptr);
+        // At least one run is spilled while tuples are appended, and one after all of them are.
+        ASSERT_GE((*orderByScan)["numSpilledRuns"].get<uint64_t>(), 2u);
+    }
+};
+
+TEST_F(OrderBySpillingTests, OrderBySpillingSingleThreadTest) {
+    checkSpilledOrderBy(1 /* numThreads */);
+}
+
+TEST_F(OrderBySpillingTests, OrderBySpillingMultiThreadTest) {
+    checkSpilledOrderBy(2 /* numThreads */);
+}
@@ -3,6 +3,10 @@
 using ::testing::Test;
 using namespace kuzu::testing;
 
+class BoolColumnReadTest : public DBTest {
+    string getInputCSVDir() override { return "dataset/copy-csv-bool-test/"; }
+};
+
 class LongStringPKTest : public DBTest {
     string getInputCSVDir() override { return "dataset/long-string-pk-tests/"; }
 };
@@ -12,6 +16,10 @@ public:
     string getInputCSVDir() override { return "dataset/tinysnb/"; }
 };
 
+TEST_F(BoolColumnReadTest, BoolColumnReadTest) {
+    runTest("test/test_files/bool_column/bool_column.test");
+}
+
 TEST_F(LongStringPKTest, LongStringPKTest) {
     runTest("test/test_files/long_string_pk/long_string_pk.test");
 }
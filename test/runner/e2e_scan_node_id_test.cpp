@@ -0,0 +1,77 @@
+#include "test/test_utility/include/test_helper.h"
+
+using namespace kuzu::testing;
+
+// The 66000 persons span 33 morsels, so 4 threads claim batches of several morsels at the start of
+// a scan and single morsels towards its end. Edges only connect persons with IDs up to 5000.
+class ScanNodeIDMorselTest : public DBTest {
+
+public:
+    string getInputCSVDir() override { return "dataset/read-list-tests/4-bytes-per-edge/"; }
+
+    // Runs the best plan with profiling and all plans without, and checks that every morsel of each
+    // node ID scan has been claimed exactly once and that the result is as expected.
+    void checkMorselsScannedOnce(const string& query, const vector<int64_t>& expectedValues,
+        bool expectSemiMasker) {
+        conn->setMaxNumThreadForExec(NUM_THREADS);
+        auto result = conn->query("PROFILE " + query);
+        ASSERT_TRUE(result->isSuccess());
+        checkResult(*result, expectedValues);
+        auto& plan = result->getQuerySummary()->printPlanToJson();
+        auto numScanNodeIDs = 0u;
+        auto hasSemiMasker = false;
+        std::function<void(nlohmann::json&)> checkOperator = [&](nlohmann::json& op) {
+            if (op["name"] == "SCAN_NODE_ID") {
+                numScanNodeIDs++;
+                ASSERT_EQ(op["numMorsels"].get<uint64_t>(), NUM_MORSELS);
+                ASSERT_TRUE(op.contains("morselClaimTime"));
+            }
+            hasSemiMasker |= op["name"] == "SEMI_MASKER";
+            for (auto& child : {"prev", "right"}) {
+                if (op.contains(child)) {
+                    checkOperator(op[child]);
+                }
+            }
+        };
+        checkOperator(plan);
+        ASSERT_GT(numScanNodeIDs, 0u);
+        ASSERT_EQ(hasSemiMasker, expectSemiMasker);
+        auto planString = result->getQuerySummary()->getPlanAsOstream().str();
+        ASSERT_NE(planString.find("NumMorsels: " + to_string(NUM_MORSELS)), string::npos);
+        ASSERT_NE(planString.find("MorselClaimTime: "), string::npos);
+        for (auto& logicalPlan : enumeratePlans(*conn, query)) {
+            auto planResult = executePlan(*conn, std::move(logicalPlan));
+            ASSERT_TRUE(planResult->isSuccess());
+            checkResult(*planResult, expectedValues);
+        }
+    }
+
+private:
+    static void checkResult(QueryResult& result, const vector<int64_t>& expectedValues) {
+        ASSERT_TRUE(result.hasNext());
+        auto tuple = result.getNext();
+        for (auto i = 0u; i < expectedValues.size(); i++) {
+            ASSERT_EQ(tuple->getResultValue(i)->getInt64Val(), expectedValues[i]);
+        }
+        ASSERT_FALSE(result.hasNext());
+    }
+
+private:
+    static constexpr uint64_t NUM_THREADS = 4;
+    static constexpr uint64_t NUM_MORSELS = 33;
+};
+
+// The zone maps of the ID column rule out all but the morsels 14 to 19.
+TEST_F(ScanNodeIDMorselTest, ZoneMapPredicatesTest) {
+    checkMorselsScannedOnce(
+        "MATCH (a:person) WHERE a.ID >= 30000 AND a.ID < 40000 RETURN COUNT(*), SUM(a.ID)",
+        vector<int64_t>{10000, 349995000}, false /* expectSemiMasker */);
+}
+
+// The node ID scan on the build side of the hash join is masked by the nodes reached from the
+// probe side, e.g. the morsels 0 to 2 for b, and its zone map predicate rules out further morsels.
+TEST_F(ScanNodeIDMorselTest, SemiMaskAndZoneMapPredicatesTest) {
+    checkMorselsScannedOnce("MATCH (a:person)-[:knows]->(b:person) WHERE a.ID < 1000 AND "
+                            "b.ID >= 4096 RETURN COUNT(*), SUM(b.ID)",
+        vector<int64_t>{1904, 9110940}, true /* expectSemiMasker */);
+}
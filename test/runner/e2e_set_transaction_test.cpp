@@ -1,5 +1,8 @@
 #include "test/test_utility/include/test_helper.h"
 
+#include "src/storage/include/storage_utils.h"
+#include "src/storage/storage_structure/include/zone_map.h"
+
 using namespace kuzu::testing;
 
 // Test manual transaction. Auto transaction is tested in update test.
@@ -46,6 +49,29 @@ public:
         ASSERT_EQ(result->getNext()->getResultValue(0)->getStringVal(),
             "abcdefghijklmnopqrstuvwxyz" + to_string(numWriteQueries + 2));
     }
+
+    // The ages of persons are at most 83, so setting an age to 200 widens the zone of its page in
+    // the zone map of the age column, which must be in the zone map file after checkpointing.
+    void testWidenZoneMapAndCommit(TransactionTestType transactionTestType) {
+        conn->beginWriteTransaction();
+        conn->query("MATCH (a:person) WHERE a.ID = 0 SET a.age = 200;");
+        commitOrRollbackConnection(true /* isCommit */, transactionTestType);
+        if (transactionTestType == TransactionTestType::RECOVERY) {
+            // This creates a new database, which checkpoints the WAL when it recovers.
+            createDBAndConn();
+        }
+        auto catalog = getCatalog(*database)->getReadOnlyVersion();
+        auto tableID = catalog->getNodeTableIDFromName("person");
+        auto propertyID = catalog->getNodeProperty(tableID, "age").propertyID;
+        auto zoneMap = ZoneMap::readFromFileIfExists(
+            INT64, StorageUtils::getZoneMapFName(StorageUtils::getNodePropertyColumnFName(
+                       databaseConfig->databasePath, tableID, propertyID, DBFileType::ORIGINAL)));
+        ASSERT_NE(zoneMap, nullptr);
+        ASSERT_TRUE(zoneMap->mayMatch(
+            0 /* startPageIdx */, 0 /* endPageIdx */, GREATER_THAN, Literal((int64_t)100)));
+        auto result = conn->query("MATCH (a:person) WHERE a.age > 100 RETURN a.ID");
+        ASSERT_EQ(TestHelper::convertResultToString(*result), vector<string>{"0"});
+    }
 };
 
 TEST_F(SetNodeStructuredPropTransactionTest,
@@ -118,6 +144,14 @@ TEST_F(SetNodeStructuredPropTransactionTest, Concurrent1Write1ReadTransactionCom
         readConn.get(), 0 /* node offset */, "fName", vector<string>{"abcdefghijklmnopqrstuvwxyz"});
 }
 
+TEST_F(SetNodeStructuredPropTransactionTest, WidenZoneMapCommitNormalExecution) {
+    testWidenZoneMapAndCommit(TransactionTestType::NORMAL_EXECUTION);
+}
+
+TEST_F(SetNodeStructuredPropTransactionTest, WidenZoneMapCommitRecovery) {
+    testWidenZoneMapAndCommit(TransactionTestType::RECOVERY);
+}
+
 TEST_F(SetNodeStructuredPropTransactionTest, Concurrent1Write1ReadTransactionRollback) {
     conn->beginWriteTransaction();
     readConn->beginReadOnlyTransaction();
@@ -17,6 +17,34 @@ public:
     }
 };
 
+// Bool columns are bit-packed with 16384 values per page, so nodes 16383 and 16384 are stored in
+// different pages. Instead of checking in a CSV file of that size, the test generates the nodes of
+// dataset/copy-csv-bool-test for 40000 IDs, which span 3 pages, into the database directory.
+class BoolColumnUpdateTest : public DBTest {
+public:
+    static constexpr uint64_t NUM_NODES = 40000;
+
+    string getInputCSVDir() override { return "dataset/copy-csv-bool-test/"; }
+
+    void SetUp() override {
+        BaseGraphTest::SetUp();
+        createDBAndConn();
+        auto csvPath = string(TestHelper::TEMP_TEST_DIR) + "vPerson.csv";
+        ofstream csvFile(csvPath);
+        for (auto i = 0u; i < NUM_NODES; i++) {
+            csvFile << i << "," << (i % 7 == 3 ? "" : (i % 3 == 0 ? "true" : "false")) << "\n";
+        }
+        csvFile.close();
+        TestHelper::executeCypherScript(getInputCSVDir() + TestHelper::SCHEMA_FILE_NAME, *conn);
+        ASSERT_TRUE(conn->query("COPY person FROM \"" + csvPath + "\"")->isSuccess());
+    }
+
+    vector<string> readIsActiveAroundFirstPageBoundary() {
+        return TestHelper::convertResultToString(*conn->query(
+            "MATCH (a:person) WHERE a.ID >= 16381 AND a.ID <= 16386 RETURN a.ID, a.isActive"));
+    }
+};
+
 // SET clause tests
 
 TEST_F(TinySnbUpdateTest, SetNodeIntPropTest) {
@@ -406,3 +434,41 @@ TEST_F(TinySnbUpdateTest, MixedDeleteInsertTest) {
     groundTruth = vector<string>{"33|"};
     ASSERT_EQ(TestHelper::convertResultToString(*result), groundTruth);
 }
+
+// The update tests below rely on reads across the pages, which are checked on their own here.
+TEST_F(BoolColumnUpdateTest, ReadBoolPropAcrossPageBoundariesTest) {
+    runTest("test/test_files/bool_column/bool_column_page_boundaries.test");
+}
+
+TEST_F(BoolColumnUpdateTest, SetBoolPropAcrossPageBoundaryTest) {
+    // Before the update, nodes 16381 to 16386 are: False, False, NULL, False, False, True.
+    auto groundTruth = vector<string>{
+        "16381|True", "16382|False", "16383|True", "16384|True", "16385|False", "16386|"};
+    conn->beginWriteTransaction();
+    conn->query("MATCH (a:person) WHERE a.ID = 16381 OR a.ID = 16383 OR a.ID = 16384 "
+                "SET a.isActive = true");
+    conn->query("MATCH (a:person) WHERE a.ID = 16386 SET a.isActive = null");
+    ASSERT_EQ(readIsActiveAroundFirstPageBoundary(), groundTruth);
+    conn->commit();
+    ASSERT_EQ(readIsActiveAroundFirstPageBoundary(), groundTruth);
+    // Bits of the other values in the updated pages must not change.
+    auto result = conn->query("MATCH (a:person) WHERE a.isActive = true RETURN COUNT(*)");
+    ASSERT_EQ(result->getNext()->getResultValue(0)->getInt64Val(), 11429 + 3 - 1);
+    result = conn->query("MATCH (a:person) WHERE a.isActive IS NULL RETURN COUNT(*)");
+    ASSERT_EQ(result->getNext()->getResultValue(0)->getInt64Val(), 5714 - 1 + 1);
+    result = conn->query("MATCH (a:person) WHERE a.ID = 16383 RETURN a.isActive");
+    ASSERT_EQ(result->getNext()->getResultValue(0)->getBooleanVal(), true);
+}
+
+TEST_F(BoolColumnUpdateTest, SetBoolPropToFalseAcrossPageBoundaryTest) {
+    auto groundTruth = vector<string>{
+        "16381|False", "16382|False", "16383|False", "16384|False", "16385|False", "16386|False"};
+    conn->beginWriteTransaction();
+    conn->query(
+        "MATCH (a:person) WHERE a.ID >= 16381 AND a.ID <= 16386 SET a.isActive = false");
+    ASSERT_EQ(readIsActiveAroundFirstPageBoundary(), groundTruth);
+    conn->rollback();
+    groundTruth = vector<string>{
+        "16381|False", "16382|False", "16383|", "16384|False", "16385|False", "16386|True"};
+    ASSERT_EQ(readIsActiveAroundFirstPageBoundary(), groundTruth);
+}
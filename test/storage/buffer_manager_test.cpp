@@ -39,3 +39,150 @@ TEST_F(BufferManagerTests, RemoveFilePagesFromFramesTest) {
     }
     delete bufferManager;
 }
+
+TEST_F(BufferManagerTests, PrefetchDoesNotPinPagesTest) {
+    FileHandle fileHandle(string(TestHelper::TEMP_TEST_DIR) + "bm_test.bin",
+        FileHandle::O_PERSISTENT_FILE_CREATE_NOT_EXISTS);
+    uint64_t numPagesToAdd = 100;
+    for (auto pageIdx = 0u; pageIdx < numPagesToAdd; ++pageIdx) {
+        fileHandle.addNewPage();
+    }
+    auto bufferManager =
+        make_unique<BufferManager>(StorageConfig::DEFAULT_BUFFER_POOL_SIZE_FOR_TESTING);
+    auto getNumPrefetchedPages = [&]() {
+        return (*bufferManager->debugInfo())["BufferManager"]
+                                             ["BufferPoolDefaultPages-numPrefetchedPages"]
+                                                 .get<uint64_t>();
+    };
+    bufferManager->pinWithoutReadingFromFile(fileHandle, 10);
+    // Ranges that contain pages in frames and pages beyond the end of the file are allowed. Only
+    // the pages of the file that are not in frames are prefetched.
+    bufferManager->prefetch(fileHandle, 0 /* startPageIdx */, numPagesToAdd + 10);
+    ASSERT_EQ(getNumPrefetchedPages(), numPagesToAdd - 1);
+    bufferManager->prefetch(fileHandle, numPagesToAdd + 1 /* startPageIdx */, 10);
+    ASSERT_EQ(getNumPrefetchedPages(), numPagesToAdd - 1);
+    bufferManager->prefetch(fileHandle, 5 /* startPageIdx */, 10);
+    ASSERT_EQ(getNumPrefetchedPages(), numPagesToAdd - 1 + 9);
+    for (auto pageIdx = 0u; pageIdx < numPagesToAdd; ++pageIdx) {
+        ASSERT_EQ(FileHandle::isAFrame(fileHandle.getFrameIdx(pageIdx)), pageIdx == 10);
+    }
+    bufferManager->unpin(fileHandle, 10);
+    bufferManager->removeFilePagesFromFrames(fileHandle);
+}
+
+TEST_F(BufferManagerTests, ConcurrentPinAndUnpinWithEvictionsTest) {
+    FileHandle fileHandle(string(TestHelper::TEMP_TEST_DIR) + "bm_test.bin",
+        FileHandle::O_PERSISTENT_FILE_CREATE_NOT_EXISTS);
+    uint64_t numPagesToAdd = 2000;
+    for (auto pageIdx = 0u; pageIdx < numPagesToAdd; ++pageIdx) {
+        fileHandle.addNewPage();
+    }
+    // Write each page's index into its first byte through a buffer manager that can hold all
+    // pages, and then flush them to the file.
+    auto bufferManager = make_unique<BufferManager>(numPagesToAdd * DEFAULT_PAGE_SIZE, 0);
+    for (auto pageIdx = 0u; pageIdx < numPagesToAdd; ++pageIdx) {
+        auto frame = bufferManager->pinWithoutReadingFromFile(fileHandle, pageIdx);
+        frame[0] = (uint8_t)pageIdx;
+        bufferManager->setPinnedPageDirty(fileHandle, pageIdx);
+        bufferManager->unpin(fileHandle, pageIdx);
+    }
+    bufferManager->flushAllDirtyPagesInFrames(fileHandle);
+    // Read the pages concurrently through a buffer manager that can hold only a quarter of them,
+    // so optimistic pins race with evictions.
+    bufferManager = make_unique<BufferManager>(numPagesToAdd / 4 * DEFAULT_PAGE_SIZE, 0);
+    atomic<uint64_t> numWrongPages{0};
+    vector<thread> threads;
+    for (auto threadIdx = 0u; threadIdx < 8; ++threadIdx) {
+        threads.emplace_back([&, threadIdx]() {
+            for (auto i = 0u; i < 20000; ++i) {
+                auto pageIdx = (i * 7919 + threadIdx * 104729) % numPagesToAdd;
+                auto frame = bufferManager->pin(fileHandle, pageIdx);
+                if (frame[0] != (uint8_t)pageIdx) {
+                    numWrongPages++;
+                }
+                bufferManager->unpin(fileHandle, pageIdx);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(numWrongPages.load(), 0u);
+    bufferManager->removeFilePagesFromFrames(fileHandle);
+}
+
+TEST_F(BufferManagerTests, RemoveFilePagesFromFramesWaitsForPinnedPagesTest) {
+    FileHandle fileHandle(string(TestHelper::TEMP_TEST_DIR) + "bm_test.bin",
+        FileHandle::O_PERSISTENT_FILE_CREATE_NOT_EXISTS);
+    uint64_t numPagesToAdd = 20;
+    for (auto pageIdx = 0u; pageIdx < numPagesToAdd; ++pageIdx) {
+        fileHandle.addNewPage();
+    }
+    auto bufferManager =
+        make_unique<BufferManager>(StorageConfig::DEFAULT_BUFFER_POOL_SIZE_FOR_TESTING);
+    bufferManager->pinWithoutReadingFromFile(fileHandle, 10);
+    // A reader that still holds the page unpins it while its frame is being removed.
+    thread reader([&]() {
+        this_thread::sleep_for(chrono::milliseconds(50));
+        bufferManager->unpin(fileHandle, 10);
+    });
+    bufferManager->removeFilePagesFromFrames(fileHandle);
+    reader.join();
+    for (auto pageIdx = 0u; pageIdx < numPagesToAdd; ++pageIdx) {
+        ASSERT_FALSE(FileHandle::isAFrame(fileHandle.getFrameIdx(pageIdx)));
+    }
+}
+
+TEST_F(BufferManagerTests, Clock2QKeepsRepeatedlyAccessedPagesDuringScanTest) {
+    FileHandle fileHandle(string(TestHelper::TEMP_TEST_DIR) + "bm_test.bin",
+        FileHandle::O_PERSISTENT_FILE_CREATE_NOT_EXISTS);
+    uint64_t numPagesToAdd = 200;
+    for (auto pageIdx = 0u; pageIdx < numPagesToAdd; ++pageIdx) {
+        fileHandle.addNewPage();
+    }
+    uint64_t numFrames = 64;
+    uint64_t numHotPages = 10;
+    for (auto replacementPolicy :
+        {BufferPoolReplacementPolicy::CLOCK, BufferPoolReplacementPolicy::CLOCK_2Q}) {
+        auto bufferManager =
+            make_unique<BufferManager>(numFrames * DEFAULT_PAGE_SIZE, 0, replacementPolicy);
+        for (auto i = 0u; i < 4; ++i) {
+            for (auto pageIdx = 0u; pageIdx < numHotPages; ++pageIdx) {
+                bufferManager->pinWithoutReadingFromFile(fileHandle, pageIdx);
+                bufferManager->unpin(fileHandle, pageIdx);
+            }
+        }
+        // Scan more pages than there are frames, pinning each page once.
+        for (auto pageIdx = numHotPages; pageIdx < numHotPages + 2 * numFrames; ++pageIdx) {
+            bufferManager->pinWithoutReadingFromFile(fileHandle, pageIdx);
+            bufferManager->unpin(fileHandle, pageIdx);
+        }
+        for (auto pageIdx = 0u; pageIdx < numHotPages; ++pageIdx) {
+            ASSERT_EQ(FileHandle::isAFrame(fileHandle.getFrameIdx(pageIdx)),
+                replacementPolicy == BufferPoolReplacementPolicy::CLOCK_2Q);
+        }
+        bufferManager->removeFilePagesFromFrames(fileHandle);
+    }
+}
+
+TEST_F(BufferManagerTests, Clock2QEvictsWhenAllUnpinnedPagesAreHotTest) {
+    FileHandle fileHandle(string(TestHelper::TEMP_TEST_DIR) + "bm_test.bin",
+        FileHandle::O_PERSISTENT_FILE_CREATE_NOT_EXISTS);
+    uint64_t numFrames = 64;
+    for (auto pageIdx = 0u; pageIdx <= numFrames; ++pageIdx) {
+        fileHandle.addNewPage();
+    }
+    auto bufferManager = make_unique<BufferManager>(
+        numFrames * DEFAULT_PAGE_SIZE, 0, BufferPoolReplacementPolicy::CLOCK_2Q);
+    // Fill every frame with a page whose recentAccessCount reaches its maximum.
+    for (auto i = 0u; i < StorageConfig::CLOCK_2Q_MAX_RECENT_ACCESS_COUNT + 2; ++i) {
+        for (auto pageIdx = 0u; pageIdx < numFrames; ++pageIdx) {
+            bufferManager->pinWithoutReadingFromFile(fileHandle, pageIdx);
+            bufferManager->unpin(fileHandle, pageIdx);
+        }
+    }
+    bufferManager->pinWithoutReadingFromFile(fileHandle, numFrames);
+    ASSERT_TRUE(FileHandle::isAFrame(fileHandle.getFrameIdx(numFrames)));
+    bufferManager->unpin(fileHandle, numFrames);
+    bufferManager->removeFilePagesFromFrames(fileHandle);
+}
@@ -305,6 +305,39 @@ TEST_F(DiskArrayUpdateTests, PushBackEnoughToFillTwoPIPsTestRollbackRecovery) {
         2 * 1023 * 1024 /* size after first batch */);
 }
 
+// Batched gets must read the same values as single gets, both of array pages that only have an
+// original version and of array pages that have been updated or added by the write transaction.
+TEST_F(DiskArrayUpdateTests, BatchedGetTest) {
+    setNodeOffset0ToEmptyListToTriggerCheckpointOrRecoveryMechanism();
+    auto headersDA = personNodeTable->getUnstrPropertyLists()->getHeaders()->headersDiskArray.get();
+    for (uint32_t nodeOffset = 500; nodeOffset <= 999; ++nodeOffset) {
+        headersDA->update(nodeOffset, nodeOffset);
+    }
+    for (uint32_t arrayOff = 1000; arrayOff < 1025; ++arrayOff) {
+        headersDA->pushBack(arrayOff);
+    }
+    // The indices are sorted and contain duplicates, as the keys looked up by the hash index.
+    vector<uint64_t> idxs;
+    for (uint64_t idx = 0; idx < 1025; idx += 3) {
+        idxs.push_back(idx);
+        if (idx % 2 == 0) {
+            idxs.push_back(idx);
+        }
+    }
+    vector<uint32_t> values(idxs.size());
+    headersDA->get(idxs, values.data(), TransactionType::WRITE);
+    for (auto i = 0u; i < idxs.size(); ++i) {
+        ASSERT_EQ(headersDA->get(idxs[i], TransactionType::WRITE), values[i]);
+    }
+    // The read only transaction does not see the pushed back elements.
+    idxs.erase(remove_if(idxs.begin(), idxs.end(), [](uint64_t idx) { return idx >= 1000; }),
+        idxs.end());
+    headersDA->get(idxs, values.data(), TransactionType::READ_ONLY);
+    for (auto i = 0u; i < idxs.size(); ++i) {
+        ASSERT_EQ(0, values[i]);
+    }
+}
+
 TEST_F(DiskArrayUpdateEmptyDBTests, EmptyDiskArrayUpdatesTest) {
     auto headers = personNodeTable->getUnstrPropertyLists()->getHeaders()->headersDiskArray.get();
     ASSERT_EQ(0, headers->getNumElements(TransactionType::READ_ONLY));
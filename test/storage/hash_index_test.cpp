@@ -0,0 +1,322 @@
+#include "test/test_utility/include/test_helper.h"
+
+#include "src/storage/include/wal_replayer.h"
+#include "src/storage/index/include/hash_index.h"
+
+using namespace kuzu::storage;
+using namespace kuzu::testing;
+
+namespace kuzu {
+namespace storage {
+
+// Builds the primary key index of a node table and updates it in write transactions. Each write
+// transaction is committed by replaying the WAL into the index file, after which the index is
+// opened again, as it would be after a restart.
+class HashIndexTest : public Test {
+
+public:
+    void SetUp() override {
+        FileUtils::createDir(TestHelper::TEMP_TEST_DIR);
+        bufferManager = make_unique<BufferManager>(
+            StorageConfig::DEFAULT_BUFFER_POOL_SIZE_FOR_TESTING, 0 /* largePageBufferPoolSize */);
+        wal = make_unique<WAL>(TestHelper::TEMP_TEST_DIR, *bufferManager);
+    }
+
+    void TearDown() override {
+        closeIndex();
+        wal.reset();
+        FileUtils::removeDir(TestHelper::TEMP_TEST_DIR);
+    }
+
+    void openIndex(DataTypeID keyDataTypeID) {
+        index = make_unique<PrimaryKeyIndex>(
+            StorageUtils::getNodeIndexIDAndFName(TestHelper::TEMP_TEST_DIR, 0 /* tableID */),
+            DataType(keyDataTypeID), *bufferManager, wal.get());
+    }
+
+    void closeIndex() {
+        if (index == nullptr) {
+            return;
+        }
+        bufferManager->removeFilePagesFromFrames(*index->getFileHandle());
+        if (index->getDiskOverflowFile() != nullptr) {
+            bufferManager->removeFilePagesFromFrames(
+                *index->getDiskOverflowFile()->getFileHandle());
+        }
+        index.reset();
+    }
+
+    void commitAndReopenIndex(DataTypeID keyDataTypeID) {
+        index->prepareCommitOrRollbackIfNecessary(true /* isCommit */);
+        wal->logCommit(0 /* transactionID */);
+        wal->flushAllPages();
+        // The index is opened again instead of being checkpointed in memory, so the WAL replayer
+        // does not need to find the index in a node table.
+        wal->updatedNodeTables.clear();
+        WALReplayer walReplayer(wal.get());
+        walReplayer.replay();
+        wal->clearWAL();
+        closeIndex();
+        openIndex(keyDataTypeID);
+    }
+
+    static string getIndexFName() {
+        return StorageUtils::getNodeIndexFName(
+            TestHelper::TEMP_TEST_DIR, 0 /* tableID */, DBFileType::ORIGINAL);
+    }
+
+    // Returns keys whose hashes have the given bits under the mask. Keys whose hashes agree on
+    // their lower bits share a primary slot and those that agree on their most significant byte
+    // share a fingerprint.
+    template<typename T>
+    static vector<T> getKeysWithHashBits(
+        hash_t mask, hash_t bits, uint64_t numKeys, const std::function<T(int64_t)>& getKey) {
+        vector<T> keys;
+        for (auto i = 0l; keys.size() < numKeys; i++) {
+            auto key = getKey(i);
+            hash_t hash;
+            function::operation::Hash::operation(key, hash);
+            if ((hash & mask) == bits) {
+                keys.push_back(key);
+            }
+        }
+        return keys;
+    }
+
+public:
+    // Keys of hashes with the same lower byte share a primary slot while there are at most 256
+    // pSlots. The fingerprint is the most significant byte of the hash.
+    static constexpr hash_t SLOT_MASK = 0xFF;
+    static constexpr hash_t FINGERPRINT_AND_SLOT_MASK = 0xFF000000000000FF;
+    unique_ptr<BufferManager> bufferManager;
+    unique_ptr<WAL> wal;
+    unique_ptr<PrimaryKeyIndex> index;
+};
+
+class HashIndexInt64Test : public HashIndexTest {
+
+public:
+    void build(const vector<int64_t>& keys) {
+        HashIndexBuilder<int64_t> builder(getIndexFName(), DataType(INT64));
+        builder.bulkReserve(keys.size());
+        for (auto key : keys) {
+            ASSERT_TRUE(builder.append(key, getValue(key)));
+            expectedValues[key] = getValue(key);
+        }
+        builder.flush();
+        openIndex(INT64);
+    }
+
+    void insert(int64_t key, node_offset_t value) {
+        ASSERT_TRUE(index->insert(key, value));
+        expectedValues[key] = value;
+    }
+
+    void deleteKey(int64_t key) {
+        index->deleteKey(key);
+        expectedValues.erase(key);
+    }
+
+    // Looks up every expected key and the given keys that do not exist both one by one and in a
+    // single batch.
+    void checkLookups(const vector<int64_t>& nonExistingKeys) {
+        auto trx = Transaction::getDummyReadOnlyTrx();
+        vector<const uint8_t*> keys;
+        node_offset_t result;
+        for (auto& [key, value] : expectedValues) {
+            ASSERT_TRUE(index->lookup(trx.get(), key, result));
+            ASSERT_EQ(result, value);
+            keys.push_back(reinterpret_cast<const uint8_t*>(&key));
+        }
+        for (auto& key : nonExistingKeys) {
+            ASSERT_FALSE(index->lookup(trx.get(), key, result));
+            keys.push_back(reinterpret_cast<const uint8_t*>(&key));
+        }
+        vector<node_offset_t> results(keys.size());
+        auto isFound = make_unique<bool[]>(keys.size());
+        index->hashIndexForInt64->lookupInternal(trx.get(), keys, results.data(), isFound.get());
+        for (auto keyIdx = 0u; keyIdx < keys.size(); keyIdx++) {
+            auto key = *reinterpret_cast<const int64_t*>(keys[keyIdx]);
+            ASSERT_EQ(isFound[keyIdx], keyIdx < expectedValues.size());
+            if (isFound[keyIdx]) {
+                ASSERT_EQ(results[keyIdx], expectedValues.at(key));
+            }
+        }
+    }
+
+    static vector<int64_t> getKeysWithHashBits(hash_t mask, hash_t bits, uint64_t numKeys) {
+        // Start far from the filler keys, so that the keys do not overlap.
+        return HashIndexTest::getKeysWithHashBits<int64_t>(
+            mask, bits, numKeys, [](int64_t i) { return NUM_FILLER_KEYS + i; });
+    }
+
+    static vector<int64_t> getFillerKeys(int64_t startKey, uint64_t numKeys) {
+        vector<int64_t> keys(numKeys);
+        iota(keys.begin(), keys.end(), startKey);
+        return keys;
+    }
+
+    static vector<int64_t> concat(vector<int64_t> left, const vector<int64_t>& right) {
+        left.insert(left.end(), right.begin(), right.end());
+        return left;
+    }
+
+    static inline node_offset_t getValue(int64_t key) { return key * 2; }
+
+public:
+    static constexpr int64_t NUM_FILLER_KEYS = 1000;
+    static constexpr uint64_t NUM_KEYS_IN_CHAIN = 100;
+    map<int64_t, node_offset_t> expectedValues;
+};
+
+class HashIndexStringTest : public HashIndexTest {
+
+public:
+    // Keys are longer than ku_string_t::SHORT_STR_LENGTH, so the index compares their prefixes and
+    // reads them from the overflow file if the prefixes are equal.
+    static string getKey(int64_t i) { return "a-long-string-key-" + to_string(i); }
+
+    void build(const vector<string>& keys) {
+        HashIndexBuilder<ku_string_t> builder(getIndexFName(), DataType(STRING));
+        builder.bulkReserve(keys.size());
+        for (auto i = 0u; i < keys.size(); i++) {
+            ASSERT_TRUE(builder.append(keys[i].c_str(), i));
+            expectedValues[keys[i]] = i;
+        }
+        builder.flush();
+        openIndex(STRING);
+    }
+
+    void insert(const string& key, node_offset_t value) {
+        ASSERT_TRUE(index->insert(key.c_str(), value));
+        expectedValues[key] = value;
+    }
+
+    void checkLookups(const vector<string>& nonExistingKeys) {
+        auto trx = Transaction::getDummyReadOnlyTrx();
+        node_offset_t result;
+        for (auto& [key, value] : expectedValues) {
+            ASSERT_TRUE(index->lookup(trx.get(), key.c_str(), result));
+            ASSERT_EQ(result, value);
+        }
+        for (auto& key : nonExistingKeys) {
+            ASSERT_FALSE(index->lookup(trx.get(), key.c_str(), result));
+        }
+    }
+
+public:
+    map<string, node_offset_t> expectedValues;
+};
+
+} // namespace storage
+} // namespace kuzu
+
+// Keys with the same fingerprint in the same slot are told apart by comparing the keys.
+TEST_F(HashIndexInt64Test, KeysWithSameFingerprintInSlotTest) {
+    auto keys = getKeysWithHashBits(FINGERPRINT_AND_SLOT_MASK, 0 /* bits */, 3 /* numKeys */);
+    build(concat(getFillerKeys(0 /* startKey */, NUM_FILLER_KEYS), {keys[0], keys[1]}));
+    checkLookups({keys[2]});
+    deleteKey(keys[0]);
+    insert(keys[2], 1);
+    commitAndReopenIndex(INT64);
+    checkLookups({keys[0]});
+}
+
+TEST_F(HashIndexInt64Test, OverflowChainTest) {
+    auto keys = getKeysWithHashBits(SLOT_MASK, 0 /* bits */, 2 * NUM_KEYS_IN_CHAIN);
+    auto keysInChain = vector<int64_t>(keys.begin(), keys.begin() + NUM_KEYS_IN_CHAIN);
+    auto keysNotInChain = vector<int64_t>(keys.begin() + NUM_KEYS_IN_CHAIN, keys.end());
+    build(concat(getFillerKeys(0 /* startKey */, NUM_FILLER_KEYS), keysInChain));
+    auto statistics = index->getSlotChainStatistics(TransactionType::READ_ONLY);
+    ASSERT_GE(statistics.maxNumOverflowSlotsInChain,
+        (NUM_KEYS_IN_CHAIN + Slot<int64_t>::CAPACITY - 1) / Slot<int64_t>::CAPACITY - 1);
+    // Lookups of keys that are not in the chain walk the whole chain.
+    checkLookups(keysNotInChain);
+}
+
+// The builder keeps the overflow slots of each partition apart until it flushes the index, when it
+// lays them out one partition after another and updates the chains to point to their final ids.
+TEST_F(HashIndexInt64Test, OverflowChainsInSeveralBuildPartitionsTest) {
+    auto keys = getFillerKeys(0 /* startKey */, NUM_FILLER_KEYS);
+    vector<int64_t> keysNotInChains;
+    auto numChains = 8u;
+    for (auto i = 0u; i < numChains; i++) {
+        // The keys of the chains fall into the pSlots 0, 16, ..., 112 of different partitions.
+        auto keysOfChain = getKeysWithHashBits(SLOT_MASK, i << 4 /* bits */, NUM_KEYS_IN_CHAIN);
+        keys.insert(keys.end(), keysOfChain.begin(), keysOfChain.begin() + NUM_KEYS_IN_CHAIN / 2);
+        keysNotInChains.insert(
+            keysNotInChains.end(), keysOfChain.begin() + NUM_KEYS_IN_CHAIN / 2, keysOfChain.end());
+    }
+    build(keys);
+    auto statistics = index->getSlotChainStatistics(TransactionType::READ_ONLY);
+    ASSERT_GE(statistics.numPrimarySlotsWithOverflowSlots, numChains);
+    ASSERT_GE(statistics.numOverflowSlots,
+        numChains * (NUM_KEYS_IN_CHAIN / 2 / Slot<int64_t>::CAPACITY));
+    checkLookups(keysNotInChains);
+}
+
+// Deleted entries keep their fingerprints, which must not match, and are reused by insertions.
+TEST_F(HashIndexInt64Test, DeleteAndReinsertInSlotTest) {
+    auto keys = getKeysWithHashBits(SLOT_MASK, 0 /* bits */, NUM_KEYS_IN_CHAIN);
+    build(concat(getFillerKeys(0 /* startKey */, NUM_FILLER_KEYS), keys));
+    auto statistics = index->getSlotChainStatistics(TransactionType::READ_ONLY);
+    vector<int64_t> deletedKeys;
+    for (auto i = 0u; i < keys.size(); i += 3) {
+        deleteKey(keys[i]);
+        deletedKeys.push_back(keys[i]);
+    }
+    commitAndReopenIndex(INT64);
+    checkLookups(deletedKeys);
+    for (auto& key : deletedKeys) {
+        insert(key, getValue(key) + 1);
+    }
+    commitAndReopenIndex(INT64);
+    checkLookups({} /* nonExistingKeys */);
+    auto statisticsAfterReinsertion = index->getSlotChainStatistics(TransactionType::READ_ONLY);
+    ASSERT_EQ(statisticsAfterReinsertion.numPrimarySlots, statistics.numPrimarySlots);
+    ASSERT_EQ(statisticsAfterReinsertion.numOverflowSlots, statistics.numOverflowSlots);
+}
+
+// Insertions split the primary slots, whose entries, including those of their overflow slots, are
+// rehashed into the new slots.
+TEST_F(HashIndexInt64Test, LookupAfterSplitTest) {
+    auto keys = getKeysWithHashBits(SLOT_MASK, 0 /* bits */, NUM_KEYS_IN_CHAIN);
+    build(concat(getFillerKeys(0 /* startKey */, NUM_FILLER_KEYS), keys));
+    auto statistics = index->getSlotChainStatistics(TransactionType::READ_ONLY);
+    auto startKey = -(int64_t)(5 * NUM_FILLER_KEYS);
+    for (auto key : getFillerKeys(startKey, 2 * NUM_FILLER_KEYS)) {
+        insert(key, getValue(key));
+    }
+    commitAndReopenIndex(INT64);
+    checkLookups(getFillerKeys(startKey + 2 * NUM_FILLER_KEYS, NUM_FILLER_KEYS));
+    for (auto key : getFillerKeys(startKey + 3 * NUM_FILLER_KEYS, 2 * NUM_FILLER_KEYS)) {
+        insert(key, getValue(key));
+    }
+    for (auto i = 0u; i < keys.size(); i += 2) {
+        deleteKey(keys[i]);
+    }
+    commitAndReopenIndex(INT64);
+    checkLookups({keys[0], keys[2]});
+    ASSERT_GT(index->getSlotChainStatistics(TransactionType::READ_ONLY).numPrimarySlots,
+        4 * statistics.numPrimarySlots);
+}
+
+// Splitting slots rehashes STRING keys, which are read from the overflow file.
+TEST_F(HashIndexStringTest, KeysWithSameFingerprintAfterSplitTest) {
+    auto keys = getKeysWithHashBits<string>(
+        FINGERPRINT_AND_SLOT_MASK, 0 /* bits */, 30 /* numKeys */, getKey);
+    auto keysToBuild = vector<string>(keys.begin(), keys.begin() + 10);
+    for (auto i = 0; i < 1000; i++) {
+        keysToBuild.push_back(to_string(i));
+    }
+    build(keysToBuild);
+    checkLookups(vector<string>(keys.begin() + 10, keys.end()));
+    for (auto i = 10u; i < 20u; i++) {
+        insert(keys[i], i);
+    }
+    for (auto i = 1000; i < 4000; i++) {
+        insert(to_string(i), i);
+    }
+    commitAndReopenIndex(STRING);
+    checkLookups(vector<string>(keys.begin() + 20, keys.end()));
+}
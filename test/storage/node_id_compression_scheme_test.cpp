@@ -0,0 +1,53 @@
+#include "include/gtest/gtest.h"
+
+#include "src/storage/include/node_id_compression_scheme.h"
+
+using namespace kuzu::common;
+
+class NodeIDCompressionSchemeTest : public testing::Test {
+
+public:
+    // Writes numNodeIDs nodeIDs with the scheme, reads them back both at once and one at a time,
+    // and checks that they match the written nodeIDs. Reads start at startPos to also decode
+    // ranges that do not start at the beginning of a page.
+    static void writeAndReadNodeIDs(const NodeIDCompressionScheme& compressionScheme,
+        const vector<table_id_t>& tableIDs, uint64_t numNodeIDs, uint64_t startPos) {
+        auto numBytesPerNodeID = compressionScheme.getNumBytesForNodeIDAfterCompression();
+        auto data = make_unique<uint8_t[]>(numNodeIDs * numBytesPerNodeID);
+        vector<nodeID_t> nodeIDs(numNodeIDs);
+        for (auto i = 0u; i < numNodeIDs; i++) {
+            nodeIDs[i] = nodeID_t((node_offset_t)i * 7919, tableIDs[i % tableIDs.size()]);
+            compressionScheme.writeNodeID(data.get() + i * numBytesPerNodeID, &nodeIDs[i]);
+        }
+        auto numNodeIDsToRead = numNodeIDs - startPos;
+        vector<nodeID_t> readNodeIDs(numNodeIDsToRead);
+        compressionScheme.readNodeIDs(
+            data.get() + startPos * numBytesPerNodeID, readNodeIDs.data(), numNodeIDsToRead);
+        for (auto i = 0u; i < numNodeIDsToRead; i++) {
+            nodeID_t readNodeID;
+            compressionScheme.readNodeID(
+                data.get() + (startPos + i) * numBytesPerNodeID, &readNodeID);
+            ASSERT_EQ(readNodeIDs[i], nodeIDs[startPos + i]);
+            ASSERT_EQ(readNodeID, nodeIDs[startPos + i]);
+        }
+    }
+};
+
+TEST_F(NodeIDCompressionSchemeTest, ReadNodeIDsWithCommonTableIDTest) {
+    NodeIDCompressionScheme compressionScheme(unordered_set<table_id_t>{3});
+    ASSERT_EQ(compressionScheme.getNumBytesForNodeIDAfterCompression(), sizeof(node_offset_t));
+    for (auto numNodeIDs : {0u, 1u, 7u, 1000u}) {
+        writeAndReadNodeIDs(compressionScheme, {3}, numNodeIDs, 0 /* startPos */);
+    }
+    writeAndReadNodeIDs(compressionScheme, {3}, 1000, 333 /* startPos */);
+}
+
+TEST_F(NodeIDCompressionSchemeTest, ReadNodeIDsWithoutCommonTableIDTest) {
+    NodeIDCompressionScheme compressionScheme(unordered_set<table_id_t>{3, 5});
+    ASSERT_EQ(compressionScheme.getNumBytesForNodeIDAfterCompression(),
+        Types::getDataTypeSize(NODE_ID));
+    for (auto numNodeIDs : {0u, 1u, 7u, 1000u}) {
+        writeAndReadNodeIDs(compressionScheme, {3, 5}, numNodeIDs, 0 /* startPos */);
+    }
+    writeAndReadNodeIDs(compressionScheme, {3, 5}, 1000, 333 /* startPos */);
+}
@@ -119,3 +119,56 @@ TEST_F(NodeInsertionDeletionTests, DeleteAddMixedTest) {
     ASSERT_EQ(conn->query(query)->getNext()->getResultValue(0)->getInt64Val(), 5000);
     ASSERT_EQ(readConn->query(query)->getNext()->getResultValue(0)->getInt64Val(), 5000);
 }
+
+// The batched lookup of the selected keys of a ValueVector must agree with single key lookups, for
+// keys in the persistent index, keys inserted or deleted by the write transaction and missing keys.
+TEST_F(NodeInsertionDeletionTests, BatchedPrimaryKeyLookupTest) {
+    auto pkIndex = personNodeTable->getPKIndex();
+    auto dataChunk = make_shared<DataChunk>(1);
+    auto keyVector = make_shared<ValueVector>(INT64, getMemoryManager(*database));
+    dataChunk->insert(0, keyVector);
+    dataChunk->state->initOriginalAndSelectedSize(DEFAULT_VECTOR_CAPACITY);
+    // Keys are distinct and unsorted. Keys 10000 to 10099 are not in the persistent index.
+    auto keys = (int64_t*)keyVector->values;
+    for (auto i = 0u; i < DEFAULT_VECTOR_CAPACITY; ++i) {
+        keys[i] = (i * 7919) % 10100;
+    }
+    for (auto i = 0u; i < DEFAULT_VECTOR_CAPACITY; ++i) {
+        if (keys[i] >= 10000 && keys[i] < 10050) {
+            ASSERT_TRUE(pkIndex->insert(keyVector.get(), i, keys[i] /* nodeOffset */));
+        } else if (keys[i] < 10000 && keys[i] % 10 == 1) {
+            pkIndex->deleteKey(keyVector.get(), i);
+        }
+    }
+    auto selVector = dataChunk->state->selVector.get();
+    selVector->resetSelectorToValuePosBuffer();
+    sel_t numSelectedKeys = 0;
+    for (auto i = 0u; i < DEFAULT_VECTOR_CAPACITY; ++i) {
+        if (i % 3 != 0) {
+            selVector->getSelectedPositionsBuffer()[numSelectedKeys++] = i;
+        }
+    }
+    selVector->selectedSize = numSelectedKeys;
+    auto writeTrx = getActiveTransaction(*conn);
+    auto readOnlyTrx = Transaction::getDummyReadOnlyTrx();
+    auto results = make_unique<node_offset_t[]>(DEFAULT_VECTOR_CAPACITY);
+    auto isFound = make_unique<bool[]>(DEFAULT_VECTOR_CAPACITY);
+    for (auto trx : {writeTrx, readOnlyTrx.get()}) {
+        pkIndex->lookup(trx, keyVector.get(), results.get(), isFound.get());
+        for (auto i = 0u; i < numSelectedKeys; ++i) {
+            auto pos = selVector->selectedPositions[i];
+            node_offset_t result;
+            ASSERT_EQ(pkIndex->lookup(trx, keyVector.get(), pos, result), isFound[pos]);
+            auto key = keys[pos];
+            if (trx == writeTrx) {
+                ASSERT_EQ((key < 10000 && key % 10 != 1) || (key >= 10000 && key < 10050),
+                    isFound[pos]);
+            } else {
+                ASSERT_EQ(key < 10000, isFound[pos]);
+            }
+            if (isFound[pos]) {
+                ASSERT_EQ((node_offset_t)key, results[pos]);
+            }
+        }
+    }
+}
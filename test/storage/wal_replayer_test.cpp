@@ -20,3 +20,141 @@ TEST_F(WALReplayerTests, ReplayingUncommittedWALForChekpointErrors) {
     } catch (StorageException& e) {
     } catch (Exception& e) { FAIL(); }
 }
+
+// Replays page records of node property column files that only consist of pages filled with a
+// single byte value, which stands for the version of the page.
+class WALReplayerPageRecordsTests : public Test {
+
+public:
+    void SetUp() override {
+        FileUtils::createDir(TestHelper::TEMP_TEST_DIR);
+        bufferManager = make_unique<BufferManager>(
+            StorageConfig::DEFAULT_BUFFER_POOL_SIZE_FOR_TESTING, 0 /* largePageBufferPoolSize */);
+        wal = make_unique<WAL>(TestHelper::TEMP_TEST_DIR, *bufferManager);
+        taskScheduler = make_unique<TaskScheduler>(4 /* numThreads */);
+    }
+
+    void TearDown() override {
+        wal.reset();
+        FileUtils::removeDir(TestHelper::TEMP_TEST_DIR);
+    }
+
+    static StorageStructureID getColumnID(uint32_t propertyID) {
+        return StorageStructureID::newStructuredNodePropertyColumnID(0 /* tableID */, propertyID);
+    }
+
+    static string getColumnFileName(uint32_t propertyID) {
+        return StorageUtils::getFileNameForReadWrite(
+            TestHelper::TEMP_TEST_DIR, getColumnID(propertyID));
+    }
+
+    void createColumnFile(uint32_t propertyID) const {
+        auto fileInfo = FileUtils::openFile(getColumnFileName(propertyID), O_RDWR | O_CREAT);
+        auto pages = make_unique<uint8_t[]>(NUM_PAGES_PER_FILE * DEFAULT_PAGE_SIZE);
+        fill(pages.get(), pages.get() + NUM_PAGES_PER_FILE * DEFAULT_PAGE_SIZE, 0);
+        FileUtils::writeToFile(
+            fileInfo.get(), pages.get(), NUM_PAGES_PER_FILE * DEFAULT_PAGE_SIZE, 0 /* offset */);
+        FileUtils::closeFile(fileInfo->fd);
+    }
+
+    void logPageUpdate(uint32_t propertyID, page_idx_t pageIdx, uint8_t version) const {
+        auto pageIdxInWAL = wal->logPageUpdateRecord(getColumnID(propertyID), pageIdx);
+        uint8_t page[DEFAULT_PAGE_SIZE];
+        fill(page, page + DEFAULT_PAGE_SIZE, version);
+        wal->fileHandle->writePage(page, pageIdxInWAL);
+    }
+
+    void replay() const {
+        wal->logCommit(0 /* transactionID */);
+        WALReplayer walReplayer(wal.get(), taskScheduler.get());
+        walReplayer.replay();
+    }
+
+    static void checkPageVersions(uint32_t propertyID, const vector<uint8_t>& expectedVersions) {
+        auto fileInfo = FileUtils::openFile(getColumnFileName(propertyID), O_RDONLY);
+        uint8_t page[DEFAULT_PAGE_SIZE];
+        for (auto pageIdx = 0u; pageIdx < NUM_PAGES_PER_FILE; pageIdx++) {
+            FileUtils::readFromFile(
+                fileInfo.get(), page, DEFAULT_PAGE_SIZE, pageIdx * DEFAULT_PAGE_SIZE);
+            auto expectedVersion =
+                pageIdx < expectedVersions.size() ? expectedVersions[pageIdx] : (uint8_t)0;
+            for (auto i = 0u; i < DEFAULT_PAGE_SIZE; i++) {
+                ASSERT_EQ(page[i], expectedVersion);
+            }
+        }
+        FileUtils::closeFile(fileInfo->fd);
+    }
+
+public:
+    static constexpr uint64_t NUM_PAGES_PER_FILE = 200;
+    unique_ptr<BufferManager> bufferManager;
+    unique_ptr<WAL> wal;
+    unique_ptr<TaskScheduler> taskScheduler;
+};
+
+TEST_F(WALReplayerPageRecordsTests, LastRecordOfPageWinsTest) {
+    createColumnFile(0 /* propertyID */);
+    logPageUpdate(0, 3, 1);
+    logPageUpdate(0, 5, 1);
+    logPageUpdate(0, 3, 2);
+    logPageUpdate(0, 4, 1);
+    logPageUpdate(0, 3, 3);
+    logPageUpdate(0, 5, 2);
+    replay();
+    checkPageVersions(0, vector<uint8_t>{0, 0, 0, 3, 1, 2});
+}
+
+TEST_F(WALReplayerPageRecordsTests, ContiguousRunLongerThanMaxNumPagesPerWriteTest) {
+    createColumnFile(0 /* propertyID */);
+    auto numPages = 2 * StorageConfig::MAX_NUM_PAGES_PER_WRITE + 22;
+    vector<uint8_t> expectedVersions(numPages);
+    // The records are logged in reverse order, so that they are only contiguous once sorted.
+    for (int64_t pageIdx = numPages - 1; pageIdx >= 0; pageIdx--) {
+        expectedVersions[pageIdx] = pageIdx % 250 + 1;
+        logPageUpdate(0, pageIdx, expectedVersions[pageIdx]);
+    }
+    replay();
+    checkPageVersions(0, expectedVersions);
+}
+
+TEST_F(WALReplayerPageRecordsTests, RunsWithGapsTest) {
+    createColumnFile(0 /* propertyID */);
+    vector<uint8_t> expectedVersions(NUM_PAGES_PER_FILE, 0);
+    for (auto pageIdx : {20u, 0u, 1u, 2u, 11u, 10u, 199u, 40u, 41u, 42u, 43u, 44u, 45u, 100u}) {
+        expectedVersions[pageIdx] = pageIdx % 250 + 1;
+        logPageUpdate(0, pageIdx, expectedVersions[pageIdx]);
+    }
+    replay();
+    checkPageVersions(0, expectedVersions);
+}
+
+// Page records before a record of another type are replayed before it and page records after it
+// are replayed after it, so the latter win.
+TEST_F(WALReplayerPageRecordsTests, PageRecordsOfMultipleFilesMixedWithOtherRecordsTest) {
+    for (auto propertyID = 0u; propertyID < 3; propertyID++) {
+        createColumnFile(propertyID);
+    }
+    for (auto pageIdx = 0u; pageIdx < 100; pageIdx++) {
+        logPageUpdate(pageIdx % 3 /* propertyID */, pageIdx, 1);
+    }
+    auto overflowFileID = getColumnID(0 /* propertyID */);
+    overflowFileID.isOverflow = true;
+    wal->logOverflowFileNextBytePosRecord(overflowFileID, 0 /* prevNextByteToWriteTo */);
+    logPageUpdate(1, 1, 2);
+    logPageUpdate(0, 0, 2);
+    logPageUpdate(1, 1, 3);
+    wal->logCommit(0 /* transactionID */);
+    logPageUpdate(0, 0, 3);
+    logPageUpdate(2, 101, 3);
+    replay();
+    vector<vector<uint8_t>> expectedVersions(3, vector<uint8_t>(102, 0));
+    for (auto pageIdx = 0u; pageIdx < 100; pageIdx++) {
+        expectedVersions[pageIdx % 3][pageIdx] = 1;
+    }
+    expectedVersions[0][0] = 3;
+    expectedVersions[1][1] = 3;
+    expectedVersions[2][101] = 3;
+    for (auto propertyID = 0u; propertyID < 3; propertyID++) {
+        checkPageVersions(propertyID, expectedVersions[propertyID]);
+    }
+}
@@ -0,0 +1,62 @@
+#include "test/test_utility/include/test_helper.h"
+
+#include "src/storage/storage_structure/include/zone_map.h"
+
+using namespace kuzu::storage;
+using namespace kuzu::testing;
+
+class ZoneMapTests : public Test {
+
+protected:
+    void SetUp() override { FileUtils::createDir(TestHelper::TEMP_TEST_DIR); }
+
+    void TearDown() override { FileUtils::removeDir(TestHelper::TEMP_TEST_DIR); }
+
+public:
+    string fName = string(TestHelper::TEMP_TEST_DIR) + "zone_map_test.zonemap";
+};
+
+TEST_F(ZoneMapTests, MayMatchTest) {
+    ZoneMap zoneMap(INT64, fName, 3 /* numPages */);
+    // Page 0 holds values in [10, 20], page 1 holds only NULLs and page 2 holds 30.
+    for (int64_t value : {15, 10, 20}) {
+        zoneMap.update(0 /* pageIdx */, (uint8_t*)&value);
+    }
+    int64_t value = 30;
+    zoneMap.update(2 /* pageIdx */, (uint8_t*)&value);
+    auto literal = Literal((int64_t)20);
+    ASSERT_TRUE(zoneMap.mayMatch(0, 0, EQUALS, literal));
+    ASSERT_TRUE(zoneMap.mayMatch(0, 0, GREATER_THAN_EQUALS, literal));
+    ASSERT_FALSE(zoneMap.mayMatch(0, 0, GREATER_THAN, literal));
+    ASSERT_FALSE(zoneMap.mayMatch(1, 1, NOT_EQUALS, literal));
+    ASSERT_FALSE(zoneMap.mayMatch(2, 2, LESS_THAN_EQUALS, literal));
+    ASSERT_TRUE(zoneMap.mayMatch(0, 2, GREATER_THAN, literal));
+    // Pages without a zone may always match.
+    ASSERT_TRUE(zoneMap.mayMatch(3, 3, EQUALS, literal));
+}
+
+TEST_F(ZoneMapTests, SaveReadAndUpdateTest) {
+    ZoneMap zoneMap(DOUBLE, fName, 1 /* numPages */);
+    double value = 1.5;
+    zoneMap.update(0 /* pageIdx */, (uint8_t*)&value);
+    zoneMap.saveToFile();
+    auto zoneMapFromFile = ZoneMap::readFromFileIfExists(DOUBLE, fName);
+    ASSERT_NE(zoneMapFromFile, nullptr);
+    ASSERT_TRUE(zoneMapFromFile->mayMatch(0, 0, EQUALS, Literal(1.5)));
+    ASSERT_FALSE(zoneMapFromFile->mayMatch(0, 0, GREATER_THAN, Literal(1.5)));
+    // Only updates that widen a zone are tracked, and they leave the file unchanged until the
+    // zone map is saved again.
+    zoneMapFromFile->update(0 /* pageIdx */, (uint8_t*)&value);
+    ASSERT_FALSE(zoneMapFromFile->hasUpdates());
+    value = 2.5;
+    zoneMapFromFile->update(0 /* pageIdx */, (uint8_t*)&value);
+    ASSERT_TRUE(zoneMapFromFile->hasUpdates());
+    ASSERT_TRUE(zoneMapFromFile->mayMatch(0, 0, GREATER_THAN, Literal(1.5)));
+    ASSERT_FALSE(
+        ZoneMap::readFromFileIfExists(DOUBLE, fName)->mayMatch(0, 0, GREATER_THAN, Literal(1.5)));
+    zoneMapFromFile->saveToFile(DBFileType::WAL_VERSION);
+    zoneMapFromFile->clearUpdates();
+    ASSERT_FALSE(zoneMapFromFile->hasUpdates());
+    ASSERT_TRUE(ZoneMap::readFromFileIfExists(DOUBLE, fName + StorageConfig::WAL_FILE_SUFFIX)
+                    ->mayMatch(0, 0, GREATER_THAN, Literal(1.5)));
+}
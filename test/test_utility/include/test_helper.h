@@ -102,6 +102,14 @@ protected:
         database.commitAndCheckpointOrRollback(
             writeTransaction, isCommit, skipCheckpointForTestingRecovery);
     }
+    static inline shared_ptr<FactorizedTable> executeInGroupCommit(Database& database,
+        const std::function<shared_ptr<FactorizedTable>(Transaction*)>& executeQuery) {
+        return database.executeInGroupCommit(executeQuery);
+    }
+    static inline uint64_t getNumTransactionsWaitingForGroupCommit(Database& database) {
+        lock_guard lck{database.groupCommitMtx};
+        return database.numTransactionsWaitingForGroupCommit;
+    }
     static inline QueryProcessor* getQueryProcessor(Database& database) {
         return database.queryProcessor.get();
     }
@@ -136,6 +144,14 @@ protected:
     static inline void rollbackIfNecessaryNoLock(Connection& connection) {
         connection.rollbackIfNecessaryNoLock();
     }
+    static inline vector<unique_ptr<planner::LogicalPlan>> enumeratePlans(
+        Connection& connection, const string& query) {
+        return connection.enumeratePlans(query);
+    }
+    static inline unique_ptr<QueryResult> executePlan(
+        Connection& connection, unique_ptr<planner::LogicalPlan> plan) {
+        return connection.executePlan(std::move(plan));
+    }
 
     void validateColumnFilesExistence(string fileName, bool existence, bool hasOverflow);
 
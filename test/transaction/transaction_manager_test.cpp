@@ -1,3 +1,6 @@
+#include <atomic>
+#include <thread>
+
 #include "gtest/gtest.h"
 #include "test/test_utility/include/test_helper.h"
 
@@ -118,3 +121,72 @@ TEST_F(TransactionManagerTest, BasicOneWriteMultipleReadOnlyTransactions) {
     ASSERT_EQ(
         expectedReadOnlyTransactionSet, transactionManager->getActiveReadOnlyTransactionIDs());
 }
+
+TEST_F(TransactionManagerTest, CommitWithPendingCheckpoint) {
+    unique_ptr<Transaction> trx1 = transactionManager->beginReadOnlyTransaction();
+    unique_ptr<Transaction> trx2 = transactionManager->beginWriteTransaction();
+    transactionManager->commitButKeepActiveWriteTransaction(trx2.get());
+    transactionManager->startPendingCheckpoint();
+    // Read-only transactions that start before the checkpoint read the committed version.
+    unique_ptr<Transaction> trx3 = transactionManager->beginReadOnlyTransaction();
+    ASSERT_EQ(READ_ONLY, trx1->getVersionToRead());
+    ASSERT_EQ(WRITE, trx3->getVersionToRead());
+    ASSERT_TRUE(trx3->isReadOnly());
+    ASSERT_EQ(trx2->getID(), transactionManager->getActiveWriteTransactionID());
+
+    // Write transactions wait for the checkpoint to finish.
+    unique_ptr<Transaction> trx4;
+    thread writeThread([&] { trx4 = transactionManager->beginWriteTransaction(); });
+    transactionManager->commit(trx1.get());
+    transactionManager->waitUntilReadTransactionsBeforePendingCheckpointLeave();
+    transactionManager->commit(trx3.get());
+    transactionManager->stopNewTransactionsForPendingCheckpoint();
+    ASSERT_EQ(nullptr, trx4);
+    transactionManager->finishPendingCheckpoint();
+    transactionManager->allowReceivingNewTransactions();
+    writeThread.join();
+    ASSERT_EQ(trx4->getID(), transactionManager->getActiveWriteTransactionID());
+    unique_ptr<Transaction> trx5 = transactionManager->beginReadOnlyTransaction();
+    ASSERT_EQ(READ_ONLY, trx5->getVersionToRead());
+}
+
+TEST_F(TransactionManagerTest, StopNewTransactionsForPendingCheckpointRetriesAfterTimeout) {
+    transactionManager->setCheckPointWaitTimeoutForTransactionsToLeaveInMicros(1000);
+    unique_ptr<Transaction> trx1 = transactionManager->beginWriteTransaction();
+    transactionManager->commitButKeepActiveWriteTransaction(trx1.get());
+    transactionManager->startPendingCheckpoint();
+    unique_ptr<Transaction> trx2 = transactionManager->beginReadOnlyTransaction();
+    atomic<bool> isStopped{false};
+    thread checkpointThread([&] {
+        transactionManager->stopNewTransactionsForPendingCheckpoint();
+        isStopped = true;
+        transactionManager->finishPendingCheckpoint();
+        transactionManager->allowReceivingNewTransactions();
+    });
+    // While trx2 is active, the checkpoint thread times out and lets new transactions start.
+    unique_ptr<Transaction> trx3 = transactionManager->beginReadOnlyTransaction();
+    ASSERT_FALSE(isStopped);
+    transactionManager->commit(trx2.get());
+    transactionManager->commit(trx3.get());
+    checkpointThread.join();
+    ASSERT_TRUE(isStopped);
+}
+
+TEST_F(TransactionManagerTest, FailedPendingCheckpointErrorsWaitingWriteTransactions) {
+    unique_ptr<Transaction> trx1 = transactionManager->beginWriteTransaction();
+    transactionManager->commitButKeepActiveWriteTransaction(trx1.get());
+    transactionManager->startPendingCheckpoint();
+    atomic<bool> hasWriteTransactionFailed{false};
+    thread writeThread([&] {
+        try {
+            transactionManager->beginWriteTransaction();
+        } catch (TransactionManagerException& e) { hasWriteTransactionFailed = true; }
+    });
+    transactionManager->failPendingCheckpoint("Checkpoint error.");
+    writeThread.join();
+    ASSERT_TRUE(hasWriteTransactionFailed);
+    try {
+        transactionManager->beginWriteTransaction();
+        FAIL();
+    } catch (TransactionManagerException& e) {}
+}
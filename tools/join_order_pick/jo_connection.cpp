@@ -17,6 +17,7 @@ unique_ptr<QueryResult> JOConnection::query(const string& query, const string& e
         auto statement = Parser::parseQuery(query);
         assert(statement->getStatementType() == StatementType::QUERY);
         auto parsedQuery = (RegularQuery*)statement.get();
+        preparedStatement->preparedSummary.isProfile = parsedQuery->isEnableProfile();
         auto boundQuery = Binder(*database->catalog).bind(*parsedQuery);
         auto& nodesStatisticsAndDeletedIDs =
             database->storageManager->getNodesStore().getNodesStatisticsAndDeletedIDs();
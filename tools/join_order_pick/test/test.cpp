@@ -52,3 +52,36 @@ TEST_F(JoinOrderPickTest, TwoHop) {
     auto queryStr = "MATCH (a:person)-[:knows]->(b:person)-[:knows]->(c:person) RETURN a.ID";
     ASSERT_TRUE(conn->query(queryStr, "HJ(c){S(c)}{HJ(a){E(a)E(c)S(b)}{S(a)}}")->isSuccess());
 }
+
+TEST_F(JoinOrderPickTest, SemiJoinFilterPrunesProbeSideTuples) {
+    // The build side only holds Alice, so the semi join filter after the extend drops the probe
+    // side tuples whose b is not Alice before they reach the hash join probe.
+    auto queryStr =
+        "PROFILE MATCH (a:person)-[:knows]->(b:person) WHERE b.fName = 'Alice' RETURN COUNT(*)";
+    auto result = conn->query(queryStr, "HJ(b){E(b)S(a)}{S(b)}");
+    ASSERT_TRUE(result->isSuccess());
+    ASSERT_EQ(result->getNext()->getResultValue(0)->getInt64Val(), 3);
+    function<nlohmann::json*(nlohmann::json&)> findSemiJoinFilter =
+        [&](nlohmann::json& op) -> nlohmann::json* {
+        if (op["name"] == "SEMI_JOIN_FILTER") {
+            return &op;
+        }
+        for (auto child : {"prev", "right"}) {
+            if (op.contains(child)) {
+                if (auto semiJoinFilter = findSemiJoinFilter(op[child])) {
+                    return semiJoinFilter;
+                }
+            }
+        }
+        return nullptr;
+    };
+    auto semiJoinFilter = findSemiJoinFilter(result->getQuerySummary()->printPlanToJson());
+    ASSERT_NE(semiJoinFilter, nullptr);
+    auto& extend = (*semiJoinFilter)["prev"];
+    ASSERT_EQ(extend["name"], "LIST_EXTEND");
+    // All 14 knows edges are extended, but at most a few false positives of the bloom filter
+    // pass it besides the 3 edges to Alice.
+    ASSERT_EQ(extend["numOutputTuples"].get<uint64_t>(), 14);
+    ASSERT_GE((*semiJoinFilter)["numOutputTuples"].get<uint64_t>(), 3);
+    ASSERT_LT((*semiJoinFilter)["numOutputTuples"].get<uint64_t>(), 14);
+}